@@ -1260,6 +1260,39 @@ const ::hermes::vm::GCExecTrace &HermesRuntime::getGCExecTrace() const {
       ->runtime_.getGCExecTrace();
 }
 
+bool HermesRuntime::stringifyTo(
+    const jsi::Value &value,
+    const std::function<void(const char *data, size_t length)> &sink) {
+  vm::Runtime &runtime = impl(this)->runtime_;
+  vm::GCScope gcScope(runtime);
+  std::string utf8;
+  std::exception_ptr sinkException;
+  auto res = vm::runtimeJSONStringifyTo(
+      runtime,
+      impl(this)->vmHandleFromValue(value),
+      vm::Runtime::getUndefinedValue(),
+      vm::Runtime::getUndefinedValue(),
+      [&](llvh::ArrayRef<char16_t> chunk) {
+        utf8.clear();
+        ::hermes::convertUTF16ToUTF8WithReplacements(utf8, chunk);
+        try {
+          sink(utf8.data(), utf8.size());
+        } catch (...) {
+          // Unwind the serialization with a JS exception, then replace it
+          // with the original one below.
+          sinkException = std::current_exception();
+          return runtime.raiseError("JSON output sink threw an exception");
+        }
+        return vm::ExecutionStatus::RETURNED;
+      });
+  if (sinkException) {
+    runtime.clearThrownValue();
+    std::rethrow_exception(sinkException);
+  }
+  impl(this)->checkStatus(res.getStatus());
+  return *res;
+}
+
 std::string HermesRuntime::getIOTrackingInfoJSON() {
   std::string buf;
   llvh::raw_string_ostream strstrm(buf);
@@ -9,6 +9,7 @@
 #define HERMES_HERMES_H
 
 #include <exception>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -140,6 +141,17 @@ class HERMES_EXPORT HermesRuntime : public jsi::Runtime {
   /// non-deterministic execution.
   const ::hermes::vm::GCExecTrace &getGCExecTrace() const;
 
+  /// Serialize \p value as JSON, like JSON.stringify(value), passing the
+  /// UTF-8 text to \p sink in chunks as it is produced instead of creating one
+  /// string, which bounds the memory needed for large values. If \p sink
+  /// throws, or the serialization throws a JS exception, the exception is
+  /// rethrown and the chunks passed so far are incomplete.
+  /// \return false if \p value has no JSON representation, e.g. it is
+  /// undefined, in which case \p sink is not called.
+  bool stringifyTo(
+      const jsi::Value &value,
+      const std::function<void(const char *data, size_t length)> &sink);
+
   /// Get IO tracking (aka HBC page access) info as a JSON string.
   /// See hermes::vm::Runtime::getIOTrackingInfoJSON() for conditions
   /// needed for there to be useful output.
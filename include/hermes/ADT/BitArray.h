@@ -11,6 +11,7 @@
 #include "llvh/Support/MathExtras.h"
 
 #include <array>
+#include <atomic>
 #include <bitset>
 
 #pragma GCC diagnostic push
@@ -142,6 +143,21 @@ class BitArray {
       allBits_[wordIdx] &= ~mask;
   }
 
+  /// Atomically set the bit at \p idx to 1.
+  /// This may be called concurrently with other calls to atomicTestAndSet and
+  /// at(), but not concurrently with any of the non-atomic mutators.
+  /// \return the value of the bit before it was set.
+  inline bool atomicTestAndSet(size_t idx) {
+    static_assert(
+        sizeof(std::atomic<uintptr_t>) == sizeof(uintptr_t),
+        "Atomic words must have the same layout as plain words");
+    assert(idx < N && "Index must be within the bitset");
+    const uintptr_t mask = 1ULL << (idx % kBitsPerWord);
+    const size_t wordIdx = idx / kBitsPerWord;
+    auto *word = reinterpret_cast<std::atomic<uintptr_t> *>(&allBits_[wordIdx]);
+    return word->fetch_or(mask, std::memory_order_relaxed) & mask;
+  }
+
   /// Set all bits to 0.
   inline void reset() {
     std::fill_n(allBits_.begin(), kNumWords, 0);
@@ -85,6 +85,10 @@ struct OptimizationSettings {
   /// Reuse property cache entries for same property name.
   bool reusePropCache{true};
 
+  /// Replace common sequences of bytecode instructions with
+  /// superinstructions.
+  bool superinstructions{true};
+
   /// Recognize calls to global functions like Object.keys() and turn them
   /// into builtin calls.
   bool staticBuiltins{false};
@@ -55,6 +55,9 @@ class BytecodeSerializer {
   uint32_t overflowStringEntryCount_{0};
   /// Hash of everything written in non-layout mode so far.
   llvh::SHA1 outputHasher_;
+  /// IDs of all functions in the order their bytecode and info are written,
+  /// computed during layout phase.
+  std::vector<uint32_t> functionLayoutOrder_{};
 
   /// Each subsection of a function's `info' section is aligned thusly.
   static constexpr uint32_t INFO_ALIGNMENT = 4;
@@ -108,6 +111,13 @@ class BytecodeSerializer {
   void serializeFunctionsBytecode(BytecodeModule &BM);
   void serializeFunctionInfo(BytecodeFunction &BF);
 
+  /// Write the bytecode of every function in functionLayoutOrder_.
+  void writeFunctionBodies(BytecodeModule &BM);
+
+  /// Populate functionLayoutOrder_: the functions named by the layout profile
+  /// in options_ come first, the rest follow in function ID order.
+  void computeFunctionLayoutOrder(BytecodeModule &BM);
+
   void finishLayout(BytecodeModule &BM);
 
   void visitFunctionHeaders();
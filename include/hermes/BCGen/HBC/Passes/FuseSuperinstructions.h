@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_BCGEN_HBC_PASSES_FUSESUPERINSTRUCTIONS_H
+#define HERMES_BCGEN_HBC_PASSES_FUSESUPERINSTRUCTIONS_H
+
+#include "hermes/BCGen/HBC/BytecodeInstructionGenerator.h"
+
+#include "llvh/ADT/ArrayRef.h"
+
+namespace hermes {
+namespace hbc {
+
+/// Replace the opcode of every instruction that is followed by the second
+/// instruction of one of the superinstructions in BytecodeList.def with that
+/// superinstruction. A superinstruction has the layout of its first
+/// instruction, and the second one stays in place, so the size of the
+/// bytecode and every offset into it, like jump targets, exception handler
+/// ranges and debug info, are unchanged. This must run on the final bytecode
+/// of a function, once jumps have been relocated.
+/// \return true if any instruction was replaced.
+bool fuseSuperinstructions(llvh::MutableArrayRef<opcode_atom_t> bytecode);
+
+} // namespace hbc
+} // namespace hermes
+
+#endif
@@ -125,6 +125,37 @@ static opt<bool> MicrotaskQueue(
     init(RuntimeConfig::getDefaultMicrotaskQueue()),
     cat(RuntimeCategory));
 
+static opt<bool> JIT(
+    "Xjit",
+    desc("Compile hot functions with the baseline JIT, where available"),
+    init(RuntimeConfig::getDefaultEnableJIT()),
+    cat(RuntimeCategory));
+
+static opt<uint32_t> JITThreshold(
+    "Xjit-threshold",
+    desc("Number of calls after which a function is compiled by the JIT"),
+    init(RuntimeConfig::getDefaultJITThreshold()),
+    cat(RuntimeCategory));
+
+static opt<hermes::vm::RegExpEngine> RegExpEngine(
+    "Xregexp-engine",
+    desc("Choose the engine which executes regular expressions"),
+    init(RuntimeConfig::getDefaultRegExpEngine()),
+    llvh::cl::values(
+        clEnumValN(
+            hermes::vm::RegExpEngine::Auto,
+            "auto",
+            "Avoid backtracking for patterns which may need exponential time"),
+        clEnumValN(
+            hermes::vm::RegExpEngine::Backtracking,
+            "backtracking",
+            "Always backtrack"),
+        clEnumValN(
+            hermes::vm::RegExpEngine::NFA,
+            "nfa",
+            "Avoid backtracking for all supported patterns")),
+    cat(RuntimeCategory));
+
 static llvh::cl::opt<bool> StopAfterInit(
     "stop-after-module-init",
     llvh::cl::desc("Exit once module loading is finished. Useful "
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_REGEX_NFA_H
+#define HERMES_REGEX_NFA_H
+
+#include "hermes/Regex/Executor.h"
+#include "hermes/Regex/RegexBytecode.h"
+#include "hermes/Regex/RegexTypes.h"
+
+#include <memory>
+#include <vector>
+
+// This file contains a non-backtracking engine for regexps. Bytecode which
+// uses no backreferences or lookarounds is translated into a Thompson NFA,
+// which is run in lock step over the input so that matching takes time linear
+// in the length of the input, regardless of the pattern.
+
+namespace hermes {
+namespace regex {
+
+/// An instruction in an NFAProgram. Instructions either consume one code unit
+/// (Char, CharICase, Any, AnyButNewline, Bracket), check a condition on the
+/// current position (LeftAnchor, RightAnchor, WordBoundary), or move between
+/// states without consuming input.
+struct NFAInsn {
+  enum Op : uint8_t {
+    /// Match the code unit x.
+    Char,
+    /// Match a code unit which canonicalizes to x.
+    CharICase,
+    /// Match any code unit.
+    Any,
+    /// Match any code unit but a line terminator.
+    AnyButNewline,
+    /// Match a code unit in ranges [x, x + y) of the program, or in the
+    /// character classes, inverted by invert.
+    Bracket,
+    /// Continue at x, or with lower priority at y.
+    Split,
+    /// Continue at x.
+    Jump,
+    /// Store the current position in capture slot x.
+    Save,
+    /// Clear capture slots [x, y).
+    ResetCaptures,
+    LeftAnchor,
+    RightAnchor,
+    /// Match a word boundary, or a non-boundary if invert is set.
+    WordBoundary,
+    /// The regex matched.
+    Match,
+  };
+
+  Op op;
+
+  /// Whether a Bracket is negated, or a WordBoundary is \B.
+  bool invert;
+
+  /// Character classes of a Bracket, see BracketInsn.
+  uint8_t positiveCharClasses;
+  uint8_t negativeCharClasses;
+
+  uint32_t x;
+  uint32_t y;
+
+  /// \return whether this instruction consumes a code unit.
+  bool consumes() const {
+    return op <= Bracket;
+  }
+};
+
+class LazyDFA;
+
+/// A regex compiled to a Thompson NFA. The program caches DFA states that it
+/// discovers while searching, so it is not safe to search with the same
+/// program concurrently.
+class NFAProgram {
+ public:
+  /// Translate the compiled regex \p bytecode into an NFA.
+  /// \return the program, or nullptr if the regex cannot be expressed as an
+  /// NFA: it has backreferences, lookarounds or the unicode flag, or its
+  /// counted loops would expand past a size limit.
+  static std::unique_ptr<NFAProgram> fromBytecode(
+      llvh::ArrayRef<uint8_t> bytecode);
+
+  ~NFAProgram();
+
+  /// \return whether backtracking execution of this regex may take
+  /// exponential time. This is the case when a loop contains another loop or
+  /// an alternation, as in /(a+)+/ or /(a|ab)*/.
+  bool backtrackingIsRisky() const {
+    return backtrackingIsRisky_;
+  }
+
+  /// \return the instructions. Execution starts at the first one.
+  llvh::ArrayRef<NFAInsn> insns() const {
+    return insns_;
+  }
+
+  /// \return the ranges of the Bracket instruction \p insn.
+  llvh::ArrayRef<BracketRange32> bracketRanges(const NFAInsn &insn) const {
+    assert(insn.op == NFAInsn::Bracket && "Not a Bracket");
+    return llvh::makeArrayRef(ranges_).slice(insn.x, insn.y);
+  }
+
+  /// \return the number of capture groups, not counting the whole match.
+  uint16_t markedCount() const {
+    return markedCount_;
+  }
+
+  /// \return whether the multiline flag was set.
+  bool multiline() const {
+    return multiline_;
+  }
+
+  /// \return the number of bytes allocated for the program and its DFA cache.
+  size_t getAllocatedSize() const;
+
+ private:
+  friend class NFACompiler;
+  template <class CharT, class Traits>
+  friend MatchRuntimeResult searchWithNFAImpl(
+      NFAProgram &program,
+      const CharT *first,
+      uint32_t start,
+      uint32_t length,
+      std::vector<CapturedRange> *captures,
+      constants::MatchFlagType matchFlags);
+
+  NFAProgram() = default;
+
+  std::vector<NFAInsn> insns_;
+
+  /// Ranges referenced by Bracket instructions.
+  std::vector<BracketRange32> ranges_;
+
+  /// Number of capture groups, not counting the whole match.
+  uint16_t markedCount_ = 0;
+
+  /// Constraints on what strings can match the regex.
+  MatchConstraintSet constraints_ = 0;
+
+  /// Whether the multiline flag was set.
+  bool multiline_ = false;
+
+  /// See backtrackingIsRisky().
+  bool backtrackingIsRisky_ = false;
+
+  /// Whether the program can be run as a DFA: it may not look at the
+  /// characters around an assertion, so the only anchors allowed are
+  /// non-multiline ^ and $.
+  bool dfaCompatible_ = true;
+
+  /// DFAs built on demand, for searches anchored at the start position and
+  /// unanchored searches respectively.
+  std::unique_ptr<LazyDFA> anchoredDFA_;
+  std::unique_ptr<LazyDFA> unanchoredDFA_;
+};
+
+/// Given a string \p first with length \p length, look for regex matches
+/// starting at offset \p start, using the NFA \p program. This has the same
+/// contract as searchWithBytecode(), and finds the same match the backtracking
+/// executor would. It never returns StackOverflow.
+/// This is the char16_t overload.
+MatchRuntimeResult searchWithNFA(
+    NFAProgram &program,
+    const char16_t *first,
+    uint32_t start,
+    uint32_t length,
+    std::vector<CapturedRange> *captures,
+    constants::MatchFlagType matchFlags);
+
+/// This is the ASCII overload.
+MatchRuntimeResult searchWithNFA(
+    NFAProgram &program,
+    const char *first,
+    uint32_t start,
+    uint32_t length,
+    std::vector<CapturedRange> *captures,
+    constants::MatchFlagType matchFlags);
+
+} // namespace regex
+} // namespace hermes
+
+#endif // HERMES_REGEX_NFA_H
@@ -140,12 +140,24 @@ class Regex {
         markedCount_ <= constants::kMaxCaptureGroupCount &&
         "Too many capture groups");
     assert(loopCount_ <= constants::kMaxLoopCount && "Too many loops");
+
+    // Find the literals that every match contains, so the executor can skip
+    // to the positions where they occur.
+    LiteralScanner scanner;
+    Node::scanLiteralsForList(nodes_, scanner);
+    LiteralScanner::Literal anchored, floating;
+    scanner.finish(&anchored, &floating);
+
     RegexBytecodeHeader header = {
         markedCount_,
         static_cast<uint16_t>(loopCount_),
         flags_.toByte(),
-        matchConstraints_};
-    RegexBytecodeStream bcs(header);
+        matchConstraints_,
+        static_cast<uint16_t>(anchored.chars.size()),
+        static_cast<uint16_t>(anchored.chars.empty() ? 0 : anchored.offset),
+        static_cast<uint16_t>(floating.chars.size())};
+    std::u16string literals = anchored.chars + floating.chars;
+    RegexBytecodeStream bcs(header, {literals.data(), literals.size()});
     Node::compile(nodes_, bcs);
     return bcs.acquireBytecode();
   }
@@ -8,6 +8,7 @@
 #ifndef HERMES_REGEX_REGEXBYTECODE_H
 #define HERMES_REGEX_REGEXBYTECODE_H
 
+#include "llvh/ADT/ArrayRef.h"
 #include "llvh/ADT/DenseMap.h"
 #include "llvh/Support/Casting.h"
 
@@ -273,6 +274,23 @@ struct RegexBytecodeHeader {
 
   /// Constraints on what strings can match this regex.
   MatchConstraintSet constraints;
+
+  /// Number of UTF-16 code units in a literal that every match contains at
+  /// anchoredLiteralOffset code units from its start, or 0 if there is none.
+  uint16_t anchoredLiteralLength;
+  uint16_t anchoredLiteralOffset;
+
+  /// Number of UTF-16 code units in a literal that every match contains at
+  /// some unknown offset, or 0 if there is none.
+  uint16_t floatingLiteralLength;
+
+  /// \return the offset of the first instruction in the bytecode stream. The
+  /// header is followed by the code units of the anchored literal, then those
+  /// of the floating literal, then the instructions.
+  uint32_t instructionsOffset() const {
+    return sizeof(RegexBytecodeHeader) +
+        (anchoredLiteralLength + floatingLiteralLength) * sizeof(char16_t);
+  }
 };
 
 LLVM_PACKED_END;
@@ -296,6 +314,9 @@ class RegexBytecodeStream {
   /// Whether our bytecode has been acquired.
   bool acquired_ = false;
 
+  /// Offset of the first instruction, following the header and literals.
+  uint32_t instructionsOffset_;
+
  public:
   /// Type acting as a reallocation-safe pointer to an instruction.
   /// This stores a pointer to the vector and an offset, rather than a pointer
@@ -339,9 +360,9 @@ class RegexBytecodeStream {
   }
 
   /// \return the current offset in the stream, which is where the next
-  /// instruction will be emitted. Note the header is omitted.
+  /// instruction will be emitted. Note the header and literals are omitted.
   uint32_t currentOffset() const {
-    return bytes_.size() - sizeof(RegexBytecodeHeader);
+    return bytes_.size() - instructionsOffset_;
   }
 
   /// \return the bytecode, transferring ownership of it to the caller.
@@ -351,10 +372,25 @@ class RegexBytecodeStream {
     return std::move(bytes_);
   }
 
-  /// Construct a RegexBytecodeStream starting with a header.
-  RegexBytecodeStream(const RegexBytecodeHeader &header) {
+  /// Construct a RegexBytecodeStream starting with a header, followed by the
+  /// code units of its literals \p literals.
+  RegexBytecodeStream(
+      const RegexBytecodeHeader &header,
+      llvh::ArrayRef<char16_t> literals = {})
+      : instructionsOffset_(header.instructionsOffset()) {
+    assert(
+        literals.size() ==
+            size_t(header.anchoredLiteralLength) +
+                header.floatingLiteralLength &&
+        "Literals do not match the header");
     const uint8_t *headerBytes = reinterpret_cast<const uint8_t *>(&header);
     bytes_.insert(bytes_.end(), headerBytes, headerBytes + sizeof header);
+    const uint8_t *literalBytes =
+        reinterpret_cast<const uint8_t *>(literals.data());
+    bytes_.insert(
+        bytes_.end(),
+        literalBytes,
+        literalBytes + literals.size() * sizeof(char16_t));
   }
 };
 
@@ -23,6 +23,7 @@
 
 #include "hermes/Regex/RegexBytecode.h"
 #include "hermes/Regex/RegexTypes.h"
+#include "hermes/Support/UTF8.h"
 
 #include "llvh/ADT/SmallVector.h"
 
@@ -39,6 +40,138 @@ using NodeList = std::vector<Node *>;
 /// A NodeHolder is list of owned Nodes. Note it is move-only.
 using NodeHolder = std::vector<std::unique_ptr<Node>>;
 
+/// A LiteralScanner walks the nodes of a regex from left to right, and finds
+/// literal strings that every match must contain. The executor searches for
+/// these to skip input positions where no match can start.
+class LiteralScanner {
+ public:
+  /// Maximum number of code units in a literal. Longer runs are truncated.
+  static constexpr size_t kMaxLength = 32;
+
+  /// Maximum nesting depth of node lists we look into. Deeper lists are
+  /// treated as matching an unknown string.
+  static constexpr unsigned kMaxDepth = 16;
+
+  /// Marks a width or offset that is not a fixed number of code units.
+  static constexpr uint32_t kVaries = UINT32_MAX;
+
+  /// A string of code units that every match contains.
+  struct Literal {
+    std::u16string chars{};
+
+    /// Offset of the literal from the start of the match, or kVaries.
+    uint32_t offset = kVaries;
+  };
+
+  /// Append the code unit \p c, which every match contains at this point.
+  void appendCodeUnit(char16_t c) {
+    if (run_.empty())
+      runOffset_ = width_;
+    if (run_.size() < kMaxLength)
+      run_.push_back(c);
+    advance(1);
+  }
+
+  /// Append a character which always matches \p n code units, but whose value
+  /// is not known.
+  void appendUnknownCodeUnits(uint32_t n) {
+    endRun();
+    advance(n);
+  }
+
+  /// Append something which matches an unknown number of code units.
+  void appendUnknown() {
+    endRun();
+    width_ = kVaries;
+  }
+
+  /// Append a loop which runs at least \p min and at most \p max times, and
+  /// whose body was scanned by \p body.
+  void appendLoop(LiteralScanner &body, uint32_t min, uint32_t max) {
+    endRun();
+    body.endRun();
+    if (min > 0) {
+      // The first iteration starts here, so its literals are required too.
+      for (Literal &lit : body.candidates_) {
+        if (lit.offset != kVaries && width_ != kVaries)
+          lit.offset += width_;
+        else
+          lit.offset = kVaries;
+        addCandidate(std::move(lit));
+      }
+    }
+    if (min == max && body.width_ != kVaries &&
+        uint64_t(min) * body.width_ < kVaries) {
+      advance(min * body.width_);
+    } else {
+      width_ = kVaries;
+    }
+  }
+
+  /// Finish scanning. Set \p anchored to the best literal at a known offset
+  /// and \p floating to the best remaining literal; either may be empty.
+  void finish(Literal *anchored, Literal *floating) {
+    endRun();
+    *anchored = Literal{};
+    *floating = Literal{};
+    for (const Literal &lit : candidates_) {
+      if (lit.offset != kVaries && lit.offset <= UINT16_MAX &&
+          score(lit) > score(*anchored))
+        *anchored = lit;
+    }
+    for (const Literal &lit : candidates_) {
+      if (score(lit) > score(*floating) && lit.chars != anchored->chars)
+        *floating = lit;
+    }
+    // A floating literal only helps if it is rarer than the anchored one.
+    if (score(*floating) <= score(*anchored))
+      *floating = Literal{};
+    floating->offset = kVaries;
+  }
+
+ private:
+  /// Width so far of every match, in code units, or kVaries.
+  uint32_t width_ = 0;
+
+  /// The current run of known code units, and its offset.
+  std::u16string run_{};
+  uint32_t runOffset_ = 0;
+
+  /// Literals found so far.
+  std::vector<Literal> candidates_{};
+
+  void advance(uint32_t n) {
+    if (width_ != kVaries)
+      width_ = uint64_t(width_) + n < kVaries ? width_ + n : kVaries;
+  }
+
+  /// End the current run of code units, recording it as a candidate.
+  void endRun() {
+    if (!run_.empty())
+      addCandidate(Literal{std::move(run_), runOffset_});
+    run_.clear();
+  }
+
+  void addCandidate(Literal lit) {
+    candidates_.push_back(std::move(lit));
+  }
+
+  /// \return how useful \p lit is for skipping input: longer literals of
+  /// rarer code units match at fewer positions.
+  static unsigned score(const Literal &lit) {
+    unsigned result = 0;
+    for (char16_t c : lit.chars) {
+      if ((c >= u'a' && c <= u'z') || c == u' ')
+        result += 1;
+      else if ((c >= u'A' && c <= u'Z') || (c >= u'0' && c <= u'9'))
+        result += 2;
+      else
+        result += 3;
+    }
+    return result;
+  }
+};
+
 /// Base class representing some part of a compiled regular expression.
 /// A Node is part of an expression that knows how to match against a State.
 /// There are nodes for Alternations, Literals, etc.
@@ -91,6 +224,26 @@ class Node {
   inline static void
   optimizeNodeList(NodeList &nodes, SyntaxFlags flags, NodeHolder &nodeHolder);
 
+  /// Scan the list of nodes \p nodes into \p scanner, which collects literals
+  /// that every match must contain. \p depth is the nesting depth of the list.
+  static void scanLiteralsForList(
+      const NodeList &nodes,
+      LiteralScanner &scanner,
+      unsigned depth = 0) {
+    if (depth > LiteralScanner::kMaxDepth) {
+      scanner.appendUnknown();
+      return;
+    }
+    for (const auto &node : nodes) {
+      node->scanLiterals(scanner, depth);
+    }
+  }
+
+  /// Describe what this node matches to \p scanner. \p depth is the nesting
+  /// depth of the list containing this node. The default is for nodes which
+  /// match the empty string, such as assertions.
+  virtual void scanLiterals(LiteralScanner &scanner, unsigned depth) const {}
+
   /// \return whether the node always matches exactly one character.
   virtual bool matchesExactlyOneCharacter() const {
     return false;
@@ -226,6 +379,12 @@ class LoopNode final : public Node {
     return {&loopee_};
   }
 
+  void scanLiterals(LiteralScanner &scanner, unsigned depth) const override {
+    LiteralScanner body;
+    scanLiteralsForList(loopee_, body, depth + 1);
+    scanner.appendLoop(body, min_, max_);
+  }
+
  protected:
   void reverseChildren() override {
     reverseNodeList(loopee_);
@@ -368,6 +527,10 @@ class AlternationNode final : public Node {
     }
   }
 
+  void scanLiterals(LiteralScanner &scanner, unsigned depth) const override {
+    scanner.appendUnknown();
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     // Instruction stream looks like:
@@ -448,6 +611,10 @@ class MarkedSubexpressionNode final : public Node {
     return contentsConstraints_ | Super::matchConstraints();
   }
 
+  void scanLiterals(LiteralScanner &scanner, unsigned depth) const override {
+    scanLiteralsForList(contents_, scanner, depth + 1);
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     if (!emitEnd_) {
@@ -473,6 +640,10 @@ class BackRefNode final : public Node {
     mexp_ = mexp;
   }
 
+  void scanLiterals(LiteralScanner &scanner, unsigned depth) const override {
+    scanner.appendUnknown();
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     bcs.emit<BackRefInsn>()->mexp = mexp_;
@@ -561,6 +732,13 @@ class MatchAnyNode final : public Node {
     return !unicode_;
   }
 
+  void scanLiterals(LiteralScanner &scanner, unsigned depth) const override {
+    if (matchesExactlyOneCharacter())
+      scanner.appendUnknownCodeUnits(1);
+    else
+      scanner.appendUnknown();
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     if (unicode_) {
@@ -626,6 +804,25 @@ class MatchCharNode final : public Node {
     return true;
   }
 
+  void scanLiterals(LiteralScanner &scanner, unsigned depth) const override {
+    for (CodePoint c : chars_) {
+      if (icase_) {
+        // We don't know which case will match, only how wide it is.
+        if (mayRequireDecodingSurrogatePair(c))
+          scanner.appendUnknown();
+        else
+          scanner.appendUnknownCodeUnits(1);
+      } else {
+        // Note a lone surrogate only matches itself, even in Unicode mode.
+        char16_t units[2];
+        char16_t *end = units;
+        encodeUTF16(end, c);
+        for (const char16_t *unit = units; unit != end; ++unit)
+          scanner.appendCodeUnit(*unit);
+      }
+    }
+  }
+
   /// \return whether matching the code point \p cp may require
   /// decoding a surrogate pair from the input string.
   bool mayRequireDecodingSurrogatePair(uint32_t cp) const {
@@ -843,6 +1040,13 @@ class BracketNode : public Node {
     return !unicode_;
   }
 
+  void scanLiterals(LiteralScanner &scanner, unsigned depth) const override {
+    if (matchesExactlyOneCharacter())
+      scanner.appendUnknownCodeUnits(1);
+    else
+      scanner.appendUnknown();
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     if (unicode_) {
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_SUPPORT_STRINGKERNELS_H
+#define HERMES_SUPPORT_STRINGKERNELS_H
+
+#include "llvh/ADT/ArrayRef.h"
+
+namespace hermes {
+
+/// Search kernels for strings of 8-bit and 16-bit code units. These use SSE2
+/// or NEON when available, and fall back to scalar loops otherwise.
+
+/// \return a pointer to the first occurrence of \p c in [\p first, \p last),
+/// or \p last if there is none.
+const char *findCodeUnit(const char *first, const char *last, char c);
+const char16_t *
+findCodeUnit(const char16_t *first, const char16_t *last, char16_t c);
+
+/// \return a pointer to the start of the first occurrence of \p needle in
+/// [\p first, \p last), or \p last if there is none. An empty needle occurs
+/// at \p first.
+const char *findSubstring(
+    const char *first,
+    const char *last,
+    llvh::ArrayRef<char> needle);
+const char16_t *findSubstring(
+    const char16_t *first,
+    const char16_t *last,
+    llvh::ArrayRef<char16_t> needle);
+
+/// \return a pointer to the first code unit in [\p first, \p last) that a
+/// JSON string cannot contain unescaped: a quote, a backslash or a control
+/// character. \return \p last if there is none.
+const char16_t *findJSONStringSpecial(
+    const char16_t *first,
+    const char16_t *last);
+
+} // namespace hermes
+
+#endif // HERMES_SUPPORT_STRINGKERNELS_H
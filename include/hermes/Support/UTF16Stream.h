@@ -60,6 +60,20 @@ class UTF16Stream {
     return *this;
   }
 
+  /// \return the UTF16 units from the current stream position to the end of
+  /// the data available without converting more input. This may be empty even
+  /// if hasChar would return true.
+  llvh::ArrayRef<char16_t> buffered() const {
+    return {cur_, end_};
+  }
+
+  /// Advances the stream by \p count UTF16 units.
+  /// \pre \p count is at most the size of buffered().
+  void skip(size_t count) {
+    assert(count <= (size_t)(end_ - cur_) && "must stay within buffered()");
+    cur_ += count;
+  }
+
   /// Begin capturing the stream of values. Once the capture is completed with a
   /// call to endCapture(), the captured stream can be viewed via an ArrayRef.
   void beginCapture();
@@ -8,6 +8,10 @@
 #ifndef HERMES_UTILS_OPTIONS_H
 #define HERMES_UTILS_OPTIONS_H
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 namespace hermes {
 
 enum OutputFormatKind {
@@ -26,6 +30,31 @@ enum OutputFormatKind {
   Execute,
 };
 
+/// A record of which functions were needed at startup, used to lay out the
+/// bytecode file so that they are stored contiguously. It can come from either
+/// of the VM's profilers; both identify functions in a file that was compiled
+/// from the same input with the same flags.
+struct BytecodeLayoutProfile {
+  /// An executed function as reported by the code coverage profiler.
+  struct ExecutedFunction {
+    /// The ID of the segment containing the function.
+    uint32_t segmentID;
+    /// The sum of the bytecode sizes of all preceding functions.
+    uint32_t virtualOffset;
+  };
+
+  /// Functions in the order that the code coverage profiler reported them.
+  std::vector<ExecutedFunction> executedFunctions{};
+
+  /// The page size of the TrackIO run, zero if there was none.
+  uint32_t pageSize = 0;
+
+  /// Pages of the file accessed in the TrackIO run, in access order. Page
+  /// numbers refer to the default layout, so the profiled file must have been
+  /// compiled without a layout profile.
+  std::vector<uint32_t> accessedPages{};
+};
+
 /// Options controlling the type of output to generate.
 struct BytecodeGenerationOptions {
   /// The format of the output.
@@ -59,6 +88,10 @@ struct BytecodeGenerationOptions {
   /// Strip the source map URL.
   bool stripSourceMappingURL = false;
 
+  /// If set, place the bodies and info of the functions in this profile first
+  /// in the bytecode file, in the order they were accessed.
+  std::shared_ptr<const BytecodeLayoutProfile> layoutProfile{};
+
   /* implicit */ BytecodeGenerationOptions(OutputFormatKind format)
       : format(format) {}
 
@@ -176,6 +176,11 @@ class AlignedHeapSegment {
   /// Mark the given \p cell.  Assumes the given address is a valid heap object.
   inline static void setCellMarkBit(const GCCell *cell);
 
+  /// Atomically mark the given \p cell, so that multiple threads may race to
+  /// mark the same cell. Assumes the given address is a valid heap object.
+  /// \return true if this call set the mark bit, false if it was already set.
+  inline static bool atomicSetCellMarkBit(const GCCell *cell);
+
   /// Return whether the given \p cell is marked.  Assumes the given address is
   /// a valid heap object.
   inline static bool getCellMarkBit(const GCCell *cell);
@@ -351,6 +356,13 @@ void AlignedHeapSegment::setCellMarkBit(const GCCell *cell) {
   markBits->mark(ind);
 }
 
+/*static*/
+bool AlignedHeapSegment::atomicSetCellMarkBit(const GCCell *cell) {
+  MarkBitArrayNC *markBits = markBitArrayCovering(cell);
+  size_t ind = markBits->addressToIndex(cell);
+  return !markBits->atomicTestAndMark(ind);
+}
+
 /*static*/
 bool AlignedHeapSegment::getCellMarkBit(const GCCell *cell) {
   MarkBitArrayNC *markBits = markBitArrayCovering(cell);
@@ -14,6 +14,7 @@
 #include "hermes/Support/SourceErrorManager.h"
 #include "hermes/VM/HermesValue.h"
 #include "hermes/VM/IdentifierTable.h"
+#include "hermes/VM/JIT/Config.h"
 #include "hermes/VM/Profiler.h"
 #include "hermes/VM/PropertyCache.h"
 #include "hermes/VM/SerializedLiteralParser.h"
@@ -58,6 +59,24 @@ class CodeBlock final
   /// cache.
   const uint32_t writePropCacheOffset_;
 
+  /// Polymorphic and prototype state of each property cache, indexed like
+  /// propertyCache(). Allocated the first time any cache in this CodeBlock
+  /// needs more than a single PropertyCacheEntry.
+  std::unique_ptr<PolymorphicPropertyCache[]> polymorphicCache_;
+
+#ifdef HERMESVM_JIT
+  /// Number of times this function has been entered by the interpreter while
+  /// it wasn't compiled by the JIT.
+  uint32_t jitCallCount_{0};
+
+  /// Set when the JIT rejected this function, so it is never tried again.
+  bool dontJIT_{false};
+
+  /// Entry point of the JIT-compiled code for this function, if any. The
+  /// code is owned by the runtime's JITContext.
+  JITCompiledFunctionPtr jitCompiled_{nullptr};
+#endif
+
 #ifndef HERMESVM_LEAN
   /// Compiles a lazy CodeBlock. Intended to be called from lazyCompile.
   ExecutionStatus lazyCompileImpl(Runtime &runtime);
@@ -77,6 +96,13 @@ class CodeBlock final
     return getTrailingObjects<PropertyCacheEntry>() + writePropCacheOffset_;
   }
 
+  /// Slow path of updatePropertyCache, used once the cache that \p entry
+  /// belongs to already holds a class.
+  void updatePolymorphicCache(
+      PropertyCacheEntry *entry,
+      CompressedPointer clazz,
+      SlotIndex slot);
+
   CodeBlock(
       RuntimeModule *runtimeModule,
       hbc::RuntimeFunctionHeader header,
@@ -274,6 +300,53 @@ class CodeBlock final
     return &propertyCache()[writePropCacheOffset_ + idx];
   }
 
+  /// \return the polymorphic entry of the cache that \p entry belongs to
+  /// which holds \p clazz, or nullptr if there is none.
+  inline PropertyCacheEntry *findPolymorphicCacheEntry(
+      const PropertyCacheEntry *entry,
+      CompressedPointer clazz) {
+    if (LLVM_LIKELY(!polymorphicCache_))
+      return nullptr;
+    for (PropertyCacheEntry &polyEntry :
+         polymorphicCache_[entry - propertyCache()].entries) {
+      if (polyEntry.clazz == clazz)
+        return &polyEntry;
+    }
+    return nullptr;
+  }
+
+  /// \return the prototype chain entry of the cache that \p entry belongs to,
+  /// or nullptr if none has been allocated.
+  inline ProtoPropertyCacheEntry *findProtoCacheEntry(
+      const PropertyCacheEntry *entry) {
+    if (LLVM_LIKELY(!polymorphicCache_))
+      return nullptr;
+    return &polymorphicCache_[entry - propertyCache()].proto;
+  }
+
+  /// \return the prototype chain entry of the cache that \p entry belongs to,
+  /// allocating it if necessary.
+  ProtoPropertyCacheEntry &getProtoCacheEntry(const PropertyCacheEntry *entry);
+
+  /// Record in the cache that \p entry belongs to that objects of class
+  /// \p clazz have the property in \p slot. The first class is stored in
+  /// \p entry itself, further classes in the polymorphic part of the cache
+  /// until it becomes megamorphic and stops changing.
+  inline void updatePropertyCache(
+      PropertyCacheEntry *entry,
+      CompressedPointer clazz,
+      SlotIndex slot) {
+    if (LLVM_LIKELY(!entry->clazz && !polymorphicCache_)) {
+      entry->clazz = clazz;
+      entry->slot = slot;
+      return;
+    }
+    updatePolymorphicCache(entry, clazz, slot);
+  }
+
+  /// \return the state of the cache that \p entry belongs to.
+  PropertyCacheState getPropertyCacheState(const PropertyCacheEntry *entry);
+
   // Mark all hidden classes in the property cache as roots.
   void markCachedHiddenClasses(Runtime &runtime, WeakRootAcceptor &acceptor);
 
@@ -286,9 +359,33 @@ class CodeBlock final
   /// \return an estimate of the size of additional memory used by this
   /// CodeBlock.
   size_t additionalMemorySize() const {
-    return propertyCacheSize_ * sizeof(PropertyCacheEntry);
+    return propertyCacheSize_ *
+        (sizeof(PropertyCacheEntry) +
+         (polymorphicCache_ ? sizeof(PolymorphicPropertyCache) : 0));
+  }
+
+#ifdef HERMESVM_JIT
+  /// \return the JIT-compiled code for this function, or nullptr.
+  JITCompiledFunctionPtr getJITCompiled() const {
+    return jitCompiled_;
+  }
+  void setJITCompiled(JITCompiledFunctionPtr ptr) {
+    jitCompiled_ = ptr;
   }
 
+  bool isDontJIT() const {
+    return dontJIT_;
+  }
+  void setDontJIT() {
+    dontJIT_ = true;
+  }
+
+  /// Count one more call of this function and \return the new count.
+  uint32_t incrementJITCallCount() {
+    return ++jitCallCount_;
+  }
+#endif
+
 #ifdef HERMES_ENABLE_DEBUGGER
   inst::OpCode getOpCode(uint32_t offset) const {
     auto opcodes = getOpcodeArray();
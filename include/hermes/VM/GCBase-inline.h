@@ -80,6 +80,62 @@ T *GCBase::makeA(uint32_t size, Args &&...args) {
   return ptr;
 }
 
+template <size_t N>
+GCBase::CellBatch<N> GCBase::allocBatch(
+    const std::array<uint32_t, N> &sizes) {
+  static_assert(N > 0, "Cannot allocate an empty batch");
+  std::array<uint32_t, N> alignedSizes;
+  uint64_t totalSize = 0;
+  for (size_t i = 0; i < N; ++i) {
+    alignedSizes[i] = heapAlignSize(sizes[i]);
+    assert(
+        alignedSizes[i] >= GC::minAllocationSize() &&
+        "Cell size is smaller than minimum");
+    totalSize += alignedSizes[i];
+  }
+  assert(
+      totalSize <= GC::maxAllocationSize() &&
+      "Batch is too large for a single allocation");
+  std::array<void *, N> cells;
+#ifdef HERMESVM_GC_RUNTIME
+  runtimeGCDispatch(
+      [&](auto *gc) { gc->allocCells(alignedSizes, cells.data()); });
+#else
+  static_cast<GC *>(this)->allocCells(alignedSizes, cells.data());
+#endif
+#ifndef NDEBUG
+  // Nothing else may be allocated until every cell in the batch exists, since
+  // the reserved memory does not yet contain valid cells.
+  ++noAllocLevel_;
+#endif
+  return CellBatch<N>(*this, alignedSizes, cells);
+}
+
+template <size_t N>
+template <typename T, class... Args>
+T *GCBase::CellBatch<N>::make(Args &&...args) {
+  assert(next_ < N && "All cells in the batch have been constructed");
+  const uint32_t size = sizes_[next_];
+  const VTable *vt = VTable::getVTable(T::getCellKind());
+  assert(
+      (!vt->size || size == heapAlignSize(vt->size)) &&
+      "Size of a fixed size cell does not match its type");
+  assert(
+      !vt->finalize_ && "Cells with finalizers cannot be allocated in a batch");
+  (void)vt;
+  T *ptr = constructCell<T>(cells_[next_], size, std::forward<Args>(args)...);
+  ++next_;
+#ifndef NDEBUG
+  if (next_ == N)
+    --gc_.noAllocLevel_;
+  ptr->setDebugAllocationIdInGC(gc_.nextObjectID());
+#endif
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+  gc_.newAlloc(ptr, size);
+#endif
+  return ptr;
+}
+
 #ifdef HERMESVM_GC_RUNTIME
 constexpr uint32_t GCBase::maxAllocationSizeImpl() {
   // Return the lesser of the two GC options' max allowed sizes.
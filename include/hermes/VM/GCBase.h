@@ -41,6 +41,7 @@
 #include "llvh/ADT/DenseMap.h"
 #include "llvh/Support/ErrorHandling.h"
 
+#include <array>
 #include <cassert>
 #include <chrono>
 #include <cstdint>
@@ -92,6 +93,14 @@ enum XorPtrKeyID {
 ///     class... Args>
 /// inline T *makeA(uint32_t size, Args &&... args);
 ///
+/// Allocate uninitialized memory for several young, finalizer-free cells at
+/// once, writing the address of each into \p cells. Cells are constructed by
+/// the caller. If necessary perform a GC cycle before reserving the memory.
+/// \pre Each size must be heap-aligned, and their sum must be at most
+///   maxAllocationSize().
+///
+///   void allocCells(llvh::ArrayRef<uint32_t> sizes, void **cells);
+///
 /// In some GCs, objects can have associated memory allocated outside the heap,
 /// and this memory can influence GC initiation and heap sizing heuristics.
 /// This method tests whether an external memory allocation is too large (e.g.,
@@ -806,6 +815,48 @@ class GCBase {
       class... Args>
   T *makeA(uint32_t size, Args &&...args);
 
+  /// Space reserved by allocBatch for a group of N young, finalizer-free cells.
+  /// The cells must be constructed with make(), in the order their sizes were
+  /// passed to allocBatch, before anything else is allocated in the heap.
+  template <size_t N>
+  class CellBatch {
+   public:
+    CellBatch(const CellBatch &) = delete;
+    CellBatch &operator=(const CellBatch &) = delete;
+
+    ~CellBatch() {
+      assert(next_ == N && "Not every cell in the batch was constructed");
+    }
+
+    /// Construct the next cell of the batch as a T, passing \p args to its
+    /// constructor.
+    template <typename T, class... Args>
+    T *make(Args &&...args);
+
+   private:
+    friend class GCBase;
+
+    CellBatch(
+        GCBase &gc,
+        const std::array<uint32_t, N> &sizes,
+        const std::array<void *, N> &cells)
+        : gc_(gc), sizes_(sizes), cells_(cells) {}
+
+    GCBase &gc_;
+    std::array<uint32_t, N> sizes_;
+    std::array<void *, N> cells_;
+    size_t next_{0};
+  };
+
+  /// Reserve space for N cells of the given \p sizes with a single
+  /// allocation, so that only one check for a collection is done for all of
+  /// them. Used when an object and its out-of-line storage are created
+  /// together. If necessary perform a GC cycle, which may potentially move
+  /// allocated objects.
+  /// \pre The heap-aligned sizes must add up to at most maxAllocationSize().
+  template <size_t N>
+  CellBatch<N> allocBatch(const std::array<uint32_t, N> &sizes);
+
   /// Name to identify this heap in logs.
   const std::string &getName() const {
     return name_;
@@ -14,9 +14,11 @@
 #include "hermes/VM/HeapAlign.h"
 #include "hermes/VM/VTable.h"
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #pragma GCC diagnostic push
 
 #ifdef HERMES_COMPILER_SUPPORTS_WSHORTEN_64_TO_32
@@ -218,6 +220,39 @@ class GCCell {
     return isMarked();
   }
 
+  /// Read the header of this cell while other threads may be racing to
+  /// install a forwarding pointer in it with trySetMarkedForwardingPointer().
+  /// \return the forwarding pointer if one has been installed. Otherwise
+  ///   \return null, and store the header in \p kindAndSize.
+  /// NOTE: this should only be used by the GC.
+  CompressedPointer loadHeaderAtomic(KindAndSize &kindAndSize) const {
+    const CompressedPointer::RawType raw =
+        atomicHeader()->load(std::memory_order_acquire);
+    if (raw & 0x1)
+      return CompressedPointer::fromRaw(raw - 0x1);
+    std::memcpy(&kindAndSize, &raw, sizeof(KindAndSize));
+    return CompressedPointer(nullptr);
+  }
+
+  /// Like setMarkedForwardingPointer, but only succeeds if no other thread has
+  /// installed a forwarding pointer in this cell first. The contents of \p cell
+  /// are published to any thread that reads the forwarding pointer with
+  /// loadHeaderAtomic().
+  /// \return true if this call installed the forwarding pointer.
+  /// NOTE: this should only be used by the GC.
+  bool trySetMarkedForwardingPointer(CompressedPointer cell) {
+    CompressedPointer::RawType expected =
+        atomicHeader()->load(std::memory_order_relaxed);
+    // The header only ever changes from a KindAndSize to a forwarding pointer,
+    // so a failed exchange means that another thread won.
+    return !(expected & 0x1) &&
+        atomicHeader()->compare_exchange_strong(
+            expected,
+            cell.getRaw() | 0x1,
+            std::memory_order_acq_rel,
+            std::memory_order_relaxed);
+  }
+
   const GCCell *nextCell() const {
     return reinterpret_cast<const GCCell *>(
         reinterpret_cast<const char *>(this) + getAllocatedSize());
@@ -277,6 +312,20 @@ class GCCell {
     return forwardingPointer_.getRaw() & 0x1;
   }
 
+ private:
+  /// \return the header of this cell, viewed as an atomic.
+  std::atomic<CompressedPointer::RawType> *atomicHeader() const {
+    static_assert(
+        sizeof(std::atomic<CompressedPointer::RawType>) ==
+                sizeof(CompressedPointer::RawType) &&
+            sizeof(KindAndSize) == sizeof(CompressedPointer::RawType),
+        "The header must be usable as an atomic");
+    return reinterpret_cast<std::atomic<CompressedPointer::RawType> *>(
+        const_cast<AssignableCompressedPointer *>(&forwardingPointer_));
+  }
+
+ public:
+
   static constexpr uint32_t maxSize() {
     return KindAndSize::maxSize();
   }
@@ -20,6 +20,8 @@
 #include "llvh/Support/ErrorOr.h"
 #include "llvh/Support/PointerLikeTypeTraits.h"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
@@ -125,6 +127,12 @@ class HadesGC final : public GCBase {
       class... Args>
   inline T *makeA(uint32_t size, Args &&...args);
 
+  /// Reserve one contiguous young gen region for all of \p sizes and carve it
+  /// into cells, writing their addresses into \p cells. This performs a
+  /// single bump and limit check for the whole batch.
+  /// (Part of general GC API defined in GCBase.h).
+  inline void allocCells(llvh::ArrayRef<uint32_t> sizes, void **cells);
+
   /// Force a garbage collection cycle.
   /// (Part of general GC API defined in GCBase.h).
   void collect(std::string cause, bool canEffectiveOOM = false) override;
@@ -397,11 +405,23 @@ class HadesGC final : public GCBase {
     /// \return the segment that was removed.
     HeapSegment popSegment();
 
+    /// Remove the segment at index \p idx from the OG, by moving the last
+    /// segment into its place. This changes the index of the last segment.
+    /// \return the segment that was removed.
+    HeapSegment removeSegment(size_t idx);
+
+    /// \return the number of bytes that were live in the segment at index
+    /// \p idx when it was last swept. For a segment that has not been swept
+    /// yet, this is the full size of a segment.
+    uint32_t segmentLiveBytes(size_t idx) const;
+
     /// Indicate that OG should target having a size of \p targetSizeBytes.
     void setTargetSizeBytes(size_t targetSizeBytes);
 
     /// Allocate into OG. Returns a pointer to the newly allocated space. That
-    /// space must be filled before releasing the gcMutex_.
+    /// space must be filled before releasing the gcMutex_. If no free space is
+    /// found while a sweep is in progress, and this is not called during a YG
+    /// collection, unswept segments are swept on demand before the OG is grown.
     /// \return A non-null pointer to memory in the old gen that should have a
     ///   constructor run in immediately.
     /// \pre gcMutex_ must be held before calling this function.
@@ -416,6 +436,11 @@ class HadesGC final : public GCBase {
     /// Increase the allocated bytes tracker by \p incr.
     void incrementAllocatedBytes(int32_t incr);
 
+    /// Return the trailing \p sz bytes at \p addr of an allocation made with
+    /// alloc() to the freelist, when they turn out not to be needed.
+    /// \pre sz is at least minAllocationSize().
+    void freeTail(void *addr, uint32_t sz);
+
     /// \return the total number of bytes that are held in external memory, kept
     /// alive by objects in the OG.
     uint64_t externalBytes() const;
@@ -486,6 +511,13 @@ class HadesGC final : public GCBase {
     /// collections it will take to complete an incremental OG collection.
     size_t sweepSegmentsRemaining() const;
 
+    /// If a sweep is in progress, sweep segments until at least \p sz bytes
+    /// are free in the OG, so that they can be allocated without growing the
+    /// heap. The last segment is always left for sweepNext to sweep, since
+    /// that finishes the collection.
+    /// \pre gcMutex_ must be held, and the background thread must be paused.
+    void sweepOnDemand(uint64_t sz);
+
     /// \return The number of bytes of native memory in use by this OldGen.
     size_t getMemorySize() const;
 
@@ -579,6 +611,59 @@ class HadesGC final : public GCBase {
         SegmentBuckets &segBuckets,
         bool setHead);
 
+    /// The result of scanning a segment for sweeping, without modifying it.
+    /// This is produced by a worker thread, and then applied to the segment by
+    /// the thread holding the gcMutex_.
+    struct SegmentSweepResult {
+      /// A coalesced range of dead cells, to be turned into a FreelistCell.
+      struct FreeRange {
+        char *start;
+        char *end;
+        /// Whether more than one cell was merged into this range, in which
+        /// case the cell head must be updated.
+        bool merged;
+      };
+      std::vector<FreeRange> freeRanges;
+      /// Dead cells that have a finalizer, in address order.
+      std::vector<GCCell *> finalizableCells;
+      /// The number of bytes of dead cells in the segment.
+      int32_t sweptBytes{0};
+      /// The number of bytes of marked cells in the segment.
+      uint32_t liveBytes{0};
+    };
+
+    /// Sweep the segment at index \p segIdx. \p backgroundThread indicates
+    /// whether this call was made from the background thread.
+    void sweepSegment(size_t segIdx, bool backgroundThread);
+
+    /// Sweep the next \p numSegments segments, scanning them in parallel on
+    /// the worker threads, and then finalizing the dead cells and building the
+    /// freelists on the calling thread. Marked cells are never trimmed.
+    void sweepSegmentsInParallel(size_t numSegments);
+
+    /// Find the dead cells in \p seg and record them in \p result. This
+    /// only reads the segment, so it may run on any thread.
+    static void scanSegmentForSweep(
+        HeapSegment &seg,
+        SegmentSweepResult &result);
+
+    /// Remove the freelists of \p segBuckets from the OG freelists, and clear
+    /// them, so that they can be rebuilt by sweeping.
+    void clearSegmentFreelists(SegmentBuckets &segBuckets);
+
+    /// Add the freelists of \p segBuckets rebuilt by sweeping back into the OG
+    /// freelists, and update freelistBucketBitArray_.
+    void restoreSegmentFreelists(SegmentBuckets &segBuckets);
+
+    /// Account for the \p segmentSweptBytes reclaimed from the segment at
+    /// index \p segIdx by sweeping, and publish them to the stats of the
+    /// ongoing OG collection. \p segmentLiveBytes is the number of bytes that
+    /// survived in the segment.
+    void recordSegmentSwept(
+        size_t segIdx,
+        int32_t segmentSweptBytes,
+        uint32_t segmentLiveBytes);
+
     HadesGC &gc_;
 
     /// Use a std::deque instead of a std::vector so that references into it
@@ -619,6 +704,10 @@ class HadesGC final : public GCBase {
     /// Contains dummy heads for the segment level freelists for each bucket.
     std::array<SegmentBucket, kNumFreelistBuckets> buckets_{};
 
+    /// For each segment in the OG, the number of bytes that were live in it
+    /// when it was last swept. See segmentLiveBytes().
+    std::deque<uint32_t> segmentLiveBytes_;
+
     /// Tracks the current progress of sweeping.
     struct SweepIterator {
       /// The current segment being swept, this should start at the end and move
@@ -637,6 +726,10 @@ class HadesGC final : public GCBase {
 #endif
     } sweepIterator_;
 
+    /// Scratch space for sweepSegmentsInParallel, one entry per segment in a
+    /// batch. Kept around to reuse the allocations across batches.
+    std::vector<SegmentSweepResult> parallelSweepResults_;
+
     /// Searches the OG for a space to allocate memory into.
     /// \return A pointer to uninitialized memory that can be written into, null
     ///   if no such space exists.
@@ -728,6 +821,28 @@ class HadesGC final : public GCBase {
   /// concurrently with the mutator.
   std::unique_ptr<Executor> backgroundExecutor_;
 
+  /// Additional threads that mark and sweep the OG alongside the background
+  /// thread, and evacuate the YG alongside the mutator. Empty unless
+  /// GCConfig::NumMarkerThreads, GCConfig::NumEvacuationThreads, or
+  /// GCConfig::NumSweeperThreads is greater than 1.
+  std::vector<std::unique_ptr<Executor>> workerExecutors_;
+
+  /// The cumulative CPU time each marker has spent in parallel marking. Index 0
+  /// is the thread driving the collection, the rest correspond to
+  /// workerExecutors_. Protected by gcMutex_.
+  std::vector<std::chrono::microseconds> markerThreadCPUTimes_;
+
+  /// The number of threads that evacuate the YG, including the mutator.
+  unsigned numEvacuationThreads_{1};
+
+  /// The number of threads that sweep the OG, including the background thread.
+  unsigned numSweeperThreads_{1};
+
+  /// Serialises allocation into the OG during a parallel YG evacuation. The
+  /// mutator holds gcMutex_ for the entire YG collection, so the worker threads
+  /// take this lock instead, and so does the mutator while they are running.
+  Mutex evacAllocMutex_;
+
   /// This tracks the current status of execution in the background thread. The
   /// future should be set every time work is enqueued onto the executor. After
   /// that, whenever we need to wait for execution in the background thread to
@@ -753,6 +868,13 @@ class HadesGC final : public GCBase {
   /// Target OG occupancy ratio at the end of an OG collection.
   const double occupancyTarget_;
 
+  /// The maximum number of segments compacted by a single OG collection.
+  size_t maxCompacteeSegments_{1};
+
+  /// The number of bytes that may be evacuated from compactee segments by a
+  /// single YG collection, to bound the pause.
+  gcheapsize_t compactionBytesPerPause_{0};
+
   /// The threshold, expressed as the occupied fraction of the target OG size,
   /// at which we should start an OG collection.
   ExponentialMovingAverage ogThreshold_{0.5, 0.75};
@@ -778,67 +900,92 @@ class HadesGC final : public GCBase {
   uint64_t ygExternalBytes_{0};
 
   struct CompacteeState {
-    /// \return true if the pointer lives in the segment that is being marked or
+    /// The maximum number of segments that can be compacted by a single OG
+    /// collection.
+    static constexpr size_t kMaxSegments = 8;
+
+    /// \return true if the pointer lives in a segment that is being marked or
     /// evacuated for compaction.
     bool contains(const void *p) const {
-      return start == AlignedStorage::start(p);
+      return std::find(
+                 starts.begin(),
+                 starts.begin() + numSegments,
+                 AlignedStorage::start(p)) != starts.begin() + numSegments;
     }
     bool contains(CompressedPointer p) const {
-      return p.getSegmentStart() == startCP;
+      return containsCP(p.getSegmentStart(), numSegments);
     }
 
-    /// \return true if the pointer lives in the segment that is currently being
+    /// \return true if the pointer lives in a segment that is currently being
     /// evacuated for compaction.
     bool evacContains(const void *p) const {
-      return evacStart == AlignedStorage::start(p);
+      return std::find(
+                 starts.begin(),
+                 starts.begin() + numEvacuating,
+                 AlignedStorage::start(p)) != starts.begin() + numEvacuating;
     }
     bool evacContains(CompressedPointer p) const {
-      return p.getSegmentStart() == evacStartCP;
+      return containsCP(p.getSegmentStart(), numEvacuating);
     }
 
     /// \return true if the compactee is ready to be evacuated.
     bool evacActive() const {
-      return evacStart != reinterpret_cast<void *>(kInvalidCompacteeStart);
+      return numEvacuating;
+    }
+
+    /// \return true if some segments will still be waiting to be evacuated
+    /// after the segments currently being evacuated, if any. Pointers into
+    /// them must be kept track of in the card tables until they are evacuated.
+    bool hasPendingSegments() const {
+      return numSegments > numEvacuating;
     }
 
 #ifndef NDEBUG
     /// \return true if the compactee has not been assigned.
     bool empty() const {
-      void *const invalid = reinterpret_cast<void *>(kInvalidCompacteeStart);
-      return evacStart == invalid && start == invalid && !segment;
+      return !numSegments && !numEvacuating && segments.empty();
     }
 #endif
 
     /// The following variables track the state of compactions.
-    /// 1. To trigger a compaction, segment and start should be set at the
-    /// beginning of marking. This ensures that all cards containing pointers to
-    /// the compactee will be dirtied.
-    /// 2. Once marking is done, completeMarking should then set evacStart, so
-    /// that the next YG collection will evacuate the segment.
-    /// 3. On completion, the YG collection will reset all these variables.
-
-    /// In order to keep the "contains" check cheap, this can be any non-null
-    /// value that cannot correspond to the start of a segment.
-    static constexpr uintptr_t kInvalidCompacteeStart = 0x1;
-
-    /// The start address of the segment that will be compacted next. This is
-    /// used during marking and by write barriers to determine whether a pointer
-    /// is in the compactee segment.
-    void *start{reinterpret_cast<void *>(kInvalidCompacteeStart)};
-    AssignableCompressedPointer startCP{
-        CompressedPointer::fromRaw(kInvalidCompacteeStart)};
-
-    /// The start address of the segment that is currently being compacted. When
-    /// this is set, the next YG will evacuate objects in this segment. This is
-    /// always going to be equal to "start" or nullptr.
-    void *evacStart{reinterpret_cast<void *>(kInvalidCompacteeStart)};
-    AssignableCompressedPointer evacStartCP{
-        CompressedPointer::fromRaw(kInvalidCompacteeStart)};
-
-    /// The segment being compacted. This should be removed from the OG right
-    /// after it is identified, and freed entirely once the compaction is
-    /// complete.
-    std::shared_ptr<HeapSegment> segment;
+    /// 1. To trigger a compaction, the segments and their start addresses
+    /// should be set at the beginning of marking. This ensures that all cards
+    /// containing pointers to the compactees will be dirtied.
+    /// 2. Once marking is done, completeMarking should then set numEvacuating,
+    /// so that the next YG collection will evacuate the first numEvacuating
+    /// segments.
+    /// 3. On completion, the YG collection removes the evacuated segments, and
+    /// sets numEvacuating for the next YG collection if any remain.
+
+    /// The segments being compacted, in the order they will be evacuated. These
+    /// should be removed from the OG right after they are identified, and freed
+    /// entirely once they have been evacuated.
+    std::vector<std::shared_ptr<HeapSegment>> segments;
+
+    /// The start addresses of the segments in \c segments. These are used
+    /// during marking and by write barriers to determine whether a pointer is
+    /// in a compactee segment, so they are kept in a flat array to keep that
+    /// check cheap.
+    std::array<void *, kMaxSegments> starts{};
+    std::array<CompressedPointer::RawType, kMaxSegments> startCPs{};
+
+    /// The number of live bytes in each segment in \c segments, as of the
+    /// last time it was swept. Used to bound how much is evacuated at once.
+    std::array<uint32_t, kMaxSegments> liveBytes{};
+
+    /// The number of entries in \c segments.
+    size_t numSegments{0};
+
+    /// The number of segments at the start of \c segments that will be
+    /// evacuated by the next YG collection. Zero until marking is complete.
+    size_t numEvacuating{0};
+
+   private:
+    bool containsCP(CompressedPointer segStart, size_t n) const {
+      const auto raw = segStart.getRaw();
+      return std::find(startCPs.begin(), startCPs.begin() + n, raw) !=
+          startCPs.begin() + n;
+    }
   } compactee_;
 
   /// The number of compactions this GC has performed.
@@ -958,21 +1105,29 @@ class HadesGC final : public GCBase {
   /// heap limit. Should be called at the start of completeMarking.
   void updateOldGenThreshold();
 
-  /// Prepare the last segment in the OG for compaction and initialise any
-  /// necessary state.
-  /// \param forceCompaction If true, a compactee will be prepared regardless of
+  /// Choose the sparsest segments in the OG for compaction, based on their
+  /// live bytes as of the last sweep, and initialise any necessary state.
+  /// Enough segments are chosen to bring the OG back to its target size, up to
+  /// maxCompacteeSegments_.
+  /// \param forceCompaction If true, compactees will be prepared regardless of
   ///   heap conditions. Note that if there are no OG heap segments, a
   ///   compaction cannot occur no matter what.
   void prepareCompactee(bool forceCompaction);
 
-  /// Run finalizers on the compactee and clear any compaction state.
+  /// Select the compactee segments to be evacuated by the next YG collection,
+  /// so that the bytes they have live fit within compactionBytesPerPause_. At
+  /// least one segment is always selected, if any remain.
+  void scheduleCompacteeEvacuation();
+
+  /// Run finalizers on the compactee segments that were just evacuated, free
+  /// them, and schedule the evacuation of any that remain.
   void finalizeCompactee();
 
   /// Search a single segment for pointers that may need to be updated as the
   /// YG/compactee are evacuated.
-  template <bool CompactionEnabled>
+  template <typename Acceptor>
   void scanDirtyCardsForSegment(
-      SlotVisitor<EvacAcceptor<CompactionEnabled>> &visitor,
+      SlotVisitor<Acceptor> &visitor,
       HeapSegment &segment);
 
   /// Find all pointers from OG into the YG/compactee during a YG collection.
@@ -1101,6 +1256,24 @@ inline T *HadesGC::makeA(uint32_t size, Args &&...args) {
       std::forward<Args>(args)...);
 }
 
+inline void HadesGC::allocCells(
+    llvh::ArrayRef<uint32_t> sizes,
+    void **cells) {
+  assert(noAllocLevel_ == 0 && "No allocs allowed right now.");
+  uint32_t totalSize = 0;
+  for (uint32_t sz : sizes)
+    totalSize += sz;
+  // The cells are placed back to back in the young gen, so no cell head
+  // bookkeeping is needed. If the young gen is later promoted wholesale, the
+  // cells are walked individually at that point.
+  char *ptr = static_cast<char *>(
+      allocWork<false /* fixedSize */, HasFinalizer::No>(totalSize));
+  for (size_t i = 0, e = sizes.size(); i < e; ++i) {
+    cells[i] = ptr;
+    ptr += sizes[i];
+  }
+}
+
 template <bool fixedSize, HasFinalizer hasFinalizer>
 void *HadesGC::allocWork(uint32_t sz) {
   assert(
@@ -108,6 +108,30 @@ class Interpreter {
   static CallResult<PseudoHandle<>>
   getByValTransient_RJS(Runtime &runtime, Handle<> base, Handle<> name);
 
+  /// Use the prototype chain cache \p entry to find the owner of a property
+  /// of \p obj, which has class \p clazz.
+  /// \return the object owning the property, or nullptr if the cache does
+  /// not apply.
+  static inline JSObject *getCachedProtoHolder(
+      Runtime &runtime,
+      JSObject *obj,
+      CompressedPointer clazz,
+      const ProtoPropertyCacheEntry &entry);
+
+  /// Look for the data property \p id on the prototype chain of \p obj, which
+  /// does not have it as an own property, and fill the prototype chain cache
+  /// of \p cacheEntry in \p codeBlock with the result. Does not allocate in
+  /// the GC heap.
+  /// \return the object owning the property, with its descriptor in \p desc,
+  /// or nullptr if the property could not be cached.
+  static JSObject *getByIdFromProtoChainAndCache(
+      Runtime &runtime,
+      CodeBlock *codeBlock,
+      PropertyCacheEntry *cacheEntry,
+      JSObject *obj,
+      SymbolID id,
+      NamedPropertyDescriptor &desc);
+
   /// Implement OpCode::PutById/TryPutById when the base is not an object.
   static ExecutionStatus putByIdTransient_RJS(
       Runtime &runtime,
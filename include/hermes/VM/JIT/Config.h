@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_JIT_CONFIG_H
+#define HERMES_VM_JIT_CONFIG_H
+
+#include "hermes/VM/CallResult.h"
+
+/// HERMESVM_JIT is defined when the baseline JIT is built into the VM. It is
+/// only available on x86-64 Linux, and can be disabled entirely by turning off
+/// HERMESVM_ALLOW_JIT.
+#if defined(HERMESVM_ALLOW_JIT) && defined(__x86_64__) && defined(__linux__)
+#define HERMESVM_JIT
+#endif
+
+namespace hermes {
+namespace vm {
+
+class Runtime;
+class PinnedHermesValue;
+class HermesValue;
+
+/// The signature of a function compiled by the JIT. The frame has already been
+/// set up by the caller and \p frameRegs points to its first local register.
+/// On success the return value is stored in \p result.
+using JITCompiledFunctionPtr = ExecutionStatus (*)(
+    Runtime *runtime,
+    PinnedHermesValue *frameRegs,
+    HermesValue *result);
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JIT_CONFIG_H
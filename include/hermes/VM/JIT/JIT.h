@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_JIT_JIT_H
+#define HERMES_VM_JIT_JIT_H
+
+#include "hermes/VM/JIT/Config.h"
+
+#ifdef HERMESVM_JIT
+
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/Runtime.h"
+
+#include "llvh/ADT/ArrayRef.h"
+
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+/// Owns the code emitted by the baseline JIT for one Runtime and decides which
+/// functions get compiled.
+///
+/// The JIT compiles a whole function at a time, once the function has been
+/// entered more than the configured number of times. A function containing an
+/// instruction the JIT doesn't support is never compiled and keeps running in
+/// the interpreter. Compiled code keeps all JS values in the register stack,
+/// emits arithmetic, comparisons and branches inline, and calls the functions
+/// in JITHelpers.h for everything else, so it shares the interpreter's slow
+/// paths and property caches.
+class JITContext {
+ public:
+  JITContext(bool enable, uint32_t threshold)
+      : enabled_(enable), threshold_(threshold) {}
+  ~JITContext();
+
+  JITContext(const JITContext &) = delete;
+  void operator=(const JITContext &) = delete;
+
+  bool isEnabled() const {
+    return enabled_;
+  }
+
+  /// \return the compiled code for \p codeBlock, compiling it first if it has
+  /// just become hot enough, or nullptr if it should run in the interpreter.
+  /// Must be called once per call of \p codeBlock.
+  JITCompiledFunctionPtr compile(Runtime &runtime, CodeBlock *codeBlock) {
+    if (LLVM_LIKELY(!enabled_))
+      return nullptr;
+    if (JITCompiledFunctionPtr ptr = codeBlock->getJITCompiled())
+      return ptr;
+    if (codeBlock->isDontJIT() ||
+        codeBlock->incrementJITCallCount() <= threshold_)
+      return nullptr;
+    return compileImpl(runtime, codeBlock);
+  }
+
+  /// Execute the compiled code \p ptr of \p codeBlock. The arguments of the
+  /// call must already have been pushed on the stack, exactly as for
+  /// Runtime::interpretFunction(); this sets up the callee frame, runs it and
+  /// pops it again.
+  static CallResult<HermesValue>
+  run(Runtime &runtime, CodeBlock *codeBlock, JITCompiledFunctionPtr ptr);
+
+ private:
+  /// Try to compile \p codeBlock, recording the result in the CodeBlock.
+  JITCompiledFunctionPtr compileImpl(Runtime &runtime, CodeBlock *codeBlock);
+
+  /// Copy \p code into executable memory. \return its address, or nullptr if
+  /// the memory could not be allocated.
+  void *allocExecutable(llvh::ArrayRef<uint8_t> code);
+
+  /// A block of memory obtained from the OS for compiled code.
+  struct Chunk {
+    uint8_t *base;
+    size_t size;
+    /// Number of bytes at the start of the chunk already in use. Always a
+    /// multiple of the page size, since each function is protected on its own.
+    size_t used;
+  };
+
+  /// Whether the JIT is enabled at all.
+  const bool enabled_;
+
+  /// Number of calls a function needs before it is compiled.
+  const uint32_t threshold_;
+
+  /// Memory holding compiled code, most recently allocated last.
+  std::vector<Chunk> chunks_{};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMESVM_JIT
+
+#endif // HERMES_VM_JIT_JIT_H
@@ -11,6 +11,8 @@
 #include "hermes/Support/UTF16Stream.h"
 #include "hermes/VM/Runtime.h"
 
+#include "llvh/ADT/STLExtras.h"
+
 namespace hermes {
 namespace vm {
 
@@ -31,6 +33,24 @@ CallResult<HermesValue> runtimeJSONStringify(
     Handle<> replacer,
     Handle<> space);
 
+/// A consumer of JSON text produced by runtimeJSONStringifyTo. It may return
+/// EXCEPTION, after raising a JS exception, to abort the serialization.
+using JSONOutputSink =
+    llvh::function_ref<ExecutionStatus(llvh::ArrayRef<char16_t>)>;
+
+/// Alternative interface to runtimeJSONStringify which passes the JSON text to
+/// \p sink in chunks as it is produced, instead of creating a string. Chunks
+/// never split a surrogate pair. If an exception is raised, the chunks passed
+/// so far are an incomplete result.
+/// \return false if \p value has no JSON representation, e.g. it is
+/// undefined, in which case \p sink is never called.
+CallResult<bool> runtimeJSONStringifyTo(
+    Runtime &runtime,
+    Handle<> value,
+    Handle<> replacer,
+    Handle<> space,
+    JSONOutputSink sink);
+
 } // namespace vm
 } // namespace hermes
 
@@ -923,8 +923,8 @@ class JSObject : public GCCell {
   /// The following three methods implement ES5.1 8.12.3.
   /// getNamed is an optimized path for getting a property with a SymbolID when
   /// it is statically known that the SymbolID is not index-like.
-  /// If \p cacheEntry is not null, and the result is suitable for use in a
-  /// property cache, populate the cache.
+  /// If \p cacheEntry is not null and empty, and the result is an own property
+  /// suitable for use in a property cache, populate the cache.
   static CallResult<PseudoHandle<>> getNamed_RJS(
       Handle<JSObject> selfHandle,
       Runtime &runtime,
@@ -1383,6 +1383,16 @@ class JSObject : public GCCell {
       SymbolID name,
       NamedPropertyDescriptor &desc);
 
+  /// Same as \c findProperty(), but consults the runtime's
+  /// PropertyLookupCache first, and records the result in it otherwise.
+  /// \return whether the property was found.
+  static bool findPropertyCached(
+      Handle<JSObject> selfHandle,
+      Runtime &runtime,
+      SymbolID name,
+      PropertyFlags expectedFlags,
+      NamedPropertyDescriptor &desc);
+
   /// ES5.1 8.12.9.
   static CallResult<bool> addOwnProperty(
       Handle<JSObject> selfHandle,
@@ -1864,8 +1874,15 @@ inline OptValue<bool> JSObject::tryGetOwnNamedDescriptorFast(
     Runtime &runtime,
     SymbolID name,
     NamedPropertyDescriptor &desc) {
-  return HiddenClass::tryFindPropertyFast(
+  PropertyLookupCache &lookupCache = runtime.getPropertyLookupCache();
+  OptValue<bool> cached = lookupCache.find(self->clazz_, name, desc);
+  if (cached.hasValue())
+    return cached;
+  OptValue<bool> found = HiddenClass::tryFindPropertyFast(
       self->clazz_.getNonNull(runtime), runtime, name, desc);
+  if (found.hasValue())
+    lookupCache.insert(self->clazz_, name, *found ? &desc : nullptr);
+  return found;
 }
 
 inline OptValue<SmallHermesValue>
@@ -2006,6 +2023,23 @@ inline OptValue<HiddenClass::PropertyPos> JSObject::findProperty(
   return ret;
 }
 
+inline bool JSObject::findPropertyCached(
+    Handle<JSObject> selfHandle,
+    Runtime &runtime,
+    SymbolID name,
+    PropertyFlags expectedFlags,
+    NamedPropertyDescriptor &desc) {
+  PropertyLookupCache &lookupCache = runtime.getPropertyLookupCache();
+  OptValue<bool> cached = lookupCache.find(selfHandle->clazz_, name, desc);
+  if (cached.hasValue())
+    return *cached;
+  bool found =
+      findProperty(selfHandle, runtime, name, expectedFlags, desc).hasValue();
+  // The lookup may have allocated, so the class must be read again.
+  lookupCache.insert(selfHandle->clazz_, name, found ? &desc : nullptr);
+  return found;
+}
+
 inline bool JSObject::shouldCacheForIn(Runtime &runtime) const {
   return !clazz_.getNonNull(runtime)->isDictionary() &&
       !flags_.indexedStorage && !flags_.hostObject && !flags_.proxyObject;
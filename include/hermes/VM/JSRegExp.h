@@ -8,6 +8,7 @@
 #ifndef HERMES_VM_JSREGEXP_H
 #define HERMES_VM_JSREGEXP_H
 
+#include "hermes/Regex/NFA.h"
 #include "hermes/Regex/Regex.h"
 #include "hermes/Regex/RegexTypes.h"
 #include "hermes/VM/JSObject.h"
@@ -139,6 +140,11 @@ class JSRegExp final : public JSObject {
   /// Store a copy of the \p bytecode array.
   void initializeBytecode(llvh::ArrayRef<uint8_t> bytecode);
 
+  /// \return the NFA to search with instead of backtracking over the
+  /// bytecode, according to the RegExpEngine of \p runtime, or nullptr to
+  /// backtrack. The NFA is built on first use.
+  regex::NFAProgram *getNFA(Runtime &runtime);
+
   static ExecutionStatus initializeGroupNameMappingObj(
       Runtime &runtime,
       Handle<JSRegExp> selfHandle,
@@ -156,6 +162,13 @@ class JSRegExp final : public JSObject {
 
   regex::SyntaxFlags syntaxFlags_ = {};
 
+  /// Whether getNFA() has decided on nfa_.
+  bool nfaInitialized_{false};
+
+  /// The NFA for the bytecode, owned by this object, or null if searches
+  /// backtrack.
+  regex::NFAProgram *nfa_{};
+
   GCPointer<JSObject> groupNameMappings_{nullptr};
 
   // Finalizer to clean up stored native regex
@@ -175,6 +175,11 @@ class MallocGC final : public GCBase {
       class... Args>
   inline T *makeA(uint32_t size, Args &&...args);
 
+  /// Allocate a cell for each of \p sizes, writing their addresses into
+  /// \p cells. The heap limit is checked once for the combined size.
+  /// (Part of general GC API defined in GCBase.h).
+  inline void allocCells(llvh::ArrayRef<uint32_t> sizes, void **cells);
+
   /// Returns whether an external allocation of the given \p size fits
   /// within the maximum heap size.  (Note that this does not guarantee that the
   /// allocation will "succeed" -- the size plus the used() of the heap may
@@ -277,6 +282,10 @@ class MallocGC final : public GCBase {
       HasFinalizer hasFinalizer = HasFinalizer::No>
   inline void *alloc(uint32_t size);
 
+  /// Allocate an object of \p size without checking whether a collection is
+  /// needed first. The caller is responsible for that check.
+  inline GCCell *allocNoCollect(uint32_t size);
+
   /// Initialize a cell with the required basic data for any cell.
   inline void initCell(GCCell *cell, uint32_t size);
 
@@ -323,6 +332,10 @@ inline void *MallocGC::alloc(uint32_t size) {
   if (LLVM_UNLIKELY(size > sizeLimit_ - allocatedBytes_)) {
     collectBeforeAlloc(kNaturalCauseForAnalytics, size);
   }
+  return allocNoCollect(size);
+}
+
+inline GCCell *MallocGC::allocNoCollect(uint32_t size) {
   // Add space for the header.
   auto *header = new (checkedMalloc(size + sizeof(CellHeader))) CellHeader();
   GCCell *mem = header->data();
@@ -337,6 +350,28 @@ inline void *MallocGC::alloc(uint32_t size) {
   return mem;
 }
 
+inline void MallocGC::allocCells(
+    llvh::ArrayRef<uint32_t> sizes,
+    void **cells) {
+  assert(noAllocLevel_ == 0 && "no alloc allowed right now");
+  uint32_t totalSize = 0;
+  for (uint32_t size : sizes) {
+    assert(
+        isSizeHeapAligned(size) &&
+        "Call to allocCells must use sizes aligned to HeapAlign");
+    totalSize += size;
+  }
+  if (shouldSanitizeHandles()) {
+    collectBeforeAlloc(kHandleSanCauseForAnalytics, totalSize);
+  }
+  // Use subtraction to prevent overflow.
+  if (LLVM_UNLIKELY(totalSize > sizeLimit_ - allocatedBytes_)) {
+    collectBeforeAlloc(kNaturalCauseForAnalytics, totalSize);
+  }
+  for (size_t i = 0, e = sizes.size(); i < e; ++i)
+    cells[i] = allocNoCollect(sizes[i]);
+}
+
 inline bool MallocGC::canAllocExternalMemory(uint32_t size) {
   return size <= maxSize_;
 }
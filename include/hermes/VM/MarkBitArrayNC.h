@@ -55,6 +55,11 @@ class MarkBitArrayNC {
   /// range of the array.
   inline void mark(size_t ind);
 
+  /// Atomically marks the bit for the given index, which is required to be
+  /// within the range of the array. Safe to call from multiple threads at once.
+  /// \return true if the bit was already marked.
+  inline bool atomicTestAndMark(size_t ind);
+
   /// Clears the bit array.
   inline void clear();
 
@@ -140,6 +145,11 @@ void MarkBitArrayNC::mark(size_t ind) {
   bitArray_.set(ind, true);
 }
 
+bool MarkBitArrayNC::atomicTestAndMark(size_t ind) {
+  assert(ind < kNumBits && "precondition: ind must be within the index range");
+  return bitArray_.atomicTestAndSet(ind);
+}
+
 void MarkBitArrayNC::clear() {
   bitArray_.reset();
 }
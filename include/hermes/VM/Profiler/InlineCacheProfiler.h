@@ -8,6 +8,7 @@
 #ifndef INLINECACHE_PROFILER_H
 #define INLINECACHE_PROFILER_H
 
+#include "hermes/VM/PropertyCache.h"
 #include "hermes/VM/SymbolID.h"
 #include "llvh/ADT/DenseMap.h"
 #pragma GCC diagnostic push
@@ -54,9 +55,10 @@ class InlineCacheProfiler {
       ++missCount;
     }
 
-    /// Increment the inline caching hit count for a pair of hidden classes.
-    void incrementHit() {
+    /// Increment the inline caching hit count, for a cache in \p state.
+    void incrementHit(PropertyCacheState state) {
       ++hitCount;
+      ++hitCountByState[static_cast<size_t>(state)];
     }
 
     /// Total number of inline caching misses at the source location.
@@ -65,6 +67,10 @@ class InlineCacheProfiler {
     /// Total number of inline caching hits at the source location.
     uint64_t hitCount{0};
 
+    /// Number of inline caching hits at the source location, indexed by the
+    /// PropertyCacheState of the cache at the time of the hit.
+    uint64_t hitCountByState[3]{};
+
     /// Internal map that keeps track of the mapping between
     /// <property, object hidden class, cached hidden class> and its frequency.
     llvh::DenseMap<ICMissKey, uint64_t> hiddenClasses;
@@ -84,8 +90,11 @@ class InlineCacheProfiler {
       ClassId objectHiddenClassId,
       ClassId cachedHiddenClassId);
 
-  /// Record an inline caching hit.
-  bool insertICHit(CodeBlock *codeblock, uint32_t instOffset);
+  /// Record an inline caching hit in a cache in \p state.
+  bool insertICHit(
+      CodeBlock *codeblock,
+      uint32_t instOffset,
+      PropertyCacheState state);
 
   /// Get the total number of inline caching misses.
   uint32_t getTotalMisses() {
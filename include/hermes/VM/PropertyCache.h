@@ -8,7 +8,10 @@
 #ifndef PROJECT_PROPERTYCACHE_H
 #define PROJECT_PROPERTYCACHE_H
 
+#include "hermes/Support/OptValue.h"
 #include "hermes/VM/GCPointer.h"
+#include "hermes/VM/HeapAlign.h"
+#include "hermes/VM/PropertyDescriptor.h"
 #include "hermes/VM/SymbolID.h"
 #include "hermes/VM/WeakRoot.h"
 
@@ -30,6 +33,142 @@ struct PropertyCacheEntry {
   SlotIndex slot{0};
 };
 
+/// The maximum number of classes a single property cache holds before it
+/// becomes megamorphic. The first class is stored in the PropertyCacheEntry
+/// itself, and the rest in a PolymorphicPropertyCache.
+static constexpr unsigned kMaxPolymorphicCacheEntries = 4;
+
+/// The state of the property cache belonging to one instruction.
+enum class PropertyCacheState : uint8_t {
+  /// At most one class has been cached.
+  Monomorphic,
+  /// Between two and kMaxPolymorphicCacheEntries classes have been cached.
+  Polymorphic,
+  /// More classes than fit in the cache have been seen. The cache keeps the
+  /// classes it has, but is no longer updated.
+  Megamorphic,
+};
+
+/// A cache entry for a property found on the prototype chain of the object
+/// being accessed. It holds the class of the accessed object, which must not
+/// be a dictionary, and the classes of the objects on its prototype chain,
+/// ending with the object that owns the property. It is valid while each
+/// object on the chain still has its cached class and \c epoch matches
+/// Runtime::getProtoCacheEpoch(), which covers properties added to
+/// dictionary-mode objects without a class change.
+struct ProtoPropertyCacheEntry {
+  /// The maximum number of prototype chain links that can be cached.
+  static constexpr unsigned kMaxDepth = 4;
+
+  /// Class of the accessed object.
+  WeakRoot<HiddenClass> receiverClazz{nullptr};
+
+  /// Classes of the objects on the prototype chain.
+  WeakRoot<HiddenClass> chain[kMaxDepth];
+
+  /// Number of valid elements in \c chain. Zero if the entry is empty.
+  uint8_t depth{0};
+
+  /// Property index in the last object of the chain.
+  SlotIndex slot{0};
+
+  /// Value of the prototype cache epoch when the entry was filled.
+  uint32_t epoch{0};
+};
+
+/// Additional state for a property cache that is allocated once it is needed,
+/// so that monomorphic caches stay small.
+struct PolymorphicPropertyCache {
+  /// Classes beyond the one in the PropertyCacheEntry. An entry whose class has
+  /// been collected is left empty and may be reused.
+  PropertyCacheEntry entries[kMaxPolymorphicCacheEntries - 1];
+
+  /// Set once the cache has run out of entries.
+  bool megamorphic{false};
+
+  /// Lookup through the prototype chain. Only used by read caches.
+  ProtoPropertyCacheEntry proto;
+};
+
+/// A runtime-wide, direct-mapped cache of own property lookups, keyed by
+/// (HiddenClass, SymbolID). It remembers both found and missing properties, so
+/// that megamorphic accesses can avoid searching (or rebuilding) the property
+/// map of the class.
+/// Entries do not keep their class alive and are not updated when the class
+/// moves, so the whole cache must be cleared by every collection that may free
+/// or move hidden classes. A class whose properties change without a class
+/// transition (i.e. a dictionary) must invalidate the affected entries.
+class PropertyLookupCache {
+ public:
+  /// Number of entries in the cache. Must be a power of two.
+  static constexpr uint32_t kNumEntries = 1024;
+
+  /// Look up property \p name of class \p clazz.
+  /// \return llvh::None if the pair is not in the cache, otherwise whether the
+  ///   class has the property, in which case its descriptor is stored in
+  ///   \p desc.
+  OptValue<bool> find(
+      CompressedPointer clazz,
+      SymbolID name,
+      NamedPropertyDescriptor &desc) const {
+    const Entry &entry = entries_[index(clazz.getRaw(), name)];
+    if (entry.clazz != clazz.getRaw() || entry.name != name)
+      return llvh::None;
+    if (entry.found)
+      desc = entry.desc;
+    return entry.found;
+  }
+
+  /// Record the result of looking up property \p name in class \p clazz,
+  /// replacing whichever pair occupied its entry. \p desc is the descriptor of
+  /// the property, or nullptr if the class does not have it.
+  void insert(
+      CompressedPointer clazz,
+      SymbolID name,
+      const NamedPropertyDescriptor *desc) {
+    Entry &entry = entries_[index(clazz.getRaw(), name)];
+    entry.clazz = clazz.getRaw();
+    entry.name = name;
+    entry.found = desc != nullptr;
+    if (desc)
+      entry.desc = *desc;
+  }
+
+  /// Forget the pair (\p clazz, \p name) if it is in the cache.
+  void invalidate(CompressedPointer clazz, SymbolID name) {
+    Entry &entry = entries_[index(clazz.getRaw(), name)];
+    if (entry.clazz == clazz.getRaw() && entry.name == name)
+      entry.clazz = 0;
+  }
+
+  /// Forget all entries.
+  void clear() {
+    for (Entry &entry : entries_)
+      entry.clazz = 0;
+  }
+
+ private:
+  struct Entry {
+    /// The class, or 0 if the entry is empty.
+    CompressedPointer::RawType clazz{0};
+    SymbolID name{};
+    /// Whether the class has the property.
+    bool found{false};
+    /// The descriptor of the property, if found.
+    NamedPropertyDescriptor desc{};
+  };
+
+  static uint32_t index(CompressedPointer::RawType clazz, SymbolID name) {
+    // Classes are heap aligned, so the low bits of the pointer carry no
+    // information.
+    uint32_t h = (uint32_t)(clazz >> LogHeapAlign) * 0x9E3779B1u;
+    h ^= name.unsafeGetRaw() * 0x85EBCA6Bu;
+    return (h ^ (h >> 16)) & (kNumEntries - 1);
+  }
+
+  Entry entries_[kNumEntries];
+};
+
 } // namespace vm
 } // namespace hermes
 #endif // PROJECT_PROPERTYCACHE_H
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_REGEXPCACHE_H
+#define HERMES_VM_REGEXPCACHE_H
+
+#include "hermes/Regex/RegexSupport.h"
+#include "hermes/Regex/RegexTypes.h"
+
+#include "llvh/ADT/ArrayRef.h"
+
+#include <deque>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+/// A size-bounded cache of compiled regexps, keyed by pattern and flags, so
+/// that RegExp objects constructed repeatedly from the same source do not
+/// parse and compile it every time. When the cache is full, the least
+/// recently used entries are evicted.
+class RegExpCache {
+ public:
+  /// A compiled regexp.
+  struct Entry {
+    /// The regex bytecode, which JSRegExp copies.
+    std::vector<uint8_t> bytecode;
+
+    /// Named capture groups, in the order they appear in the pattern.
+    std::deque<regex::GroupName> orderedGroupNames;
+
+    /// Map from group name to group number. The keys reference the names in
+    /// orderedGroupNames.
+    regex::ParsedGroupNamesMapping groupNamesMapping;
+  };
+
+  /// The maximum number of entries.
+  static constexpr size_t kMaxEntries = 64;
+
+  /// The maximum total size of the cached bytecode. A single larger regexp is
+  /// still cached, until the next insertion evicts it.
+  static constexpr size_t kMaxBytecodeSize = 256 * 1024;
+
+  /// Look up the regexp with pattern \p pattern and flags \p flags, and count
+  /// the lookup as a hit or a miss.
+  /// \return the entry, or nullptr if it is not cached. The entry stays valid
+  /// until the next call to insert().
+  Entry *lookup(llvh::ArrayRef<char16_t> pattern, regex::SyntaxFlags flags);
+
+  /// Add \p entry as the compiled form of pattern \p pattern with flags
+  /// \p flags, which must not be cached already, evicting old entries as
+  /// needed.
+  /// \return the inserted entry.
+  Entry &insert(
+      llvh::ArrayRef<char16_t> pattern,
+      regex::SyntaxFlags flags,
+      Entry &&entry);
+
+  /// Remove all entries. The hit and miss counts are kept.
+  void clear();
+
+  /// \return the number of cached regexps.
+  size_t size() const {
+    return entries_.size();
+  }
+
+  /// \return the number of lookups which found an entry.
+  uint64_t getNumHits() const {
+    return numHits_;
+  }
+
+  /// \return the number of lookups which found no entry.
+  uint64_t getNumMisses() const {
+    return numMisses_;
+  }
+
+  /// \return an estimate of the memory used by the cache.
+  size_t getAllocatedSize() const;
+
+ private:
+  /// The key of a regexp: its flags byte followed by its pattern.
+  using Key = std::u16string;
+
+  static Key makeKey(
+      llvh::ArrayRef<char16_t> pattern,
+      regex::SyntaxFlags flags);
+
+  /// The entries, most recently used first.
+  std::list<std::pair<Key, Entry>> entries_{};
+
+  /// Map from key to its position in entries_.
+  std::unordered_map<Key, std::list<std::pair<Key, Entry>>::iterator> index_{};
+
+  /// Total size of the bytecode in entries_.
+  size_t bytecodeSize_ = 0;
+
+  uint64_t numHits_ = 0;
+  uint64_t numMisses_ = 0;
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_REGEXPCACHE_H
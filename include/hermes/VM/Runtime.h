@@ -26,12 +26,14 @@
 #include "hermes/VM/IdentifierTable.h"
 #include "hermes/VM/InternalProperty.h"
 #include "hermes/VM/InterpreterState.h"
+#include "hermes/VM/JIT/Config.h"
 #include "hermes/VM/PointerBase.h"
 #include "hermes/VM/Predefined.h"
 #include "hermes/VM/Profiler.h"
 #include "hermes/VM/Profiler/SamplingProfilerDefs.h"
 #include "hermes/VM/PropertyCache.h"
 #include "hermes/VM/PropertyDescriptor.h"
+#include "hermes/VM/RegExpCache.h"
 #include "hermes/VM/RegExpMatch.h"
 #include "hermes/VM/RuntimeModule.h"
 #include "hermes/VM/StackFrame.h"
@@ -45,6 +47,7 @@
 #include "hermes/VM/Profiler/InlineCacheProfiler.h"
 #endif
 
+#include "llvh/ADT/BitVector.h"
 #include "llvh/ADT/DenseMap.h"
 #include "llvh/ADT/SmallVector.h"
 
@@ -91,6 +94,7 @@ class ScopedNativeDepthReducer;
 class ScopedNativeDepthTracker;
 class ScopedNativeCallFrame;
 class CodeCoverageProfiler;
+class JITContext;
 struct StackTracesTree;
 
 #if HERMESVM_SAMPLING_PROFILER_AVAILABLE
@@ -322,6 +326,13 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
       class... Args>
   T *makeAVariable(uint32_t size, Args &&...args);
 
+  /// Reserve space for N cells of the given \p sizes with a single heap
+  /// allocation. See GCBase::allocBatch for the requirements on the batch.
+  /// If necessary perform a GC cycle, which may potentially move
+  /// allocated objects.
+  template <size_t N>
+  GC::CellBatch<N> allocBatch(const std::array<uint32_t, N> &sizes);
+
   /// Used as a placeholder for places where we should be checking for OOM
   /// but aren't yet.
   /// TODO: do something when there is an uncaught exception, e.g. print
@@ -433,6 +444,10 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
     return symbolRegistry_;
   }
 
+  RegExpCache &getRegExpCache() {
+    return regExpCache_;
+  }
+
   /// Return a StringPrimitive representation of a single character. The first
   /// 256 characters are pre-allocated. The rest are allocated every time.
   Handle<StringPrimitive> getCharacterString(char16_t ch);
@@ -766,6 +781,38 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
       PropCacheID id,
       SmallHermesValue hv);
 
+  /// \return the current epoch of the prototype chain property caches. Entries
+  /// filled in an earlier epoch are no longer valid.
+  uint32_t getProtoCacheEpoch() const {
+    return protoCacheEpoch_;
+  }
+
+  /// Record that a prototype chain cache entry for property \p name is being
+  /// filled in the current epoch.
+  void addProtoCachedName(SymbolID name) {
+    if (name.unsafeGetIndex() >= protoCachedNames_.size())
+      protoCachedNames_.resize(name.unsafeGetIndex() + 1);
+    protoCachedNames_.set(name.unsafeGetIndex());
+  }
+
+  /// Invalidate the prototype chain caches if any of them is for property
+  /// \p name. Must be called whenever \p name is added to an object without
+  /// changing its class.
+  void invalidateProtoCaches(SymbolID name) {
+    if (LLVM_UNLIKELY(
+            name.unsafeGetIndex() < protoCachedNames_.size() &&
+            protoCachedNames_.test(name.unsafeGetIndex()))) {
+      ++protoCacheEpoch_;
+      // No entry is valid anymore, so no name needs to be tracked either.
+      protoCachedNames_.reset();
+    }
+  }
+
+  /// \return the runtime-wide cache of own property lookups in hidden classes.
+  PropertyLookupCache &getPropertyLookupCache() {
+    return propertyLookupCache_;
+  }
+
   /// @}
 
 #define RUNTIME_HV_FIELD(name) PinnedHermesValue name{};
@@ -803,8 +850,15 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   /// Track time spent of each opcode in the interpreter, in CPU cycles.
   uint64_t timeSpent[256] = {0};
 
+  /// Track the frequency of each pair of consecutively executed opcodes,
+  /// indexed by the first opcode of the pair.
+  uint32_t opcodePairFrequency[256][256] = {};
+
   /// Dump opcode stats to a stream.
   void dumpOpcodeStats(llvh::raw_ostream &os) const;
+
+  /// Dump the \p topN most frequently executed opcode pairs to a stream.
+  void dumpOpcodePairStats(llvh::raw_ostream &os, unsigned topN) const;
 #endif
 
 #if defined(HERMESVM_PROFILER_JSFUNCTION)
@@ -845,6 +899,12 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
     return *codeCoverageProfiler_;
   }
 
+#ifdef HERMESVM_JIT
+  JITContext &getJITContext() {
+    return *jitContext_;
+  }
+#endif
+
 #if HERMESVM_SAMPLING_PROFILER_AVAILABLE
   /// Sampling profiler data for this runtime. The ctor/dtor of SamplingProfiler
   /// will automatically register/unregister this runtime from profiling.
@@ -897,6 +957,10 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
     return hasMicrotaskQueue_;
   }
 
+  RegExpEngine getRegExpEngine() const {
+    return regExpEngine_;
+  }
+
   bool builtinsAreFrozen() const {
     return builtinsFrozen_;
   }
@@ -975,13 +1039,17 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   /// collected.
   void preventHCGC(HiddenClass *hc);
 
-  /// Inserts Hidden Classes into InlineCacheProfiler
+  /// Inserts Hidden Classes into InlineCacheProfiler. \p polymorphicHit
+  /// indicates that the object hidden class was found in the polymorphic part
+  /// of the cache, which is in state \p cacheState.
   void recordHiddenClass(
       CodeBlock *codeBlock,
       const Inst *cacheMissInst,
       SymbolID symbolID,
       HiddenClass *objectHiddenClass,
-      HiddenClass *cachedHiddenClass);
+      HiddenClass *cachedHiddenClass,
+      bool polymorphicHit,
+      PropertyCacheState cacheState);
 
   /// Resolve HiddenClass pointers from its hidden class Id.
   HiddenClass *resolveHiddenClassId(ClassId classId);
@@ -1172,6 +1240,9 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   /// Set to true if we are using microtasks.
   const bool hasMicrotaskQueue_;
 
+  /// Which engine executes regular expressions.
+  const RegExpEngine regExpEngine_;
+
   /// Set to true if we should randomize stack placement etc.
   const bool shouldRandomizeMemoryLayout_;
 
@@ -1196,6 +1267,7 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   friend class GCScope;
   friend class HandleBase;
   friend class Interpreter;
+  friend class JITHelpers;
   friend class RuntimeModule;
   friend class MarkRootsPhaseTimer;
   friend struct RuntimeOffsets;
@@ -1224,6 +1296,9 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   /// The global symbol registry.
   SymbolRegistry symbolRegistry_{};
 
+  /// Regexps compiled by the RegExp constructor.
+  RegExpCache regExpCache_{};
+
   /// Shared location to place native objects required by JSLib
   std::unique_ptr<JSLibStorage> jsLibStorage_;
 
@@ -1290,6 +1365,18 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   /// Cache for property lookups in non-JS code.
   PropertyCacheEntry fixedPropCache_[(size_t)PropCacheID::_COUNT];
 
+  /// Epoch of the prototype chain property caches. Starts at one so that an
+  /// empty entry never matches.
+  uint32_t protoCacheEpoch_{1};
+
+  /// Set of the properties, indexed by SymbolID index, that prototype chain
+  /// caches have been filled for in the current epoch.
+  llvh::BitVector protoCachedNames_;
+
+  /// Cache of own property lookups in hidden classes, cleared whenever a
+  /// collection may free or move hidden classes.
+  PropertyLookupCache propertyLookupCache_;
+
   /// StringPrimitive representation of the first 256 characters.
   /// These are allocated as "long-lived" objects, so they don't need
   /// to be scanned as roots in young-gen collections.
@@ -1344,6 +1431,11 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   /// Pointer to the code coverage profiler.
   const std::unique_ptr<CodeCoverageProfiler> codeCoverageProfiler_;
 
+#ifdef HERMESVM_JIT
+  /// The baseline JIT, which owns all code compiled for this runtime.
+  const std::unique_ptr<JITContext> jitContext_;
+#endif
+
   /// Bit flags for async break request reasons.
   enum class AsyncBreakReasonBits : uint8_t {
     DebuggerExplicit = 0x1,
@@ -1984,6 +2076,15 @@ T *Runtime::makeAVariable(uint32_t size, Args &&...args) {
       size, std::forward<Args>(args)...);
 }
 
+template <size_t N>
+GC::CellBatch<N> Runtime::allocBatch(const std::array<uint32_t, N> &sizes) {
+#ifndef NDEBUG
+  // See the comment in makeAFixed.
+  (void)getCurrentIP();
+#endif
+  return getHeap().allocBatch(sizes);
+}
+
 template <typename T>
 inline T Runtime::ignoreAllocationFailure(CallResult<T> res) {
   if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
@@ -39,6 +39,10 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   friend class StringView;
   template <typename T>
   friend class BufferedStringPrimitive;
+  template <typename T>
+  friend class RopeStringPrimitive;
+  template <typename T>
+  friend class SlicedStringPrimitive;
 
   friend llvh::raw_ostream &operator<<(
       llvh::raw_ostream &OS,
@@ -139,6 +143,16 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   static constexpr uint32_t CONCAT_STRING_MIN_SIZE =
       std::max(256u, EXTERNAL_STRING_MIN_SIZE);
 
+  /// Slices of at least this size may use SlicedStringPrimitive instead of
+  /// copying the characters. Shorter slices are cheaper to copy than the
+  /// extra cell is worth.
+  static constexpr uint32_t SLICED_STRING_MIN_SIZE = 32;
+
+  /// Slices are copied anyway if the string they would refer to is more than
+  /// this many times longer and has not survived a collection yet, because it
+  /// is then likely to be otherwise dead soon.
+  static constexpr uint32_t SLICED_STRING_MAX_YOUNG_PARENT_RATIO = 8;
+
   static bool classof(const GCCell *cell) {
     return kindInRange(
         cell->getKind(),
@@ -265,20 +279,12 @@ class StringPrimitive : public VariableSizeRuntimeCell {
       size_t length);
 
   /// Flatten the string if it's a rope, possibly causing allocation/GC.
-  static Handle<StringPrimitive> ensureFlat(
+  static inline Handle<StringPrimitive> ensureFlat(
       Runtime &runtime,
-      Handle<StringPrimitive> self) {
-    // In the future, ensureFlat may trigger GC as it might allocate for
-    // ropes. Move the heap here.
-    runtime.potentiallyMoveHeap();
-    return self;
-    // TODO: Deal with different subclasses (e.g. rope)
-  }
+      Handle<StringPrimitive> self);
 
   /// \return true if the string is flat.
-  bool isFlat() const {
-    return true;
-  }
+  inline bool isFlat() const;
 
   /// \return a StringView of this string. In the case of a rope, we will need
   /// to resolve the rope, which might involve object allocations.
@@ -353,6 +359,12 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   /// it is safe to call this function which guarantees to not trigger gc.
   static StringView createStringViewMustBeFlat(Handle<StringPrimitive> self);
 
+  /// Call \p visit with each flat string whose characters, in order, make up
+  /// this string. Ropes which have not been flattened are visited
+  /// recursively instead of being flattened.
+  template <typename F>
+  void forEachFlatPiece(F visit) const;
+
  protected:
   /// \return whether the StringPrimitive can be converted from non-uniqued to
   /// uniqued without reallocating.
@@ -685,6 +697,12 @@ class BufferedStringPrimitive final : public StringPrimitive {
     return cell->getKind() == BufferedStringPrimitive::getCellKind();
   }
 
+  /// \return whether this string ends its concatenation buffer, so that it can
+  /// be appended to without copying.
+  bool endsConcatBuffer() const {
+    return getStringLength() == getConcatBuffer()->contents_.size();
+  }
+
 #ifdef UNIT_TEST
   /// Expose the concatenation buffer for unit tests.
   ExternalStringPrimitive<T> *testGetConcatBuffer() const {
@@ -779,6 +797,244 @@ inline bool isBufferedStringPrimitive(const GCCell *cell) {
       cell->getKind() == CellKind::BufferedASCIIStringPrimitiveKind;
 }
 
+/// An immutable JavaScript primitive string representing the concatenation of
+/// two other strings, which it references instead of copying their contents.
+/// This makes repeated concatenation linear in cases where a concatenation
+/// buffer cannot be shared, like prepending, building trees of strings, or
+/// appending different suffixes to the same prefix.
+///
+/// The characters are copied to a malloc'ed buffer the first time they are
+/// accessed. Flattening does not allocate in the GC heap, so it is also done
+/// lazily by the raw pointer accessors. When it is done through
+/// StringPrimitive::ensureFlat(), which has access to the runtime, the
+/// references to the two halves are dropped as well.
+template <typename T>
+class RopeStringPrimitive final : public StringPrimitive {
+  friend class StringPrimitive;
+  friend PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
+      Runtime &runtime,
+      Handle<StringPrimitive> leftHnd,
+      Handle<StringPrimitive> rightHnd);
+  friend void RopeASCIIStringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+  friend void RopeUTF16StringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+
+ public:
+  /// \return the cell kind for this string.
+  static constexpr CellKind getCellKind() {
+    return std::is_same<T, char16_t>::value
+        ? CellKind::RopeUTF16StringPrimitiveKind
+        : CellKind::RopeASCIIStringPrimitiveKind;
+  }
+
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == RopeStringPrimitive::getCellKind();
+  }
+
+  /// Concatenations which would create a rope deeper than this copy the
+  /// characters instead, which bounds the cost of flattening.
+  static constexpr uint32_t MAX_DEPTH = 1024;
+
+ private:
+  static const VTable vt;
+
+ public:
+  /// Construct a rope of depth \p depth representing the concatenation of
+  /// \p left and \p right.
+  RopeStringPrimitive(
+      Runtime &runtime,
+      Handle<StringPrimitive> left,
+      Handle<StringPrimitive> right,
+      uint32_t depth)
+      : StringPrimitive(left->getStringLength() + right->getStringLength()),
+        depth_(depth) {
+    leftHV_.set(HermesValue::encodeStringValue(*left), runtime.getHeap());
+    rightHV_.set(HermesValue::encodeStringValue(*right), runtime.getHeap());
+  }
+
+  /// \return whether the characters have been copied to a flat buffer.
+  bool isFlattened() const {
+    return flat_ != nullptr;
+  }
+
+  /// \return the number of ropes on the longest path from this one to a flat
+  /// string, or 0 if this rope has been flattened.
+  uint32_t getDepth() const {
+    return isFlattened() ? 0 : depth_;
+  }
+
+  /// \return the left half of the string.
+  /// \pre the rope has not been flattened.
+  StringPrimitive *getLeft() const {
+    assert(!isFlattened() && "flattened ropes may drop their halves");
+    return vmcast<StringPrimitive>(leftHV_);
+  }
+
+  /// \return the right half of the string.
+  /// \pre the rope has not been flattened.
+  StringPrimitive *getRight() const {
+    assert(!isFlattened() && "flattened ropes may drop their halves");
+    return vmcast<StringPrimitive>(rightHV_);
+  }
+
+ private:
+  /// Allocate a rope representing the concatenation of \p leftHnd and
+  /// \p rightHnd.
+  /// \pre The types must be compatible with respect to T (both strings must be
+  /// ASCII if T is char), the combined length must have been validated and
+  /// the resulting depth must not exceed MAX_DEPTH.
+  static PseudoHandle<StringPrimitive> create(
+      Runtime &runtime,
+      Handle<StringPrimitive> leftHnd,
+      Handle<StringPrimitive> rightHnd);
+
+  /// \return a const pointer to the first character of the string, flattening
+  /// it if necessary.
+  const T *getRawPointer() const {
+    if (LLVM_UNLIKELY(!flat_))
+      flatten();
+    return flat_;
+  }
+
+  /// Copy the characters to a new flat buffer. This doesn't allocate in the
+  /// GC heap, and keeps the halves alive.
+  void flatten() const;
+
+  /// Flatten the string if necessary, account for the flat buffer as external
+  /// memory and drop the references to the halves.
+  void flattenAndRelease(Runtime &runtime);
+
+  /// \return the size of the flat buffer, or 0 if there is none.
+  size_t calcExternalMemorySize() const {
+    return flat_ ? getStringLength() * sizeof(T) : 0;
+  }
+
+  /// Finalizer to free the flat buffer.
+  static void _finalizeImpl(GCCell *cell, GC &gc);
+
+  /// \return the size of the flat buffer of \p cell, which is assumed to be a
+  /// RopeStringPrimitive.
+  static size_t _mallocSizeImpl(GCCell *cell);
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+  static std::string _snapshotNameImpl(GCCell *cell, GC &gc);
+  static void _snapshotAddEdgesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+  static void _snapshotAddNodesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+#endif
+
+  /// The two halves of the string. They are cleared once the rope has been
+  /// flattened by flattenAndRelease().
+  GCHermesValue leftHV_;
+  GCHermesValue rightHV_;
+
+  /// The depth of the rope when it was created.
+  uint32_t depth_;
+
+  /// Whether the flat buffer has been credited as external memory.
+  bool creditedFlat_{false};
+
+  /// The flattened characters, or nullptr if the rope has not been flattened
+  /// yet.
+  mutable T *flat_{nullptr};
+};
+
+/// An immutable JavaScript primitive string consisting of a range of the
+/// characters of another, flat string, which it keeps alive instead of copying
+/// the range. The parent is never itself a SlicedStringPrimitive, and its
+/// characters are located on every access, since they may move.
+template <typename T>
+class SlicedStringPrimitive final : public StringPrimitive {
+  friend class StringPrimitive;
+  friend void SlicedASCIIStringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+  friend void SlicedUTF16StringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+
+ public:
+  /// \return the cell kind for this string.
+  static constexpr CellKind getCellKind() {
+    return std::is_same<T, char16_t>::value
+        ? CellKind::SlicedUTF16StringPrimitiveKind
+        : CellKind::SlicedASCIIStringPrimitiveKind;
+  }
+
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == SlicedStringPrimitive::getCellKind();
+  }
+
+ private:
+  static const VTable vt;
+
+ public:
+  /// Construct a slice of \p length characters of \p parent, starting at
+  /// \p offset.
+  SlicedStringPrimitive(
+      Runtime &runtime,
+      Handle<StringPrimitive> parent,
+      uint32_t offset,
+      uint32_t length)
+      : StringPrimitive(length), offset_(offset) {
+    parentHV_.set(HermesValue::encodeStringValue(*parent), runtime.getHeap());
+    assert(
+        offset + length <= parent->getStringLength() &&
+        "slice exceeds parent string");
+  }
+
+  /// \return the string whose characters this string refers to.
+  StringPrimitive *getParent() const {
+    return vmcast<StringPrimitive>(parentHV_);
+  }
+
+  /// \return the index of the first character in the parent string.
+  uint32_t getOffset() const {
+    return offset_;
+  }
+
+ private:
+  /// Allocate a slice of \p length characters of \p parentHnd, starting at
+  /// \p offset.
+  /// \pre \p parentHnd is flat, is not a SlicedStringPrimitive and its type
+  /// matches T.
+  static PseudoHandle<StringPrimitive> create(
+      Runtime &runtime,
+      Handle<StringPrimitive> parentHnd,
+      uint32_t offset,
+      uint32_t length);
+
+  /// \return a const pointer to the first character of the string.
+  const T *getRawPointer() const {
+    return getParent()->template castToPointer<T>() + offset_;
+  }
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+  static void _snapshotAddEdgesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+  static void _snapshotAddNodesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+#endif
+
+  /// The string containing the characters.
+  GCHermesValue parentHV_;
+
+  /// The index of the first character in the parent string.
+  uint32_t offset_;
+};
+
+/// \return true if this is one of the SlicedStringPrimitive classes.
+inline bool isSlicedStringPrimitive(const GCCell *cell) {
+  return cell->getKind() == CellKind::SlicedUTF16StringPrimitiveKind ||
+      cell->getKind() == CellKind::SlicedASCIIStringPrimitiveKind;
+}
+
+/// \return true if this is one of the RopeStringPrimitive classes.
+inline bool isRopeStringPrimitive(const GCCell *cell) {
+  return cell->getKind() == CellKind::RopeUTF16StringPrimitiveKind ||
+      cell->getKind() == CellKind::RopeASCIIStringPrimitiveKind;
+}
+
 /// This function is not part of the API and is not supposed to be called
 /// directly. It is used internally by StringPrimitive::concat. It is used
 /// to handle the case when the result string exceeds the minimal length for
@@ -789,7 +1045,9 @@ inline bool isBufferedStringPrimitive(const GCCell *cell) {
 /// Some cases where it needs to allocate a new buffer include:
 /// - the left string is not a BufferedStringPrimitive
 /// - appending UTF16 to ASCII
-/// - appending to the middle of the concatenation chain.
+/// When copying either string would be wasteful, for example when appending
+/// to the middle of the concatenation chain or to a rope, or when the right
+/// string is long, it allocates a RopeStringPrimitive instead.
 /// \pre The combined length must have been validated by the caller.
 PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
     Runtime &runtime,
@@ -864,6 +1122,48 @@ const VTable BufferedStringPrimitive<T>::vt = VTable(
 using BufferedUTF16StringPrimitive = BufferedStringPrimitive<char16_t>;
 using BufferedASCIIStringPrimitive = BufferedStringPrimitive<char>;
 
+template <typename T>
+const VTable RopeStringPrimitive<T>::vt = VTable(
+    RopeStringPrimitive<T>::getCellKind(),
+    0,
+    RopeStringPrimitive<T>::_finalizeImpl,
+    RopeStringPrimitive<T>::_mallocSizeImpl,
+    nullptr
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+    ,
+    VTable::HeapSnapshotMetadata {
+      HeapSnapshot::NodeType::ConcatenatedString,
+          RopeStringPrimitive<T>::_snapshotNameImpl,
+          RopeStringPrimitive<T>::_snapshotAddEdgesImpl,
+          RopeStringPrimitive<T>::_snapshotAddNodesImpl, nullptr
+    }
+#endif
+);
+
+using RopeUTF16StringPrimitive = RopeStringPrimitive<char16_t>;
+using RopeASCIIStringPrimitive = RopeStringPrimitive<char>;
+
+template <typename T>
+const VTable SlicedStringPrimitive<T>::vt = VTable(
+    SlicedStringPrimitive<T>::getCellKind(),
+    0,
+    nullptr, // finalize.
+    nullptr, // mallocSize
+    nullptr
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+    ,
+    VTable::HeapSnapshotMetadata {
+      HeapSnapshot::NodeType::SlicedString,
+          SlicedStringPrimitive<T>::_snapshotNameImpl,
+          SlicedStringPrimitive<T>::_snapshotAddEdgesImpl,
+          SlicedStringPrimitive<T>::_snapshotAddNodesImpl, nullptr
+    }
+#endif
+);
+
+using SlicedUTF16StringPrimitive = SlicedStringPrimitive<char16_t>;
+using SlicedASCIIStringPrimitive = SlicedStringPrimitive<char>;
+
 //===----------------------------------------------------------------------===//
 // StringPrimitive inline methods.
 
@@ -986,6 +1286,28 @@ inline CallResult<HermesValue> StringPrimitive::createLongLived(
   }
 }
 
+/*static*/ inline Handle<StringPrimitive> StringPrimitive::ensureFlat(
+    Runtime &runtime,
+    Handle<StringPrimitive> self) {
+  // Flattening a rope may trigger GC, so move the heap here even for strings
+  // which are already flat.
+  runtime.potentiallyMoveHeap();
+  if (auto *rope = dyn_vmcast<RopeASCIIStringPrimitive>(*self)) {
+    rope->flattenAndRelease(runtime);
+  } else if (auto *rope = dyn_vmcast<RopeUTF16StringPrimitive>(*self)) {
+    rope->flattenAndRelease(runtime);
+  }
+  return self;
+}
+
+inline bool StringPrimitive::isFlat() const {
+  if (auto *rope = dyn_vmcast<RopeASCIIStringPrimitive>(this))
+    return rope->isFlattened();
+  if (auto *rope = dyn_vmcast<RopeUTF16StringPrimitive>(this))
+    return rope->isFlattened();
+  return true;
+}
+
 inline bool StringPrimitive::canBeUniqued() const {
   return vmisa<SymbolStringPrimitive>(this);
 }
@@ -1016,6 +1338,10 @@ inline const char *StringPrimitive::castToASCIIPointer() const {
     return vmcast<DynamicUniquedASCIIStringPrimitive>(this)->getRawPointer();
   } else if (vmisa<DynamicASCIIStringPrimitive>(this)) {
     return vmcast<DynamicASCIIStringPrimitive>(this)->getRawPointer();
+  } else if (vmisa<SlicedASCIIStringPrimitive>(this)) {
+    return vmcast<SlicedASCIIStringPrimitive>(this)->getRawPointer();
+  } else if (vmisa<RopeASCIIStringPrimitive>(this)) {
+    return vmcast<RopeASCIIStringPrimitive>(this)->getRawPointer();
   } else {
     return vmcast<BufferedASCIIStringPrimitive>(this)->getRawPointer();
   }
@@ -1028,6 +1354,10 @@ inline const char16_t *StringPrimitive::castToUTF16Pointer() const {
     return vmcast<DynamicUniquedUTF16StringPrimitive>(this)->getRawPointer();
   } else if (vmisa<DynamicUTF16StringPrimitive>(this)) {
     return vmcast<DynamicUTF16StringPrimitive>(this)->getRawPointer();
+  } else if (vmisa<SlicedUTF16StringPrimitive>(this)) {
+    return vmcast<SlicedUTF16StringPrimitive>(this)->getRawPointer();
+  } else if (vmisa<RopeUTF16StringPrimitive>(this)) {
+    return vmcast<RopeUTF16StringPrimitive>(this)->getRawPointer();
   } else {
     return vmcast<BufferedUTF16StringPrimitive>(this)->getRawPointer();
   }
@@ -1083,6 +1413,10 @@ inline bool StringPrimitive::isASCII() const {
           CellKind::DynamicASCIIStringPrimitiveKind,
           CellKind::BufferedUTF16StringPrimitiveKind,
           CellKind::BufferedASCIIStringPrimitiveKind,
+          CellKind::RopeUTF16StringPrimitiveKind,
+          CellKind::RopeASCIIStringPrimitiveKind,
+          CellKind::SlicedUTF16StringPrimitiveKind,
+          CellKind::SlicedASCIIStringPrimitiveKind,
           CellKind::DynamicUniquedUTF16StringPrimitiveKind,
           CellKind::DynamicUniquedASCIIStringPrimitiveKind,
           CellKind::ExternalUTF16StringPrimitiveKind,
@@ -1102,6 +1436,10 @@ inline bool StringPrimitive::isExternal() const {
           CellKind::DynamicASCIIStringPrimitiveKind,
           CellKind::BufferedUTF16StringPrimitiveKind,
           CellKind::BufferedASCIIStringPrimitiveKind,
+          CellKind::RopeUTF16StringPrimitiveKind,
+          CellKind::RopeASCIIStringPrimitiveKind,
+          CellKind::SlicedUTF16StringPrimitiveKind,
+          CellKind::SlicedASCIIStringPrimitiveKind,
           CellKind::DynamicUniquedUTF16StringPrimitiveKind,
           CellKind::DynamicUniquedASCIIStringPrimitiveKind,
           CellKind::ExternalUTF16StringPrimitiveKind,
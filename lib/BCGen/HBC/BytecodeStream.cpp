@@ -7,6 +7,11 @@
 
 #include "hermes/BCGen/HBC/BytecodeStream.h"
 
+#include "llvh/ADT/BitVector.h"
+
+#include <algorithm>
+#include <numeric>
+
 using namespace hermes;
 using namespace hbc;
 
@@ -46,8 +51,8 @@ void BytecodeSerializer::serialize(BytecodeModule &BM, const SHA1 &sourceHash) {
   visitBytecodeSegmentsInOrder(*this);
   serializeFunctionsBytecode(BM);
 
-  for (auto &entry : BM.getFunctionTable()) {
-    serializeFunctionInfo(*entry);
+  for (uint32_t id : functionLayoutOrder_) {
+    serializeFunctionInfo(*BM.getFunctionTable()[id]);
   }
 
   serializeDebugInfo(BM);
@@ -180,10 +185,18 @@ void BytecodeSerializer::serializeDebugOffsets(BytecodeFunction &BF) {
 
 // ============================ Function ============================
 void BytecodeSerializer::serializeFunctionsBytecode(BytecodeModule &BM) {
+  if (isLayout_) {
+    computeFunctionLayoutOrder(BM);
+  }
+  writeFunctionBodies(BM);
+}
+
+void BytecodeSerializer::writeFunctionBodies(BytecodeModule &BM) {
   // Map from opcodes and jumptables to offsets, used to deduplicate bytecode.
   using DedupKey = llvh::ArrayRef<opcode_atom_t>;
   llvh::DenseMap<DedupKey, uint32_t> bcMap;
-  for (auto &entry : BM.getFunctionTable()) {
+  for (uint32_t id : functionLayoutOrder_) {
+    auto &entry = BM.getFunctionTable()[id];
     if (options_.optimizationEnabled) {
       // If identical bytecode exists, we'll reuse it.
       bool reuse = false;
@@ -230,6 +243,95 @@ void BytecodeSerializer::serializeFunctionsBytecode(BytecodeModule &BM) {
   }
 }
 
+void BytecodeSerializer::computeFunctionLayoutOrder(BytecodeModule &BM) {
+  const uint32_t count = BM.getNumFunctions();
+  functionLayoutOrder_.resize(count);
+  std::iota(functionLayoutOrder_.begin(), functionLayoutOrder_.end(), 0);
+
+  const BytecodeLayoutProfile *profile = options_.layoutProfile.get();
+  if (!profile) {
+    return;
+  }
+
+  std::vector<uint32_t> hot;
+  llvh::BitVector isHot(count);
+  auto addHot = [&hot, &isHot](uint32_t id) {
+    if (!isHot.test(id)) {
+      isHot.set(id);
+      hot.push_back(id);
+    }
+  };
+
+  if (profile->pageSize && !profile->accessedPages.empty()) {
+    // The page numbers refer to the default layout, so do a throwaway layout
+    // of the bodies in function ID order to see which functions each accessed
+    // page held. The real layout below overwrites the offsets.
+    struct Body {
+      uint32_t start;
+      uint32_t end;
+      uint32_t id;
+    };
+    std::vector<Body> bodies;
+    bodies.reserve(count);
+    size_t start = loc_;
+    writeFunctionBodies(BM);
+    loc_ = start;
+    for (uint32_t id = 0; id < count; ++id) {
+      const BytecodeFunction &BF = *BM.getFunctionTable()[id];
+      uint32_t offset = BF.getOffset();
+      uint32_t size = BF.getHeader().bytecodeSizeInBytes;
+      bodies.push_back({offset, offset + size, id});
+    }
+    // Bodies don't overlap unless they were deduplicated, in which case they
+    // are identical, so sorting by start also sorts by end.
+    std::sort(bodies.begin(), bodies.end(), [](const Body &a, const Body &b) {
+      return a.start < b.start || (a.start == b.start && a.id < b.id);
+    });
+    for (uint32_t page : profile->accessedPages) {
+      uint64_t pageStart = (uint64_t)page * profile->pageSize;
+      uint64_t pageEnd = pageStart + profile->pageSize;
+      auto it = std::partition_point(
+          bodies.begin(), bodies.end(), [pageStart](const Body &b) {
+            return b.end <= pageStart;
+          });
+      for (; it != bodies.end() && it->start < pageEnd; ++it) {
+        addHot(it->id);
+      }
+    }
+  }
+
+  if (!profile->executedFunctions.empty()) {
+    // Virtual offsets don't depend on the layout, so they can be mapped back to
+    // function IDs directly.
+    llvh::DenseMap<uint32_t, uint32_t> idByVirtualOffset;
+    uint32_t virtualOffset = 0;
+    for (uint32_t id = 0; id < count; ++id) {
+      idByVirtualOffset.try_emplace(virtualOffset, id);
+      virtualOffset +=
+          BM.getFunctionTable()[id]->getHeader().bytecodeSizeInBytes;
+    }
+    for (const auto &executed : profile->executedFunctions) {
+      if (executed.segmentID != BM.getSegmentID()) {
+        continue;
+      }
+      auto it = idByVirtualOffset.find(executed.virtualOffset);
+      if (it != idByVirtualOffset.end()) {
+        addHot(it->second);
+      }
+    }
+  }
+
+  // Hot functions first in access order, then the rest in ID order.
+  auto cold = functionLayoutOrder_.begin();
+  cold = std::copy(hot.begin(), hot.end(), cold);
+  for (uint32_t id = 0; id < count; ++id) {
+    if (!isHot.test(id)) {
+      *cold++ = id;
+    }
+  }
+  assert(cold == functionLayoutOrder_.end() && "Function layout is incomplete");
+}
+
 void BytecodeSerializer::serializeFunctionInfo(BytecodeFunction &BF) {
   // Set the offset of this function's info. Any subsection that is present is
   // aligned to INFO_ALIGNMENT, so we also align the recorded offset to that.
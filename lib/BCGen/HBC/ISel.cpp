@@ -10,6 +10,7 @@
 #include "hermes/BCGen/BCOpt.h"
 #include "hermes/BCGen/HBC/BytecodeGenerator.h"
 #include "hermes/BCGen/HBC/HBC.h"
+#include "hermes/BCGen/HBC/Passes/FuseSuperinstructions.h"
 #include "hermes/IR/Analysis.h"
 #include "hermes/SourceMap/SourceMapGenerator.h"
 #include "hermes/Support/BigIntSupport.h"
@@ -1806,6 +1807,10 @@ void HBCISel::generate(SourceMapGenerator *outSourceMap) {
   addDebugTextifiedCalleeInfo();
   generateJumpTable();
   populatePropertyCachingInfo();
+  if (bytecodeGenerationOptions_.optimizationEnabled &&
+      F_->getContext().getOptimizationSettings().superinstructions) {
+    fuseSuperinstructions(BCFGen_->opcodes_);
+  }
   BCFGen_->bytecodeGenerationComplete();
 }
 
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define DEBUG_TYPE "fusesuperinstructions"
+
+#include "hermes/BCGen/HBC/Passes/FuseSuperinstructions.h"
+
+#include "hermes/Inst/InstDecode.h"
+
+#include "llvh/ADT/SmallVector.h"
+#include "llvh/ADT/Statistic.h"
+
+STATISTIC(NumSuperinstructions, "Number of superinstructions formed");
+
+namespace hermes {
+namespace hbc {
+
+namespace {
+
+/// \return the superinstruction made of \p first followed by \p second, or
+/// \p first if there is none. \p second may itself be a superinstruction,
+/// which makes the result a sequence of three instructions.
+opcode_atom_t fuse(opcode_atom_t first, opcode_atom_t second) {
+#define DEFINE_SUPERINSTRUCTION(name, firstName, secondName) \
+  if (first == firstName##Op && second == secondName##Op)    \
+    return name##Op;
+#include "hermes/BCGen/HBC/BytecodeList.def"
+  return first;
+}
+
+/// \return the first instruction of the superinstruction \p op, or \p op if
+/// it is not a superinstruction.
+opcode_atom_t unfuse(opcode_atom_t op) {
+  switch (op) {
+#define DEFINE_SUPERINSTRUCTION(name, firstName, secondName) \
+  case name##Op:                                             \
+    return firstName##Op;
+#include "hermes/BCGen/HBC/BytecodeList.def"
+    default:
+      return op;
+  }
+}
+
+} // namespace
+
+bool fuseSuperinstructions(llvh::MutableArrayRef<opcode_atom_t> bytecode) {
+  llvh::SmallVector<uint32_t, 64> offsets;
+  for (uint32_t offset = 0; offset < bytecode.size();
+       offset += inst::getInstSize((inst::OpCode)bytecode[offset])) {
+    offsets.push_back(offset);
+  }
+
+  // Visit the instructions backwards, so that the instruction following the
+  // current one has already been fused with its own successor, and the
+  // longest sequence is formed. If there is no superinstruction starting
+  // with the longer sequence, try again with just the next instruction.
+  bool changed = false;
+  for (size_t i = offsets.size(); i-- > 1;) {
+    opcode_atom_t &first = bytecode[offsets[i - 1]];
+    opcode_atom_t second = bytecode[offsets[i]];
+    opcode_atom_t fused = fuse(first, second);
+    if (fused == first)
+      fused = fuse(first, unfuse(second));
+    if (fused != first) {
+      first = fused;
+      ++NumSuperinstructions;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+} // namespace hbc
+} // namespace hermes
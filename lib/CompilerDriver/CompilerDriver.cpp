@@ -579,6 +579,13 @@ static opt<bool> ReusePropCache(
 static CLFlag
     Inline('f', "inline", true, "inlining of functions", CompilerCategory);
 
+static CLFlag Superinstructions(
+    'f',
+    "superinstructions",
+    true,
+    "superinstructions for common instruction sequences",
+    CompilerCategory);
+
 static CLFlag StripFunctionNames(
     'f',
     "strip-function-names",
@@ -597,6 +604,15 @@ static opt<std::string> BaseBytecodeFile(
     llvh::cl::init(""),
     cat(CompilerCategory));
 
+static opt<std::string> LayoutProfile(
+    "layout-profile",
+    desc("Place the functions accessed in this profile first in the bytecode "
+         "file. Accepts the JSON written by -track-io, or the executed "
+         "function list of the code coverage profiler, one "
+         "segment:virtualOffset entry per line"),
+    init(""),
+    cat(CompilerCategory));
+
 static opt<unsigned> PadFunctionBodiesPercent(
     "pad-function-bodies-percent",
     desc(
@@ -1139,6 +1155,7 @@ std::shared_ptr<Context> createContext(
       cl::BytecodeFormat == cl::BytecodeFormatKind::HBC && cl::Inline;
 
   optimizationOpts.reusePropCache = cl::ReusePropCache;
+  optimizationOpts.superinstructions = cl::Superinstructions;
 
   // When the setting is auto-detect, we will set the correct value after
   // parsing.
@@ -1560,6 +1577,86 @@ bool readBaseBytecodeMap(
   return true;
 }
 
+/// Read the page accesses of a TrackIO run from \p json into \p profile.
+/// \p json is either the array written by the VM, in which case the first
+/// tracked module is used, or the "tracking_info" object of one module.
+/// \return whether it succeeded.
+bool readTrackIOProfile(
+    BytecodeLayoutProfile &profile,
+    ::hermes::parser::JSONValue *json) {
+  using namespace ::hermes::parser;
+  if (auto *modules = llvh::dyn_cast<JSONArray>(json)) {
+    if (modules->size() == 0) {
+      return true;
+    }
+    auto *module = llvh::dyn_cast<JSONObject>(modules->at(0));
+    json = module ? module->get("tracking_info") : nullptr;
+  }
+  auto *info = llvh::dyn_cast_or_null<JSONObject>(json);
+  if (!info) {
+    llvh::errs() << "Invalid layout profile: missing tracking_info\n";
+    return false;
+  }
+  auto *pageSize = llvh::dyn_cast_or_null<JSONNumber>(info->get("page_size"));
+  auto *pageIDs = llvh::dyn_cast_or_null<JSONArray>(info->get("page_ids"));
+  if (!pageSize || !pageIDs) {
+    llvh::errs() << "Invalid layout profile: missing page_size or page_ids\n";
+    return false;
+  }
+  profile.pageSize = pageSize->getValue();
+  for (const JSONValue *id : *pageIDs) {
+    auto *page = llvh::dyn_cast<JSONNumber>(id);
+    if (!page) {
+      llvh::errs() << "Invalid layout profile: page id is not a number\n";
+      return false;
+    }
+    profile.accessedPages.push_back(page->getValue());
+  }
+  return true;
+}
+
+/// Read the profile used to lay out the bytecode file from \p inputPath.
+/// \return the profile, nullptr on failure. Error messages are printed to
+/// stderr.
+std::shared_ptr<const BytecodeLayoutProfile> readLayoutProfile(
+    llvh::StringRef inputPath,
+    ::hermes::parser::JSLexer::Allocator &alloc) {
+  std::unique_ptr<llvh::MemoryBuffer> file = memoryBufferFromFile(inputPath);
+  if (!file) {
+    return nullptr;
+  }
+  auto profile = std::make_shared<BytecodeLayoutProfile>();
+  llvh::StringRef text = file->getBuffer().ltrim();
+  if (text.startswith("[") || text.startswith("{")) {
+    auto *json = parseJSONFile(file, alloc);
+    if (!json || !readTrackIOProfile(*profile, json)) {
+      return nullptr;
+    }
+    return profile;
+  }
+
+  // Code coverage entries are "segmentID:virtualOffset:debugInfo", where the
+  // debug info may be empty and may itself contain colons.
+  llvh::SmallVector<llvh::StringRef, 16> lines;
+  text.split(lines, '\n', -1, false);
+  for (llvh::StringRef line : lines) {
+    line = line.trim();
+    if (line.empty()) {
+      continue;
+    }
+    llvh::StringRef segment, rest;
+    std::tie(segment, rest) = line.split(':');
+    BytecodeLayoutProfile::ExecutedFunction executed;
+    if (segment.getAsInteger(10, executed.segmentID) ||
+        rest.split(':').first.getAsInteger(10, executed.virtualOffset)) {
+      llvh::errs() << "Invalid layout profile entry: " << line << '\n';
+      return nullptr;
+    }
+    profile->executedFunctions.push_back(executed);
+  }
+  return profile;
+}
+
 /// Read a resolution table. Given a file name, it maps every require string
 /// to the actual file which must be required.
 /// Prints out error messages to stderr in case of failure.
@@ -2061,6 +2158,14 @@ CompileResult processSourceFiles(
 
   genOptions.stripFunctionNames = cl::StripFunctionNames;
 
+  if (!cl::LayoutProfile.empty()) {
+    genOptions.layoutProfile =
+        readLayoutProfile(cl::LayoutProfile, context->getAllocator());
+    if (!genOptions.layoutProfile) {
+      return InputFileError;
+    }
+  }
+
   // If the dump target is None, return bytecode in an executable form.
   if (cl::DumpTarget == Execute) {
     assert(
@@ -8,6 +8,7 @@
 #include "hermes/Regex/Executor.h"
 #include "hermes/Regex/RegexTraits.h"
 #include "hermes/Support/OptValue.h"
+#include "hermes/Support/StringKernels.h"
 
 #include "llvh/ADT/SmallVector.h"
 #include "llvh/Support/TrailingObjects.h"
@@ -400,6 +401,18 @@ struct Context {
   /// This is effectively a timeout on the regexp execution.
   uint32_t backtracksRemaining_ = kBacktrackLimit;
 
+  /// A literal that every match contains at anchoredLiteralOffset_ code units
+  /// from its start, or empty if there is none.
+  llvh::SmallVector<CodeUnit, 16> anchoredLiteral_;
+  uint32_t anchoredLiteralOffset_ = 0;
+
+  /// A literal that every match contains somewhere, or empty if there is none.
+  llvh::SmallVector<CodeUnit, 16> floatingLiteral_;
+
+  /// The first occurrence of floatingLiteral_ found so far, or nullptr if we
+  /// have not searched for it yet.
+  const CodeUnit *floatingLiteralPosition_ = nullptr;
+
   Context(
       llvh::ArrayRef<uint8_t> bytecodeStream,
       constants::MatchFlagType flags,
@@ -416,6 +429,9 @@ struct Context {
         markedCount_(markedCount),
         loopCount_(loopCount) {}
 
+  /// Load the literals that every match contains from the bytecode header.
+  void loadLiterals();
+
   /// Run the given State \p state, by starting at its cursor and acting on its
   /// ip_ until the match succeeds or fails. If \p onlyAtStart is set, only
   /// test the match at \pos; otherwise test all successive input positions from
@@ -504,6 +520,13 @@ struct Context {
       const CodeUnit *start,
       size_t index,
       size_t lastIndex) const;
+
+  /// \return the first index at or after \p index, relative to \p start,
+  /// where a match could start given the literals that every match contains,
+  /// or SIZE_MAX if there is none. \p length is the number of code units
+  /// following \p start.
+  inline size_t
+  nextCandidateIndex(const CodeUnit *start, size_t index, size_t length);
 };
 
 /// We store loop and captured range data contiguously in a single allocation at
@@ -958,6 +981,76 @@ inline size_t Context<Traits>::advanceStringIndex(
   return index + 2;
 }
 
+template <class Traits>
+void Context<Traits>::loadLiterals() {
+  auto header =
+      reinterpret_cast<const RegexBytecodeHeader *>(bytecodeStream_.data());
+  auto load = [](const uint8_t *bytes,
+                 uint16_t length,
+                 llvh::SmallVectorImpl<CodeUnit> &out) {
+    for (uint16_t i = 0; i < length; ++i) {
+      // The literals are not necessarily aligned.
+      char16_t unit;
+      std::memcpy(&unit, bytes + i * sizeof(unit), sizeof(unit));
+      // An ASCII string holds the literal only if it is ASCII too. Rather than
+      // reasoning about how other characters compare, don't use the literal.
+      if (sizeof(CodeUnit) == 1 && !isASCII(unit)) {
+        out.clear();
+        return;
+      }
+      out.push_back(static_cast<CodeUnit>(unit));
+    }
+  };
+  const uint8_t *anchoredBytes =
+      bytecodeStream_.data() + sizeof(RegexBytecodeHeader);
+  load(anchoredBytes, header->anchoredLiteralLength, anchoredLiteral_);
+  anchoredLiteralOffset_ = header->anchoredLiteralOffset;
+  load(
+      anchoredBytes + header->anchoredLiteralLength * sizeof(char16_t),
+      header->floatingLiteralLength,
+      floatingLiteral_);
+}
+
+template <class Traits>
+inline size_t Context<Traits>::nextCandidateIndex(
+    const CodeUnit *start,
+    size_t index,
+    size_t length) {
+  const CodeUnit *const end = start + length;
+  for (;;) {
+    if (!anchoredLiteral_.empty()) {
+      if (length - index < anchoredLiteralOffset_ + anchoredLiteral_.size())
+        return SIZE_MAX;
+      const CodeUnit *found = findSubstring(
+          start + index + anchoredLiteralOffset_, end, anchoredLiteral_);
+      if (found == end)
+        return SIZE_MAX;
+      index = found - start - anchoredLiteralOffset_;
+    }
+
+    // advanceStringIndex() never stops between the halves of a surrogate
+    // pair, so neither may we.
+    if (sizeof(CodeUnit) > 1 && syntaxFlags_.unicode && index > 0 &&
+        index < length && isHighSurrogate(start[index - 1]) &&
+        isLowSurrogate(start[index])) {
+      ++index;
+      continue;
+    }
+
+    // The floating literal must occur at or after the start of the match.
+    if (!floatingLiteral_.empty() &&
+        (!floatingLiteralPosition_ ||
+         floatingLiteralPosition_ < start + index)) {
+      const CodeUnit *found =
+          findSubstring(start + index, end, floatingLiteral_);
+      if (found == end)
+        return SIZE_MAX;
+      floatingLiteralPosition_ = found;
+    }
+    return index;
+  }
+}
+
 template <class Traits>
 auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
     -> ExecutorResult<const CodeUnit *> {
@@ -967,8 +1060,12 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
   // We'll refer to the cursor often.
   Cursor<Traits> &c = s->cursor_;
 
-  // Pull out the instruction portion of the bytecode, following the header.
-  const uint8_t *const bytecode = &bytecodeStream_[sizeof(RegexBytecodeHeader)];
+  // Pull out the instruction portion of the bytecode, following the header
+  // and literals.
+  const uint8_t *const bytecode =
+      &bytecodeStream_[reinterpret_cast<const RegexBytecodeHeader *>(
+                           bytecodeStream_.data())
+                           ->instructionsOffset()];
 
   // Save the incoming IP in case we have to loop.
   const auto startIp = s->ip_;
@@ -990,6 +1087,10 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
       (c.forwards() || locsToCheckCount == 1) &&
       "Can only check one location when cursor is backwards");
 
+  // Whether to skip locations which lack the literals every match contains.
+  const bool skipToLiterals = !onlyAtStart &&
+      (!anchoredLiteral_.empty() || !floatingLiteral_.empty());
+
   // Macro used when a state fails to match.
 #define BACKTRACK()                            \
   do {                                         \
@@ -1003,6 +1104,11 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
 
   for (size_t locIndex = 0; locIndex < locsToCheckCount;
        locIndex = advanceStringIndex(startLoc, locIndex, charsToRight)) {
+    if (skipToLiterals) {
+      locIndex = nextCandidateIndex(startLoc, locIndex, charsToRight);
+      if (locIndex >= locsToCheckCount)
+        break;
+    }
     const CodeUnit *potentialMatchLocation = startLoc + locIndex;
     c.setCurrentPointer(potentialMatchLocation);
     s->ip_ = startIp;
@@ -1536,6 +1642,7 @@ MatchRuntimeResult searchWithBytecodeImpl(
       first + length,
       header->markedCount,
       header->loopCount);
+  ctx.loadLiterals();
   State<Traits> state{cursor, markedCount, loopCount};
 
   // We check only one location if either the regex pattern constrains us to, or
@@ -0,0 +1,964 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Regex/NFA.h"
+#include "hermes/Regex/RegexTraits.h"
+
+#include "llvh/Support/ErrorHandling.h"
+
+#include <algorithm>
+#include <map>
+
+namespace hermes {
+namespace regex {
+
+namespace {
+
+/// Programs which would need more instructions than this, typically because
+/// of large counted loops like /(ab){1000}/, are left to the backtracking
+/// executor.
+constexpr uint32_t kMaxInstructions = 10000;
+
+/// ES5.1 7.3
+template <class CodePoint>
+bool isLineTerminator(CodePoint c) {
+  return c == u'\u000A' || c == u'\u000D' || c == u'\u2028' || c == u'\u2029';
+}
+
+/// \return whether the consuming instruction \p insn of \p program matches the
+/// code unit \p c.
+template <class Traits>
+bool matchesCodeUnit(
+    const NFAProgram &program,
+    const Traits &traits,
+    const NFAInsn &insn,
+    typename Traits::CodePoint c) {
+  switch (insn.op) {
+    case NFAInsn::Char:
+      return c == insn.x;
+    case NFAInsn::CharICase:
+      return c == insn.x ||
+          (uint32_t)Traits::canonicalize(c, false /* unicode */) == insn.x;
+    case NFAInsn::Any:
+      return true;
+    case NFAInsn::AnyButNewline:
+      return !isLineTerminator(c);
+    case NFAInsn::Bracket: {
+      // This mirrors bracketMatchesChar() in the backtracking executor.
+      if (insn.positiveCharClasses || insn.negativeCharClasses) {
+        for (auto charClass :
+             {CharacterClass::Digits,
+              CharacterClass::Spaces,
+              CharacterClass::Words}) {
+          if ((insn.positiveCharClasses & charClass) &&
+              traits.characterHasType(c, charClass))
+            return !insn.invert;
+          if ((insn.negativeCharClasses & charClass) &&
+              !traits.characterHasType(c, charClass))
+            return !insn.invert;
+        }
+      }
+      return traits.rangesContain(program.bracketRanges(insn), c) ^
+          insn.invert;
+    }
+    default:
+      llvm_unreachable("Instruction does not consume input");
+  }
+}
+
+/// A set of instruction indices which can be cleared in constant time.
+class SparseSet {
+  std::vector<uint32_t> sparse_;
+  std::vector<uint32_t> dense_;
+
+ public:
+  explicit SparseSet(uint32_t capacity) : sparse_(capacity) {
+    dense_.reserve(capacity);
+  }
+
+  bool contains(uint32_t pc) const {
+    uint32_t idx = sparse_[pc];
+    return idx < dense_.size() && dense_[idx] == pc;
+  }
+
+  /// Insert \p pc. \return false if it was already present.
+  bool insert(uint32_t pc) {
+    if (contains(pc))
+      return false;
+    sparse_[pc] = dense_.size();
+    dense_.push_back(pc);
+    return true;
+  }
+
+  void clear() {
+    dense_.clear();
+  }
+};
+
+} // namespace
+
+//===----------------------------------------------------------------------===//
+// NFACompiler
+
+/// Translates regex bytecode into an NFAProgram. The bytecode is structured:
+/// the body of every alternation and loop is a contiguous range of
+/// instructions, so it can be compiled recursively, once per copy needed.
+class NFACompiler {
+ public:
+  NFACompiler(NFAProgram &program, const uint8_t *insns)
+      : program_(program), insns_(insns) {}
+
+  /// Compile the bytecode instructions in the range [ip, end).
+  /// \return false if they cannot be expressed as an NFA.
+  bool compileRange(uint32_t ip, uint32_t end);
+
+ private:
+  /// Append an instruction. \return its index.
+  uint32_t emit(NFAInsn::Op op, uint32_t x = 0, uint32_t y = 0) {
+    program_.insns_.push_back(NFAInsn{op, false, 0, 0, x, y});
+    return program_.insns_.size() - 1;
+  }
+
+  /// Emit an instruction clearing the capture groups [mexpBegin, mexpEnd),
+  /// if there are any.
+  void emitResetCaptures(uint16_t mexpBegin, uint16_t mexpEnd) {
+    if (mexpBegin != mexpEnd)
+      emit(NFAInsn::ResetCaptures, 2 + 2 * mexpBegin, 2 + 2 * mexpEnd);
+  }
+
+  /// Compile a loop over the bytecode in [bodyIp, bodyEnd), by emitting \p
+  /// min copies of the body followed by either a starred copy or max - min
+  /// optional copies. Each iteration clears the capture groups [mexpBegin,
+  /// mexpEnd) before running the body.
+  bool compileLoop(
+      uint32_t bodyIp,
+      uint32_t bodyEnd,
+      uint32_t min,
+      uint32_t max,
+      bool greedy,
+      uint16_t mexpBegin = 0,
+      uint16_t mexpEnd = 0);
+
+  /// \return whether the program has grown past kMaxInstructions.
+  bool tooLarge() const {
+    return program_.insns_.size() > kMaxInstructions;
+  }
+
+  template <typename Instruction>
+  const Instruction *insnAt(uint32_t ip) const {
+    return llvh::cast<Instruction>(
+        reinterpret_cast<const Insn *>(insns_ + ip));
+  }
+
+  NFAProgram &program_;
+
+  /// The bytecode instructions, following the header and literals.
+  const uint8_t *insns_;
+
+  /// Number of loops which may iterate more than once enclosing the
+  /// instruction being compiled.
+  unsigned loopDepth_ = 0;
+};
+
+bool NFACompiler::compileLoop(
+    uint32_t bodyIp,
+    uint32_t bodyEnd,
+    uint32_t min,
+    uint32_t max,
+    bool greedy,
+    uint16_t mexpBegin,
+    uint16_t mexpEnd) {
+  // Backtracking over a loop which may iterate a variable number of times
+  // with a body that has choices of its own is what makes matching
+  // exponential.
+  bool repeats = max > 1 && max != min;
+  if (repeats && loopDepth_ > 0)
+    program_.backtrackingIsRisky_ = true;
+  loopDepth_ += repeats;
+
+  auto compileBody = [&]() {
+    emitResetCaptures(mexpBegin, mexpEnd);
+    return compileRange(bodyIp, bodyEnd);
+  };
+
+  bool success = true;
+  for (uint32_t i = 0; success && i < min; ++i)
+    success = compileBody() && !tooLarge();
+
+  if (success && max == UINT32_MAX) {
+    // split -> body, exit
+    // body...
+    // jump split
+    uint32_t split = emit(NFAInsn::Split);
+    success = compileBody();
+    emit(NFAInsn::Jump, split);
+    uint32_t exit = program_.insns_.size();
+    NFAInsn &insn = program_.insns_[split];
+    insn.x = greedy ? split + 1 : exit;
+    insn.y = greedy ? exit : split + 1;
+  } else if (success && max > min) {
+    // Each optional iteration may exit the whole loop.
+    llvh::SmallVector<uint32_t, 4> splits;
+    for (uint32_t i = min; success && i < max; ++i) {
+      splits.push_back(emit(NFAInsn::Split));
+      success = compileBody() && !tooLarge();
+    }
+    uint32_t exit = program_.insns_.size();
+    for (uint32_t split : splits) {
+      NFAInsn &insn = program_.insns_[split];
+      insn.x = greedy ? split + 1 : exit;
+      insn.y = greedy ? exit : split + 1;
+    }
+  }
+
+  loopDepth_ -= repeats;
+  return success;
+}
+
+bool NFACompiler::compileRange(uint32_t ip, uint32_t end) {
+  while (ip < end) {
+    if (tooLarge())
+      return false;
+    const Insn *base = reinterpret_cast<const Insn *>(insns_ + ip);
+    switch (base->opcode) {
+      case Opcode::Goal:
+        emit(NFAInsn::Match);
+        ip += sizeof(GoalInsn);
+        break;
+      case Opcode::LeftAnchor:
+        emit(NFAInsn::LeftAnchor);
+        program_.dfaCompatible_ &= !program_.multiline_;
+        ip += sizeof(LeftAnchorInsn);
+        break;
+      case Opcode::RightAnchor:
+        emit(NFAInsn::RightAnchor);
+        program_.dfaCompatible_ &= !program_.multiline_;
+        ip += sizeof(RightAnchorInsn);
+        break;
+      case Opcode::WordBoundary: {
+        const auto *insn = insnAt<WordBoundaryInsn>(ip);
+        program_.insns_[emit(NFAInsn::WordBoundary)].invert = insn->invert;
+        program_.dfaCompatible_ = false;
+        ip += sizeof(WordBoundaryInsn);
+        break;
+      }
+      case Opcode::MatchAny:
+        emit(NFAInsn::Any);
+        ip += sizeof(MatchAnyInsn);
+        break;
+      case Opcode::MatchAnyButNewline:
+        emit(NFAInsn::AnyButNewline);
+        ip += sizeof(MatchAnyButNewlineInsn);
+        break;
+      case Opcode::MatchChar8:
+        emit(NFAInsn::Char, (uint8_t)insnAt<MatchChar8Insn>(ip)->c);
+        ip += sizeof(MatchChar8Insn);
+        break;
+      case Opcode::MatchChar16:
+        emit(NFAInsn::Char, insnAt<MatchChar16Insn>(ip)->c);
+        ip += sizeof(MatchChar16Insn);
+        break;
+      case Opcode::MatchCharICase8:
+        emit(NFAInsn::CharICase, (uint8_t)insnAt<MatchCharICase8Insn>(ip)->c);
+        ip += sizeof(MatchCharICase8Insn);
+        break;
+      case Opcode::MatchCharICase16:
+        emit(NFAInsn::CharICase, insnAt<MatchCharICase16Insn>(ip)->c);
+        ip += sizeof(MatchCharICase16Insn);
+        break;
+      case Opcode::MatchNChar8: {
+        const auto *insn = insnAt<MatchNChar8Insn>(ip);
+        auto chars = reinterpret_cast<const uint8_t *>(insn + 1);
+        for (uint8_t i = 0; i < insn->charCount; ++i)
+          emit(NFAInsn::Char, chars[i]);
+        ip += insn->totalWidth();
+        break;
+      }
+      case Opcode::MatchNCharICase8: {
+        const auto *insn = insnAt<MatchNCharICase8Insn>(ip);
+        auto chars = reinterpret_cast<const uint8_t *>(insn + 1);
+        for (uint8_t i = 0; i < insn->charCount; ++i)
+          emit(NFAInsn::CharICase, chars[i]);
+        ip += insn->totalWidth();
+        break;
+      }
+      case Opcode::Bracket: {
+        const auto *insn = insnAt<BracketInsn>(ip);
+        auto ranges = reinterpret_cast<const BracketRange32 *>(insn + 1);
+        NFAInsn &nfaInsn = program_.insns_[emit(
+            NFAInsn::Bracket, program_.ranges_.size(), insn->rangeCount)];
+        nfaInsn.invert = insn->negate;
+        nfaInsn.positiveCharClasses = insn->positiveCharClasses;
+        nfaInsn.negativeCharClasses = insn->negativeCharClasses;
+        program_.ranges_.insert(
+            program_.ranges_.end(), ranges, ranges + insn->rangeCount);
+        ip += insn->totalWidth();
+        break;
+      }
+      case Opcode::BeginMarkedSubexpression:
+        emit(
+            NFAInsn::Save,
+            2 + 2 * insnAt<BeginMarkedSubexpressionInsn>(ip)->mexp);
+        ip += sizeof(BeginMarkedSubexpressionInsn);
+        break;
+      case Opcode::EndMarkedSubexpression:
+        emit(
+            NFAInsn::Save,
+            3 + 2 * insnAt<EndMarkedSubexpressionInsn>(ip)->mexp);
+        ip += sizeof(EndMarkedSubexpressionInsn);
+        break;
+      case Opcode::Alternation: {
+        // [Alternation][Primary][Jump32][Secondary][...]
+        // The secondary branch ends where the Jump32 goes.
+        const auto *insn = insnAt<AlternationInsn>(ip);
+        uint32_t jumpIp = insn->secondaryBranch - sizeof(Jump32Insn);
+        uint32_t continuation = insnAt<Jump32Insn>(jumpIp)->target;
+        if (loopDepth_ > 0)
+          program_.backtrackingIsRisky_ = true;
+        uint32_t split = emit(NFAInsn::Split);
+        if (!compileRange(ip + sizeof(AlternationInsn), jumpIp))
+          return false;
+        uint32_t jump = emit(NFAInsn::Jump);
+        program_.insns_[split].x = split + 1;
+        program_.insns_[split].y = program_.insns_.size();
+        if (!compileRange(insn->secondaryBranch, continuation))
+          return false;
+        program_.insns_[jump].x = program_.insns_.size();
+        ip = continuation;
+        break;
+      }
+      case Opcode::BeginLoop: {
+        const auto *insn = insnAt<BeginLoopInsn>(ip);
+        // Once the minimum is reached, iterations which match the empty
+        // string are rejected. The NFA does not track loop entry positions,
+        // so only accept loops whose optional iterations cannot be empty.
+        if (insn->max > insn->min &&
+            !(insn->loopeeConstraints & MatchConstraintNonEmpty))
+          return false;
+        if (!compileLoop(
+                ip + sizeof(BeginLoopInsn),
+                insn->notTakenTarget - sizeof(EndLoopInsn),
+                insn->min,
+                insn->max,
+                insn->greedy,
+                insn->mexpBegin,
+                insn->mexpEnd))
+          return false;
+        ip = insn->notTakenTarget;
+        break;
+      }
+      case Opcode::BeginSimpleLoop: {
+        const auto *insn = insnAt<BeginSimpleLoopInsn>(ip);
+        if (!compileLoop(
+                ip + sizeof(BeginSimpleLoopInsn),
+                insn->notTakenTarget - sizeof(EndSimpleLoopInsn),
+                0,
+                UINT32_MAX,
+                true /* greedy */))
+          return false;
+        ip = insn->notTakenTarget;
+        break;
+      }
+      case Opcode::Width1Loop: {
+        const auto *insn = insnAt<Width1LoopInsn>(ip);
+        if (!compileLoop(
+                ip + sizeof(Width1LoopInsn),
+                insn->notTakenTarget,
+                insn->min,
+                insn->max,
+                insn->greedy))
+          return false;
+        ip = insn->notTakenTarget;
+        break;
+      }
+      case Opcode::BackRef:
+      case Opcode::Lookaround:
+      case Opcode::U16MatchAny:
+      case Opcode::U16MatchAnyButNewline:
+      case Opcode::U16MatchChar32:
+      case Opcode::U16MatchCharICase32:
+      case Opcode::U16Bracket:
+        return false;
+      case Opcode::Jump32:
+      case Opcode::EndLoop:
+      case Opcode::EndSimpleLoop:
+        llvm_unreachable("Jumps are handled with their enclosing construct");
+    }
+  }
+  return !tooLarge();
+}
+
+std::unique_ptr<NFAProgram> NFAProgram::fromBytecode(
+    llvh::ArrayRef<uint8_t> bytecode) {
+  assert(
+      bytecode.size() >= sizeof(RegexBytecodeHeader) && "Bytecode too small");
+  auto header = reinterpret_cast<const RegexBytecodeHeader *>(bytecode.data());
+  auto syntaxFlags = SyntaxFlags::fromByte(header->syntaxFlags);
+  // Unicode regexps match code points rather than code units.
+  if (syntaxFlags.unicode)
+    return nullptr;
+
+  std::unique_ptr<NFAProgram> program{new NFAProgram()};
+  program->markedCount_ = header->markedCount;
+  program->constraints_ = header->constraints;
+  program->multiline_ = syntaxFlags.multiline;
+
+  uint32_t offset = header->instructionsOffset();
+  NFACompiler compiler{*program, bytecode.data() + offset};
+  if (!compiler.compileRange(0, bytecode.size() - offset))
+    return nullptr;
+  program->insns_.shrink_to_fit();
+  program->ranges_.shrink_to_fit();
+  return program;
+}
+
+//===----------------------------------------------------------------------===//
+// LazyDFA
+
+/// A DFA which is built from an NFAProgram on demand, one state and
+/// transition at a time, as the input requires them. Each state is the set of
+/// NFA instructions that threads could be waiting at. The DFA only decides
+/// whether there is a match, and is used to reject inputs quickly; finding the
+/// bounds of the match and its captures is left to the PikeVM.
+/// The DFA does not support assertions other than non-multiline anchors.
+class LazyDFA {
+ public:
+  enum class Result {
+    Match,
+    NoMatch,
+    /// The DFA had too many states.
+    GaveUp,
+  };
+
+  /// Create a DFA for \p program. If \p anchored is set, only matches starting
+  /// at the search start position are considered.
+  LazyDFA(const NFAProgram &program, bool anchored)
+      : program_(program),
+        anchored_(anchored),
+        visited_(program.insns().size()) {}
+
+  /// Search the input [first, first + length) starting at \p start for a
+  /// match, using \p traits for matching characters. \p length must be
+  /// nonzero.
+  template <class Traits>
+  Result search(
+      const Traits &traits,
+      const typename Traits::CodeUnit *first,
+      uint32_t start,
+      uint32_t length);
+
+  size_t getAllocatedSize() const {
+    size_t size = states_.capacity() * sizeof(State);
+    for (const State &state : states_)
+      size += state.pcs.capacity() * sizeof(uint32_t);
+    return size;
+  }
+
+ private:
+  /// Number of states at which the cache is flushed.
+  static constexpr uint32_t kMaxStates = 256;
+
+  /// Number of flushes in a single search after which the DFA gives up.
+  static constexpr uint32_t kMaxFlushes = 8;
+
+  static constexpr uint32_t kUnknown = UINT32_MAX;
+
+  struct State {
+    /// The consuming, RightAnchor and Match instructions that threads may be
+    /// waiting at, sorted.
+    std::vector<uint32_t> pcs;
+
+    /// Whether a thread has matched.
+    bool match = false;
+
+    /// Whether the state matches at the end of the input, or -1 if unknown.
+    int8_t matchesAtEnd = -1;
+
+    /// Next states on ASCII code units, or kUnknown.
+    uint32_t next[128];
+
+    explicit State(std::vector<uint32_t> &&pcs) : pcs(std::move(pcs)) {
+      std::fill(std::begin(next), std::end(next), kUnknown);
+    }
+  };
+
+  /// Add the instructions reachable from \p pc without consuming input to
+  /// \p pcs. \p atStart and \p atEnd tell whether we are at the start or end
+  /// of the input.
+  void addClosure(
+      uint32_t pc,
+      bool atStart,
+      bool atEnd,
+      std::vector<uint32_t> &pcs);
+
+  /// \return the index of the state for \p pcs, creating it if needed.
+  uint32_t intern(std::vector<uint32_t> &&pcs);
+
+  /// \return the state reached from \p state on the code unit \p c.
+  template <class Traits>
+  uint32_t computeNext(
+      const Traits &traits,
+      uint32_t state,
+      typename Traits::CodePoint c);
+
+  /// \return whether \p state matches at the end of the input.
+  bool matchesAtEnd(uint32_t state);
+
+  /// Drop all states, retaining only \p state. \return its new index.
+  uint32_t flush(uint32_t state);
+
+  const NFAProgram &program_;
+  const bool anchored_;
+
+  std::vector<State> states_;
+  std::map<std::vector<uint32_t>, uint32_t> index_;
+
+  /// Start states for searches starting elsewhere and at the start of the
+  /// input, respectively.
+  uint32_t startStates_[2] = {kUnknown, kUnknown};
+
+  /// Scratch space for computing closures.
+  SparseSet visited_;
+  std::vector<uint32_t> stack_;
+};
+
+void LazyDFA::addClosure(
+    uint32_t pc,
+    bool atStart,
+    bool atEnd,
+    std::vector<uint32_t> &pcs) {
+  auto insns = program_.insns();
+  stack_.push_back(pc);
+  while (!stack_.empty()) {
+    pc = stack_.back();
+    stack_.pop_back();
+    while (visited_.insert(pc)) {
+      const NFAInsn &insn = insns[pc];
+      if (insn.op == NFAInsn::Split) {
+        stack_.push_back(insn.y);
+        pc = insn.x;
+      } else if (insn.op == NFAInsn::Jump) {
+        pc = insn.x;
+      } else if (
+          insn.op == NFAInsn::Save || insn.op == NFAInsn::ResetCaptures ||
+          (insn.op == NFAInsn::LeftAnchor && atStart) ||
+          (insn.op == NFAInsn::RightAnchor && atEnd)) {
+        pc++;
+      } else if (insn.op == NFAInsn::LeftAnchor) {
+        break;
+      } else {
+        // Consuming instructions, Match, and a RightAnchor which may yet
+        // match at the end of the input.
+        assert(insn.op != NFAInsn::WordBoundary && "Not DFA compatible");
+        pcs.push_back(pc);
+        break;
+      }
+    }
+  }
+}
+
+uint32_t LazyDFA::intern(std::vector<uint32_t> &&pcs) {
+  std::sort(pcs.begin(), pcs.end());
+  auto it = index_.find(pcs);
+  if (it != index_.end())
+    return it->second;
+  uint32_t idx = states_.size();
+  index_.emplace(pcs, idx);
+  auto insns = program_.insns();
+  bool match = std::any_of(pcs.begin(), pcs.end(), [insns](uint32_t pc) {
+    return insns[pc].op == NFAInsn::Match;
+  });
+  states_.emplace_back(std::move(pcs));
+  states_.back().match = match;
+  return idx;
+}
+
+template <class Traits>
+uint32_t LazyDFA::computeNext(
+    const Traits &traits,
+    uint32_t state,
+    typename Traits::CodePoint c) {
+  auto insns = program_.insns();
+  std::vector<uint32_t> pcs;
+  visited_.clear();
+  for (uint32_t pc : states_[state].pcs) {
+    const NFAInsn &insn = insns[pc];
+    if (insn.consumes() && matchesCodeUnit(program_, traits, insn, c))
+      addClosure(pc + 1, false, false, pcs);
+  }
+  // An unanchored search may start a new thread at every position.
+  if (!anchored_)
+    addClosure(0, false, false, pcs);
+  return intern(std::move(pcs));
+}
+
+bool LazyDFA::matchesAtEnd(uint32_t state) {
+  State &s = states_[state];
+  if (s.matchesAtEnd < 0) {
+    auto insns = program_.insns();
+    std::vector<uint32_t> pcs;
+    visited_.clear();
+    for (uint32_t pc : s.pcs) {
+      if (insns[pc].op == NFAInsn::RightAnchor)
+        addClosure(pc + 1, false, true, pcs);
+    }
+    s.matchesAtEnd = std::any_of(pcs.begin(), pcs.end(), [insns](uint32_t pc) {
+      return insns[pc].op == NFAInsn::Match;
+    });
+  }
+  return s.matchesAtEnd;
+}
+
+uint32_t LazyDFA::flush(uint32_t state) {
+  std::vector<uint32_t> pcs = std::move(states_[state].pcs);
+  states_.clear();
+  index_.clear();
+  startStates_[0] = startStates_[1] = kUnknown;
+  return intern(std::move(pcs));
+}
+
+template <class Traits>
+LazyDFA::Result LazyDFA::search(
+    const Traits &traits,
+    const typename Traits::CodeUnit *first,
+    uint32_t start,
+    uint32_t length) {
+  using CodePoint = typename Traits::CodePoint;
+  assert(length > 0 && "The DFA does not handle empty inputs");
+  uint32_t &startState = startStates_[start == 0];
+  if (startState == kUnknown) {
+    std::vector<uint32_t> pcs;
+    visited_.clear();
+    addClosure(0, start == 0, false, pcs);
+    startState = intern(std::move(pcs));
+  }
+
+  uint32_t cur = startState;
+  uint32_t flushes = 0;
+  for (uint32_t pos = start; pos < length; ++pos) {
+    if (states_[cur].match)
+      return Result::Match;
+    // Anchored searches can end early once every thread has died.
+    if (anchored_ && states_[cur].pcs.empty())
+      return Result::NoMatch;
+    CodePoint c = (CodePoint)first[pos];
+    uint32_t next = c < 128 ? states_[cur].next[c] : kUnknown;
+    if (next == kUnknown) {
+      if (states_.size() >= kMaxStates) {
+        if (++flushes > kMaxFlushes)
+          return Result::GaveUp;
+        cur = flush(cur);
+      }
+      next = computeNext(traits, cur, c);
+      if (c < 128)
+        states_[cur].next[c] = next;
+    }
+    cur = next;
+  }
+  return states_[cur].match || matchesAtEnd(cur) ? Result::Match
+                                                  : Result::NoMatch;
+}
+
+NFAProgram::~NFAProgram() = default;
+
+size_t NFAProgram::getAllocatedSize() const {
+  size_t size = insns_.capacity() * sizeof(NFAInsn) +
+      ranges_.capacity() * sizeof(BracketRange32);
+  if (anchoredDFA_)
+    size += anchoredDFA_->getAllocatedSize();
+  if (unanchoredDFA_)
+    size += unanchoredDFA_->getAllocatedSize();
+  return size;
+}
+
+//===----------------------------------------------------------------------===//
+// PikeVM
+
+/// Runs an NFAProgram over an input by advancing all threads in lock step, one
+/// code unit at a time. Threads are kept in priority order and at most one
+/// thread may wait at each instruction, so the first thread to match is the
+/// one the backtracking executor would have found, and the running time is
+/// proportional to the input length times the program size.
+template <class Traits>
+class PikeVM {
+  using CodeUnit = typename Traits::CodeUnit;
+  using CodePoint = typename Traits::CodePoint;
+
+ public:
+  PikeVM(
+      const NFAProgram &program,
+      const CodeUnit *first,
+      uint32_t length,
+      constants::MatchFlagType flags)
+      : program_(program),
+        insns_(program.insns()),
+        first_(first),
+        length_(length),
+        flags_(flags),
+        numSlots_(2 + 2 * program.markedCount()),
+        lists_{ThreadList(insns_.size()), ThreadList(insns_.size())} {}
+
+  /// Search for the leftmost match starting at or after \p start, or only at
+  /// \p start if \p onlyAtStart is set. \return whether a match was found,
+  /// and if so, populate \p captures with the match and its capture groups.
+  bool search(
+      uint32_t start,
+      bool onlyAtStart,
+      std::vector<CapturedRange> *captures);
+
+ private:
+  /// Threads at one position of the input.
+  struct ThreadList {
+    /// Instructions already reached at this position. A lower priority thread
+    /// reaching one of these has the same future as the thread that got
+    /// there first, so it is dropped.
+    SparseSet visited;
+
+    /// The consuming or Match instruction each thread is waiting at, in
+    /// priority order.
+    std::vector<uint32_t> pcs;
+
+    /// The capture slots of each thread, numSlots_ per thread.
+    std::vector<uint32_t> slots;
+
+    explicit ThreadList(uint32_t size) : visited(size) {}
+
+    void clear() {
+      visited.clear();
+      pcs.clear();
+      slots.clear();
+    }
+  };
+
+  /// A pending step while adding a thread: either following the instruction
+  /// pc, or restoring a capture slot to value after a branch is explored.
+  struct Job {
+    uint32_t pc;
+    uint32_t slot;
+    uint32_t value;
+  };
+  static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+  /// \return whether the assertion \p insn holds at \p pos.
+  bool assertionHolds(const NFAInsn &insn, uint32_t pos) const;
+
+  /// Add threads to \p list for every consuming or Match instruction reachable
+  /// from \p pc at position \p pos, in priority order, with the capture slots
+  /// \p slots. \p slots is restored before returning.
+  void addThreads(
+      ThreadList &list,
+      uint32_t pc,
+      uint32_t pos,
+      std::vector<uint32_t> &slots);
+
+  const NFAProgram &program_;
+  llvh::ArrayRef<NFAInsn> insns_;
+  const CodeUnit *const first_;
+  const uint32_t length_;
+  const constants::MatchFlagType flags_;
+  const uint32_t numSlots_;
+  Traits traits_;
+
+  ThreadList lists_[2];
+  std::vector<Job> stack_;
+};
+
+template <class Traits>
+bool PikeVM<Traits>::assertionHolds(const NFAInsn &insn, uint32_t pos) const {
+  // These mirror the backtracking executor.
+  switch (insn.op) {
+    case NFAInsn::LeftAnchor:
+      return pos == 0 ||
+          (program_.multiline() && isLineTerminator(first_[pos - 1]));
+    case NFAInsn::RightAnchor:
+      if (pos == length_)
+        return !(flags_ & constants::matchNotEndOfLine);
+      return program_.multiline() && isLineTerminator(first_[pos]);
+    case NFAInsn::WordBoundary: {
+      bool prevIsWordchar = pos > 0 &&
+          traits_.characterHasType(
+              (CodePoint)first_[pos - 1], CharacterClass::Words);
+      bool currentIsWordchar = pos < length_ &&
+          traits_.characterHasType(
+              (CodePoint)first_[pos], CharacterClass::Words);
+      return (prevIsWordchar != currentIsWordchar) ^ insn.invert;
+    }
+    default:
+      llvm_unreachable("Not an assertion");
+  }
+}
+
+template <class Traits>
+void PikeVM<Traits>::addThreads(
+    ThreadList &list,
+    uint32_t pc,
+    uint32_t pos,
+    std::vector<uint32_t> &slots) {
+  stack_.push_back({pc, kNoSlot, 0});
+  while (!stack_.empty()) {
+    Job job = stack_.back();
+    stack_.pop_back();
+    if (job.slot != kNoSlot) {
+      slots[job.slot] = job.value;
+      continue;
+    }
+    // Follow the preferred path first, deferring alternatives to the stack
+    // so that they are explored once it is exhausted.
+    for (pc = job.pc; list.visited.insert(pc);) {
+      const NFAInsn &insn = insns_[pc];
+      if (insn.op == NFAInsn::Split) {
+        stack_.push_back({insn.y, kNoSlot, 0});
+        pc = insn.x;
+      } else if (insn.op == NFAInsn::Jump) {
+        pc = insn.x;
+      } else if (insn.op == NFAInsn::Save) {
+        stack_.push_back({0, insn.x, slots[insn.x]});
+        slots[insn.x] = pos;
+        pc++;
+      } else if (insn.op == NFAInsn::ResetCaptures) {
+        for (uint32_t slot = insn.x; slot < insn.y; ++slot) {
+          stack_.push_back({0, slot, slots[slot]});
+          slots[slot] = kNotMatched;
+        }
+        pc++;
+      } else if (!insn.consumes() && insn.op != NFAInsn::Match) {
+        if (!assertionHolds(insn, pos))
+          break;
+        pc++;
+      } else {
+        list.pcs.push_back(pc);
+        list.slots.insert(list.slots.end(), slots.begin(), slots.end());
+        break;
+      }
+    }
+  }
+}
+
+template <class Traits>
+bool PikeVM<Traits>::search(
+    uint32_t start,
+    bool onlyAtStart,
+    std::vector<CapturedRange> *captures) {
+  ThreadList *cur = &lists_[0];
+  ThreadList *next = &lists_[1];
+  cur->clear();
+  std::vector<uint32_t> slots(numSlots_);
+  std::vector<uint32_t> matchSlots;
+
+  for (uint32_t pos = start;; ++pos) {
+    // Start a thread at this position, with the lowest priority, unless a
+    // higher priority thread has already matched.
+    if (matchSlots.empty() && (pos == start || !onlyAtStart)) {
+      std::fill(slots.begin(), slots.end(), kNotMatched);
+      slots[0] = pos;
+      addThreads(*cur, 0, pos, slots);
+    }
+
+    next->clear();
+    for (size_t i = 0, e = cur->pcs.size(); i < e; ++i) {
+      const NFAInsn &insn = insns_[cur->pcs[i]];
+      const uint32_t *threadSlots = &cur->slots[i * numSlots_];
+      if (insn.op == NFAInsn::Match) {
+        // Lower priority threads can only find worse matches.
+        matchSlots.assign(threadSlots, threadSlots + numSlots_);
+        matchSlots[1] = pos;
+        break;
+      }
+      if (pos < length_ &&
+          matchesCodeUnit(
+              program_, traits_, insn, (CodePoint)first_[pos])) {
+        slots.assign(threadSlots, threadSlots + numSlots_);
+        addThreads(*next, cur->pcs[i] + 1, pos + 1, slots);
+      }
+    }
+    std::swap(cur, next);
+
+    if (pos == length_ ||
+        (cur->pcs.empty() && (!matchSlots.empty() || onlyAtStart)))
+      break;
+  }
+
+  if (matchSlots.empty())
+    return false;
+  if (captures) {
+    captures->clear();
+    for (uint32_t slot = 0; slot < numSlots_; slot += 2) {
+      if (matchSlots[slot] == kNotMatched)
+        captures->push_back({kNotMatched, kNotMatched});
+      else
+        captures->push_back({matchSlots[slot], matchSlots[slot + 1]});
+    }
+  }
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// Entry points
+
+template <class CharT, class Traits>
+MatchRuntimeResult searchWithNFAImpl(
+    NFAProgram &program,
+    const CharT *first,
+    uint32_t start,
+    uint32_t length,
+    std::vector<CapturedRange> *captures,
+    constants::MatchFlagType matchFlags) {
+  // Check for match impossibility before doing anything else, as the
+  // backtracking executor does.
+  MatchConstraintSet constraints = program.constraints_;
+  if ((constraints & MatchConstraintNonASCII) &&
+      (matchFlags & constants::matchInputAllAscii))
+    return MatchRuntimeResult::NoMatch;
+  if ((constraints & MatchConstraintAnchoredAtStart) && start != 0)
+    return MatchRuntimeResult::NoMatch;
+
+  bool onlyAtStart = (constraints & MatchConstraintAnchoredAtStart) ||
+      (matchFlags & constants::matchOnlyAtStart);
+
+  // The DFA rejects inputs that do not match in a single pass, without
+  // tracking captures.
+  if (program.dfaCompatible_ && length > 0 &&
+      !(matchFlags & constants::matchNotEndOfLine)) {
+    auto &dfa = onlyAtStart ? program.anchoredDFA_ : program.unanchoredDFA_;
+    if (!dfa)
+      dfa.reset(new LazyDFA(program, onlyAtStart));
+    LazyDFA::Result res = dfa->search(Traits(), first, start, length);
+    if (res == LazyDFA::Result::NoMatch)
+      return MatchRuntimeResult::NoMatch;
+    if (res == LazyDFA::Result::Match && !captures)
+      return MatchRuntimeResult::Match;
+  }
+
+  PikeVM<Traits> vm(program, first, length, matchFlags);
+  return vm.search(start, onlyAtStart, captures) ? MatchRuntimeResult::Match
+                                                 : MatchRuntimeResult::NoMatch;
+}
+
+MatchRuntimeResult searchWithNFA(
+    NFAProgram &program,
+    const char16_t *first,
+    uint32_t start,
+    uint32_t length,
+    std::vector<CapturedRange> *captures,
+    constants::MatchFlagType matchFlags) {
+  return searchWithNFAImpl<char16_t, UTF16RegexTraits>(
+      program, first, start, length, captures, matchFlags);
+}
+
+MatchRuntimeResult searchWithNFA(
+    NFAProgram &program,
+    const char *first,
+    uint32_t start,
+    uint32_t length,
+    std::vector<CapturedRange> *captures,
+    constants::MatchFlagType matchFlags) {
+  return searchWithNFAImpl<char, ASCIIRegexTraits>(
+      program, first, start, length, captures, matchFlags);
+}
+
+} // namespace regex
+} // namespace hermes
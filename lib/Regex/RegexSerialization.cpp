@@ -289,7 +289,31 @@ void dumpRegexBytecode(llvh::ArrayRef<uint8_t> bytes, llvh::raw_ostream &OS) {
       aligner(header->loopCount),
       aligner(header->syntaxFlags),
       header->constraints);
-  bytes = bytes.slice(sizeof *header);
+  // Output the literals, if any. Non-ASCII code units are escaped.
+  auto dumpLiteral = [&OS](const uint8_t *units, uint16_t length) {
+    for (uint16_t i = 0; i < length; ++i) {
+      char16_t c;
+      memcpy(&c, units + i * sizeof(c), sizeof(c));
+      if (c >= 0x20 && c < 0x7F)
+        OS << (char)c;
+      else
+        OS << llvh::format("\\u%04x", (unsigned)c);
+    }
+  };
+  const uint8_t *literals = bytes.data() + sizeof *header;
+  if (header->anchoredLiteralLength) {
+    OS << "  Anchored literal at " << header->anchoredLiteralOffset << ": ";
+    dumpLiteral(literals, header->anchoredLiteralLength);
+    OS << '\n';
+  }
+  if (header->floatingLiteralLength) {
+    OS << "  Floating literal: ";
+    dumpLiteral(
+        literals + header->anchoredLiteralLength * sizeof(char16_t),
+        header->floatingLiteralLength);
+    OS << '\n';
+  }
+  bytes = bytes.slice(header->instructionsOffset());
   uint32_t cursor = 0;
   while (cursor < bytes.size()) {
     // Output offset in left column.
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/StringKernels.h"
+
+#include "llvh/Support/MathExtras.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HERMES_STRING_KERNELS_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define HERMES_STRING_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace hermes {
+
+namespace {
+
+#if defined(HERMES_STRING_KERNELS_SSE2) || defined(HERMES_STRING_KERNELS_NEON)
+#define HERMES_STRING_KERNELS_VECTOR
+
+/// A 16-byte vector of code units of type CharT. Comparisons produce a mask
+/// with one set bit per matching code unit, at bit kBitsPerUnit * index.
+template <typename CharT>
+struct Vec;
+
+#ifdef HERMES_STRING_KERNELS_SSE2
+
+template <>
+struct Vec<char> {
+  static constexpr size_t kUnits = 16;
+  static constexpr unsigned kBitsPerUnit = 1;
+  __m128i v;
+
+  static Vec splat(char c) {
+    return {_mm_set1_epi8(c)};
+  }
+  static Vec load(const char *p) {
+    return {_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))};
+  }
+  uint64_t equalMask(Vec other) const {
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, other.v));
+  }
+};
+
+template <>
+struct Vec<char16_t> {
+  static constexpr size_t kUnits = 8;
+  static constexpr unsigned kBitsPerUnit = 2;
+  __m128i v;
+
+  static Vec splat(char16_t c) {
+    return {_mm_set1_epi16((short)c)};
+  }
+  static Vec load(const char16_t *p) {
+    return {_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))};
+  }
+  Vec operator&(Vec other) const {
+    return {_mm_and_si128(v, other.v)};
+  }
+  uint64_t equalMask(Vec other) const {
+    // movemask produces two bits per 16-bit lane; keep the low one.
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi16(v, other.v)) & 0x5555;
+  }
+};
+
+#else // HERMES_STRING_KERNELS_NEON
+
+template <>
+struct Vec<char> {
+  static constexpr size_t kUnits = 16;
+  static constexpr unsigned kBitsPerUnit = 4;
+  uint8x16_t v;
+
+  static Vec splat(char c) {
+    return {vdupq_n_u8((uint8_t)c)};
+  }
+  static Vec load(const char *p) {
+    return {vld1q_u8(reinterpret_cast<const uint8_t *>(p))};
+  }
+  uint64_t equalMask(Vec other) const {
+    // NEON has no movemask; narrowing each byte to a nibble gives a 64-bit
+    // mask with four bits per byte.
+    uint8x8_t nibbles =
+        vshrn_n_u16(vreinterpretq_u16_u8(vceqq_u8(v, other.v)), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) &
+        0x1111111111111111ull;
+  }
+};
+
+template <>
+struct Vec<char16_t> {
+  static constexpr size_t kUnits = 8;
+  static constexpr unsigned kBitsPerUnit = 8;
+  uint16x8_t v;
+
+  static Vec splat(char16_t c) {
+    return {vdupq_n_u16(c)};
+  }
+  static Vec load(const char16_t *p) {
+    return {vld1q_u16(reinterpret_cast<const uint16_t *>(p))};
+  }
+  Vec operator&(Vec other) const {
+    return {vandq_u16(v, other.v)};
+  }
+  uint64_t equalMask(Vec other) const {
+    uint8x8_t bytes = vmovn_u16(vceqq_u16(v, other.v));
+    return vget_lane_u64(vreinterpret_u64_u8(bytes), 0) &
+        0x0101010101010101ull;
+  }
+};
+
+#endif
+
+/// \return the index of the code unit for the lowest set bit of \p mask.
+template <typename CharT>
+inline size_t firstIndex(uint64_t mask) {
+  return llvh::countTrailingZeros(mask, llvh::ZB_Undefined) /
+      Vec<CharT>::kBitsPerUnit;
+}
+
+#endif // HERMES_STRING_KERNELS_SSE2 || HERMES_STRING_KERNELS_NEON
+
+template <typename CharT>
+const CharT *
+findCodeUnitImpl(const CharT *first, const CharT *last, CharT c) {
+#ifdef HERMES_STRING_KERNELS_VECTOR
+  using V = Vec<CharT>;
+  const V target = V::splat(c);
+  for (; (size_t)(last - first) >= V::kUnits; first += V::kUnits) {
+    if (uint64_t mask = V::load(first).equalMask(target))
+      return first + firstIndex<CharT>(mask);
+  }
+#endif
+  return std::find(first, last, c);
+}
+
+template <typename CharT>
+const CharT *findSubstringImpl(
+    const CharT *first,
+    const CharT *last,
+    llvh::ArrayRef<CharT> needle) {
+  const size_t n = needle.size();
+  if (n == 0)
+    return first;
+  if (n == 1)
+    return findCodeUnit(first, last, needle[0]);
+  if ((size_t)(last - first) < n)
+    return last;
+
+#ifdef HERMES_STRING_KERNELS_VECTOR
+  // Compare a block of candidate starts against the first code unit of the
+  // needle, and the same block shifted by n - 1 against the last code unit.
+  // Only starts that pass both are compared in full.
+  using V = Vec<CharT>;
+  const V head = V::splat(needle.front());
+  const V tail = V::splat(needle.back());
+  const CharT *const lastStart = last - n;
+  for (; (size_t)(lastStart - first) + 1 >= V::kUnits; first += V::kUnits) {
+    uint64_t mask = V::load(first).equalMask(head) &
+        V::load(first + n - 1).equalMask(tail);
+    while (mask) {
+      const CharT *start = first + firstIndex<CharT>(mask);
+      if (std::memcmp(
+              start + 1, needle.data() + 1, (n - 2) * sizeof(CharT)) == 0)
+        return start;
+      mask &= mask - 1;
+    }
+  }
+#endif
+  return std::search(first, last, needle.begin(), needle.end());
+}
+
+/// \return whether \p c ends a run of plain code units in a JSON string.
+inline bool isJSONStringSpecial(char16_t c) {
+  return c == u'"' || c == u'\\' || c < 0x20;
+}
+
+} // namespace
+
+const char *findCodeUnit(const char *first, const char *last, char c) {
+  // The C library's memchr is already vectorized, and picks the widest vector
+  // unit available at runtime.
+  const void *found = std::memchr(first, c, last - first);
+  return found ? static_cast<const char *>(found) : last;
+}
+
+const char16_t *
+findCodeUnit(const char16_t *first, const char16_t *last, char16_t c) {
+  return findCodeUnitImpl(first, last, c);
+}
+
+const char *findSubstring(
+    const char *first,
+    const char *last,
+    llvh::ArrayRef<char> needle) {
+  return findSubstringImpl(first, last, needle);
+}
+
+const char16_t *findSubstring(
+    const char16_t *first,
+    const char16_t *last,
+    llvh::ArrayRef<char16_t> needle) {
+  return findSubstringImpl(first, last, needle);
+}
+
+const char16_t *findJSONStringSpecial(
+    const char16_t *first,
+    const char16_t *last) {
+#ifdef HERMES_STRING_KERNELS_VECTOR
+  using V = Vec<char16_t>;
+  const V quote = V::splat(u'"');
+  const V backslash = V::splat(u'\\');
+  // A code unit is a control character if clearing its low five bits leaves
+  // zero.
+  const V controlMask = V::splat(0xFFE0);
+  const V zero = V::splat(0);
+  for (; (size_t)(last - first) >= V::kUnits; first += V::kUnits) {
+    V chars = V::load(first);
+    if (uint64_t mask = chars.equalMask(quote) | chars.equalMask(backslash) |
+            (chars & controlMask).equalMask(zero))
+      return first + firstIndex<char16_t>(mask);
+  }
+#endif
+  return std::find_if(first, last, isJSONStringSpecial);
+}
+
+} // namespace hermes
@@ -373,6 +373,60 @@ ExecutionStatus CodeBlock::lazyCompileImpl(Runtime &runtime) {
 }
 #endif // HERMESVM_LEAN
 
+ProtoPropertyCacheEntry &CodeBlock::getProtoCacheEntry(
+    const PropertyCacheEntry *entry) {
+  if (!polymorphicCache_)
+    polymorphicCache_.reset(new PolymorphicPropertyCache[propertyCacheSize_]);
+  return polymorphicCache_[entry - propertyCache()].proto;
+}
+
+void CodeBlock::updatePolymorphicCache(
+    PropertyCacheEntry *entry,
+    CompressedPointer clazz,
+    SlotIndex slot) {
+  if (!entry->clazz) {
+    // The cached class was collected, or the entry was never filled because
+    // another cache in this CodeBlock is polymorphic. Reuse it unless the
+    // cache has already given up.
+    if (!polymorphicCache_ ||
+        !polymorphicCache_[entry - propertyCache()].megamorphic) {
+      entry->clazz = clazz;
+      entry->slot = slot;
+    }
+    return;
+  }
+  if (!polymorphicCache_)
+    polymorphicCache_.reset(new PolymorphicPropertyCache[propertyCacheSize_]);
+  PolymorphicPropertyCache &poly = polymorphicCache_[entry - propertyCache()];
+  if (poly.megamorphic)
+    return;
+  for (PropertyCacheEntry &polyEntry : poly.entries) {
+    if (!polyEntry.clazz) {
+      polyEntry.clazz = clazz;
+      polyEntry.slot = slot;
+      return;
+    }
+  }
+  // Every entry is in use. Keep them, but stop rewriting the cache so that a
+  // site which sees many classes does not keep thrashing it.
+  poly.megamorphic = true;
+}
+
+PropertyCacheState CodeBlock::getPropertyCacheState(
+    const PropertyCacheEntry *entry) {
+  if (!polymorphicCache_)
+    return PropertyCacheState::Monomorphic;
+  const PolymorphicPropertyCache &poly =
+      polymorphicCache_[entry - propertyCache()];
+  if (poly.megamorphic)
+    return PropertyCacheState::Megamorphic;
+  for (const PropertyCacheEntry &polyEntry : poly.entries) {
+    if (polyEntry.clazz)
+      return PropertyCacheState::Polymorphic;
+  }
+  return PropertyCacheState::Monomorphic;
+}
+
 void CodeBlock::markCachedHiddenClasses(
     Runtime &runtime,
     WeakRootAcceptor &acceptor) {
@@ -382,6 +436,24 @@ void CodeBlock::markCachedHiddenClasses(
       acceptor.acceptWeak(prop.clazz);
     }
   }
+  if (!polymorphicCache_)
+    return;
+  for (auto &poly : llvh::makeMutableArrayRef(
+           polymorphicCache_.get(), propertyCacheSize_)) {
+    for (auto &prop : poly.entries) {
+      if (prop.clazz) {
+        acceptor.acceptWeak(prop.clazz);
+      }
+    }
+    if (poly.proto.receiverClazz) {
+      acceptor.acceptWeak(poly.proto.receiverClazz);
+    }
+    for (unsigned i = 0; i < poly.proto.depth; ++i) {
+      if (poly.proto.chain[i]) {
+        acceptor.acceptWeak(poly.proto.chain[i]);
+      }
+    }
+  }
 }
 
 uint32_t CodeBlock::getVirtualOffset() const {
@@ -1787,9 +1787,13 @@ void GCBase::sizeDiagnosticCensus(size_t allocatedBytes) {
     // We include ExternalStringPrimitives because we're including external
     // memory in the overall heap size. We do not include
     // BufferedStringPrimitives because they just store a pointer to an
-    // ExternalStringPrimitive (which is already tracked).
+    // ExternalStringPrimitive (which is already tracked),
+    // SlicedStringPrimitives, which share the characters of another string, or
+    // RopeStringPrimitives, whose characters are in the strings they
+    // reference until they are flattened.
     auto *strprim = dyn_vmcast<StringPrimitive>(cell);
-    if (strprim && !isBufferedStringPrimitive(cell)) {
+    if (strprim && !isBufferedStringPrimitive(cell) &&
+        !isSlicedStringPrimitive(cell) && !isRopeStringPrimitive(cell)) {
       auto &stat = strprim->isASCII()
           ? acceptor.diagnostic.stats.breakdown["StringPrimitive (ASCII)"]
           : acceptor.diagnostic.stats.breakdown["StringPrimitive (UTF-16)"];
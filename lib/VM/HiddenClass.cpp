@@ -368,6 +368,12 @@ Handle<HiddenClass> HiddenClass::deleteProperty(
 
   --newHandle->numProperties_;
 
+  // A no-cache dictionary is modified in place, so forget its lookup.
+  runtime.getPropertyLookupCache().invalidate(
+      CompressedPointer::encodeNonNull(*newHandle, runtime),
+      DictPropertyMap::getDescriptorPair(
+          newHandle->propertyMap_.getNonNull(runtime), pos)
+          ->first);
   DictPropertyMap::erase(newHandle->propertyMap_.get(runtime), runtime, pos);
 
   LLVM_DEBUG(
@@ -412,6 +418,12 @@ CallResult<std::pair<Handle<HiddenClass>, SlotIndex>> HiddenClass::addProperty(
     }
 
     ++selfHandle->numProperties_;
+    // The class did not change, so prototype chain caches that may now be
+    // shadowed by this property, and any cached lookup of it in this class,
+    // must be invalidated explicitly.
+    runtime.invalidateProtoCaches(name);
+    runtime.getPropertyLookupCache().invalidate(
+        CompressedPointer::encodeNonNull(*selfHandle, runtime), name);
     return std::make_pair(selfHandle, newSlot);
   }
 
@@ -553,9 +565,12 @@ Handle<HiddenClass> HiddenClass::updateProperty(
         selfHandle->propertyMap_ &&
         "propertyMap must exist in dictionary mode");
     selfHandle->flags_ = computeFlags(selfHandle->flags_, newFlags, false);
-    DictPropertyMap::getDescriptorPair(
-        selfHandle->propertyMap_.getNonNull(runtime), pos)
-        ->second.flags = newFlags;
+    auto *descPair = DictPropertyMap::getDescriptorPair(
+        selfHandle->propertyMap_.getNonNull(runtime), pos);
+    descPair->second.flags = newFlags;
+    runtime.getPropertyLookupCache().invalidate(
+        CompressedPointer::encodeNonNull(*selfHandle, runtime),
+        descPair->first);
     // If it's still cacheable, make it non-cacheable.
     if (!selfHandle->isDictionaryNoCache()) {
       selfHandle = copyToNewDictionary(selfHandle, runtime, /*noCache*/ true);
@@ -738,6 +753,10 @@ Handle<HiddenClass> HiddenClass::updatePropertyFlagsWithoutTransitions(
   MutableHandle<HiddenClass> classHandle{runtime};
   if (selfHandle->isDictionary()) {
     classHandle = *selfHandle;
+    // Any number of properties may change in place. This is rare enough
+    // (e.g. freezing a dictionary object) that the whole lookup cache can be
+    // dropped.
+    runtime.getPropertyLookupCache().clear();
   } else {
     classHandle = *copyToNewDictionary(selfHandle, runtime);
   }
@@ -9,6 +9,7 @@
 #define HERMES_VM_INTERPRETER_INTERNAL_H
 
 #include "hermes/VM/Interpreter.h"
+#include "hermes/VM/JSObject.h"
 
 // Convenient aliases for operand registers.
 #if !defined(__arm__) || !defined(__clang__) || \
@@ -143,6 +144,31 @@ CallResult<HermesValue> doBitNotSlowPath(Runtime &runtime, Handle<> src);
 
 CallResult<HermesValue> doNegateSlowPath(Runtime &runtime, Handle<> src);
 
+/// \return true if the properties of \p obj cannot be described by its class
+/// alone, so it must not take part in a prototype chain cache.
+inline bool isUncacheableProtoChainObject(JSObject *obj) {
+  return obj->isProxyObject() || obj->isHostObject() || obj->isLazy();
+}
+
+inline JSObject *Interpreter::getCachedProtoHolder(
+    Runtime &runtime,
+    JSObject *obj,
+    CompressedPointer clazz,
+    const ProtoPropertyCacheEntry &entry) {
+  if (entry.receiverClazz != clazz ||
+      entry.epoch != runtime.getProtoCacheEpoch() ||
+      LLVM_UNLIKELY(isUncacheableProtoChainObject(obj)))
+    return nullptr;
+  JSObject *cur = obj;
+  for (unsigned i = 0; i < entry.depth; ++i) {
+    cur = cur->getParent(runtime);
+    if (!cur || entry.chain[i] != CompressedPointer{cur->getClassGCPtr()} ||
+        LLVM_UNLIKELY(isUncacheableProtoChainObject(cur)))
+      return nullptr;
+  }
+  return cur;
+}
+
 } // namespace vm
 } // namespace hermes
 #endif // HERMES_VM_INTERPRETER_INTERNAL_H
@@ -17,6 +17,7 @@
 #include "hermes/VM/Callable.h"
 #include "hermes/VM/CodeBlock.h"
 #include "hermes/VM/HandleRootOwner-inline.h"
+#include "hermes/VM/JIT/JIT.h"
 #include "hermes/VM/JSArray.h"
 #include "hermes/VM/JSError.h"
 #include "hermes/VM/JSGenerator.h"
@@ -53,12 +54,15 @@ HERMES_SLOW_STATISTIC(
 HERMES_SLOW_STATISTIC(
     NumGetByIdCacheHits,
     "NumGetByIdCacheHits: Number of property 'read by id' cache hits");
+HERMES_SLOW_STATISTIC(
+    NumGetByIdPolyHits,
+    "NumGetByIdPolyHits: Number of property 'read by id' polymorphic cache hits");
 HERMES_SLOW_STATISTIC(
     NumGetByIdProtoHits,
     "NumGetByIdProtoHits: Number of property 'read by id' cache hits for the prototype");
 HERMES_SLOW_STATISTIC(
     NumGetByIdCacheEvicts,
-    "NumGetByIdCacheEvicts: Number of property 'read by id' cache evictions");
+    "NumGetByIdCacheEvicts: Number of property 'read by id' classes not cached due to a megamorphic cache");
 HERMES_SLOW_STATISTIC(
     NumGetByIdFastPaths,
     "NumGetByIdFastPaths: Number of property 'read by id' fast paths");
@@ -87,9 +91,12 @@ HERMES_SLOW_STATISTIC(
 HERMES_SLOW_STATISTIC(
     NumPutByIdCacheHits,
     "NumPutByIdCacheHits: Number of property 'write by id' cache hits");
+HERMES_SLOW_STATISTIC(
+    NumPutByIdPolyHits,
+    "NumPutByIdPolyHits: Number of property 'write by id' polymorphic cache hits");
 HERMES_SLOW_STATISTIC(
     NumPutByIdCacheEvicts,
-    "NumPutByIdCacheEvicts: Number of property 'write by id' cache evictions");
+    "NumPutByIdCacheEvicts: Number of property 'write by id' classes not cached due to a megamorphic cache");
 HERMES_SLOW_STATISTIC(
     NumPutByIdFastPaths,
     "NumPutByIdFastPaths: Number of property 'write by id' fast paths");
@@ -322,6 +329,50 @@ CallResult<PseudoHandle<>> Interpreter::getByIdTransient_RJS(
       *primitivePrototypeResult, runtime, id, base);
 }
 
+JSObject *Interpreter::getByIdFromProtoChainAndCache(
+    Runtime &runtime,
+    CodeBlock *codeBlock,
+    PropertyCacheEntry *cacheEntry,
+    JSObject *obj,
+    SymbolID id,
+    NamedPropertyDescriptor &desc) {
+  // The receiver class is the cache key, so it must describe every property
+  // of the receiver. That is not the case for dictionaries, whose properties
+  // can be added in place.
+  if (obj->getClass(runtime)->isDictionary() ||
+      isUncacheableProtoChainObject(obj))
+    return nullptr;
+  HiddenClass *chain[ProtoPropertyCacheEntry::kMaxDepth];
+  JSObject *cur = obj;
+  for (unsigned depth = 0; depth < ProtoPropertyCacheEntry::kMaxDepth;
+       ++depth) {
+    cur = cur->getParent(runtime);
+    if (!cur || isUncacheableProtoChainObject(cur))
+      return nullptr;
+    chain[depth] = cur->getClass(runtime);
+    if (chain[depth]->isDictionaryNoCache())
+      return nullptr;
+    OptValue<bool> found =
+        JSObject::tryGetOwnNamedDescriptorFast(cur, runtime, id, desc);
+    if (!found.hasValue())
+      return nullptr;
+    if (!found.getValue())
+      continue;
+    if (desc.flags.accessor || desc.flags.hostObject || desc.flags.proxyObject)
+      return nullptr;
+    ProtoPropertyCacheEntry &entry = codeBlock->getProtoCacheEntry(cacheEntry);
+    entry.receiverClazz = CompressedPointer{obj->getClassGCPtr()};
+    for (unsigned i = 0; i <= depth; ++i)
+      entry.chain[i] = CompressedPointer::encodeNonNull(chain[i], runtime);
+    entry.depth = depth + 1;
+    entry.slot = desc.slot;
+    entry.epoch = runtime.getProtoCacheEpoch();
+    runtime.addProtoCachedName(id);
+    return cur;
+  }
+  return nullptr;
+}
+
 PseudoHandle<> Interpreter::getByValTransientFast(
     Runtime &runtime,
     Handle<> base,
@@ -986,6 +1037,32 @@ tailCall:
   runtime.getCodeCoverageProfiler().markExecuted(curCodeBlock);
 
   if (!SingleStep) {
+#ifdef HERMESVM_JIT
+    if (JITCompiledFunctionPtr jitPtr =
+            runtime.getJITContext().compile(runtime, curCodeBlock)) {
+      // The frame of the callee has been set up by the caller, but isn't the
+      // current frame yet. Run the compiled code and return to the caller,
+      // like Ret does.
+      StackFramePtr calleeFrame{runtime.getStackPointer()};
+      CodeBlock *callerCodeBlock = calleeFrame.getSavedCodeBlock();
+      const Inst *callerIP = calleeFrame.getSavedIP();
+      res = JITContext::run(runtime, curCodeBlock, jitPtr);
+      PROFILER_EXIT_FUNCTION(curCodeBlock);
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+      runtime.popCallStack();
+#endif
+      if (!callerCodeBlock)
+        return res;
+      curCodeBlock = callerCodeBlock;
+      ip = callerIP;
+      frameRegs = &runtime.getCurrentFrame().getFirstLocalRef();
+      if (res == ExecutionStatus::EXCEPTION)
+        goto exception;
+      O1REG(Call) = *res;
+      ip = nextInstCall(ip);
+      goto jitReturn;
+    }
+#endif
     auto newFrame = runtime.setCurrentFrameToTopOfStack();
     runtime.saveCallerIPInStackFrame();
 #ifndef NDEBUG
@@ -1048,6 +1125,9 @@ tailCall:
 
   assert((const uint8_t *)ip < curCodeBlock->end() && "CodeBlock is empty");
 
+#ifdef HERMESVM_JIT
+jitReturn:
+#endif
   INIT_STATE_FOR_CODEBLOCK(curCodeBlock);
 
 #define BEFORE_OP_CODE                                                       \
@@ -1087,6 +1167,16 @@ tailCall:
   }                                             \
   goto *opcodeDispatch[(unsigned)ip->opCode]
 
+// Continue with the second instruction of a superinstruction, which is \p name
+// unless a breakpoint or another superinstruction has replaced its opcode,
+// with a direct jump instead of dispatching on the opcode.
+#define DISPATCH_FUSED(name)                      \
+  if (SingleStep || ip->opCode != OpCode::name) { \
+    DISPATCH;                                     \
+  }                                               \
+  BEFORE_OP_CODE;                                 \
+  goto case_##name
+
 #else // HERMESVM_INDIRECT_THREADING
 
 #define CASE(name) case OpCode::name:
@@ -1098,6 +1188,7 @@ tailCall:
     return HermesValue::encodeUndefinedValue(); \
   }                                             \
   continue
+#define DISPATCH_FUSED(name) DISPATCH
 
 #endif // HERMESVM_INDIRECT_THREADING
 
@@ -2220,7 +2311,14 @@ tailCall:
           auto cacheHCPtr = vmcast_or_null<HiddenClass>(static_cast<GCCell *>(
               cacheEntry->clazz.get(runtime, runtime.getHeap())));
           CAPTURE_IP(runtime.recordHiddenClass(
-              curCodeBlock, ip, ID(idVal), obj->getClass(runtime), cacheHCPtr));
+              curCodeBlock,
+              ip,
+              ID(idVal),
+              obj->getClass(runtime),
+              cacheHCPtr,
+              curCodeBlock->findPolymorphicCacheEntry(
+                  cacheEntry, obj->getClassGCPtr()) != nullptr,
+              curCodeBlock->getPropertyCacheState(cacheEntry)));
           // obj may be moved by GC due to recordHiddenClass
           obj = objHandle.get();
         }
@@ -2246,6 +2344,31 @@ tailCall:
           ip = nextIP;
           DISPATCH;
         }
+        // Otherwise try the rest of a polymorphic cache, and then the
+        // prototype chain cache.
+        if (auto *polyEntry =
+                curCodeBlock->findPolymorphicCacheEntry(cacheEntry, clazzPtr)) {
+          ++NumGetByIdPolyHits;
+          CAPTURE_IP(
+              O1REG(GetById) =
+                  JSObject::getNamedSlotValueUnsafe<PropStorage::Inline::Yes>(
+                      obj, runtime, polyEntry->slot)
+                      .unboxToHV(runtime));
+          ip = nextIP;
+          DISPATCH;
+        }
+        if (auto *protoEntry = curCodeBlock->findProtoCacheEntry(cacheEntry)) {
+          if (JSObject *holder = Interpreter::getCachedProtoHolder(
+                  runtime, obj, clazzPtr, *protoEntry)) {
+            ++NumGetByIdProtoHits;
+            CAPTURE_IP(
+                O1REG(GetById) = JSObject::getNamedSlotValueUnsafe(
+                                     holder, runtime, protoEntry->slot)
+                                     .unboxToHV(runtime));
+            ip = nextIP;
+            DISPATCH;
+          }
+        }
         auto id = ID(idVal);
         NamedPropertyDescriptor desc;
         CAPTURE_IP_ASSIGN(
@@ -2263,14 +2386,14 @@ tailCall:
           if (LLVM_LIKELY(!clazz->isDictionaryNoCache()) &&
               LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
 #ifdef HERMES_SLOW_DEBUG
-            if (cacheEntry->clazz && cacheEntry->clazz != clazzPtr)
+            if (curCodeBlock->getPropertyCacheState(cacheEntry) ==
+                PropertyCacheState::Megamorphic)
               ++NumGetByIdCacheEvicts;
 #else
             (void)NumGetByIdCacheEvicts;
 #endif
-            // Cache the class, id and property slot.
-            cacheEntry->clazz = clazzPtr;
-            cacheEntry->slot = desc.slot;
+            // Cache the class and property slot.
+            curCodeBlock->updatePropertyCache(cacheEntry, clazzPtr, desc.slot);
           }
 
           assert(
@@ -2284,24 +2407,21 @@ tailCall:
           DISPATCH;
         }
 
-        // The cache may also be populated via the prototype of the object.
-        // This value is only reliable if the fast path was a definite
-        // not-found.
+        // The prototype chain cache may be populated when the property is
+        // found on a prototype of the object. This is only reliable if the
+        // fast path was a definite not-found.
+        // TODO: A lazy object is reported as having no properties and
+        // therefore cannot contain the property, which is why
+        // getByIdFromProtoChainAndCache rejects it. That check should be
+        // merged into tryGetOwnNamedDescriptorFast().
         if (fastPathResult.hasValue() && !fastPathResult.getValue() &&
-            LLVM_LIKELY(!obj->isProxyObject())) {
-          CAPTURE_IP_ASSIGN(JSObject * parent, obj->getParent(runtime));
-          // TODO: This isLazy check is because a lazy object is reported as
-          // having no properties and therefore cannot contain the property.
-          // This check does not belong here, it should be merged into
-          // tryGetOwnNamedDescriptorFast().
-          if (parent && cacheEntry->clazz == parent->getClassGCPtr() &&
-              LLVM_LIKELY(!obj->isLazy())) {
-            ++NumGetByIdProtoHits;
-            // We've already checked that this isn't a Proxy.
+            LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
+          if (JSObject *holder = Interpreter::getByIdFromProtoChainAndCache(
+                  runtime, curCodeBlock, cacheEntry, obj, id, desc)) {
             CAPTURE_IP(
-                O1REG(GetById) = JSObject::getNamedSlotValueUnsafe(
-                                     parent, runtime, cacheEntry->slot)
-                                     .unboxToHV(runtime));
+                O1REG(GetById) =
+                    JSObject::getNamedSlotValueUnsafe(holder, runtime, desc)
+                        .unboxToHV(runtime));
             ip = nextIP;
             DISPATCH;
           }
@@ -2411,7 +2531,14 @@ tailCall:
           auto cacheHCPtr = vmcast_or_null<HiddenClass>(static_cast<GCCell *>(
               cacheEntry->clazz.get(runtime, runtime.getHeap())));
           CAPTURE_IP(runtime.recordHiddenClass(
-              curCodeBlock, ip, ID(idVal), obj->getClass(runtime), cacheHCPtr));
+              curCodeBlock,
+              ip,
+              ID(idVal),
+              obj->getClass(runtime),
+              cacheHCPtr,
+              curCodeBlock->findPolymorphicCacheEntry(
+                  cacheEntry, obj->getClassGCPtr()) != nullptr,
+              curCodeBlock->getPropertyCacheState(cacheEntry)));
           // shv/obj may be invalidated by recordHiddenClass
           if (shv.isPointer())
             shv.unsafeUpdatePointer(
@@ -2431,6 +2558,15 @@ tailCall:
           ip = nextIP;
           DISPATCH;
         }
+        if (auto *polyEntry =
+                curCodeBlock->findPolymorphicCacheEntry(cacheEntry, clazzPtr)) {
+          ++NumPutByIdPolyHits;
+          CAPTURE_IP(
+              JSObject::setNamedSlotValueUnsafe<PropStorage::Inline::Yes>(
+                  obj, runtime, polyEntry->slot, shv));
+          ip = nextIP;
+          DISPATCH;
+        }
         auto id = ID(idVal);
         NamedPropertyDescriptor desc;
         CAPTURE_IP_ASSIGN(
@@ -2448,14 +2584,14 @@ tailCall:
           if (LLVM_LIKELY(!clazz->isDictionary()) &&
               LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
 #ifdef HERMES_SLOW_DEBUG
-            if (cacheEntry->clazz && cacheEntry->clazz != clazzPtr)
+            if (curCodeBlock->getPropertyCacheState(cacheEntry) ==
+                PropertyCacheState::Megamorphic)
               ++NumPutByIdCacheEvicts;
 #else
             (void)NumPutByIdCacheEvicts;
 #endif
             // Cache the class and property slot.
-            cacheEntry->clazz = clazzPtr;
-            cacheEntry->slot = desc.slot;
+            curCodeBlock->updatePropertyCache(cacheEntry, clazzPtr, desc.slot);
           }
 
           // This must be valid because an own property was already found.
@@ -3340,6 +3476,58 @@ tailCall:
       LOAD_CONST(LoadConstTrue, HermesValue::encodeBoolValue(true));
       LOAD_CONST(LoadConstFalse, HermesValue::encodeBoolValue(false));
       LOAD_CONST(LoadConstZero, HermesValue::encodeTrustedNumberValue(0));
+
+      // Superinstructions execute their first instruction and then continue
+      // with the second one, which follows in the bytecode.
+      CASE(MovMov) {
+        O1REG(MovMov) = O2REG(MovMov);
+        ip = NEXTINST(MovMov);
+        DISPATCH_FUSED(Mov);
+      }
+      CASE(MovMovMov) {
+        O1REG(MovMovMov) = O2REG(MovMovMov);
+        ip = NEXTINST(MovMovMov);
+        DISPATCH_FUSED(MovMov);
+      }
+      CASE(MovRet) {
+        O1REG(MovRet) = O2REG(MovRet);
+        ip = NEXTINST(MovRet);
+        DISPATCH_FUSED(Ret);
+      }
+      CASE(LoadParamLoadParam) {
+        O1REG(LoadParamLoadParam) =
+            LLVM_LIKELY(ip->iLoadParamLoadParam.op2 <= FRAME.getArgCount())
+            ? FRAME.getArgRef((int32_t)ip->iLoadParamLoadParam.op2 - 1)
+            : HermesValue::encodeUndefinedValue();
+        ip = NEXTINST(LoadParamLoadParam);
+        DISPATCH_FUSED(LoadParam);
+      }
+      CASE(LoadParamLoadConstZero) {
+        O1REG(LoadParamLoadConstZero) =
+            LLVM_LIKELY(ip->iLoadParamLoadConstZero.op2 <= FRAME.getArgCount())
+            ? FRAME.getArgRef((int32_t)ip->iLoadParamLoadConstZero.op2 - 1)
+            : HermesValue::encodeUndefinedValue();
+        ip = NEXTINST(LoadParamLoadConstZero);
+        DISPATCH_FUSED(LoadConstZero);
+      }
+      CASE(LoadConstUInt8Add) {
+        O1REG(LoadConstUInt8Add) =
+            HermesValue::encodeTrustedNumberValue(ip->iLoadConstUInt8Add.op2);
+        ip = NEXTINST(LoadConstUInt8Add);
+        DISPATCH_FUSED(Add);
+      }
+      CASE(LoadConstZeroLess) {
+        O1REG(LoadConstZeroLess) = HermesValue::encodeTrustedNumberValue(0);
+        ip = NEXTINST(LoadConstZeroLess);
+        DISPATCH_FUSED(Less);
+      }
+      CASE(LoadConstZeroJStrictEqual) {
+        O1REG(LoadConstZeroJStrictEqual) =
+            HermesValue::encodeTrustedNumberValue(0);
+        ip = NEXTINST(LoadConstZeroJStrictEqual);
+        DISPATCH_FUSED(JStrictEqual);
+      }
+
       CASE(LoadConstBigInt) {
         idVal = ip->iLoadConstBigInt.op2;
         nextIP = NEXTINST(LoadConstBigInt);
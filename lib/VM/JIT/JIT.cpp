@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define DEBUG_TYPE "jit"
+#include "hermes/VM/JIT/JIT.h"
+
+#ifdef HERMESVM_JIT
+
+#include "x86-64/CodeGen.h"
+
+#include "hermes/Support/OSCompat.h"
+#include "hermes/VM/JSError.h"
+#include "hermes/VM/StackFrame-inline.h"
+
+#include "llvh/ADT/Statistic.h"
+#include "llvh/Support/Debug.h"
+
+#include <sys/mman.h>
+
+STATISTIC(NumJITCompiled, "Number of functions compiled by the JIT");
+STATISTIC(NumJITRejected, "Number of functions the JIT could not compile");
+
+namespace hermes {
+namespace vm {
+
+/// Size of the blocks of memory requested from the OS for compiled code.
+static constexpr size_t kChunkSize = 1 << 20;
+
+JITContext::~JITContext() {
+  for (const Chunk &chunk : chunks_)
+    munmap(chunk.base, chunk.size);
+}
+
+JITCompiledFunctionPtr JITContext::compileImpl(
+    Runtime &runtime,
+    CodeBlock *codeBlock) {
+  // The interpreter compiles lazy functions before they are called, so this
+  // only happens if compilation failed.
+  if (codeBlock->isLazy()) {
+    codeBlock->setDontJIT();
+    return nullptr;
+  }
+
+  std::vector<uint8_t> code;
+  if (!x86_64::generateCode(runtime, codeBlock, code)) {
+    ++NumJITRejected;
+    LLVM_DEBUG({
+      llvh::dbgs() << "JIT: rejected "
+                   << codeBlock->getNameString(runtime.getHeap().getCallbacks())
+                   << "\n";
+    });
+    codeBlock->setDontJIT();
+    return nullptr;
+  }
+
+  void *mem = allocExecutable(code);
+  if (!mem) {
+    codeBlock->setDontJIT();
+    return nullptr;
+  }
+
+  ++NumJITCompiled;
+  LLVM_DEBUG({
+    llvh::dbgs() << "JIT: compiled "
+                 << codeBlock->getNameString(runtime.getHeap().getCallbacks())
+                 << " into " << code.size() << " bytes\n";
+  });
+  auto ptr = reinterpret_cast<JITCompiledFunctionPtr>(mem);
+  codeBlock->setJITCompiled(ptr);
+  return ptr;
+}
+
+void *JITContext::allocExecutable(llvh::ArrayRef<uint8_t> code) {
+  const size_t pageSize = oscompat::page_size();
+  const size_t size = llvh::alignTo(code.size(), pageSize);
+
+  if (chunks_.empty() || chunks_.back().size - chunks_.back().used < size) {
+    size_t chunkSize = std::max(kChunkSize, size);
+    void *base = mmap(
+        nullptr,
+        chunkSize,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+    if (base == MAP_FAILED)
+      return nullptr;
+    chunks_.push_back(Chunk{static_cast<uint8_t *>(base), chunkSize, 0});
+  }
+
+  // Every function gets its own pages, so that they can be made executable as
+  // soon as the code has been copied, and never writable again.
+  Chunk &chunk = chunks_.back();
+  uint8_t *mem = chunk.base + chunk.used;
+  memcpy(mem, code.data(), code.size());
+  if (mprotect(mem, size, PROT_READ | PROT_EXEC) != 0)
+    return nullptr;
+  chunk.used += size;
+  return mem;
+}
+
+CallResult<HermesValue> JITContext::run(
+    Runtime &runtime,
+    CodeBlock *codeBlock,
+    JITCompiledFunctionPtr ptr) {
+  ScopedNativeDepthTracker depthTracker{runtime};
+  if (LLVM_UNLIKELY(depthTracker.overflowed())) {
+    return runtime.raiseStackOverflow(Runtime::StackOverflowKind::NativeStack);
+  }
+
+  // Like the interpreter, restore the caller's IP when returning, since the
+  // helpers called by the compiled code update it.
+  const inst::Inst *savedIP = runtime.getCurrentIP();
+  GCScope gcScope{runtime};
+
+  StackFramePtr newFrame = runtime.setCurrentFrameToTopOfStack();
+  runtime.saveCallerIPInStackFrame();
+
+  if (LLVM_UNLIKELY(!runtime.checkAndAllocStack(
+          codeBlock->getFrameSize() +
+              StackFrameLayout::CalleeExtraRegistersAtStart,
+          HermesValue::encodeUndefinedValue()))) {
+    (void)runtime.raiseStackOverflow(
+        Runtime::StackOverflowKind::JSRegisterStack);
+    runtime.restoreStackAndPreviousFrame(newFrame);
+    runtime.setCurrentIP(savedIP);
+    return ExecutionStatus::EXCEPTION;
+  }
+
+  if (LLVM_UNLIKELY(codeBlock->getHeaderFlags().isCallProhibited(
+          newFrame.isConstructorCall()))) {
+    (void)runtime.raiseTypeError(
+        !newFrame.isConstructorCall() ? "Class constructor invoked without new"
+                                      : "Function is not a constructor");
+    runtime.restoreStackAndPreviousFrame(newFrame);
+    runtime.setCurrentIP(savedIP);
+    return ExecutionStatus::EXCEPTION;
+  }
+
+  HermesValue result = HermesValue::encodeUndefinedValue();
+  ExecutionStatus status =
+      ptr(&runtime, &newFrame.getFirstLocalRef(), &result);
+
+  if (status == ExecutionStatus::EXCEPTION) {
+    // An Error created by a helper doesn't know about the compiled frame, so
+    // collect its stack trace here, as the interpreter does when it handles
+    // an exception.
+    if (auto *jsError = dyn_vmcast<JSError>(runtime.getThrownValue())) {
+      if (!jsError->getStackTrace()) {
+        auto errorHandle = runtime.makeHandle(jsError);
+        runtime.clearThrownValue();
+        (void)JSError::recordStackTrace(
+            errorHandle, runtime, false, codeBlock, runtime.getCurrentIP());
+        runtime.setThrownValue(errorHandle.getHermesValue());
+      }
+    }
+  }
+
+  runtime.restoreStackAndPreviousFrame(newFrame);
+  runtime.setCurrentIP(savedIP);
+  if (status == ExecutionStatus::EXCEPTION)
+    return ExecutionStatus::EXCEPTION;
+  return result;
+}
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMESVM_JIT
@@ -0,0 +1,1127 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define DEBUG_TYPE "jit"
+#include "JITHelpers.h"
+
+#ifdef HERMESVM_JIT
+
+#include "hermes/Inst/InstDecode.h"
+#include "hermes/Support/Conversions.h"
+#include "hermes/VM/Callable.h"
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/Interpreter.h"
+#include "hermes/VM/JIT/JIT.h"
+#include "hermes/VM/JSArray.h"
+#include "hermes/VM/Operations.h"
+#include "hermes/VM/Profiler/CodeCoverageProfiler.h"
+#include "hermes/VM/RuntimeModule-inline.h"
+#include "hermes/VM/StackFrame-inline.h"
+#include "hermes/VM/StringPrimitive.h"
+
+#include "../Interpreter-internal.h"
+
+namespace hermes {
+namespace vm {
+
+using namespace hermes::inst;
+
+using CondResult = JITHelpers::CondResult;
+
+#define JIT_HELPER_IMPL(name)             \
+  ExecutionStatus JITHelpers::name(       \
+      Runtime &runtime,                   \
+      PinnedHermesValue *frameRegs,       \
+      const Inst *ip,                     \
+      CodeBlock *curCodeBlock)
+#define JIT_COND_HELPER_IMPL(name)        \
+  CondResult JITHelpers::name(            \
+      Runtime &runtime,                   \
+      PinnedHermesValue *frameRegs,       \
+      const Inst *ip,                     \
+      CodeBlock *curCodeBlock)
+
+namespace {
+
+/// Conditional jumps come in a short and a long form, which only differ in
+/// the width of the jump target that precedes the registers. \return the
+/// register operand \p fromEnd bytes before the end of the instruction \p ip.
+PinnedHermesValue &
+jumpOperand(PinnedHermesValue *frameRegs, const Inst *ip, unsigned fromEnd) {
+  const uint8_t *end = (const uint8_t *)ip + getInstSize(ip->opCode);
+  return frameRegs[*(end - fromEnd)];
+}
+
+/// Store the result \p res of an instruction with the usual "output, input,
+/// input" layout into its output register.
+inline ExecutionStatus storeResult(
+    PinnedHermesValue *frameRegs,
+    const Inst *ip,
+    const CallResult<HermesValue> &res) {
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(Add) = *res;
+  return ExecutionStatus::RETURNED;
+}
+
+/// Implement a binary instruction with the slow path \p Oper.
+template <CallResult<HermesValue> (*Oper)(Runtime &, Handle<>, Handle<>)>
+ExecutionStatus
+binaryOp(Runtime &runtime, PinnedHermesValue *frameRegs, const Inst *ip) {
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  return storeResult(
+      frameRegs,
+      ip,
+      Oper(runtime, Handle<>(&O2REG(Add)), Handle<>(&O3REG(Add))));
+}
+
+/// Implement a bitwise or shift instruction, with the fast path \p Fast for
+/// number operands and the slow path \p Slow otherwise.
+template <
+    double (*Fast)(double, double),
+    CallResult<HermesValue> (*Slow)(Runtime &, Handle<>, Handle<>)>
+ExecutionStatus
+bitwiseOp(Runtime &runtime, PinnedHermesValue *frameRegs, const Inst *ip) {
+  if (LLVM_LIKELY(O2REG(BitAnd).isNumber() && O3REG(BitAnd).isNumber())) {
+    O1REG(BitAnd) = HermesValue::encodeTrustedNumberValue(
+        Fast(O2REG(BitAnd).getNumber(), O3REG(BitAnd).getNumber()));
+    return ExecutionStatus::RETURNED;
+  }
+  return binaryOp<Slow>(runtime, frameRegs, ip);
+}
+
+template <auto Oper>
+double bitwiseFast(double x, double y) {
+  return Oper(hermes::truncateToInt32(x), hermes::truncateToInt32(y));
+}
+
+template <auto Oper>
+double shiftFast(double x, double y) {
+  return Oper(
+      hermes::truncateToInt32(x), hermes::truncateToInt32(y) & 0x1f);
+}
+
+/// Implement a comparison producing a boolean, using \p oper for numbers and
+/// \p Slow otherwise.
+template <
+    bool (*Fast)(double, double),
+    CallResult<bool> (*Slow)(Runtime &, Handle<>, Handle<>)>
+ExecutionStatus
+compareOp(Runtime &runtime, PinnedHermesValue *frameRegs, const Inst *ip) {
+  if (LLVM_LIKELY(O2REG(Less).isNumber() && O3REG(Less).isNumber())) {
+    O1REG(Less) = HermesValue::encodeBoolValue(
+        Fast(O2REG(Less).getNumber(), O3REG(Less).getNumber()));
+    return ExecutionStatus::RETURNED;
+  }
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  CallResult<bool> res =
+      Slow(runtime, Handle<>(&O2REG(Less)), Handle<>(&O3REG(Less)));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(Less) = HermesValue::encodeBoolValue(*res);
+  return ExecutionStatus::RETURNED;
+}
+
+inline bool lessFast(double x, double y) {
+  return x < y;
+}
+inline bool lessEqFast(double x, double y) {
+  return x <= y;
+}
+inline bool greaterFast(double x, double y) {
+  return x > y;
+}
+inline bool greaterEqFast(double x, double y) {
+  return x >= y;
+}
+
+/// Evaluate the condition of a comparison jump whose operands are not both
+/// numbers, using \p Slow.
+template <CallResult<bool> (*Slow)(Runtime &, Handle<>, Handle<>)>
+CondResult
+compareJump(Runtime &runtime, PinnedHermesValue *frameRegs, const Inst *ip) {
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  CallResult<bool> res = Slow(
+      runtime,
+      Handle<>(&jumpOperand(frameRegs, ip, 2)),
+      Handle<>(&jumpOperand(frameRegs, ip, 1)));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return CondResult::Exception;
+  return *res ? CondResult::True : CondResult::False;
+}
+
+/// Call the JS function \p calleeBlock whose frame has already been set up,
+/// running its compiled code directly if there is any.
+CallResult<HermesValue> callCodeBlock(
+    Runtime &runtime,
+    CodeBlock *calleeBlock,
+    CodeBlock *curCodeBlock,
+    const Inst *ip) {
+  if (LLVM_UNLIKELY(
+          calleeBlock->lazyCompile(runtime) == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  // Functions that aren't compiled yet go through the interpreter, which
+  // counts the call and compiles them once they are hot.
+  JITCompiledFunctionPtr ptr = calleeBlock->getJITCompiled();
+  if (!ptr)
+    return runtime.interpretFunction(calleeBlock);
+
+  runtime.getCodeCoverageProfiler().markExecuted(calleeBlock);
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+  runtime.pushCallStack(curCodeBlock, ip);
+#endif
+  CallResult<HermesValue> res = JITContext::run(runtime, calleeBlock, ptr);
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+  runtime.popCallStack();
+#endif
+  return res;
+}
+
+} // namespace
+
+//===----------------------------------------------------------------------===//
+// Slow paths of inline instructions.
+
+JIT_HELPER_IMPL(addSlowPath) {
+  return binaryOp<addOp_RJS>(runtime, frameRegs, ip);
+}
+JIT_HELPER_IMPL(subSlowPath) {
+  return binaryOp<doOperSlowPath<doSub>>(runtime, frameRegs, ip);
+}
+JIT_HELPER_IMPL(mulSlowPath) {
+  return binaryOp<doOperSlowPath<doMul>>(runtime, frameRegs, ip);
+}
+JIT_HELPER_IMPL(divSlowPath) {
+  return binaryOp<doOperSlowPath<doDiv>>(runtime, frameRegs, ip);
+}
+
+JIT_HELPER_IMPL(incSlowPath) {
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  return storeResult(
+      frameRegs,
+      ip,
+      doIncDecOperSlowPath<doInc>(runtime, Handle<>(&O2REG(Inc))));
+}
+JIT_HELPER_IMPL(decSlowPath) {
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  return storeResult(
+      frameRegs,
+      ip,
+      doIncDecOperSlowPath<doDec>(runtime, Handle<>(&O2REG(Dec))));
+}
+
+JIT_COND_HELPER_IMPL(toBoolean) {
+  return vm::toBoolean(jumpOperand(frameRegs, ip, 1)) ? CondResult::True
+                                                      : CondResult::False;
+}
+JIT_COND_HELPER_IMPL(jLessSlowPath) {
+  return compareJump<lessOp_RJS>(runtime, frameRegs, ip);
+}
+JIT_COND_HELPER_IMPL(jLessEqualSlowPath) {
+  return compareJump<lessEqualOp_RJS>(runtime, frameRegs, ip);
+}
+JIT_COND_HELPER_IMPL(jGreaterSlowPath) {
+  return compareJump<greaterOp_RJS>(runtime, frameRegs, ip);
+}
+JIT_COND_HELPER_IMPL(jGreaterEqualSlowPath) {
+  return compareJump<greaterEqualOp_RJS>(runtime, frameRegs, ip);
+}
+JIT_COND_HELPER_IMPL(jEqual) {
+  return compareJump<abstractEqualityTest_RJS>(runtime, frameRegs, ip);
+}
+JIT_COND_HELPER_IMPL(jStrictEqual) {
+  return strictEqualityTest(
+             jumpOperand(frameRegs, ip, 2), jumpOperand(frameRegs, ip, 1))
+      ? CondResult::True
+      : CondResult::False;
+}
+
+//===----------------------------------------------------------------------===//
+// Arithmetic, comparisons and conversions.
+
+JIT_HELPER_IMPL(mod) {
+  if (LLVM_LIKELY(O2REG(Mod).isNumber() && O3REG(Mod).isNumber())) {
+    O1REG(Mod) = HermesValue::encodeUntrustedNumberValue(
+        doMod(O2REG(Mod).getNumber(), O3REG(Mod).getNumber()));
+    return ExecutionStatus::RETURNED;
+  }
+  return binaryOp<doOperSlowPath<doMod>>(runtime, frameRegs, ip);
+}
+
+JIT_HELPER_IMPL(bitAnd) {
+  return bitwiseOp<
+      bitwiseFast<doBitAnd>,
+      doBitOperSlowPath<doBitAnd>>(runtime, frameRegs, ip);
+}
+JIT_HELPER_IMPL(bitOr) {
+  return bitwiseOp<bitwiseFast<doBitOr>, doBitOperSlowPath<doBitOr>>(
+      runtime, frameRegs, ip);
+}
+JIT_HELPER_IMPL(bitXor) {
+  return bitwiseOp<
+      bitwiseFast<doBitXor>,
+      doBitOperSlowPath<doBitXor>>(runtime, frameRegs, ip);
+}
+JIT_HELPER_IMPL(lShift) {
+  return bitwiseOp<shiftFast<doLShift>, doShiftOperSlowPath<doLShift>>(
+      runtime, frameRegs, ip);
+}
+JIT_HELPER_IMPL(rShift) {
+  return bitwiseOp<shiftFast<doRShift>, doShiftOperSlowPath<doRShift>>(
+      runtime, frameRegs, ip);
+}
+JIT_HELPER_IMPL(uRshift) {
+  return bitwiseOp<shiftFast<doURshift>, doShiftOperSlowPath<doURshift>>(
+      runtime, frameRegs, ip);
+}
+
+JIT_HELPER_IMPL(bitNot) {
+  if (LLVM_LIKELY(O2REG(BitNot).isNumber())) {
+    O1REG(BitNot) = HermesValue::encodeUntrustedNumberValue(
+        ~hermes::truncateToInt32(O2REG(BitNot).getNumber()));
+    return ExecutionStatus::RETURNED;
+  }
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  return storeResult(
+      frameRegs, ip, doBitNotSlowPath(runtime, Handle<>(&O2REG(BitNot))));
+}
+
+JIT_HELPER_IMPL(negate) {
+  if (LLVM_LIKELY(O2REG(Negate).isNumber())) {
+    O1REG(Negate) =
+        HermesValue::encodeUntrustedNumberValue(-O2REG(Negate).getNumber());
+    return ExecutionStatus::RETURNED;
+  }
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  return storeResult(
+      frameRegs, ip, doNegateSlowPath(runtime, Handle<>(&O2REG(Negate))));
+}
+
+JIT_HELPER_IMPL(notOp) {
+  O1REG(Not) = HermesValue::encodeBoolValue(!vm::toBoolean(O2REG(Not)));
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(typeOf) {
+  runtime.setCurrentIP(ip);
+  O1REG(TypeOf) = vm::typeOf(runtime, Handle<>(&O2REG(TypeOf)));
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(less) {
+  return compareOp<lessFast, lessOp_RJS>(runtime, frameRegs, ip);
+}
+JIT_HELPER_IMPL(lessEq) {
+  return compareOp<lessEqFast, lessEqualOp_RJS>(runtime, frameRegs, ip);
+}
+JIT_HELPER_IMPL(greater) {
+  return compareOp<greaterFast, greaterOp_RJS>(runtime, frameRegs, ip);
+}
+JIT_HELPER_IMPL(greaterEq) {
+  return compareOp<greaterEqFast, greaterEqualOp_RJS>(runtime, frameRegs, ip);
+}
+
+JIT_HELPER_IMPL(eq) {
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  CallResult<bool> res = abstractEqualityTest_RJS(
+      runtime, Handle<>(&O2REG(Eq)), Handle<>(&O3REG(Eq)));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(Eq) =
+      HermesValue::encodeBoolValue(ip->opCode == OpCode::Eq ? *res : !*res);
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(strictEq) {
+  bool res = strictEqualityTest(O2REG(StrictEq), O3REG(StrictEq));
+  O1REG(StrictEq) =
+      HermesValue::encodeBoolValue(ip->opCode == OpCode::StrictEq ? res : !res);
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(toNumber) {
+  if (LLVM_LIKELY(O2REG(ToNumber).isNumber())) {
+    O1REG(ToNumber) = O2REG(ToNumber);
+    return ExecutionStatus::RETURNED;
+  }
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  return storeResult(
+      frameRegs, ip, toNumber_RJS(runtime, Handle<>(&O2REG(ToNumber))));
+}
+
+JIT_HELPER_IMPL(toNumeric) {
+  if (LLVM_LIKELY(O2REG(ToNumeric).isNumber())) {
+    O1REG(ToNumeric) = O2REG(ToNumeric);
+    return ExecutionStatus::RETURNED;
+  }
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  return storeResult(
+      frameRegs, ip, toNumeric_RJS(runtime, Handle<>(&O2REG(ToNumeric))));
+}
+
+JIT_HELPER_IMPL(toInt32) {
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  return storeResult(
+      frameRegs, ip, toInt32_RJS(runtime, Handle<>(&O2REG(ToInt32))));
+}
+
+JIT_HELPER_IMPL(addEmptyString) {
+  if (LLVM_LIKELY(O2REG(AddEmptyString).isString())) {
+    O1REG(AddEmptyString) = O2REG(AddEmptyString);
+    return ExecutionStatus::RETURNED;
+  }
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  CallResult<HermesValue> res = toPrimitive_RJS(
+      runtime, Handle<>(&O2REG(AddEmptyString)), PreferredType::NONE);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto strRes = toString_RJS(runtime, runtime.makeHandle(*res));
+  if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(AddEmptyString) = strRes->getHermesValue();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(instanceOf) {
+  GCScopeMarkerRAII marker{runtime};
+  runtime.setCurrentIP(ip);
+  CallResult<bool> res = instanceOfOperator_RJS(
+      runtime, Handle<>(&O2REG(InstanceOf)), Handle<>(&O3REG(InstanceOf)));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(InstanceOf) = HermesValue::encodeBoolValue(*res);
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(isIn) {
+  runtime.setCurrentIP(ip);
+  if (LLVM_UNLIKELY(!O3REG(IsIn).isObject())) {
+    return runtime.raiseTypeError("right operand of 'in' is not an object");
+  }
+  GCScopeMarkerRAII marker{runtime};
+  CallResult<bool> res = JSObject::hasComputed(
+      Handle<JSObject>::vmcast(&O3REG(IsIn)), runtime, Handle<>(&O2REG(IsIn)));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(IsIn) = HermesValue::encodeBoolValue(*res);
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(loadConstString) {
+  runtime.setCurrentIP(ip);
+  uint32_t stringID = ip->opCode == OpCode::LoadConstString
+      ? ip->iLoadConstString.op2
+      : ip->iLoadConstStringLongIndex.op2;
+  O1REG(LoadConstString) = HermesValue::encodeStringValue(
+      curCodeBlock->getRuntimeModule()->getStringPrimFromStringIDMayAllocate(
+          stringID));
+  return ExecutionStatus::RETURNED;
+}
+
+//===----------------------------------------------------------------------===//
+// Environments and globals.
+
+JIT_HELPER_IMPL(getEnvironment) {
+  Environment *curEnv =
+      FRAME.getCalleeClosureUnsafe()->getEnvironment(runtime);
+  for (unsigned level = ip->iGetEnvironment.op2; level; --level) {
+    assert(curEnv && "invalid environment relative level");
+    curEnv = curEnv->getParentEnvironment(runtime);
+  }
+  O1REG(GetEnvironment) = HermesValue::encodeObjectValue(curEnv);
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(createEnvironment) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  Handle<> parentEnv = runtime.makeHandle(HermesValue::encodeObjectValueUnsafe(
+      FRAME.getCalleeClosureUnsafe()->getEnvironment(runtime)));
+  O1REG(CreateEnvironment) = Environment::create(
+      runtime,
+      Handle<Environment>::vmcast_or_null(parentEnv),
+      curCodeBlock->getEnvironmentSize());
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(createInnerEnvironment) {
+  runtime.setCurrentIP(ip);
+  O1REG(CreateInnerEnvironment) = Environment::create(
+      runtime,
+      Handle<Environment>::vmcast(&O2REG(CreateInnerEnvironment)),
+      ip->iCreateInnerEnvironment.op3);
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(storeToEnvironment) {
+  switch (ip->opCode) {
+    case OpCode::StoreToEnvironment:
+      vmcast<Environment>(O1REG(StoreToEnvironment))
+          ->slot(ip->iStoreToEnvironment.op2)
+          .set(O3REG(StoreToEnvironment), runtime.getHeap());
+      break;
+    case OpCode::StoreToEnvironmentL:
+      vmcast<Environment>(O1REG(StoreToEnvironmentL))
+          ->slot(ip->iStoreToEnvironmentL.op2)
+          .set(O3REG(StoreToEnvironmentL), runtime.getHeap());
+      break;
+    case OpCode::StoreNPToEnvironment:
+      vmcast<Environment>(O1REG(StoreNPToEnvironment))
+          ->slot(ip->iStoreNPToEnvironment.op2)
+          .setNonPtr(O3REG(StoreNPToEnvironment), runtime.getHeap());
+      break;
+    default:
+      assert(ip->opCode == OpCode::StoreNPToEnvironmentL && "bad opcode");
+      vmcast<Environment>(O1REG(StoreNPToEnvironmentL))
+          ->slot(ip->iStoreNPToEnvironmentL.op2)
+          .setNonPtr(O3REG(StoreNPToEnvironmentL), runtime.getHeap());
+      break;
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(loadFromEnvironment) {
+  if (ip->opCode == OpCode::LoadFromEnvironment) {
+    O1REG(LoadFromEnvironment) =
+        vmcast<Environment>(O2REG(LoadFromEnvironment))
+            ->slot(ip->iLoadFromEnvironment.op3);
+  } else {
+    O1REG(LoadFromEnvironmentL) =
+        vmcast<Environment>(O2REG(LoadFromEnvironmentL))
+            ->slot(ip->iLoadFromEnvironmentL.op3);
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(declareGlobalVar) {
+  runtime.setCurrentIP(ip);
+  return Interpreter::declareGlobalVarImpl(runtime, curCodeBlock, ip);
+}
+
+//===----------------------------------------------------------------------===//
+// Property access.
+
+JIT_HELPER_IMPL(getById) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  uint32_t idVal;
+  bool tryProp = false;
+  switch (ip->opCode) {
+    case OpCode::GetByIdShort:
+      idVal = ip->iGetByIdShort.op4;
+      break;
+    case OpCode::GetById:
+      idVal = ip->iGetById.op4;
+      break;
+    case OpCode::GetByIdLong:
+      idVal = ip->iGetByIdLong.op4;
+      break;
+    case OpCode::TryGetById:
+      idVal = ip->iTryGetById.op4;
+      tryProp = true;
+      break;
+    default:
+      assert(ip->opCode == OpCode::TryGetByIdLong && "bad opcode");
+      idVal = ip->iTryGetByIdLong.op4;
+      tryProp = true;
+      break;
+  }
+
+  // All the variants have the same layout up to the identifier, see the
+  // interpreter.
+  CallResult<PseudoHandle<>> resPH{ExecutionStatus::EXCEPTION};
+  if (LLVM_LIKELY(O2REG(GetById).isObject())) {
+    auto *obj = vmcast<JSObject>(O2REG(GetById));
+    auto cacheIdx = ip->iGetById.op3;
+    auto *cacheEntry = curCodeBlock->getReadCacheEntry(cacheIdx);
+    CompressedPointer clazzPtr{obj->getClassGCPtr()};
+
+    if (LLVM_LIKELY(cacheEntry->clazz == clazzPtr)) {
+      O1REG(GetById) =
+          JSObject::getNamedSlotValueUnsafe<PropStorage::Inline::Yes>(
+              obj, runtime, cacheEntry->slot)
+              .unboxToHV(runtime);
+      return ExecutionStatus::RETURNED;
+    }
+    if (auto *polyEntry =
+            curCodeBlock->findPolymorphicCacheEntry(cacheEntry, clazzPtr)) {
+      O1REG(GetById) =
+          JSObject::getNamedSlotValueUnsafe<PropStorage::Inline::Yes>(
+              obj, runtime, polyEntry->slot)
+              .unboxToHV(runtime);
+      return ExecutionStatus::RETURNED;
+    }
+    if (auto *protoEntry = curCodeBlock->findProtoCacheEntry(cacheEntry)) {
+      if (JSObject *holder = Interpreter::getCachedProtoHolder(
+              runtime, obj, clazzPtr, *protoEntry)) {
+        O1REG(GetById) = JSObject::getNamedSlotValueUnsafe(
+                             holder, runtime, protoEntry->slot)
+                             .unboxToHV(runtime);
+        return ExecutionStatus::RETURNED;
+      }
+    }
+
+    auto id = ID(idVal);
+    NamedPropertyDescriptor desc;
+    OptValue<bool> fastPathResult =
+        JSObject::tryGetOwnNamedDescriptorFast(obj, runtime, id, desc);
+    if (LLVM_LIKELY(fastPathResult.hasValue() && fastPathResult.getValue()) &&
+        !desc.flags.accessor) {
+      HiddenClass *clazz = vmcast<HiddenClass>(clazzPtr.getNonNull(runtime));
+      if (LLVM_LIKELY(!clazz->isDictionaryNoCache()) &&
+          LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
+        curCodeBlock->updatePropertyCache(cacheEntry, clazzPtr, desc.slot);
+      }
+      O1REG(GetById) = JSObject::getNamedSlotValueUnsafe(obj, runtime, desc)
+                           .unboxToHV(runtime);
+      return ExecutionStatus::RETURNED;
+    }
+
+    if (fastPathResult.hasValue() && !fastPathResult.getValue() &&
+        LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
+      if (JSObject *holder = Interpreter::getByIdFromProtoChainAndCache(
+              runtime, curCodeBlock, cacheEntry, obj, id, desc)) {
+        O1REG(GetById) = JSObject::getNamedSlotValueUnsafe(holder, runtime, desc)
+                             .unboxToHV(runtime);
+        return ExecutionStatus::RETURNED;
+      }
+    }
+
+    PropOpFlags defaultPropOpFlags =
+        DEFAULT_PROP_OP_FLAGS(curCodeBlock->isStrictMode());
+    resPH = JSObject::getNamed_RJS(
+        Handle<JSObject>::vmcast(&O2REG(GetById)),
+        runtime,
+        id,
+        !tryProp ? defaultPropOpFlags : defaultPropOpFlags.plusMustExist(),
+        cacheIdx != hbc::PROPERTY_CACHING_DISABLED ? cacheEntry : nullptr);
+  } else {
+    assert(!tryProp && "TryGetById can only be used on the global object");
+    resPH = Interpreter::getByIdTransient_RJS(
+        runtime, Handle<>(&O2REG(GetById)), ID(idVal));
+  }
+  if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(GetById) = resPH->get();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(putById) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  uint32_t idVal;
+  bool tryProp = false;
+  switch (ip->opCode) {
+    case OpCode::PutById:
+      idVal = ip->iPutById.op4;
+      break;
+    case OpCode::PutByIdLong:
+      idVal = ip->iPutByIdLong.op4;
+      break;
+    case OpCode::TryPutById:
+      idVal = ip->iTryPutById.op4;
+      tryProp = true;
+      break;
+    default:
+      assert(ip->opCode == OpCode::TryPutByIdLong && "bad opcode");
+      idVal = ip->iTryPutByIdLong.op4;
+      tryProp = true;
+      break;
+  }
+
+  bool strictMode = curCodeBlock->isStrictMode();
+  if (LLVM_LIKELY(O1REG(PutById).isObject())) {
+    SmallHermesValue shv =
+        SmallHermesValue::encodeHermesValue(O2REG(PutById), runtime);
+    auto *obj = vmcast<JSObject>(O1REG(PutById));
+    auto cacheIdx = ip->iPutById.op3;
+    auto *cacheEntry = curCodeBlock->getWriteCacheEntry(cacheIdx);
+    CompressedPointer clazzPtr{obj->getClassGCPtr()};
+
+    if (LLVM_LIKELY(cacheEntry->clazz == clazzPtr)) {
+      JSObject::setNamedSlotValueUnsafe<PropStorage::Inline::Yes>(
+          obj, runtime, cacheEntry->slot, shv);
+      return ExecutionStatus::RETURNED;
+    }
+    if (auto *polyEntry =
+            curCodeBlock->findPolymorphicCacheEntry(cacheEntry, clazzPtr)) {
+      JSObject::setNamedSlotValueUnsafe<PropStorage::Inline::Yes>(
+          obj, runtime, polyEntry->slot, shv);
+      return ExecutionStatus::RETURNED;
+    }
+
+    auto id = ID(idVal);
+    NamedPropertyDescriptor desc;
+    OptValue<bool> hasOwnProp =
+        JSObject::tryGetOwnNamedDescriptorFast(obj, runtime, id, desc);
+    if (LLVM_LIKELY(hasOwnProp.hasValue() && hasOwnProp.getValue()) &&
+        !desc.flags.accessor && desc.flags.writable &&
+        !desc.flags.internalSetter) {
+      HiddenClass *clazz = vmcast<HiddenClass>(clazzPtr.getNonNull(runtime));
+      if (LLVM_LIKELY(!clazz->isDictionary()) &&
+          LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
+        curCodeBlock->updatePropertyCache(cacheEntry, clazzPtr, desc.slot);
+      }
+      JSObject::setNamedSlotValueUnsafe(obj, runtime, desc.slot, shv);
+      return ExecutionStatus::RETURNED;
+    }
+
+    PropOpFlags defaultPropOpFlags = DEFAULT_PROP_OP_FLAGS(strictMode);
+    auto putRes = JSObject::putNamed_RJS(
+        Handle<JSObject>::vmcast(&O1REG(PutById)),
+        runtime,
+        id,
+        Handle<>(&O2REG(PutById)),
+        !tryProp ? defaultPropOpFlags : defaultPropOpFlags.plusMustExist());
+    if (LLVM_UNLIKELY(putRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    return ExecutionStatus::RETURNED;
+  }
+  assert(!tryProp && "TryPutById can only be used on the global object");
+  return Interpreter::putByIdTransient_RJS(
+      runtime,
+      Handle<>(&O1REG(PutById)),
+      ID(idVal),
+      Handle<>(&O2REG(PutById)),
+      strictMode);
+}
+
+JIT_HELPER_IMPL(getByVal) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  CallResult<PseudoHandle<>> resPH{ExecutionStatus::EXCEPTION};
+  if (LLVM_LIKELY(O2REG(GetByVal).isObject())) {
+    resPH = JSObject::getComputed_RJS(
+        Handle<JSObject>::vmcast(&O2REG(GetByVal)),
+        runtime,
+        Handle<>(&O3REG(GetByVal)));
+  } else {
+    resPH = Interpreter::getByValTransient_RJS(
+        runtime, Handle<>(&O2REG(GetByVal)), Handle<>(&O3REG(GetByVal)));
+  }
+  if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(GetByVal) = resPH->get();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(putByVal) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  bool strictMode = curCodeBlock->isStrictMode();
+  if (LLVM_LIKELY(O1REG(PutByVal).isObject())) {
+    auto putRes = JSObject::putComputed_RJS(
+        Handle<JSObject>::vmcast(&O1REG(PutByVal)),
+        runtime,
+        Handle<>(&O2REG(PutByVal)),
+        Handle<>(&O3REG(PutByVal)),
+        DEFAULT_PROP_OP_FLAGS(strictMode));
+    if (LLVM_UNLIKELY(putRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    return ExecutionStatus::RETURNED;
+  }
+  return Interpreter::putByValTransient_RJS(
+      runtime,
+      Handle<>(&O1REG(PutByVal)),
+      Handle<>(&O2REG(PutByVal)),
+      Handle<>(&O3REG(PutByVal)),
+      strictMode);
+}
+
+JIT_HELPER_IMPL(putNewOwnById) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  uint32_t idVal;
+  switch (ip->opCode) {
+    case OpCode::PutNewOwnByIdShort:
+      idVal = ip->iPutNewOwnByIdShort.op3;
+      break;
+    case OpCode::PutNewOwnById:
+    case OpCode::PutNewOwnNEById:
+      idVal = ip->iPutNewOwnById.op3;
+      break;
+    default:
+      assert(
+          (ip->opCode == OpCode::PutNewOwnByIdLong ||
+           ip->opCode == OpCode::PutNewOwnNEByIdLong) &&
+          "bad opcode");
+      idVal = ip->iPutNewOwnByIdLong.op3;
+      break;
+  }
+  assert(
+      O1REG(PutNewOwnById).isObject() &&
+      "Object argument of PutNewOwnById must be an object");
+  return JSObject::defineNewOwnProperty(
+      Handle<JSObject>::vmcast(&O1REG(PutNewOwnById)),
+      runtime,
+      ID(idVal),
+      ip->opCode <= OpCode::PutNewOwnByIdLong
+          ? PropertyFlags::defaultNewNamedPropertyFlags()
+          : PropertyFlags::nonEnumerablePropertyFlags(),
+      Handle<>(&O2REG(PutNewOwnById)));
+}
+
+JIT_HELPER_IMPL(putOwnByIndex) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  uint32_t idVal = ip->opCode == OpCode::PutOwnByIndex
+      ? ip->iPutOwnByIndex.op3
+      : ip->iPutOwnByIndexL.op3;
+  auto indexHandle =
+      runtime.makeHandle(HermesValue::encodeUntrustedNumberValue(idVal));
+  JSObject::defineOwnComputedPrimitive(
+      Handle<JSObject>::vmcast(&O1REG(PutOwnByIndex)),
+      runtime,
+      indexHandle,
+      DefinePropertyFlags::getDefaultNewPropertyFlags(),
+      Handle<>(&O2REG(PutOwnByIndex)));
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(putOwnByVal) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  return Interpreter::casePutOwnByVal(runtime, frameRegs, ip);
+}
+
+JIT_HELPER_IMPL(putOwnGetterSetterByVal) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  return Interpreter::casePutOwnGetterSetterByVal(runtime, frameRegs, ip);
+}
+
+JIT_HELPER_IMPL(getPNameList) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  return Interpreter::caseGetPNameList(runtime, frameRegs, ip);
+}
+
+JIT_HELPER_IMPL(iteratorBegin) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  return Interpreter::caseIteratorBegin(runtime, frameRegs, ip);
+}
+
+JIT_HELPER_IMPL(iteratorNext) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  return Interpreter::caseIteratorNext(runtime, frameRegs, ip);
+}
+
+JIT_HELPER_IMPL(directEval) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  return Interpreter::caseDirectEval(runtime, frameRegs, ip);
+}
+
+//===----------------------------------------------------------------------===//
+// Object creation.
+
+JIT_HELPER_IMPL(newObject) {
+  runtime.setCurrentIP(ip);
+  O1REG(NewObject) = JSObject::create(runtime).getHermesValue();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(newObjectWithParent) {
+  runtime.setCurrentIP(ip);
+  O1REG(NewObjectWithParent) =
+      JSObject::create(
+          runtime,
+          O2REG(NewObjectWithParent).isObject()
+              ? Handle<JSObject>::vmcast(&O2REG(NewObjectWithParent))
+              : O2REG(NewObjectWithParent).isNull()
+              ? Runtime::makeNullHandle<JSObject>()
+              : Handle<JSObject>::vmcast(&runtime.objectPrototype))
+          .getHermesValue();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(newObjectWithBuffer) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  CallResult<PseudoHandle<>> resPH = ip->opCode == OpCode::NewObjectWithBuffer
+      ? Interpreter::createObjectFromBuffer(
+            runtime,
+            curCodeBlock,
+            ip->iNewObjectWithBuffer.op3,
+            ip->iNewObjectWithBuffer.op4,
+            ip->iNewObjectWithBuffer.op5)
+      : Interpreter::createObjectFromBuffer(
+            runtime,
+            curCodeBlock,
+            ip->iNewObjectWithBufferLong.op3,
+            ip->iNewObjectWithBufferLong.op4,
+            ip->iNewObjectWithBufferLong.op5);
+  if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(NewObjectWithBuffer) = resPH->get();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(newArray) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  auto createRes =
+      JSArray::create(runtime, ip->iNewArray.op2, ip->iNewArray.op2);
+  if (LLVM_UNLIKELY(createRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(NewArray) = createRes->getHermesValue();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(newArrayWithBuffer) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  CallResult<PseudoHandle<>> resPH = ip->opCode == OpCode::NewArrayWithBuffer
+      ? Interpreter::createArrayFromBuffer(
+            runtime,
+            curCodeBlock,
+            ip->iNewArrayWithBuffer.op2,
+            ip->iNewArrayWithBuffer.op3,
+            ip->iNewArrayWithBuffer.op4)
+      : Interpreter::createArrayFromBuffer(
+            runtime,
+            curCodeBlock,
+            ip->iNewArrayWithBufferLong.op2,
+            ip->iNewArrayWithBufferLong.op3,
+            ip->iNewArrayWithBufferLong.op4);
+  if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(NewArrayWithBuffer) = resPH->get();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(createThis) {
+  runtime.setCurrentIP(ip);
+  if (LLVM_UNLIKELY(!vmisa<Callable>(O3REG(CreateThis)))) {
+    return runtime.raiseTypeError("constructor is not callable");
+  }
+  GCScopeMarkerRAII marker{runtime};
+  auto res = Callable::newObject(
+      Handle<Callable>::vmcast(&O3REG(CreateThis)),
+      runtime,
+      Handle<JSObject>::vmcast(
+          O2REG(CreateThis).isObject() ? &O2REG(CreateThis)
+                                       : &runtime.objectPrototype));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(CreateThis) = res->getHermesValue();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(selectObject) {
+  O1REG(SelectObject) = O3REG(SelectObject).isObject() ? O3REG(SelectObject)
+                                                       : O2REG(SelectObject);
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(createClosure) {
+  runtime.setCurrentIP(ip);
+  uint32_t idVal = ip->opCode == OpCode::CreateClosure
+      ? ip->iCreateClosure.op3
+      : ip->iCreateClosureLongIndex.op3;
+  auto *runtimeModule = curCodeBlock->getRuntimeModule();
+  O1REG(CreateClosure) =
+      JSFunction::create(
+          runtime,
+          runtimeModule->getDomain(runtime),
+          Handle<JSObject>::vmcast(&runtime.functionPrototype),
+          Handle<Environment>::vmcast(&O2REG(CreateClosure)),
+          runtimeModule->getCodeBlockMayAllocate(idVal))
+          .getHermesValue();
+  return ExecutionStatus::RETURNED;
+}
+
+//===----------------------------------------------------------------------===//
+// Calls.
+
+JIT_HELPER_IMPL(call) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  uint32_t callArgCount;
+  // As in the interpreter, HermesValue cannot be assigned to.
+  HermesValue::RawType newTarget =
+      HermesValue::encodeUndefinedValue().getRaw();
+  StackFramePtr fr{runtime.stackPointer_};
+  // Note in Call1 through Call4, the first argument is 'this' which has
+  // argument index -1.
+  switch (ip->opCode) {
+    case OpCode::Call:
+      callArgCount = ip->iCall.op3;
+      break;
+    case OpCode::CallLong:
+      callArgCount = ip->iCallLong.op3;
+      break;
+    case OpCode::Construct:
+      callArgCount = ip->iConstruct.op3;
+      newTarget = O2REG(Construct).getRaw();
+      break;
+    case OpCode::ConstructLong:
+      callArgCount = ip->iConstructLong.op3;
+      newTarget = O2REG(ConstructLong).getRaw();
+      break;
+    case OpCode::Call1:
+      callArgCount = 1;
+      fr.getArgRefUnsafe(-1) = O3REG(Call1);
+      break;
+    case OpCode::Call2:
+      callArgCount = 2;
+      fr.getArgRefUnsafe(-1) = O3REG(Call2);
+      fr.getArgRefUnsafe(0) = O4REG(Call2);
+      break;
+    case OpCode::Call3:
+      callArgCount = 3;
+      fr.getArgRefUnsafe(-1) = O3REG(Call3);
+      fr.getArgRefUnsafe(0) = O4REG(Call3);
+      fr.getArgRefUnsafe(1) = O5REG(Call3);
+      break;
+    default:
+      assert(ip->opCode == OpCode::Call4 && "bad opcode");
+      callArgCount = 4;
+      fr.getArgRefUnsafe(-1) = O3REG(Call4);
+      fr.getArgRefUnsafe(0) = O4REG(Call4);
+      fr.getArgRefUnsafe(1) = O5REG(Call4);
+      fr.getArgRefUnsafe(2) = O6REG(Call4);
+      break;
+  }
+
+  // The callee frame has no saved CodeBlock, so that an interpreted callee
+  // returns here instead of continuing in the caller's bytecode.
+  StackFramePtr::initFrame(
+      runtime.stackPointer_,
+      FRAME,
+      ip,
+      nullptr,
+      callArgCount - 1,
+      O2REG(Call),
+      HermesValue::fromRaw(newTarget));
+
+  if (auto *func = dyn_vmcast<JSFunction>(O2REG(Call))) {
+    CallResult<HermesValue> res = callCodeBlock(
+        runtime, func->getCodeBlock(runtime), curCodeBlock, ip);
+    return storeResult(frameRegs, ip, res);
+  }
+  auto resPH = Interpreter::handleCallSlowPath(runtime, &O2REG(Call));
+  if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(Call) = resPH->get();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(callDirect) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  CodeBlock *calleeBlock = ip->opCode == OpCode::CallDirect
+      ? curCodeBlock->getRuntimeModule()->getCodeBlockMayAllocate(
+            ip->iCallDirect.op3)
+      : curCodeBlock->getRuntimeModule()->getCodeBlockMayAllocate(
+            ip->iCallDirectLongIndex.op3);
+  StackFramePtr::initFrame(
+      runtime.stackPointer_,
+      FRAME,
+      ip,
+      nullptr,
+      (uint32_t)ip->iCallDirect.op2 - 1,
+      HermesValue::encodeNativePointer(calleeBlock),
+      HermesValue::encodeUndefinedValue());
+  return storeResult(
+      frameRegs, ip, callCodeBlock(runtime, calleeBlock, curCodeBlock, ip));
+}
+
+JIT_HELPER_IMPL(callBuiltin) {
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  return Interpreter::implCallBuiltin(
+      runtime,
+      frameRegs,
+      curCodeBlock,
+      ip->opCode == OpCode::CallBuiltin ? ip->iCallBuiltin.op3
+                                        : ip->iCallBuiltinLong.op3);
+}
+
+JIT_HELPER_IMPL(getBuiltinClosure) {
+  Callable *closure = runtime.getBuiltinCallable(ip->iGetBuiltinClosure.op2);
+  O1REG(GetBuiltinClosure) = HermesValue::encodeObjectValue(closure);
+  return ExecutionStatus::RETURNED;
+}
+
+//===----------------------------------------------------------------------===//
+// 'this', async breaks and exceptions.
+
+JIT_HELPER_IMPL(coerceThisNS) {
+  if (LLVM_LIKELY(O2REG(CoerceThisNS).isObject())) {
+    O1REG(CoerceThisNS) = O2REG(CoerceThisNS);
+    return ExecutionStatus::RETURNED;
+  }
+  if (O2REG(CoerceThisNS).isNull() || O2REG(CoerceThisNS).isUndefined()) {
+    O1REG(CoerceThisNS) = runtime.global_;
+    return ExecutionStatus::RETURNED;
+  }
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  return storeResult(
+      frameRegs, ip, toObject(runtime, Handle<>(&O2REG(CoerceThisNS))));
+}
+
+JIT_HELPER_IMPL(loadThisNS) {
+  PinnedHermesValue &thisArg = FRAME.getThisArgRef();
+  if (LLVM_LIKELY(thisArg.isObject())) {
+    O1REG(LoadThisNS) = thisArg;
+    return ExecutionStatus::RETURNED;
+  }
+  if (thisArg.isNull() || thisArg.isUndefined()) {
+    O1REG(LoadThisNS) = runtime.global_;
+    return ExecutionStatus::RETURNED;
+  }
+  runtime.setCurrentIP(ip);
+  GCScopeMarkerRAII marker{runtime};
+  return storeResult(frameRegs, ip, toObject(runtime, Handle<>(&thisArg)));
+}
+
+JIT_HELPER_IMPL(asyncBreakCheck) {
+  // Debugger requests are left pending for the interpreter, since compiled
+  // code cannot be stepped.
+  if (LLVM_UNLIKELY(runtime.hasAsyncBreak()) &&
+      runtime.testAndClearTimeoutAsyncBreakRequest()) {
+    runtime.setCurrentIP(ip);
+    return runtime.notifyTimeout();
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_HELPER_IMPL(throwOp) {
+  runtime.setCurrentIP(ip);
+  runtime.thrownValue_ = O1REG(Throw);
+  return ExecutionStatus::EXCEPTION;
+}
+
+JIT_HELPER_IMPL(throwIfEmpty) {
+  if (LLVM_UNLIKELY(O2REG(ThrowIfEmpty).isEmpty())) {
+    runtime.setCurrentIP(ip);
+    return runtime.raiseReferenceError("accessing an uninitialized variable");
+  }
+  O1REG(ThrowIfEmpty) = O2REG(ThrowIfEmpty);
+  return ExecutionStatus::RETURNED;
+}
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMESVM_JIT
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_JIT_JITHELPERS_H
+#define HERMES_VM_JIT_JITHELPERS_H
+
+#include "hermes/VM/JIT/Config.h"
+
+#ifdef HERMESVM_JIT
+
+#include "hermes/VM/Runtime.h"
+
+namespace hermes {
+namespace vm {
+
+/// Out-of-line implementations of instructions, called from code emitted by
+/// the JIT. They mirror the corresponding cases of the interpreter loop and
+/// share its slow paths and property caches.
+///
+/// Every helper receives the runtime, the registers of the current frame, the
+/// instruction being executed and the CodeBlock containing it, so compiled code
+/// can call all of them the same way. This is a class so that it can be a
+/// friend of Runtime, like Interpreter.
+class JITHelpers {
+ public:
+  /// The result of a helper evaluating the condition of a branch.
+  enum class CondResult : uint32_t { False, True, Exception };
+
+  using Helper = ExecutionStatus (*)(
+      Runtime &runtime,
+      PinnedHermesValue *frameRegs,
+      const inst::Inst *ip,
+      CodeBlock *curCodeBlock);
+  using CondHelper = CondResult (*)(
+      Runtime &runtime,
+      PinnedHermesValue *frameRegs,
+      const inst::Inst *ip,
+      CodeBlock *curCodeBlock);
+
+#define JIT_HELPER(name)            \
+  static ExecutionStatus name(      \
+      Runtime &runtime,             \
+      PinnedHermesValue *frameRegs, \
+      const inst::Inst *ip,         \
+      CodeBlock *curCodeBlock);
+#define JIT_COND_HELPER(name)       \
+  static CondResult name(           \
+      Runtime &runtime,             \
+      PinnedHermesValue *frameRegs, \
+      const inst::Inst *ip,         \
+      CodeBlock *curCodeBlock);
+
+  /// Slow paths of instructions whose fast path is emitted inline: they are
+  /// only called once the operands are known not to be numbers.
+  JIT_HELPER(addSlowPath)
+  JIT_HELPER(subSlowPath)
+  JIT_HELPER(mulSlowPath)
+  JIT_HELPER(divSlowPath)
+  JIT_HELPER(incSlowPath)
+  JIT_HELPER(decSlowPath)
+
+  /// Conditional branches with non-number operands. These return whether the
+  /// un-negated condition holds, e.g. whether a < b for JNotLess.
+  JIT_COND_HELPER(toBoolean)
+  JIT_COND_HELPER(jLessSlowPath)
+  JIT_COND_HELPER(jLessEqualSlowPath)
+  JIT_COND_HELPER(jGreaterSlowPath)
+  JIT_COND_HELPER(jGreaterEqualSlowPath)
+  JIT_COND_HELPER(jEqual)
+  JIT_COND_HELPER(jStrictEqual)
+
+  /// Whole instructions. Each one handles all the variants of an opcode, such
+  /// as the short and long forms.
+  JIT_HELPER(mod)
+  JIT_HELPER(bitAnd)
+  JIT_HELPER(bitOr)
+  JIT_HELPER(bitXor)
+  JIT_HELPER(lShift)
+  JIT_HELPER(rShift)
+  JIT_HELPER(uRshift)
+  JIT_HELPER(bitNot)
+  JIT_HELPER(negate)
+  JIT_HELPER(notOp)
+  JIT_HELPER(typeOf)
+  JIT_HELPER(less)
+  JIT_HELPER(lessEq)
+  JIT_HELPER(greater)
+  JIT_HELPER(greaterEq)
+  JIT_HELPER(eq)
+  JIT_HELPER(strictEq)
+  JIT_HELPER(toNumber)
+  JIT_HELPER(toNumeric)
+  JIT_HELPER(toInt32)
+  JIT_HELPER(addEmptyString)
+  JIT_HELPER(instanceOf)
+  JIT_HELPER(isIn)
+  JIT_HELPER(loadConstString)
+  JIT_HELPER(getEnvironment)
+  JIT_HELPER(createEnvironment)
+  JIT_HELPER(createInnerEnvironment)
+  JIT_HELPER(storeToEnvironment)
+  JIT_HELPER(loadFromEnvironment)
+  JIT_HELPER(declareGlobalVar)
+  JIT_HELPER(getById)
+  JIT_HELPER(putById)
+  JIT_HELPER(getByVal)
+  JIT_HELPER(putByVal)
+  JIT_HELPER(putNewOwnById)
+  JIT_HELPER(putOwnByIndex)
+  JIT_HELPER(putOwnByVal)
+  JIT_HELPER(putOwnGetterSetterByVal)
+  JIT_HELPER(getPNameList)
+  JIT_HELPER(iteratorBegin)
+  JIT_HELPER(iteratorNext)
+  JIT_HELPER(directEval)
+  JIT_HELPER(newObject)
+  JIT_HELPER(newObjectWithParent)
+  JIT_HELPER(newObjectWithBuffer)
+  JIT_HELPER(newArray)
+  JIT_HELPER(newArrayWithBuffer)
+  JIT_HELPER(call)
+  JIT_HELPER(callDirect)
+  JIT_HELPER(callBuiltin)
+  JIT_HELPER(getBuiltinClosure)
+  JIT_HELPER(createThis)
+  JIT_HELPER(selectObject)
+  JIT_HELPER(createClosure)
+  JIT_HELPER(coerceThisNS)
+  JIT_HELPER(loadThisNS)
+  JIT_HELPER(asyncBreakCheck)
+  JIT_HELPER(throwOp)
+  JIT_HELPER(throwIfEmpty)
+
+#undef JIT_HELPER
+#undef JIT_COND_HELPER
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMESVM_JIT
+
+#endif // HERMES_VM_JIT_JITHELPERS_H
@@ -0,0 +1,688 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define DEBUG_TYPE "jit"
+#include "CodeGen.h"
+
+#ifdef HERMESVM_JIT
+
+#include "X86Emitter.h"
+
+#include "../JITHelpers.h"
+
+#include "hermes/BCGen/HBC/StackFrameLayout.h"
+#include "hermes/Inst/InstDecode.h"
+#include "hermes/VM/CodeBlock.h"
+
+#include "llvh/ADT/DenseMap.h"
+#include "llvh/ADT/Optional.h"
+#include "llvh/Support/Debug.h"
+
+namespace hermes {
+namespace vm {
+namespace x86_64 {
+
+using namespace hermes::inst;
+
+namespace {
+
+/// \return true if \p opCode is the long form of a jump.
+bool isLongJump(OpCode opCode) {
+  switch (opCode) {
+#define DEFINE_JUMP_LONG_VARIANT(shortName, longName) \
+  case OpCode::longName:                              \
+    return true;
+#include "hermes/BCGen/HBC/BytecodeList.def"
+    default:
+      return false;
+  }
+}
+
+/// \return the first instruction of the superinstruction \p opCode, or
+/// \p opCode if it isn't one. The second instruction of a superinstruction
+/// follows it in the bytecode, so only the first needs to be compiled.
+OpCode firstOfSuperinstruction(OpCode opCode) {
+  switch (opCode) {
+#define DEFINE_SUPERINSTRUCTION(name, first, second) \
+  case OpCode::name:                                 \
+    return OpCode::first;
+#include "hermes/BCGen/HBC/BytecodeList.def"
+    default:
+      return opCode;
+  }
+}
+
+/// Registers holding values that live across the whole function.
+/// The Runtime.
+constexpr Reg kRuntime = Reg::rbx;
+/// The first local register of the frame.
+constexpr Reg kFrameRegs = Reg::r12;
+/// The CodeBlock being executed.
+constexpr Reg kCodeBlock = Reg::r13;
+/// Where to store the return value.
+constexpr Reg kResult = Reg::r14;
+/// The smallest encoding of a HermesValue that isn't a number.
+constexpr Reg kFirstNonNumber = Reg::r15;
+
+/// Translates one function. All JS values stay in the register stack, so the
+/// code for each instruction is independent of the others, and the helpers see
+/// the registers exactly as the interpreter would.
+class CodeGen {
+ public:
+  CodeGen(Runtime &runtime, CodeBlock *codeBlock, std::vector<uint8_t> &code)
+      : runtime_(runtime), codeBlock_(codeBlock), a_(code) {}
+
+  bool run();
+
+ private:
+  /// A jump to a bytecode offset, resolved once all instructions have been
+  /// emitted.
+  struct BranchFixup {
+    size_t fixup;
+    uint32_t target;
+  };
+
+  /// The slow path of an instruction emitted inline, moved to the end of the
+  /// function. It calls exactly one of \c helper and \c condHelper.
+  struct SlowPath {
+    /// Jumps from the fast path to the slow path.
+    std::vector<size_t> jumps;
+    const Inst *ip;
+    JITHelpers::Helper helper;
+    JITHelpers::CondHelper condHelper;
+    /// Whether the branch is taken when \c condHelper returns false.
+    bool negate;
+    /// Where to continue after the slow path.
+    size_t resume;
+  };
+
+  /// \return the displacement of register \p reg from kFrameRegs.
+  static int32_t regDisp(uint32_t reg) {
+    return (int32_t)(reg * sizeof(PinnedHermesValue));
+  }
+  /// \return the displacement of the frame slot \p slot from kFrameRegs.
+  static int32_t frameDisp(int32_t slot) {
+    return (slot - StackFrameLayout::FirstLocal) *
+        (int32_t)sizeof(PinnedHermesValue);
+  }
+
+  /// \return the register operand \p fromEnd bytes before the end of \p ip.
+  /// The short and long forms of a jump only differ in the width of the
+  /// target, which precedes the registers.
+  static uint8_t trailingReg(const Inst *ip, unsigned fromEnd) {
+    return *((const uint8_t *)ip + getInstSize(ip->opCode) - fromEnd);
+  }
+
+  /// \return the bytecode offset targeted by the jump \p ip.
+  uint32_t jumpTarget(const Inst *ip) const {
+    int32_t rel = isLongJump(ip->opCode) ? ip->iJmpLong.op1 : ip->iJmp.op1;
+    return codeBlock_->getOffsetOf(ip) + rel;
+  }
+
+  void emitPrologue();
+  void emitEpilogue();
+
+  /// Emit a jump to the target of the jump instruction \p ip, conditional on
+  /// \p cc if it is set.
+  void emitBranch(const Inst *ip, llvh::Optional<Cond> cc);
+
+  /// Load register \p reg into \p dst, jumping to a slow path recorded in
+  /// \p slow if it isn't a number.
+  void loadNumberOrBranch(Reg dst, uint32_t reg, std::vector<size_t> &slow);
+
+  /// Emit a call to the helper at \p helper for \p ip, leaving its result in
+  /// eax.
+  void emitHelperCall(const Inst *ip, uint64_t helper);
+  /// Emit a call to \p helper, propagating an exception.
+  void emitHelper(const Inst *ip, JITHelpers::Helper helper);
+  /// Emit a call to \p helper and a jump to the target of \p ip if it returns
+  /// true, or false when \p negate is set, propagating an exception.
+  void emitCondHelperJump(
+      const Inst *ip,
+      JITHelpers::CondHelper helper,
+      bool negate);
+
+  /// Emit an arithmetic instruction with the usual three registers. \p helper
+  /// handles non-numbers, and is nullptr if they are known to be numbers.
+  void emitBinaryArith(
+      const Inst *ip,
+      Emitter::SDOp op,
+      JITHelpers::Helper helper);
+  /// Emit Inc or Dec.
+  void emitIncDec(const Inst *ip, Emitter::SDOp op, JITHelpers::Helper helper);
+  /// Emit a comparison jump. The operands are compared the other way around
+  /// if \p swap is set, so that the condition is always "above", or "above or
+  /// equal" if \p orEqual is set. \p negate is set for the "Not" forms, and
+  /// \p helper is nullptr for the "N" forms.
+  void emitCompareJump(
+      const Inst *ip,
+      bool swap,
+      bool orEqual,
+      bool negate,
+      JITHelpers::CondHelper helper);
+  void emitJmpTrueFalse(const Inst *ip, bool jumpIfTrue);
+  void emitLoadParam(const Inst *ip, uint32_t dst, uint32_t param);
+  void emitLoadConst(uint32_t dst, HermesValue value);
+
+  /// Emit the code for \p ip. \return false if it is not supported.
+  bool emitInst(const Inst *ip);
+
+  Runtime &runtime_;
+  CodeBlock *const codeBlock_;
+  Emitter a_;
+
+  /// Native offset of each bytecode instruction.
+  llvh::DenseMap<uint32_t, size_t> instOffsets_{};
+  std::vector<BranchFixup> branches_{};
+  std::vector<SlowPath> slowPaths_{};
+  /// Jumps to the code returning ExecutionStatus::EXCEPTION.
+  std::vector<size_t> exceptionJumps_{};
+  /// Jumps to the epilogue, with eax already set.
+  std::vector<size_t> epilogueJumps_{};
+};
+
+void CodeGen::emitPrologue() {
+  a_.push(Reg::rbp);
+  a_.mov(Reg::rbp, Reg::rsp);
+  a_.push(kRuntime);
+  a_.push(kFrameRegs);
+  a_.push(kCodeBlock);
+  a_.push(kResult);
+  a_.push(kFirstNonNumber);
+  // Keep the stack aligned to 16 bytes at calls.
+  a_.subRsp(8);
+  // The arguments of JITCompiledFunctionPtr.
+  a_.mov(kRuntime, Reg::rdi);
+  a_.mov(kFrameRegs, Reg::rsi);
+  a_.mov(kResult, Reg::rdx);
+  a_.movImm(kCodeBlock, (uint64_t)codeBlock_);
+  a_.movImm(
+      kFirstNonNumber,
+      (uint64_t)HermesValue::Tag::First << HermesValue::kNumDataBits);
+}
+
+void CodeGen::emitEpilogue() {
+  a_.addRsp(8);
+  a_.pop(kFirstNonNumber);
+  a_.pop(kResult);
+  a_.pop(kCodeBlock);
+  a_.pop(kFrameRegs);
+  a_.pop(kRuntime);
+  a_.pop(Reg::rbp);
+  a_.ret();
+}
+
+void CodeGen::emitBranch(const Inst *ip, llvh::Optional<Cond> cc) {
+  size_t fixup = cc ? a_.jcc(*cc) : a_.jmp();
+  branches_.push_back({fixup, jumpTarget(ip)});
+}
+
+void CodeGen::loadNumberOrBranch(
+    Reg dst,
+    uint32_t reg,
+    std::vector<size_t> &slow) {
+  a_.load(dst, kFrameRegs, regDisp(reg));
+  a_.cmp(dst, kFirstNonNumber);
+  slow.push_back(a_.jcc(Cond::ae));
+}
+
+void CodeGen::emitHelperCall(const Inst *ip, uint64_t helper) {
+  a_.mov(Reg::rdi, kRuntime);
+  a_.mov(Reg::rsi, kFrameRegs);
+  a_.movImm(Reg::rdx, (uint64_t)ip);
+  a_.mov(Reg::rcx, kCodeBlock);
+  a_.movImm(Reg::rax, helper);
+  a_.call(Reg::rax);
+}
+
+void CodeGen::emitHelper(const Inst *ip, JITHelpers::Helper helper) {
+  static_assert(
+      (uint32_t)ExecutionStatus::EXCEPTION == 0,
+      "exception checks test for zero");
+  emitHelperCall(ip, reinterpret_cast<uint64_t>(helper));
+  a_.test32(Reg::rax);
+  exceptionJumps_.push_back(a_.jcc(Cond::e));
+}
+
+void CodeGen::emitCondHelperJump(
+    const Inst *ip,
+    JITHelpers::CondHelper helper,
+    bool negate) {
+  emitHelperCall(ip, reinterpret_cast<uint64_t>(helper));
+  a_.cmp32Imm8(Reg::rax, (int8_t)JITHelpers::CondResult::Exception);
+  exceptionJumps_.push_back(a_.jcc(Cond::e));
+  static_assert(
+      (uint32_t)JITHelpers::CondResult::False == 0, "conditions test for zero");
+  a_.test32(Reg::rax);
+  emitBranch(ip, negate ? Cond::e : Cond::ne);
+}
+
+void CodeGen::emitBinaryArith(
+    const Inst *ip,
+    Emitter::SDOp op,
+    JITHelpers::Helper helper) {
+  // All arithmetic instructions have the same layout as Add.
+  SlowPath slow{{}, ip, helper, nullptr, false, 0};
+  if (helper) {
+    loadNumberOrBranch(Reg::rax, ip->iAdd.op2, slow.jumps);
+    loadNumberOrBranch(Reg::rcx, ip->iAdd.op3, slow.jumps);
+  }
+  a_.movsdLoad(XReg::xmm0, kFrameRegs, regDisp(ip->iAdd.op2));
+  a_.sdOp(op, XReg::xmm0, kFrameRegs, regDisp(ip->iAdd.op3));
+  a_.movsdStore(kFrameRegs, regDisp(ip->iAdd.op1), XReg::xmm0);
+  if (helper) {
+    slow.resume = a_.offset();
+    slowPaths_.push_back(std::move(slow));
+  }
+}
+
+void CodeGen::emitIncDec(
+    const Inst *ip,
+    Emitter::SDOp op,
+    JITHelpers::Helper helper) {
+  SlowPath slow{{}, ip, helper, nullptr, false, 0};
+  loadNumberOrBranch(Reg::rax, ip->iInc.op2, slow.jumps);
+  a_.movImm(Reg::rax, llvh::DoubleToBits(1.0));
+  a_.movqFromGPR(XReg::xmm1, Reg::rax);
+  a_.movsdLoad(XReg::xmm0, kFrameRegs, regDisp(ip->iInc.op2));
+  a_.sdOp(op, XReg::xmm0, XReg::xmm1);
+  a_.movsdStore(kFrameRegs, regDisp(ip->iInc.op1), XReg::xmm0);
+  slow.resume = a_.offset();
+  slowPaths_.push_back(std::move(slow));
+}
+
+void CodeGen::emitCompareJump(
+    const Inst *ip,
+    bool swap,
+    bool orEqual,
+    bool negate,
+    JITHelpers::CondHelper helper) {
+  uint8_t lhs = trailingReg(ip, 2);
+  uint8_t rhs = trailingReg(ip, 1);
+  SlowPath slow{{}, ip, nullptr, helper, negate, 0};
+  if (helper) {
+    loadNumberOrBranch(Reg::rax, lhs, slow.jumps);
+    loadNumberOrBranch(Reg::rcx, rhs, slow.jumps);
+  }
+  // ucomisd sets CF and ZF if the operands are unordered, so "above" and
+  // "above or equal" are false for NaN, and their negations are true.
+  a_.movsdLoad(XReg::xmm0, kFrameRegs, regDisp(swap ? rhs : lhs));
+  a_.ucomisd(XReg::xmm0, kFrameRegs, regDisp(swap ? lhs : rhs));
+  Cond cc = orEqual ? (negate ? Cond::b : Cond::ae)
+                    : (negate ? Cond::be : Cond::a);
+  emitBranch(ip, cc);
+  if (helper) {
+    slow.resume = a_.offset();
+    slowPaths_.push_back(std::move(slow));
+  }
+}
+
+void CodeGen::emitJmpTrueFalse(const Inst *ip, bool jumpIfTrue) {
+  // Booleans are checked inline, anything else goes through toBoolean.
+  a_.load(Reg::rax, kFrameRegs, regDisp(trailingReg(ip, 1)));
+  a_.movImm(Reg::rcx, HermesValue::encodeBoolValue(jumpIfTrue).getRaw());
+  a_.cmp(Reg::rax, Reg::rcx);
+  emitBranch(ip, Cond::e);
+  a_.movImm(Reg::rcx, HermesValue::encodeBoolValue(!jumpIfTrue).getRaw());
+  a_.cmp(Reg::rax, Reg::rcx);
+  size_t done = a_.jcc(Cond::e);
+  emitCondHelperJump(ip, JITHelpers::toBoolean, !jumpIfTrue);
+  a_.bind(done);
+}
+
+void CodeGen::emitLoadParam(const Inst *ip, uint32_t dst, uint32_t param) {
+  // Parameter 0 is 'this', and missing parameters are undefined.
+  a_.cmpMem32Imm(kFrameRegs, frameDisp(StackFrameLayout::ArgCount), param);
+  size_t missing = a_.jcc(Cond::b);
+  a_.load(
+      Reg::rax,
+      kFrameRegs,
+      frameDisp(StackFrameLayout::ThisArg - (int32_t)param));
+  size_t done = a_.jmp();
+  a_.bind(missing);
+  a_.movImm(Reg::rax, HermesValue::encodeUndefinedValue().getRaw());
+  a_.bind(done);
+  a_.store(kFrameRegs, regDisp(dst), Reg::rax);
+}
+
+void CodeGen::emitLoadConst(uint32_t dst, HermesValue value) {
+  a_.movImm(Reg::rax, value.getRaw());
+  a_.store(kFrameRegs, regDisp(dst), Reg::rax);
+}
+
+bool CodeGen::emitInst(const Inst *ip) {
+  using H = JITHelpers;
+  switch (firstOfSuperinstruction(ip->opCode)) {
+    case OpCode::Mov:
+      a_.load(Reg::rax, kFrameRegs, regDisp(ip->iMov.op2));
+      a_.store(kFrameRegs, regDisp(ip->iMov.op1), Reg::rax);
+      return true;
+    case OpCode::MovLong:
+      a_.load(Reg::rax, kFrameRegs, regDisp(ip->iMovLong.op2));
+      a_.store(kFrameRegs, regDisp(ip->iMovLong.op1), Reg::rax);
+      return true;
+
+    case OpCode::LoadParam:
+      emitLoadParam(ip, ip->iLoadParam.op1, ip->iLoadParam.op2);
+      return true;
+    case OpCode::LoadParamLong:
+      emitLoadParam(ip, ip->iLoadParamLong.op1, ip->iLoadParamLong.op2);
+      return true;
+    case OpCode::LoadConstUInt8:
+      emitLoadConst(
+          ip->iLoadConstUInt8.op1,
+          HermesValue::encodeTrustedNumberValue(ip->iLoadConstUInt8.op2));
+      return true;
+    case OpCode::LoadConstInt:
+      emitLoadConst(
+          ip->iLoadConstInt.op1,
+          HermesValue::encodeTrustedNumberValue(ip->iLoadConstInt.op2));
+      return true;
+    case OpCode::LoadConstDouble:
+      emitLoadConst(
+          ip->iLoadConstDouble.op1,
+          HermesValue::encodeUntrustedNumberValue(ip->iLoadConstDouble.op2));
+      return true;
+    case OpCode::LoadConstEmpty:
+      emitLoadConst(ip->iLoadConstEmpty.op1, HermesValue::encodeEmptyValue());
+      return true;
+    case OpCode::LoadConstUndefined:
+      emitLoadConst(
+          ip->iLoadConstUndefined.op1, HermesValue::encodeUndefinedValue());
+      return true;
+    case OpCode::LoadConstNull:
+      emitLoadConst(ip->iLoadConstNull.op1, HermesValue::encodeNullValue());
+      return true;
+    case OpCode::LoadConstTrue:
+      emitLoadConst(ip->iLoadConstTrue.op1, HermesValue::encodeBoolValue(true));
+      return true;
+    case OpCode::LoadConstFalse:
+      emitLoadConst(
+          ip->iLoadConstFalse.op1, HermesValue::encodeBoolValue(false));
+      return true;
+    case OpCode::LoadConstZero:
+      emitLoadConst(
+          ip->iLoadConstZero.op1, HermesValue::encodeTrustedNumberValue(0));
+      return true;
+
+    case OpCode::GetGlobalObject:
+      a_.movImm(Reg::rax, (uint64_t)&runtime_.global_);
+      a_.load(Reg::rax, Reg::rax, 0);
+      a_.store(kFrameRegs, regDisp(ip->iGetGlobalObject.op1), Reg::rax);
+      return true;
+    case OpCode::GetNewTarget:
+      a_.load(
+          Reg::rax, kFrameRegs, frameDisp(StackFrameLayout::NewTarget));
+      a_.store(kFrameRegs, regDisp(ip->iGetNewTarget.op1), Reg::rax);
+      return true;
+
+    case OpCode::Add:
+      emitBinaryArith(ip, Emitter::SDOp::add, H::addSlowPath);
+      return true;
+    case OpCode::AddN:
+      emitBinaryArith(ip, Emitter::SDOp::add, nullptr);
+      return true;
+    case OpCode::Sub:
+      emitBinaryArith(ip, Emitter::SDOp::sub, H::subSlowPath);
+      return true;
+    case OpCode::SubN:
+      emitBinaryArith(ip, Emitter::SDOp::sub, nullptr);
+      return true;
+    case OpCode::Mul:
+      emitBinaryArith(ip, Emitter::SDOp::mul, H::mulSlowPath);
+      return true;
+    case OpCode::MulN:
+      emitBinaryArith(ip, Emitter::SDOp::mul, nullptr);
+      return true;
+    case OpCode::Div:
+      emitBinaryArith(ip, Emitter::SDOp::div, H::divSlowPath);
+      return true;
+    case OpCode::DivN:
+      emitBinaryArith(ip, Emitter::SDOp::div, nullptr);
+      return true;
+    case OpCode::Inc:
+      emitIncDec(ip, Emitter::SDOp::add, H::incSlowPath);
+      return true;
+    case OpCode::Dec:
+      emitIncDec(ip, Emitter::SDOp::sub, H::decSlowPath);
+      return true;
+
+    case OpCode::Jmp:
+    case OpCode::JmpLong:
+      emitBranch(ip, llvh::None);
+      return true;
+    case OpCode::JmpTrue:
+    case OpCode::JmpTrueLong:
+      emitJmpTrueFalse(ip, true);
+      return true;
+    case OpCode::JmpFalse:
+    case OpCode::JmpFalseLong:
+      emitJmpTrueFalse(ip, false);
+      return true;
+    case OpCode::JmpUndefined:
+    case OpCode::JmpUndefinedLong:
+      a_.load(Reg::rax, kFrameRegs, regDisp(trailingReg(ip, 1)));
+      a_.movImm(Reg::rcx, HermesValue::encodeUndefinedValue().getRaw());
+      a_.cmp(Reg::rax, Reg::rcx);
+      emitBranch(ip, Cond::e);
+      return true;
+
+#define COMPARE_JUMP(name, swap, orEqual, helper)         \
+  case OpCode::J##name:                                   \
+  case OpCode::J##name##Long:                             \
+    emitCompareJump(ip, swap, orEqual, false, H::helper); \
+    return true;                                          \
+  case OpCode::JNot##name:                                \
+  case OpCode::JNot##name##Long:                          \
+    emitCompareJump(ip, swap, orEqual, true, H::helper);  \
+    return true;                                          \
+  case OpCode::J##name##N:                                \
+  case OpCode::J##name##NLong:                            \
+    emitCompareJump(ip, swap, orEqual, false, nullptr);   \
+    return true;                                          \
+  case OpCode::JNot##name##N:                             \
+  case OpCode::JNot##name##NLong:                         \
+    emitCompareJump(ip, swap, orEqual, true, nullptr);    \
+    return true;
+      COMPARE_JUMP(Less, true, false, jLessSlowPath)
+      COMPARE_JUMP(LessEqual, true, true, jLessEqualSlowPath)
+      COMPARE_JUMP(Greater, false, false, jGreaterSlowPath)
+      COMPARE_JUMP(GreaterEqual, false, true, jGreaterEqualSlowPath)
+#undef COMPARE_JUMP
+    case OpCode::JEqual:
+    case OpCode::JEqualLong:
+      emitCondHelperJump(ip, H::jEqual, false);
+      return true;
+    case OpCode::JNotEqual:
+    case OpCode::JNotEqualLong:
+      emitCondHelperJump(ip, H::jEqual, true);
+      return true;
+    case OpCode::JStrictEqual:
+    case OpCode::JStrictEqualLong:
+      emitCondHelperJump(ip, H::jStrictEqual, false);
+      return true;
+    case OpCode::JStrictNotEqual:
+    case OpCode::JStrictNotEqualLong:
+      emitCondHelperJump(ip, H::jStrictEqual, true);
+      return true;
+
+    case OpCode::Ret:
+      a_.load(Reg::rax, kFrameRegs, regDisp(ip->iRet.op1));
+      a_.store(kResult, 0, Reg::rax);
+      a_.mov32Imm(Reg::rax, (uint32_t)ExecutionStatus::RETURNED);
+      epilogueJumps_.push_back(a_.jmp());
+      return true;
+
+    case OpCode::Unreachable:
+      a_.ud2();
+      return true;
+
+#define HELPER(name, helper)   \
+  case OpCode::name:           \
+    emitHelper(ip, H::helper); \
+    return true;
+      HELPER(Mod, mod)
+      HELPER(BitAnd, bitAnd)
+      HELPER(BitOr, bitOr)
+      HELPER(BitXor, bitXor)
+      HELPER(LShift, lShift)
+      HELPER(RShift, rShift)
+      HELPER(URshift, uRshift)
+      HELPER(BitNot, bitNot)
+      HELPER(Negate, negate)
+      HELPER(Not, notOp)
+      HELPER(TypeOf, typeOf)
+      HELPER(Less, less)
+      HELPER(LessEq, lessEq)
+      HELPER(Greater, greater)
+      HELPER(GreaterEq, greaterEq)
+      HELPER(Eq, eq)
+      HELPER(Neq, eq)
+      HELPER(StrictEq, strictEq)
+      HELPER(StrictNeq, strictEq)
+      HELPER(ToNumber, toNumber)
+      HELPER(ToNumeric, toNumeric)
+      HELPER(ToInt32, toInt32)
+      HELPER(AddEmptyString, addEmptyString)
+      HELPER(InstanceOf, instanceOf)
+      HELPER(IsIn, isIn)
+      HELPER(LoadConstString, loadConstString)
+      HELPER(LoadConstStringLongIndex, loadConstString)
+      HELPER(GetEnvironment, getEnvironment)
+      HELPER(CreateEnvironment, createEnvironment)
+      HELPER(CreateInnerEnvironment, createInnerEnvironment)
+      HELPER(StoreToEnvironment, storeToEnvironment)
+      HELPER(StoreToEnvironmentL, storeToEnvironment)
+      HELPER(StoreNPToEnvironment, storeToEnvironment)
+      HELPER(StoreNPToEnvironmentL, storeToEnvironment)
+      HELPER(LoadFromEnvironment, loadFromEnvironment)
+      HELPER(LoadFromEnvironmentL, loadFromEnvironment)
+      HELPER(DeclareGlobalVar, declareGlobalVar)
+      HELPER(GetByIdShort, getById)
+      HELPER(GetById, getById)
+      HELPER(GetByIdLong, getById)
+      HELPER(TryGetById, getById)
+      HELPER(TryGetByIdLong, getById)
+      HELPER(PutById, putById)
+      HELPER(PutByIdLong, putById)
+      HELPER(TryPutById, putById)
+      HELPER(TryPutByIdLong, putById)
+      HELPER(GetByVal, getByVal)
+      HELPER(PutByVal, putByVal)
+      HELPER(PutNewOwnByIdShort, putNewOwnById)
+      HELPER(PutNewOwnById, putNewOwnById)
+      HELPER(PutNewOwnByIdLong, putNewOwnById)
+      HELPER(PutNewOwnNEById, putNewOwnById)
+      HELPER(PutNewOwnNEByIdLong, putNewOwnById)
+      HELPER(PutOwnByIndex, putOwnByIndex)
+      HELPER(PutOwnByIndexL, putOwnByIndex)
+      HELPER(PutOwnByVal, putOwnByVal)
+      HELPER(PutOwnGetterSetterByVal, putOwnGetterSetterByVal)
+      HELPER(IteratorBegin, iteratorBegin)
+      HELPER(IteratorNext, iteratorNext)
+      HELPER(DirectEval, directEval)
+      HELPER(NewObject, newObject)
+      HELPER(NewObjectWithParent, newObjectWithParent)
+      HELPER(NewObjectWithBuffer, newObjectWithBuffer)
+      HELPER(NewObjectWithBufferLong, newObjectWithBuffer)
+      HELPER(NewArray, newArray)
+      HELPER(NewArrayWithBuffer, newArrayWithBuffer)
+      HELPER(NewArrayWithBufferLong, newArrayWithBuffer)
+      HELPER(Call, call)
+      HELPER(CallLong, call)
+      HELPER(Construct, call)
+      HELPER(ConstructLong, call)
+      HELPER(Call1, call)
+      HELPER(Call2, call)
+      HELPER(Call3, call)
+      HELPER(Call4, call)
+      HELPER(CallDirect, callDirect)
+      HELPER(CallDirectLongIndex, callDirect)
+      HELPER(CallBuiltin, callBuiltin)
+      HELPER(CallBuiltinLong, callBuiltin)
+      HELPER(GetBuiltinClosure, getBuiltinClosure)
+      HELPER(CreateThis, createThis)
+      HELPER(SelectObject, selectObject)
+      HELPER(CreateClosure, createClosure)
+      HELPER(CreateClosureLongIndex, createClosure)
+      HELPER(CoerceThisNS, coerceThisNS)
+      HELPER(LoadThisNS, loadThisNS)
+      HELPER(AsyncBreakCheck, asyncBreakCheck)
+      HELPER(Throw, throwOp)
+      HELPER(ThrowIfEmpty, throwIfEmpty)
+#undef HELPER
+
+    default:
+      // Everything else, notably exception handlers, generators, the
+      // arguments object and the debugger, is left to the interpreter.
+      LLVM_DEBUG(
+          llvh::dbgs() << "JIT: unsupported instruction "
+                       << getOpCodeString(ip->opCode) << "\n");
+      return false;
+  }
+}
+
+bool CodeGen::run() {
+  // Displacements of registers must fit in 32 bits.
+  if (codeBlock_->getFrameSize() >= (1u << 24))
+    return false;
+
+  emitPrologue();
+
+  const uint8_t *begin = codeBlock_->begin();
+  const uint8_t *end = codeBlock_->end();
+  for (const uint8_t *cur = begin; cur < end;) {
+    const Inst *ip = reinterpret_cast<const Inst *>(cur);
+    if (ip->opCode >= OpCode::_last)
+      return false;
+    instOffsets_[cur - begin] = a_.offset();
+    if (!emitInst(ip))
+      return false;
+    cur += getInstSize(ip->opCode);
+  }
+
+  for (SlowPath &slow : slowPaths_) {
+    for (size_t fixup : slow.jumps)
+      a_.bind(fixup);
+    if (slow.helper) {
+      emitHelper(slow.ip, slow.helper);
+    } else {
+      emitCondHelperJump(slow.ip, slow.condHelper, slow.negate);
+    }
+    a_.patch(a_.jmp(), slow.resume);
+  }
+
+  for (const BranchFixup &branch : branches_) {
+    auto it = instOffsets_.find(branch.target);
+    if (it == instOffsets_.end())
+      return false;
+    a_.patch(branch.fixup, it->second);
+  }
+
+  for (size_t fixup : exceptionJumps_)
+    a_.bind(fixup);
+  a_.zero32(Reg::rax);
+  for (size_t fixup : epilogueJumps_)
+    a_.bind(fixup);
+  emitEpilogue();
+  return true;
+}
+
+} // namespace
+
+bool generateCode(
+    Runtime &runtime,
+    CodeBlock *codeBlock,
+    std::vector<uint8_t> &code) {
+  return CodeGen(runtime, codeBlock, code).run();
+}
+
+} // namespace x86_64
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMESVM_JIT
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_JIT_X86_64_CODEGEN_H
+#define HERMES_VM_JIT_X86_64_CODEGEN_H
+
+#include "hermes/VM/JIT/Config.h"
+
+#ifdef HERMESVM_JIT
+
+#include <cstdint>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+class CodeBlock;
+
+namespace x86_64 {
+
+/// Translate the bytecode of \p codeBlock into machine code implementing a
+/// JITCompiledFunctionPtr, appending it to \p code.
+/// \return false if the function contains an instruction that the JIT doesn't
+///   support, in which case it must keep running in the interpreter.
+bool generateCode(
+    Runtime &runtime,
+    CodeBlock *codeBlock,
+    std::vector<uint8_t> &code);
+
+} // namespace x86_64
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMESVM_JIT
+
+#endif // HERMES_VM_JIT_X86_64_CODEGEN_H
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_JIT_X86_64_X86EMITTER_H
+#define HERMES_VM_JIT_X86_64_X86EMITTER_H
+
+#include "llvh/Support/MathExtras.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+namespace x86_64 {
+
+/// General purpose registers, numbered as in the instruction encoding.
+enum class Reg : uint8_t {
+  rax,
+  rcx,
+  rdx,
+  rbx,
+  rsp,
+  rbp,
+  rsi,
+  rdi,
+  r8,
+  r9,
+  r10,
+  r11,
+  r12,
+  r13,
+  r14,
+  r15,
+};
+
+/// SSE registers.
+enum class XReg : uint8_t { xmm0, xmm1 };
+
+/// Condition codes, numbered as in the encoding of Jcc.
+enum class Cond : uint8_t {
+  b = 0x2, ///< Below (unsigned), CF=1.
+  ae = 0x3, ///< Above or equal (unsigned), CF=0.
+  e = 0x4,
+  ne = 0x5,
+  be = 0x6, ///< Below or equal (unsigned), CF=1 or ZF=1.
+  a = 0x7, ///< Above (unsigned), CF=0 and ZF=0.
+};
+
+/// A minimal assembler for the handful of x86-64 instructions the baseline JIT
+/// needs. Memory operands are always of the form [base + disp32].
+class Emitter {
+ public:
+  explicit Emitter(std::vector<uint8_t> &buf) : buf_(buf) {}
+
+  /// \return the current offset in the output.
+  size_t offset() const {
+    return buf_.size();
+  }
+
+  void push(Reg r) {
+    rexIfNeeded(false, 0, idx(r));
+    emit8(0x50 | (idx(r) & 7));
+  }
+  void pop(Reg r) {
+    rexIfNeeded(false, 0, idx(r));
+    emit8(0x58 | (idx(r) & 7));
+  }
+  void ret() {
+    emit8(0xc3);
+  }
+  void ud2() {
+    emit8(0x0f);
+    emit8(0x0b);
+  }
+
+  /// mov dst, src
+  void mov(Reg dst, Reg src) {
+    rex(true, idx(src), idx(dst));
+    emit8(0x89);
+    emit8(0xc0 | ((idx(src) & 7) << 3) | (idx(dst) & 7));
+  }
+  /// movabs dst, imm64
+  void movImm(Reg dst, uint64_t imm) {
+    rex(true, 0, idx(dst));
+    emit8(0xb8 | (idx(dst) & 7));
+    emit64(imm);
+  }
+  /// mov dst, [base + disp]
+  void load(Reg dst, Reg base, int32_t disp) {
+    rex(true, idx(dst), idx(base));
+    emit8(0x8b);
+    modrmMem(idx(dst), base, disp);
+  }
+  /// mov [base + disp], src
+  void store(Reg base, int32_t disp, Reg src) {
+    rex(true, idx(src), idx(base));
+    emit8(0x89);
+    modrmMem(idx(src), base, disp);
+  }
+  /// mov r32, imm32
+  void mov32Imm(Reg dst, uint32_t imm) {
+    rexIfNeeded(false, 0, idx(dst));
+    emit8(0xb8 | (idx(dst) & 7));
+    emit32(imm);
+  }
+  /// xor r32, r32
+  void zero32(Reg r) {
+    rexIfNeeded(false, idx(r), idx(r));
+    emit8(0x31);
+    emit8(0xc0 | ((idx(r) & 7) << 3) | (idx(r) & 7));
+  }
+
+  /// cmp a, b
+  void cmp(Reg a, Reg b) {
+    rex(true, idx(b), idx(a));
+    emit8(0x39);
+    emit8(0xc0 | ((idx(b) & 7) << 3) | (idx(a) & 7));
+  }
+  /// cmp r32, imm8
+  void cmp32Imm8(Reg r, int8_t imm) {
+    rexIfNeeded(false, 0, idx(r));
+    emit8(0x83);
+    emit8(0xc0 | (7 << 3) | (idx(r) & 7));
+    emit8((uint8_t)imm);
+  }
+  /// cmp dword [base + disp], imm32
+  void cmpMem32Imm(Reg base, int32_t disp, uint32_t imm) {
+    rexIfNeeded(false, 0, idx(base));
+    emit8(0x81);
+    modrmMem(7, base, disp);
+    emit32(imm);
+  }
+  /// test r32, r32
+  void test32(Reg r) {
+    rexIfNeeded(false, idx(r), idx(r));
+    emit8(0x85);
+    emit8(0xc0 | ((idx(r) & 7) << 3) | (idx(r) & 7));
+  }
+
+  /// sub rsp, imm8 / add rsp, imm8
+  void subRsp(int8_t imm) {
+    rex(true, 0, idx(Reg::rsp));
+    emit8(0x83);
+    emit8(0xc0 | (5 << 3) | idx(Reg::rsp));
+    emit8((uint8_t)imm);
+  }
+  void addRsp(int8_t imm) {
+    rex(true, 0, idx(Reg::rsp));
+    emit8(0x83);
+    emit8(0xc0 | (0 << 3) | idx(Reg::rsp));
+    emit8((uint8_t)imm);
+  }
+
+  /// call r
+  void call(Reg r) {
+    rexIfNeeded(false, 0, idx(r));
+    emit8(0xff);
+    emit8(0xc0 | (2 << 3) | (idx(r) & 7));
+  }
+
+  /// Emit a jmp with a 32-bit displacement to be patched later.
+  /// \return the offset of the displacement.
+  size_t jmp() {
+    emit8(0xe9);
+    emit32(0);
+    return offset() - 4;
+  }
+  /// Emit a jcc with a 32-bit displacement to be patched later.
+  /// \return the offset of the displacement.
+  size_t jcc(Cond cc) {
+    emit8(0x0f);
+    emit8(0x80 | (uint8_t)cc);
+    emit32(0);
+    return offset() - 4;
+  }
+  /// Make the jump whose displacement is at \p fixup go to \p target.
+  void patch(size_t fixup, size_t target) {
+    int32_t rel = (int32_t)((int64_t)target - (int64_t)(fixup + 4));
+    memcpy(&buf_[fixup], &rel, sizeof(rel));
+  }
+  /// Make the jump whose displacement is at \p fixup go to the current offset.
+  void bind(size_t fixup) {
+    patch(fixup, offset());
+  }
+
+  /// movsd x, [base + disp]
+  void movsdLoad(XReg x, Reg base, int32_t disp) {
+    emit8(0xf2);
+    rexIfNeeded(false, idx(x), idx(base));
+    emit8(0x0f);
+    emit8(0x10);
+    modrmMem(idx(x), base, disp);
+  }
+  /// movsd [base + disp], x
+  void movsdStore(Reg base, int32_t disp, XReg x) {
+    emit8(0xf2);
+    rexIfNeeded(false, idx(x), idx(base));
+    emit8(0x0f);
+    emit8(0x11);
+    modrmMem(idx(x), base, disp);
+  }
+  /// movq x, r
+  void movqFromGPR(XReg x, Reg r) {
+    emit8(0x66);
+    rex(true, idx(x), idx(r));
+    emit8(0x0f);
+    emit8(0x6e);
+    emit8(0xc0 | ((idx(x) & 7) << 3) | (idx(r) & 7));
+  }
+
+  /// The scalar double operations with a memory operand. \p op is the second
+  /// opcode byte.
+  enum class SDOp : uint8_t { add = 0x58, mul = 0x59, sub = 0x5c, div = 0x5e };
+  void sdOp(SDOp op, XReg x, Reg base, int32_t disp) {
+    emit8(0xf2);
+    rexIfNeeded(false, idx(x), idx(base));
+    emit8(0x0f);
+    emit8((uint8_t)op);
+    modrmMem(idx(x), base, disp);
+  }
+  /// The same operations between two registers.
+  void sdOp(SDOp op, XReg x, XReg y) {
+    emit8(0xf2);
+    emit8(0x0f);
+    emit8((uint8_t)op);
+    emit8(0xc0 | (idx(x) << 3) | idx(y));
+  }
+  /// ucomisd x, [base + disp]
+  void ucomisd(XReg x, Reg base, int32_t disp) {
+    emit8(0x66);
+    rexIfNeeded(false, idx(x), idx(base));
+    emit8(0x0f);
+    emit8(0x2e);
+    modrmMem(idx(x), base, disp);
+  }
+
+ private:
+  static uint8_t idx(Reg r) {
+    return (uint8_t)r;
+  }
+  static uint8_t idx(XReg x) {
+    return (uint8_t)x;
+  }
+
+  void emit8(uint8_t b) {
+    buf_.push_back(b);
+  }
+  void emit32(uint32_t v) {
+    for (unsigned i = 0; i < 4; ++i)
+      emit8((uint8_t)(v >> (i * 8)));
+  }
+  void emit64(uint64_t v) {
+    for (unsigned i = 0; i < 8; ++i)
+      emit8((uint8_t)(v >> (i * 8)));
+  }
+
+  /// Emit a REX prefix with W set to \p w, and R and B taken from the high
+  /// bit of \p reg and \p rm.
+  void rex(bool w, uint8_t reg, uint8_t rm) {
+    emit8(0x40 | (w << 3) | ((reg >> 3) << 2) | (rm >> 3));
+  }
+  /// Emit a REX prefix only if it is needed to encode the operands.
+  void rexIfNeeded(bool w, uint8_t reg, uint8_t rm) {
+    if (w || reg >= 8 || rm >= 8)
+      rex(w, reg, rm);
+  }
+
+  /// Emit the ModRM byte, and SIB and displacement, of [base + disp] with
+  /// \p reg in the reg field.
+  void modrmMem(uint8_t reg, Reg base, int32_t disp) {
+    bool short8 = llvh::isInt<8>(disp);
+    emit8((short8 ? 0x40 : 0x80) | ((reg & 7) << 3) | (idx(base) & 7));
+    // rsp and r12 can only be used as a base with a SIB byte.
+    if ((idx(base) & 7) == idx(Reg::rsp))
+      emit8(0x24);
+    if (short8)
+      emit8((uint8_t)disp);
+    else
+      emit32((uint32_t)disp);
+  }
+
+  std::vector<uint8_t> &buf_;
+};
+
+} // namespace x86_64
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JIT_X86_64_X86EMITTER_H
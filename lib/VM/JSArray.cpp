@@ -546,6 +546,32 @@ CallResult<Handle<JSArray>> JSArray::createNoAllocPropStorage(
       classHandle->getNumProperties() >= jsArrayPropertyCount() &&
       "invalid number of properties in JSArray hidden class");
 
+  // Only allocate the storage if capacity is not zero.
+  if (capacity) {
+    if (LLVM_UNLIKELY(capacity > StorageType::maxElements()))
+      return runtime.raiseRangeError("Out of memory for array elements");
+    const uint32_t storageSize =
+        StorageType::allocationSizeForCapacity(capacity);
+    if (LLVM_LIKELY(
+            cellSize<JSArray>() + heapAlignSize(storageSize) <=
+            GC::maxAllocationSize())) {
+      // Allocate the array and its storage together, which saves a check for
+      // a collection, and means the array never needs a handle to survive the
+      // storage allocation.
+      auto batch = runtime.allocBatch<2>({cellSize<JSArray>(), storageSize});
+      auto *arr = batch.make<JSArray>(
+          runtime, prototypeHandle, classHandle, GCPointerBase::NoBarriers());
+      auto *storage = batch.make<StorageType>();
+      auto self = JSObjectInit::initToHandle(runtime, arr);
+      self->setIndexedStorage(runtime, storage, runtime.getHeap());
+      putLength(
+          self.get(),
+          runtime,
+          SmallHermesValue::encodeNumberValue(length, runtime));
+      return self;
+    }
+  }
+
   auto self = JSObjectInit::initToHandle(
       runtime,
       runtime.makeAFixed<JSArray>(
@@ -553,8 +579,6 @@ CallResult<Handle<JSArray>> JSArray::createNoAllocPropStorage(
 
   // Only allocate the storage if capacity is not zero.
   if (capacity) {
-    if (LLVM_UNLIKELY(capacity > StorageType::maxElements()))
-      return runtime.raiseRangeError("Out of memory for array elements");
     auto arrRes = StorageType::create(runtime, capacity);
     if (arrRes == ExecutionStatus::EXCEPTION) {
       return ExecutionStatus::EXCEPTION;
@@ -150,6 +150,10 @@ hermesInternalGetInstrumentedStats(void *, Runtime &runtime, NativeArgs args) {
   ADD_PROP("js_vaSize", info.va);
   ADD_PROP("js_externalBytes", info.externalBytes);
   ADD_PROP("js_markStackOverflows", info.numMarkStackOverflows);
+
+  auto &regExpCache = runtime.getRegExpCache();
+  ADD_PROP("js_regExpCacheHits", regExpCache.getNumHits());
+  ADD_PROP("js_regExpCacheMisses", regExpCache.getNumMisses());
 #undef ADD_PROP
 
   return resultHandle.getHermesValue();
@@ -7,6 +7,8 @@
 
 #include "JSONLexer.h"
 
+#include "hermes/Support/StringKernels.h"
+#include "hermes/Support/UTF8.h"
 #include "hermes/VM/StringPrimitive.h"
 #include "llvh/ADT/ScopeExit.h"
 
@@ -107,6 +109,46 @@ CallResult<char16_t> JSONLexer::consumeUnicode() {
   return static_cast<char16_t>(val);
 }
 
+/// Parse \p str if it is a simple decimal: an optional minus sign and at most
+/// 15 digits, with an optional fraction and no exponent. Such a number is
+/// exactly an integer below 2^53 divided by a power of ten no greater than
+/// 10^15, both representable as doubles, so one division rounds it correctly.
+/// \return whether \p str was parsed into \p result.
+static bool parseSimpleDecimal(llvh::ArrayRef<char> str, double &result) {
+  static constexpr double kPowersOfTen[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+      1e13, 1e14, 1e15};
+  static constexpr unsigned kMaxDigits = 15;
+
+  const char *ptr = str.begin();
+  const char *end = str.end();
+  bool negative = ptr != end && *ptr == '-';
+  if (negative)
+    ++ptr;
+  uint64_t mantissa = 0;
+  unsigned numDigits = 0;
+  unsigned numFractionDigits = 0;
+  bool inFraction = false;
+  for (; ptr != end; ++ptr) {
+    char ch = *ptr;
+    if (ch >= '0' && ch <= '9') {
+      if (++numDigits > kMaxDigits)
+        return false;
+      mantissa = mantissa * 10 + (ch - '0');
+      numFractionDigits += inFraction;
+    } else if (ch == '.' && !inFraction && numDigits) {
+      inFraction = true;
+    } else {
+      return false;
+    }
+  }
+  if (!numDigits || (inFraction && !numFractionDigits))
+    return false;
+  double value = (double)mantissa / kPowersOfTen[numFractionDigits];
+  result = negative ? -value : value;
+  return true;
+}
+
 ExecutionStatus JSONLexer::scanNumber() {
   llvh::SmallVector<char, 32> str8;
   while (curCharPtr_.hasChar()) {
@@ -126,10 +168,16 @@ ExecutionStatus JSONLexer::scanNumber() {
     return errorWithChar(u"Unexpected character in number: ", str8[1]);
   }
 
+  double value;
+  if (parseSimpleDecimal(str8, value)) {
+    token_.setNumber(value);
+    return ExecutionStatus::RETURNED;
+  }
+
   str8.push_back('\0');
 
   char *endPtr;
-  double value = ::hermes_g_strtod(str8.data(), &endPtr);
+  value = ::hermes_g_strtod(str8.data(), &endPtr);
   if (endPtr != str8.data() + len) {
     return errorWithChar(u"Unexpected character in number: ", *endPtr);
   }
@@ -154,6 +202,24 @@ ExecutionStatus JSONLexer::scanString() {
   hermes::JenkinsHash hash = hermes::JenkinsHashInit;
 
   while (curCharPtr_.hasChar()) {
+    // Consume the run of code units which need no special handling at once.
+    llvh::ArrayRef<char16_t> buffered = curCharPtr_.buffered();
+    llvh::ArrayRef<char16_t> run{
+        buffered.begin(),
+        findJSONStringSpecial(buffered.begin(), buffered.end())};
+    if (!run.empty()) {
+      if (hasEscape)
+        tmpStorage.append(run);
+      if constexpr (ForKey::value) {
+        for (char16_t c : run)
+          hash = hermes::updateJenkinsHash(hash, c);
+      } else {
+        allAscii = allAscii && isAllASCII(run.begin(), run.end());
+      }
+      curCharPtr_.skip(run.size());
+      continue;
+    }
+
     if (*curCharPtr_ == '"') {
       // End of string.
       llvh::ArrayRef<char16_t> strRef =
@@ -174,66 +240,59 @@ ExecutionStatus JSONLexer::scanString() {
       }
       token_.setString(runtime_.makeHandle<StringPrimitive>(*strRes));
       return ExecutionStatus::RETURNED;
-    } else if (*curCharPtr_ <= '\u001F') {
+    } else if (*curCharPtr_ != u'\\') {
       return error(u"U+0000 thru U+001F is not allowed in string");
     }
-    char16_t scannedChar = -1;
-    if (*curCharPtr_ == u'\\') {
-      if (!hasEscape) {
-        // This is the first escape character encountered, so append everything
-        // we've seen so far to tmpStorage.
-        tmpStorage.append(curCharPtr_.endCapture());
-      }
-      hasEscape = true;
-      ++curCharPtr_;
-      if (!curCharPtr_.hasChar()) {
-        return error("Unexpected end of input");
-      }
-      switch (*curCharPtr_) {
+
+    if (!hasEscape) {
+      // This is the first escape character encountered, so append everything
+      // we've seen so far to tmpStorage.
+      tmpStorage.append(curCharPtr_.endCapture());
+    }
+    hasEscape = true;
+    ++curCharPtr_;
+    if (!curCharPtr_.hasChar()) {
+      return error("Unexpected end of input");
+    }
+    switch (*curCharPtr_) {
 #define CONSUME_VAL(v)     \
   tmpStorage.push_back(v); \
   ++curCharPtr_;
 
-        case u'"':
-        case u'/':
-        case u'\\':
-          CONSUME_VAL(*curCharPtr_)
-          break;
-        case 'b':
-          CONSUME_VAL(8)
-          break;
-        case 'f':
-          CONSUME_VAL(12)
-          break;
-        case 'n':
-          CONSUME_VAL(10)
-          break;
-        case 'r':
-          CONSUME_VAL(13)
-          break;
-        case 't':
-          CONSUME_VAL(9)
-          break;
-        case 'u': {
-          ++curCharPtr_;
-          CallResult<char16_t> cr = consumeUnicode();
-          if (LLVM_UNLIKELY(cr == ExecutionStatus::EXCEPTION)) {
-            return ExecutionStatus::EXCEPTION;
-          }
-          tmpStorage.push_back(*cr);
-          break;
+      case u'"':
+      case u'/':
+      case u'\\':
+        CONSUME_VAL(*curCharPtr_)
+        break;
+      case 'b':
+        CONSUME_VAL(8)
+        break;
+      case 'f':
+        CONSUME_VAL(12)
+        break;
+      case 'n':
+        CONSUME_VAL(10)
+        break;
+      case 'r':
+        CONSUME_VAL(13)
+        break;
+      case 't':
+        CONSUME_VAL(9)
+        break;
+      case 'u': {
+        ++curCharPtr_;
+        CallResult<char16_t> cr = consumeUnicode();
+        if (LLVM_UNLIKELY(cr == ExecutionStatus::EXCEPTION)) {
+          return ExecutionStatus::EXCEPTION;
         }
-
-        default:
-          return errorWithChar(u"Invalid escape sequence: ", *curCharPtr_);
+        tmpStorage.push_back(*cr);
+        break;
       }
-      scannedChar = tmpStorage.back();
-    } else {
-      scannedChar = *curCharPtr_;
-      if (hasEscape)
-        tmpStorage.push_back(scannedChar);
-      ++curCharPtr_;
+
+      default:
+        return errorWithChar(u"Invalid escape sequence: ", *curCharPtr_);
     }
+    char16_t scannedChar = tmpStorage.back();
     if constexpr (ForKey::value) {
       hash = hermes::updateJenkinsHash(hash, scannedChar);
     } else {
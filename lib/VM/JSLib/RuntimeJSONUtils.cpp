@@ -63,6 +63,30 @@ class RuntimeJSONParser {
   /// If it drops below 0 while parsing, raise a stack overflow.
   int32_t remainingDepth_{MAX_RECURSION_DEPTH};
 
+  /// The number of object nesting levels whose shapes are predicted.
+  static constexpr unsigned kNumShapePredictions = 8;
+
+  /// The keys and hidden class of the last object parsed at some nesting
+  /// level. Arrays of records repeat the same keys in the same order, so the
+  /// next object at that level is created with this class up front, and its
+  /// values are stored straight into their slots while its keys match.
+  struct ShapePrediction {
+    /// The class, which also keeps the symbols in keys alive. Null if there
+    /// is no prediction.
+    MutableHandle<HiddenClass> clazz;
+
+    /// The keys in the order they were added to clazz, so key i is in slot i.
+    llvh::SmallVector<SymbolID, 8> keys{};
+
+    explicit ShapePrediction(Runtime &runtime) : clazz(runtime) {}
+  };
+
+  /// Predictions for the outermost kNumShapePredictions object nesting levels.
+  llvh::SmallVector<ShapePrediction, kNumShapePredictions> shapePredictions_{};
+
+  /// The number of objects enclosing the value being parsed.
+  unsigned objectDepth_ = 0;
+
  public:
   explicit RuntimeJSONParser(
       Runtime &runtime,
@@ -71,7 +95,10 @@ class RuntimeJSONParser {
       : runtime_(runtime),
         lexer_(runtime, std::move(jsonString)),
         reviver_(reviver),
-        tmpHandle_(runtime) {}
+        tmpHandle_(runtime) {
+    for (unsigned i = 0; i < kNumShapePredictions; ++i)
+      shapePredictions_.emplace_back(runtime);
+  }
 
   /// Parse JSON string through lexer_, create objects using runtime_.
   /// If errors occur, this function will return undefined, and the error
@@ -92,6 +119,14 @@ class RuntimeJSONParser {
   /// When this function is finished, the current token must be "}".
   CallResult<HermesValue> parseObject();
 
+  /// Replace \p object, which was created with the class of \p prediction,
+  /// with an ordinary object that has only the first \p count properties of
+  /// that class. Called once a key does not match the prediction.
+  void abandonPrediction(
+      MutableHandle<JSObject> &object,
+      const ShapePrediction &prediction,
+      uint32_t count);
+
   /// Use reviver to filter the result.
   CallResult<HermesValue> revive(Handle<> value);
 
@@ -164,11 +199,19 @@ class JSONStringifyer {
   static constexpr uint32_t MAX_RECURSION_DEPTH{
       RuntimeJSONParser::MAX_RECURSION_DEPTH};
 
-  /// The output buffer. The serialization process will append into it.
+  /// The output buffer. The serialization process will append into it, and
+  /// never removes anything from it except by flushing it to sink_.
   llvh::SmallVector<char16_t, 32> output_{};
 
+  /// If set, output_ is passed to it in chunks of roughly kOutputChunkSize
+  /// characters while serializing, instead of being kept until the end.
+  JSONOutputSink sink_;
+
+  /// The size at which output_ is flushed to sink_.
+  static constexpr size_t kOutputChunkSize = 16 * 1024;
+
  public:
-  explicit JSONStringifyer(Runtime &runtime)
+  explicit JSONStringifyer(Runtime &runtime, JSONOutputSink sink = nullptr)
       : runtime_(runtime),
         replacerFunction_(runtime),
         gap_{runtime, nullptr},
@@ -179,7 +222,8 @@ class JSONStringifyer {
         tmpHandle2_(runtime),
         operationStrValue_(runtime),
         operationJOK_(runtime),
-        operationStrHolder_(runtime) {}
+        operationStrHolder_(runtime),
+        sink_(sink) {}
 
   LLVM_NODISCARD ExecutionStatus init(Handle<> replacer, Handle<> space) {
     auto arrRes = PropStorage::create(runtime_, 4);
@@ -203,7 +247,17 @@ class JSONStringifyer {
   /// Stringify \p value.
   CallResult<HermesValue> stringify(Handle<> value);
 
+  /// Stringify \p value, passing the whole output to sink_.
+  /// \return false if \p value has no JSON representation, in which case
+  /// nothing is passed to sink_.
+  CallResult<bool> stringifyToSink(Handle<> value);
+
  private:
+  /// Serialize \p value into output_, covering steps 9 to 11 in ES5.1
+  /// 15.12.3.
+  /// \return false if \p value has no JSON representation.
+  CallResult<bool> serializeTopLevel(Handle<> value);
+
   /// Check the type of replacer, initialize
   /// ReplacerFunction (replacerFunction_) and PropertyList (propertyList_).
   /// Covers step 3 and 4 in ES5.1 15.12.3.
@@ -222,6 +276,18 @@ class JSONStringifyer {
   /// \return whether the result is not undefined.
   CallResult<bool> operationStr(HermesValue key);
 
+  /// Implement Str.2 to Str.4 and Str.12 on operationStrValue_, which holds
+  /// holder[key]. Nothing is written to the output, so that callers can decide
+  /// whether to write a property name first. On return, tmpHandle_ holds
+  /// \p key, converted to a string if it was needed.
+  /// \return whether the value will be serialized, i.e. Str does not return
+  /// undefined.
+  CallResult<bool> operationStrPrepare(HermesValue key);
+
+  /// Implement Str.5 to Str.11, serializing operationStrValue_ after
+  /// operationStrPrepare has accepted it.
+  ExecutionStatus operationStrSerialize();
+
   /// Implement the abstract operation Quote(value).
   /// It wraps a String value in double quotes and escapes characters within it.
   void operationQuote(StringView value);
@@ -236,6 +302,32 @@ class JSONStringifyer {
   /// It serializes an object.
   ExecutionStatus operationJO();
 
+  /// Serialize the properties of the object being processed by operationJO
+  /// by looking up each key in operationJOK_, which is either the
+  /// PropertyList or the object's own enumerable keys.
+  /// \return whether any property was written.
+  CallResult<bool> operationJOKeys();
+
+  /// Serialize the properties of the plain object being processed by
+  /// operationJO by walking its hidden class \p clazz, whose property map is
+  /// snapshotted up front, and reading slots directly as long as the object
+  /// keeps that class.
+  /// \return whether any property was written.
+  CallResult<bool> operationJOSlots(Handle<HiddenClass> clazz);
+
+  /// \return whether operationJOSlots can be used to serialize \p obj.
+  bool canSerializeFromSlots(JSObject *obj);
+
+  /// Having computed the value of property \p key into operationStrValue_,
+  /// write it as a member of the current object unless Str returns undefined.
+  /// \p hasElement tells whether a member has already been written.
+  /// \return whether the member was written.
+  CallResult<bool> operationJOMember(HermesValue key, bool hasElement);
+
+  /// Pass the output written so far to sink_, if there is one and \p force
+  /// is set or enough output has accumulated.
+  ExecutionStatus flushOutput(bool force = false);
+
   /// Append '\n' and indent to output_.
   /// The indent is constructed according to depthCount_.
   void indent();
@@ -390,7 +482,8 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
   assert(
       lexer_.getCurToken()->getKind() == JSONTokenKind::LBrace &&
       "Wrong entrance to parseObject");
-  auto object = runtime_.makeHandle(JSObject::create(runtime_));
+  llvh::SaveAndRestore<unsigned> oldObjectDepth{
+      objectDepth_, objectDepth_ + 1};
 
   // If the lexer encounters a string in this context, it should treat it as a
   // key string, which means it will store the string as a symbol.
@@ -399,9 +492,25 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
     return ExecutionStatus::EXCEPTION;
   }
   if (lexer_.getCurToken()->getKind() == JSONTokenKind::RBrace) {
-    return object.getHermesValue();
+    return JSObject::create(runtime_).getHermesValue();
   }
 
+  // The prediction for this nesting level, or null while the keys do not
+  // match it.
+  ShapePrediction *prediction = objectDepth_ <= kNumShapePredictions
+      ? &shapePredictions_[objectDepth_ - 1]
+      : nullptr;
+  if (prediction && !prediction->clazz)
+    prediction = nullptr;
+  MutableHandle<JSObject> object{
+      runtime_,
+      prediction ? JSObject::create(runtime_, prediction->clazz).get()
+                 : JSObject::create(runtime_).get()};
+  // The number of leading keys which matched the prediction.
+  uint32_t numPredicted = 0;
+  // The keys of the object, to predict the shape of the next one.
+  llvh::SmallVector<SymbolID, 8> keys;
+
   MutableHandle<SymbolID> key{runtime_};
   GCScope gcScope{runtime_};
   auto marker = gcScope.createMarker();
@@ -431,12 +540,29 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
       return ExecutionStatus::EXCEPTION;
     }
 
-    (void)JSObject::defineOwnComputedPrimitive(
-        object,
-        runtime_,
-        key,
-        DefinePropertyFlags::getDefaultNewPropertyFlags(),
-        runtime_.makeHandle(*parRes));
+    if (prediction && numPredicted < prediction->keys.size() &&
+        *key == prediction->keys[numPredicted]) {
+      // Encode the value before reading the object pointer, since encoding
+      // may allocate.
+      auto shv = SmallHermesValue::encodeHermesValue(*parRes, runtime_);
+      JSObject::setNamedSlotValueUnsafe(*object, runtime_, numPredicted, shv);
+      ++numPredicted;
+    } else {
+      auto value = runtime_.makeHandle(*parRes);
+      if (prediction) {
+        abandonPrediction(object, *prediction, numPredicted);
+        keys.append(
+            prediction->keys.begin(), prediction->keys.begin() + numPredicted);
+        prediction = nullptr;
+      }
+      (void)JSObject::defineOwnComputedPrimitive(
+          object,
+          runtime_,
+          key,
+          DefinePropertyFlags::getDefaultNewPropertyFlags(),
+          value);
+      keys.push_back(*key);
+    }
 
     if (lexer_.getCurToken()->getKind() == JSONTokenKind::Comma) {
       if (LLVM_UNLIKELY(
@@ -453,9 +579,54 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
   assert(
       lexer_.getCurToken()->getKind() == JSONTokenKind::RBrace &&
       "Unexpected stop for object parse");
+
+  if (prediction) {
+    if (numPredicted == prediction->keys.size())
+      return object.getHermesValue();
+    // The object ended early.
+    abandonPrediction(object, *prediction, numPredicted);
+    keys.append(
+        prediction->keys.begin(), prediction->keys.begin() + numPredicted);
+  }
+
+  // Predict that the next object at this level has the same shape. Duplicate
+  // keys, index-like keys and dictionary classes break the correspondence
+  // between keys and slots, so such shapes are not remembered.
+  if (objectDepth_ <= kNumShapePredictions) {
+    HiddenClass *clazz = object->getClass(runtime_);
+    if (!clazz->isDictionary() && !clazz->getHasIndexLikeProperties() &&
+        clazz->getNumProperties() == keys.size()) {
+      ShapePrediction &next = shapePredictions_[objectDepth_ - 1];
+      next.clazz = clazz;
+      next.keys = std::move(keys);
+    }
+  }
   return object.getHermesValue();
 }
 
+void RuntimeJSONParser::abandonPrediction(
+    MutableHandle<JSObject> &object,
+    const ShapePrediction &prediction,
+    uint32_t count) {
+  auto predicted = runtime_.makeHandle(object.get());
+  object = JSObject::create(runtime_).get();
+  MutableHandle<SymbolID> key{runtime_};
+  MutableHandle<> value{runtime_};
+  GCScopeMarkerRAII marker{runtime_};
+  for (uint32_t i = 0; i < count; ++i) {
+    key = prediction.keys[i];
+    value = JSObject::getNamedSlotValueUnsafe(*predicted, runtime_, i)
+                .unboxToHV(runtime_);
+    (void)JSObject::defineOwnComputedPrimitive(
+        object,
+        runtime_,
+        key,
+        DefinePropertyFlags::getDefaultNewPropertyFlags(),
+        value);
+    marker.flush();
+  }
+}
+
 CallResult<HermesValue> RuntimeJSONParser::revive(Handle<> value) {
   auto root = runtime_.makeHandle(JSObject::create(runtime_));
   auto status = JSObject::defineOwnProperty(
@@ -741,6 +912,25 @@ CallResult<bool> JSONStringifyer::operationStr(HermesValue key) {
   }
   operationStrValue_.set(propRes->get());
 
+  auto prepRes = operationStrPrepare(*tmpHandle_);
+  if (LLVM_UNLIKELY(prepRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (!*prepRes) {
+    return false;
+  }
+  // Flush just before the recursive call.
+  marker.flush();
+  if (LLVM_UNLIKELY(operationStrSerialize() == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return true;
+}
+
+CallResult<bool> JSONStringifyer::operationStrPrepare(HermesValue key) {
+  GCScopeMarkerRAII marker{runtime_};
+  tmpHandle_ = key;
+
   // Str.2. If Type(value) is Object or BigInt, then
   MutableHandle<> hValueHV{runtime_, *operationStrValue_};
   if (vmisa<BigIntPrimitive>(*operationStrValue_)) {
@@ -756,12 +946,12 @@ CallResult<bool> JSONStringifyer::operationStr(HermesValue key) {
   if (auto valueObj = Handle<JSObject>::dyn_vmcast(hValueHV)) {
     // Str.2.
     // Str.2.a: check if toJSON exists in value.
-    if (LLVM_UNLIKELY(
-            (propRes = JSObject::getNamedWithReceiver_RJS(
-                 valueObj,
-                 runtime_,
-                 Predefined::getSymbolID(Predefined::toJSON),
-                 operationStrValue_)) == ExecutionStatus::EXCEPTION)) {
+    auto propRes = JSObject::getNamedWithReceiver_RJS(
+        valueObj,
+        runtime_,
+        Predefined::getSymbolID(Predefined::toJSON),
+        operationStrValue_);
+    if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
       return ExecutionStatus::EXCEPTION;
     }
     // Str.2.b: check if toJSON is a Callable.
@@ -841,10 +1031,20 @@ CallResult<bool> JSONStringifyer::operationStr(HermesValue key) {
     operationStrValue_ = HermesValue::encodeBigIntValue(bigintData);
   }
 
+  // Str.12: everything else serializes as undefined.
+  HermesValue value = *operationStrValue_;
+  return value.isNull() || value.isBool() || value.isString() ||
+      value.isNumber() || vmisa<BigIntPrimitive>(value) ||
+      (vmisa<JSObject>(value) && !vmisa<Callable>(value));
+}
+
+ExecutionStatus JSONStringifyer::operationStrSerialize() {
+  GCScopeMarkerRAII marker{runtime_};
+
   // Str.5.
   if (operationStrValue_->isNull()) {
     appendToOutput(Predefined::getSymbolID(Predefined::null));
-    return true;
+    return ExecutionStatus::RETURNED;
   }
 
   if (operationStrValue_->isBool()) {
@@ -855,14 +1055,14 @@ CallResult<bool> JSONStringifyer::operationStr(HermesValue key) {
       // Str.7.
       appendToOutput(Predefined::getSymbolID(Predefined::falseStr));
     }
-    return true;
+    return ExecutionStatus::RETURNED;
   }
 
   // Str.8.
   if (operationStrValue_->isString()) {
     operationQuote(StringPrimitive::createStringView(
         runtime_, Handle<StringPrimitive>::vmcast(operationStrValue_)));
-    return true;
+    return ExecutionStatus::RETURNED;
   }
 
   // Str.9.
@@ -876,7 +1076,7 @@ CallResult<bool> JSONStringifyer::operationStr(HermesValue key) {
     } else {
       appendToOutput(Predefined::getSymbolID(Predefined::null));
     }
-    return true;
+    return ExecutionStatus::RETURNED;
   }
 
   // Str.10
@@ -885,34 +1085,29 @@ CallResult<bool> JSONStringifyer::operationStr(HermesValue key) {
   }
 
   // Str.11.
-  if (vmisa<JSObject>(*operationStrValue_) &&
-      !vmisa<Callable>(*operationStrValue_)) {
-    auto cr = pushValueToStack(*operationStrValue_);
+  assert(
+      vmisa<JSObject>(*operationStrValue_) &&
+      !vmisa<Callable>(*operationStrValue_) &&
+      "operationStrPrepare should have rejected the value");
+  auto cr = pushValueToStack(*operationStrValue_);
 
-    if (cr == ExecutionStatus::EXCEPTION) {
-      return ExecutionStatus::EXCEPTION;
-    }
-    if (LLVM_UNLIKELY(!*cr)) {
-      return runtime_.raiseTypeError("cyclical structure in JSON object");
-    }
-    // Flush just before the recursive call (pushValueToStack can create
-    // handles).
-    marker.flush();
-    CallResult<bool> isArrayRes =
-        isArray(runtime_, vmcast<JSObject>(*operationStrValue_));
-    if (LLVM_UNLIKELY(isArrayRes == ExecutionStatus::EXCEPTION)) {
-      return ExecutionStatus::EXCEPTION;
-    }
-    ExecutionStatus status = *isArrayRes ? operationJA() : operationJO();
-    popValueFromStack();
-    if (LLVM_UNLIKELY(status == ExecutionStatus::EXCEPTION)) {
-      return ExecutionStatus::EXCEPTION;
-    }
-    return true;
+  if (cr == ExecutionStatus::EXCEPTION) {
+    return ExecutionStatus::EXCEPTION;
   }
-
-  // Str.12.
-  return false;
+  if (LLVM_UNLIKELY(!*cr)) {
+    return runtime_.raiseTypeError("cyclical structure in JSON object");
+  }
+  // Flush just before the recursive call (pushValueToStack can create
+  // handles).
+  marker.flush();
+  CallResult<bool> isArrayRes =
+      isArray(runtime_, vmcast<JSObject>(*operationStrValue_));
+  if (LLVM_UNLIKELY(isArrayRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  ExecutionStatus status = *isArrayRes ? operationJA() : operationJO();
+  popValueFromStack();
+  return status;
 }
 
 void JSONStringifyer::operationQuote(StringView value) {
@@ -954,7 +1149,26 @@ ExecutionStatus JSONStringifyer::operationJA() {
         stackValue_->at(stackValue_->size() - 1).getObject(runtime_));
     // Flush just before the recursion in case any handles were created.
     marker.flush();
-    auto status = operationStr(HermesValue::encodeUntrustedNumberValue(index));
+    CallResult<bool> status{ExecutionStatus::EXCEPTION};
+    // Elements of an array without index-like named properties can be read
+    // directly from its storage. Holes still need a full Get, which looks at
+    // the prototype chain.
+    auto *arr = dyn_vmcast<JSArray>(*operationStrHolder_);
+    SmallHermesValue elem = arr && arr->hasFastIndexProperties()
+        ? arr->at(runtime_, index)
+        : SmallHermesValue::encodeEmptyValue();
+    if (LLVM_LIKELY(!elem.isEmpty())) {
+      operationStrValue_ = elem.unboxToHV(runtime_);
+      status = operationStrPrepare(
+          HermesValue::encodeUntrustedNumberValue(index));
+      if (LLVM_LIKELY(status == ExecutionStatus::RETURNED) && *status &&
+          LLVM_UNLIKELY(
+              operationStrSerialize() == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+    } else {
+      status = operationStr(HermesValue::encodeUntrustedNumberValue(index));
+    }
     if (LLVM_UNLIKELY(status == ExecutionStatus::EXCEPTION)) {
       return ExecutionStatus::EXCEPTION;
     }
@@ -962,6 +1176,9 @@ ExecutionStatus JSONStringifyer::operationJA() {
       // operationStr returns undefined, we need to replace with null.
       appendToOutput(Predefined::getSymbolID(Predefined::null));
     }
+    if (LLVM_UNLIKELY(flushOutput() == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
   }
   depthCount_ = stepBack;
 
@@ -984,16 +1201,19 @@ ExecutionStatus JSONStringifyer::operationJO() {
   }
   depthCount_++;
   output_.push_back(u'{');
-  auto beginningLoc = output_.size();
-  indent();
 
+  CallResult<bool> hasElement{ExecutionStatus::EXCEPTION};
+  auto *obj = vmcast<JSObject>(
+      stackValue_->at(stackValue_->size() - 1).getObject(runtime_));
   if (propertyList_) {
     // JO.5.
     operationJOK_ = propertyList_.get();
+    hasElement = operationJOKeys();
+  } else if (canSerializeFromSlots(obj)) {
+    hasElement = operationJOSlots(runtime_.makeHandle(obj->getClass(runtime_)));
   } else {
     // JO.6.
-    tmpHandle_ = HermesValue::encodeObjectValue(
-        stackValue_->at(stackValue_->size() - 1).getObject(runtime_));
+    tmpHandle_ = HermesValue::encodeObjectValue(obj);
     if (LLVM_LIKELY(!Handle<JSObject>::vmcast(tmpHandle_)->isProxyObject())) {
       // enumerableOwnProperties_RJS is the spec definition, and is
       // used below on proxies so the correct traps get called.  In
@@ -1015,27 +1235,30 @@ ExecutionStatus JSONStringifyer::operationJO() {
       }
       operationJOK_ = vmcast<JSArray>(*ownPropRes);
     }
+    hasElement = operationJOKeys();
+  }
+  if (LLVM_UNLIKELY(hasElement == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
   }
 
-  marker.flush();
+  // It's important to reset depthCount_ first, because the last
+  // indent before } should be the old indent.
+  depthCount_ = stepBack;
+
+  if (*hasElement) {
+    indent();
+  }
+  output_.push_back(u'}');
+  return ExecutionStatus::RETURNED;
+}
+
+CallResult<bool> JSONStringifyer::operationJOKeys() {
+  GCScopeMarkerRAII marker{runtime_};
 
   // JO.8.
   bool hasElement = false;
   for (uint32_t index = 0, len = operationJOK_->getEndIndex(); index < len;
        ++index) {
-    // JO.8.a.
-    // We are speculating that the Str operation will not return undefined,
-    // and just append the key/value pair to the output. If it turns out
-    // that the Str operation does return undefined, we roll back to
-    // curLocation.
-    auto savedLocation = output_.size();
-
-    if (hasElement) {
-      // JO.10.
-      output_.push_back(u',');
-      indent();
-    }
-
     tmpHandle_ = operationJOK_->at(runtime_, index).unboxToHV(runtime_);
     if (LLVM_UNLIKELY(!tmpHandle_->isString())) {
       // property may come from getOwnPropertyNames, which may contain numbers.
@@ -1050,15 +1273,6 @@ ExecutionStatus JSONStringifyer::operationJO() {
       tmpHandle_ = status->getHermesValue();
     }
     // tmpHandle now contains property as string.
-    // JO.8.b.i
-    operationQuote(StringPrimitive::createStringView(
-        runtime_, Handle<StringPrimitive>::vmcast(tmpHandle_)));
-    // JO.8.b.ii
-    output_.push_back(u':');
-    // JO.8.b.iii
-    if (gap_.get()) {
-      output_.push_back(u' ');
-    }
 
     // JO.9.a.
     operationStrHolder_ = vmcast<JSObject>(
@@ -1072,7 +1286,14 @@ ExecutionStatus JSONStringifyer::operationJO() {
 
     // Flush just before recursion (propStoragePushBack may create handles).
     marker.flush();
-    auto result = operationStr(*tmpHandle_);
+    CallResult<bool> result{ExecutionStatus::EXCEPTION};
+    // JO.8.a: Str(K, value).
+    auto propRes =
+        JSObject::getComputed_RJS(operationStrHolder_, runtime_, tmpHandle_);
+    if (LLVM_LIKELY(propRes != ExecutionStatus::EXCEPTION)) {
+      operationStrValue_ = propRes->get();
+      result = operationJOMember(*tmpHandle_, hasElement);
+    }
 
     operationJOK_ =
         vmcast<JSArray>(stackJO_->pop_back(runtime_).getObject(runtime_));
@@ -1080,26 +1301,112 @@ ExecutionStatus JSONStringifyer::operationJO() {
     if (LLVM_UNLIKELY(result == ExecutionStatus::EXCEPTION)) {
       return ExecutionStatus::EXCEPTION;
     }
+    hasElement |= *result;
+  }
+  return hasElement;
+}
+
+bool JSONStringifyer::canSerializeFromSlots(JSObject *obj) {
+  // Only plain objects are guaranteed to have no indexed storage and no
+  // exotic [[Get]]. Dictionary classes are excluded because they change in
+  // place, so a class comparison would not detect added or deleted
+  // properties.
+  if (obj->getKind() != CellKind::JSObjectKind || obj->isProxyObject() ||
+      obj->isHostObject() || obj->isLazy()) {
+    return false;
+  }
+  HiddenClass *clazz = obj->getClass(runtime_);
+  return !clazz->isDictionary() && !clazz->getHasIndexLikeProperties();
+}
+
+CallResult<bool> JSONStringifyer::operationJOSlots(Handle<HiddenClass> clazz) {
+  // JO.6: the enumerable own string keys, in insertion order. Since the class
+  // has no index-like properties, this is also the order required by
+  // [[OwnPropertyKeys]]. clazz keeps the symbols alive.
+  llvh::SmallVector<std::pair<SymbolID, NamedPropertyDescriptor>, 16> props;
+  HiddenClass::forEachProperty(
+      clazz, runtime_, [&props](SymbolID id, NamedPropertyDescriptor desc) {
+        if (isPropertyNamePrimitive(id) && desc.flags.enumerable) {
+          props.emplace_back(id, desc);
+        }
+      });
+
+  GCScopeMarkerRAII marker{runtime_};
+
+  // JO.8.
+  bool hasElement = false;
+  for (const auto &prop : props) {
+    // JO.9.a.
+    operationStrHolder_ = vmcast<JSObject>(
+        stackValue_->at(stackValue_->size() - 1).getObject(runtime_));
 
-    if (LLVM_UNLIKELY(!result.getValue())) {
-      // Str returns undefined, we need to roll back.
-      output_.resize(savedLocation);
+    // JO.8.a: Str(K, value). As long as the object has the class the keys
+    // were taken from, a data property holds its value in its slot. Otherwise
+    // a toJSON or replacer call has changed the object, so do a full Get.
+    if (LLVM_LIKELY(
+            operationStrHolder_->getClass(runtime_) == *clazz &&
+            !prop.second.flags.accessor)) {
+      operationStrValue_ = JSObject::getNamedSlotValueUnsafe(
+                               operationStrHolder_.get(), runtime_, prop.second)
+                               .unboxToHV(runtime_);
     } else {
-      hasElement = true;
+      auto propRes =
+          JSObject::getNamed_RJS(operationStrHolder_, runtime_, prop.first);
+      if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      operationStrValue_ = propRes->get();
     }
+
+    auto result = operationJOMember(
+        HermesValue::encodeStringValue(
+            runtime_.getStringPrimFromSymbolID(prop.first)),
+        hasElement);
+    if (LLVM_UNLIKELY(result == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    hasElement |= *result;
+    marker.flush();
+  }
+  return hasElement;
+}
+
+CallResult<bool> JSONStringifyer::operationJOMember(
+    HermesValue key,
+    bool hasElement) {
+  // Only write the member once it is known that Str will not return
+  // undefined, so that nothing has to be taken back from the output.
+  auto prepRes = operationStrPrepare(key);
+  if (LLVM_UNLIKELY(prepRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (!*prepRes) {
+    return false;
   }
-  // It's important to reset depthCount_ first, because the last
-  // indent before } should be the old indent.
-  depthCount_ = stepBack;
 
   if (hasElement) {
-    indent();
-  } else {
-    // If the object is empty, we need to roll back the first indent.
-    output_.resize(beginningLoc);
+    // JO.10.
+    output_.push_back(u',');
   }
-  output_.push_back(u'}');
-  return ExecutionStatus::RETURNED;
+  indent();
+  // operationStrPrepare left the key in tmpHandle_ as a string.
+  // JO.8.b.i
+  operationQuote(StringPrimitive::createStringView(
+      runtime_, Handle<StringPrimitive>::vmcast(tmpHandle_)));
+  // JO.8.b.ii
+  output_.push_back(u':');
+  // JO.8.b.iii
+  if (gap_.get()) {
+    output_.push_back(u' ');
+  }
+
+  if (LLVM_UNLIKELY(operationStrSerialize() == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (LLVM_UNLIKELY(flushOutput() == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return true;
 }
 
 void JSONStringifyer::indent() {
@@ -1141,7 +1448,21 @@ void JSONStringifyer::appendToOutput(const StringPrimitive *str) {
   str->appendUTF16String(output_);
 }
 
-CallResult<HermesValue> JSONStringifyer::stringify(Handle<> value) {
+ExecutionStatus JSONStringifyer::flushOutput(bool force) {
+  if (!sink_ || (!force && output_.size() < kOutputChunkSize)) {
+    return ExecutionStatus::RETURNED;
+  }
+  // This is only called after a complete value has been written, and strings
+  // are quoted with unpaired surrogates escaped, so the output never ends in
+  // the middle of a surrogate pair here.
+  if (LLVM_UNLIKELY(sink_(output_) == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  output_.clear();
+  return ExecutionStatus::RETURNED;
+}
+
+CallResult<bool> JSONStringifyer::serializeTopLevel(Handle<> value) {
   // All previous steps have been covered by the constructor.
   // Clear the output buffer.
   output_.clear();
@@ -1160,18 +1481,35 @@ CallResult<HermesValue> JSONStringifyer::stringify(Handle<> value) {
   (void)status;
 
   // Step 11 in ES5.1 15.12.3.
-  status = operationStr(HermesValue::encodeStringValue(
+  return operationStr(HermesValue::encodeStringValue(
       runtime_.getPredefinedString(Predefined::emptyString)));
-  if (LLVM_UNLIKELY(status == ExecutionStatus::EXCEPTION)) {
+}
+
+CallResult<HermesValue> JSONStringifyer::stringify(Handle<> value) {
+  assert(!sink_ && "use stringifyToSink with a sink");
+  auto res = serializeTopLevel(value);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  if (status.getValue()) {
+  if (*res) {
     return StringPrimitive::create(runtime_, output_);
   } else {
     return HermesValue::encodeUndefinedValue();
   }
 }
 
+CallResult<bool> JSONStringifyer::stringifyToSink(Handle<> value) {
+  assert(sink_ && "stringifyToSink requires a sink");
+  auto res = serializeTopLevel(value);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (*res && LLVM_UNLIKELY(flushOutput(true) == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return res;
+}
+
 CallResult<HermesValue> runtimeJSONStringify(
     Runtime &runtime,
     Handle<> value,
@@ -1186,5 +1524,20 @@ CallResult<HermesValue> runtimeJSONStringify(
   return stringifyer.stringify(value);
 }
 
+CallResult<bool> runtimeJSONStringifyTo(
+    Runtime &runtime,
+    Handle<> value,
+    Handle<> replacer,
+    Handle<> space,
+    JSONOutputSink sink) {
+  GCScope gcScope{runtime, "runtimeJSONStringifyTo"};
+
+  JSONStringifyer stringifyer{runtime, sink};
+  if (stringifyer.init(replacer, space) == ExecutionStatus::EXCEPTION) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return stringifyer.stringifyToSink(value);
+}
+
 } // namespace vm
 } // namespace hermes
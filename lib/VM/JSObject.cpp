@@ -880,7 +880,7 @@ JSObject *JSObject::getNamedDescriptorUnsafe(
     SymbolID name,
     PropertyFlags expectedFlags,
     NamedPropertyDescriptor &desc) {
-  if (findProperty(selfHandle, runtime, name, expectedFlags, desc))
+  if (findPropertyCached(selfHandle, runtime, name, expectedFlags, desc))
     return *selfHandle;
 
   // Check here for host object flag.  This means that "normal" own
@@ -904,7 +904,7 @@ JSObject *JSObject::getNamedDescriptorUnsafe(
     // Initialize the object and perform the lookup again.
     JSObject::initializeLazyObject(runtime, selfHandle);
 
-    if (findProperty(selfHandle, runtime, name, expectedFlags, desc))
+    if (findPropertyCached(selfHandle, runtime, name, expectedFlags, desc))
       return *selfHandle;
   }
 
@@ -925,7 +925,7 @@ JSObject *JSObject::getNamedDescriptorUnsafe(
               !mutableSelfHandle->flags_.hostObject &&
               !mutableSelfHandle->flags_.proxyObject)) {
       findProp:
-        if (findProperty(
+        if (findPropertyCached(
                 mutableSelfHandle,
                 runtime,
                 name,
@@ -1059,8 +1059,11 @@ CallResult<PseudoHandle<>> JSObject::getNamedWithReceiver_RJS(
   if (LLVM_LIKELY(
           !desc.flags.accessor && !desc.flags.hostObject &&
           !desc.flags.proxyObject)) {
-    // Populate the cache if requested.
-    if (cacheEntry && !propObj->getClass(runtime)->isDictionaryNoCache()) {
+    // Populate the cache if requested. Properties found on the prototype
+    // chain are cached separately by the interpreter, and an existing entry is
+    // left alone since the interpreter manages its polymorphic state.
+    if (cacheEntry && propObj == selfHandle.get() && !cacheEntry->clazz &&
+        !propObj->getClass(runtime)->isDictionaryNoCache()) {
       cacheEntry->clazz = propObj->getClassGCPtr();
       cacheEntry->slot = desc.slot;
     }
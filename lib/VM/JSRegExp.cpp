@@ -8,6 +8,7 @@
 #include "hermes/VM/JSRegExp.h"
 
 #include "hermes/Regex/Executor.h"
+#include "hermes/Regex/NFA.h"
 #include "hermes/Regex/Regex.h"
 #include "hermes/Regex/RegexTraits.h"
 #include "hermes/Support/UTF8.h"
@@ -169,26 +170,39 @@ ExecutionStatus JSRegExp::initialize(
   llvh::SmallVector<char16_t, 16> patternText16;
   pattern->appendUTF16String(patternText16);
 
-  // Build the regex.
-  regex::Regex<regex::UTF16RegexTraits> regex(patternText16, flagsText16);
-
-  if (!regex.valid()) {
-    return runtime.raiseSyntaxError(
-        TwineChar16("Invalid RegExp: ") +
-        regex::constants::messageForError(regex.getError()));
+  // Reuse the compiled form of an identical regexp if there is one. Invalid
+  // flags are left for the regex parser to report.
+  RegExpCache &cache = runtime.getRegExpCache();
+  auto sflags = regex::SyntaxFlags::fromString(flagsText16);
+  RegExpCache::Entry *entry =
+      sflags ? cache.lookup(patternText16, *sflags) : nullptr;
+  if (!entry) {
+    // Build the regex.
+    regex::Regex<regex::UTF16RegexTraits> regex(patternText16, flagsText16);
+
+    if (!regex.valid()) {
+      return runtime.raiseSyntaxError(
+          TwineChar16("Invalid RegExp: ") +
+          regex::constants::messageForError(regex.getError()));
+    }
+    // The regex is valid. Compile it and cache its bytecode and group names.
+    // Moving the group names keeps the mapping's references to them valid.
+    RegExpCache::Entry newEntry;
+    newEntry.bytecode = regex.compile();
+    newEntry.orderedGroupNames = regex.acquireOrderedGroupNames();
+    newEntry.groupNamesMapping = regex.acquireGroupNamesMapping();
+    entry = &cache.insert(patternText16, regex.flags(), std::move(newEntry));
   }
-  // The regex is valid. Compile and store its bytecode.
-  auto bytecode = regex.compile();
-  // Also store the name mappings.
+  // Store the name mappings.
   if (LLVM_UNLIKELY(
           initializeGroupNameMappingObj(
               runtime,
               selfHandle,
-              regex.getOrderedNamedGroups(),
-              regex.getGroupNamesMapping()) == ExecutionStatus::EXCEPTION)) {
+              entry->orderedGroupNames,
+              entry->groupNamesMapping) == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  initialize(selfHandle, runtime, pattern, flags, bytecode);
+  initialize(selfHandle, runtime, pattern, flags, entry->bytecode);
   return ExecutionStatus::RETURNED;
 }
 
@@ -251,6 +265,22 @@ void JSRegExp::initializeBytecode(llvh::ArrayRef<uint8_t> bytecode) {
   memcpy(bytecode_, bytecode.data(), sz);
 }
 
+regex::NFAProgram *JSRegExp::getNFA(Runtime &runtime) {
+  RegExpEngine engine = runtime.getRegExpEngine();
+  if (engine == RegExpEngine::Backtracking)
+    return nullptr;
+  if (!nfaInitialized_) {
+    nfaInitialized_ = true;
+    // The NFA runs in linear time, but backtracking is usually faster, so
+    // only use the NFA by default where backtracking could blow up.
+    auto nfa = regex::NFAProgram::fromBytecode(
+        llvh::makeArrayRef(bytecode_, bytecodeSize_));
+    if (nfa && (engine == RegExpEngine::NFA || nfa->backtrackingIsRisky()))
+      nfa_ = nfa.release();
+  }
+  return nfa_;
+}
+
 PseudoHandle<StringPrimitive> JSRegExp::getPattern(
     JSRegExp *self,
     PointerBase &base) {
@@ -261,18 +291,30 @@ template <typename CharT, typename Traits>
 CallResult<RegExpMatch> performSearch(
     Runtime &runtime,
     llvh::ArrayRef<uint8_t> bytecode,
+    regex::NFAProgram *nfa,
     const CharT *start,
     uint32_t stringLength,
     uint32_t searchStartOffset,
     regex::constants::MatchFlagType matchFlags) {
   std::vector<regex::CapturedRange> nativeMatchRanges;
-  auto matchResult = regex::searchWithBytecode(
-      bytecode,
-      start,
-      searchStartOffset,
-      stringLength,
-      &nativeMatchRanges,
-      matchFlags);
+  regex::MatchRuntimeResult matchResult;
+  if (nfa) {
+    matchResult = regex::searchWithNFA(
+        *nfa,
+        start,
+        searchStartOffset,
+        stringLength,
+        &nativeMatchRanges,
+        matchFlags);
+  } else {
+    matchResult = regex::searchWithBytecode(
+        bytecode,
+        start,
+        searchStartOffset,
+        stringLength,
+        &nativeMatchRanges,
+        matchFlags);
+  }
   if (matchResult == regex::MatchRuntimeResult::StackOverflow) {
     return runtime.raiseRangeError("Maximum regex stack depth reached");
   } else if (matchResult == regex::MatchRuntimeResult::NoMatch) {
@@ -319,12 +361,14 @@ CallResult<RegExpMatch> JSRegExp::search(
     matchFlags |= regex::constants::matchOnlyAtStart;
   }
 
+  regex::NFAProgram *nfa = selfHandle->getNFA(runtime);
   CallResult<RegExpMatch> matchResult = RegExpMatch{};
   if (input.isASCII()) {
     matchFlags |= regex::constants::matchInputAllAscii;
     matchResult = performSearch<char, regex::ASCIIRegexTraits>(
         runtime,
         llvh::makeArrayRef(selfHandle->bytecode_, selfHandle->bytecodeSize_),
+        nfa,
         input.castToCharPtr(),
         input.length(),
         searchStartOffset,
@@ -333,6 +377,7 @@ CallResult<RegExpMatch> JSRegExp::search(
     matchResult = performSearch<char16_t, regex::UTF16RegexTraits>(
         runtime,
         llvh::makeArrayRef(selfHandle->bytecode_, selfHandle->bytecodeSize_),
+        nfa,
         input.castToChar16Ptr(),
         input.length(),
         searchStartOffset,
@@ -352,6 +397,7 @@ CallResult<RegExpMatch> JSRegExp::search(
 
 JSRegExp::~JSRegExp() {
   free(bytecode_);
+  delete nfa_;
 }
 
 void JSRegExp::_finalizeImpl(GCCell *cell, GC &gc) {
@@ -364,7 +410,8 @@ void JSRegExp::_finalizeImpl(GCCell *cell, GC &gc) {
 
 size_t JSRegExp::_mallocSizeImpl(GCCell *cell) {
   auto *self = vmcast<JSRegExp>(cell);
-  return self->bytecodeSize_;
+  return self->bytecodeSize_ +
+      (self->nfa_ ? self->nfa_->getAllocatedSize() : 0);
 }
 
 #ifdef HERMES_MEMORY_INSTRUMENTATION
@@ -59,10 +59,11 @@ bool InlineCacheProfiler::insertICMiss(
 
 bool InlineCacheProfiler::insertICHit(
     CodeBlock *codeblock,
-    uint32_t instOffset) {
+    uint32_t instOffset,
+    PropertyCacheState state) {
   // if not exist, create inline caching entry for the source location
   ICMiss &icMiss = getICMissBySourceLocation(codeblock, instOffset);
-  icMiss.incrementHit();
+  icMiss.incrementHit(state);
 
   ++totalHits_;
   return true;
@@ -176,7 +177,16 @@ void InlineCacheProfiler::dumpInfoOfSourceLocation(
            << (1. * icMiss.missCount) / (icMiss.missCount + icMiss.hitCount);
     std::string missRatio = stream.str();
     ostream << "total access: " << icMiss.missCount + icMiss.hitCount
-            << ", miss ratio: " << missRatio << "\n";
+            << ", miss ratio: " << missRatio << ", hits (monomorphic: "
+            << icMiss.hitCountByState[static_cast<size_t>(
+                   PropertyCacheState::Monomorphic)]
+            << ", polymorphic: "
+            << icMiss.hitCountByState[static_cast<size_t>(
+                   PropertyCacheState::Polymorphic)]
+            << ", megamorphic: "
+            << icMiss.hitCountByState[static_cast<size_t>(
+                   PropertyCacheState::Megamorphic)]
+            << ")\n";
   } else {
     ostream << "[No Loc]\n";
   }
@@ -188,7 +198,8 @@ void InlineCacheProfiler::dumpInfoOfSourceLocation(
 /// The source locations are ranked in the descending order of IC misses.
 ///
 /// An example of output for a specific source location is as follows:
-/// [filename:line:column] total access: 2661, miss ratio: 0.3
+/// [filename:line:column] total access: 2661, miss ratio: 0.3, hits
+///   (monomorphic: 1200, polymorphic: 663, megamorphic: 0)
 ///  property: children, inline cache misses: 427
 ///    <type, domNamespace, children, childIndex, context, footer>
 ///    <domNamespace, type, children, childIndex, context, footer>
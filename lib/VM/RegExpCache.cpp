@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/VM/RegExpCache.h"
+
+namespace hermes {
+namespace vm {
+
+RegExpCache::Key RegExpCache::makeKey(
+    llvh::ArrayRef<char16_t> pattern,
+    regex::SyntaxFlags flags) {
+  Key key;
+  key.reserve(pattern.size() + 1);
+  key.push_back(flags.toByte());
+  key.append(pattern.begin(), pattern.end());
+  return key;
+}
+
+RegExpCache::Entry *RegExpCache::lookup(
+    llvh::ArrayRef<char16_t> pattern,
+    regex::SyntaxFlags flags) {
+  auto it = index_.find(makeKey(pattern, flags));
+  if (it == index_.end()) {
+    ++numMisses_;
+    return nullptr;
+  }
+  ++numHits_;
+  // Move the entry to the front.
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return &it->second->second;
+}
+
+RegExpCache::Entry &RegExpCache::insert(
+    llvh::ArrayRef<char16_t> pattern,
+    regex::SyntaxFlags flags,
+    Entry &&entry) {
+  Key key = makeKey(pattern, flags);
+  assert(!index_.count(key) && "Regexp is already cached");
+  // Evict from the back until there is room, but keep at least the new entry.
+  while (!entries_.empty() &&
+         (entries_.size() >= kMaxEntries ||
+          bytecodeSize_ + entry.bytecode.size() > kMaxBytecodeSize)) {
+    bytecodeSize_ -= entries_.back().second.bytecode.size();
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+  bytecodeSize_ += entry.bytecode.size();
+  entries_.emplace_front(key, std::move(entry));
+  index_.emplace(std::move(key), entries_.begin());
+  return entries_.front().second;
+}
+
+void RegExpCache::clear() {
+  index_.clear();
+  entries_.clear();
+  bytecodeSize_ = 0;
+}
+
+size_t RegExpCache::getAllocatedSize() const {
+  size_t size = bytecodeSize_;
+  for (const auto &keyAndEntry : entries_) {
+    // The key is stored both in the list and in the index.
+    size += 2 * keyAndEntry.first.capacity() * sizeof(char16_t);
+    for (const auto &name : keyAndEntry.second.orderedGroupNames)
+      size += name.capacity_in_bytes();
+    size += keyAndEntry.second.groupNamesMapping.getMemorySize();
+  }
+  return size;
+}
+
+} // namespace vm
+} // namespace hermes
@@ -70,6 +70,48 @@ void Runtime::dumpOpcodeStats(llvh::raw_ostream &os) const {
   }
   os << stream.str();
 }
+
+void Runtime::dumpOpcodePairStats(llvh::raw_ostream &os, unsigned topN) const {
+  const unsigned numOpcodes = static_cast<unsigned>(inst::OpCode::_last);
+  std::vector<std::pair<unsigned, unsigned>> pairs;
+  uint64_t total = 0;
+  for (unsigned first = 0; first < numOpcodes; ++first) {
+    for (unsigned second = 0; second < numOpcodes; ++second) {
+      if (uint32_t freq = opcodePairFrequency[first][second]) {
+        pairs.emplace_back(first, second);
+        total += freq;
+      }
+    }
+  }
+
+  auto freq = [this](const std::pair<unsigned, unsigned> &p) {
+    return opcodePairFrequency[p.first][p.second];
+  };
+  std::sort(
+      pairs.begin(),
+      pairs.end(),
+      [&freq](
+          const std::pair<unsigned, unsigned> &a,
+          const std::pair<unsigned, unsigned> &b) { return freq(a) > freq(b); });
+  if (pairs.size() > topN)
+    pairs.resize(topN);
+
+  std::ostringstream stream;
+  stream << "Opcode pairs sorted by frequency:\n"
+         << std::left << std::setfill(' ') << std::setw(25) << "==First=="
+         << std::setw(25) << "==Second==" << std::setw(14) << "==Frequency=="
+         << "==Percent=="
+         << "\n";
+  for (const auto &p : pairs) {
+    stream << std::left << std::setfill(' ') << std::setw(25)
+           << inst::getOpCodeString(static_cast<inst::OpCode>(p.first)).data()
+           << std::setw(25)
+           << inst::getOpCodeString(static_cast<inst::OpCode>(p.second)).data()
+           << std::setw(14) << freq(p) << std::fixed << std::setprecision(2)
+           << (total ? 100.0 * freq(p) / total : 0.0) << "\n";
+  }
+  os << stream.str();
+}
 #endif
 
 #if defined(HERMESVM_PROFILER_JSFUNCTION)
@@ -25,6 +25,7 @@
 #include "hermes/VM/FillerCell.h"
 #include "hermes/VM/HeapRuntime.h"
 #include "hermes/VM/IdentifierTable.h"
+#include "hermes/VM/JIT/JIT.h"
 #include "hermes/VM/JSArray.h"
 #include "hermes/VM/JSError.h"
 #include "hermes/VM/JSLib.h"
@@ -257,6 +258,7 @@ Runtime::Runtime(
       hasIntl_(runtimeConfig.getIntl()),
       hasArrayBuffer_(runtimeConfig.getArrayBuffer()),
       hasMicrotaskQueue_(runtimeConfig.getMicrotaskQueue()),
+      regExpEngine_(runtimeConfig.getRegExpEngine()),
       shouldRandomizeMemoryLayout_(runtimeConfig.getRandomizeMemoryLayout()),
       bytecodeWarmupPercent_(runtimeConfig.getBytecodeWarmupPercent()),
       trackIO_(runtimeConfig.getTrackIO()),
@@ -272,6 +274,11 @@ Runtime::Runtime(
       crashCallbackKey_(
           crashMgr_->registerCallback([this](int fd) { crashCallback(fd); })),
       codeCoverageProfiler_(std::make_unique<CodeCoverageProfiler>(*this)),
+#ifdef HERMESVM_JIT
+      jitContext_(std::make_unique<JITContext>(
+          runtimeConfig.getEnableJIT(),
+          runtimeConfig.getJITThreshold())),
+#endif
       gcEventCallback_(runtimeConfig.getGCConfig().getCallback()) {
   assert(
       (void *)this == (void *)(HandleRootOwner *)this &&
@@ -657,6 +664,9 @@ void Runtime::markWeakRoots(WeakRootAcceptor &acceptor, bool markLongLived) {
     for (auto &entry : fixedPropCache_) {
       acceptor.acceptWeak(entry.clazz);
     }
+    // The lookup cache cannot be updated in place, since its entries are
+    // indexed by the address of the class.
+    propertyLookupCache_.clear();
     for (auto &rm : runtimeModuleList_)
       rm.markLongLivedWeakRoots(acceptor);
   }
@@ -890,8 +900,9 @@ const void *Runtime::getStringForSymbol(SymbolID id) {
 
 size_t Runtime::mallocSize() const {
   // Register stack uses mmap and RuntimeModules are tracked by their owning
-  // Domains. So this only considers IdentifierTable size.
-  return sizeof(IdentifierTable) + identifierTable_.additionalMemorySize();
+  // Domains. So this only considers IdentifierTable and RegExpCache size.
+  return sizeof(IdentifierTable) + identifierTable_.additionalMemorySize() +
+      regExpCache_.getAllocatedSize();
 }
 
 #ifdef HERMESVM_SANITIZE_HANDLES
@@ -2145,12 +2156,14 @@ void Runtime::recordHiddenClass(
     const Inst *cacheMissInst,
     SymbolID symbolID,
     HiddenClass *objectHiddenClass,
-    HiddenClass *cachedHiddenClass) {
+    HiddenClass *cachedHiddenClass,
+    bool polymorphicHit,
+    PropertyCacheState cacheState) {
   auto offset = codeBlock->getOffsetOf(cacheMissInst);
 
   // inline caching hit
-  if (objectHiddenClass == cachedHiddenClass) {
-    inlineCacheProfiler_.insertICHit(codeBlock, offset);
+  if (objectHiddenClass == cachedHiddenClass || polymorphicHit) {
+    inlineCacheProfiler_.insertICHit(codeBlock, offset, cacheState);
     return;
   }
 
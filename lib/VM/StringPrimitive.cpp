@@ -330,9 +330,44 @@ CallResult<HermesValue> StringPrimitive::slice(
     size_t length) {
   assert(
       start + length <= str->getStringLength() && "Invalid length for slice");
+  if (start == 0 && length == str->getStringLength()) {
+    return str.getHermesValue();
+  }
 
   SafeUInt32 safeLen(length);
 
+  ensureFlat(runtime, str);
+  if (length >= SLICED_STRING_MIN_SIZE) {
+    // Refer to the string which actually holds the characters, so that
+    // slices and concatenation buffers are not kept alive needlessly.
+    StringPrimitive *parent = str.get();
+    uint32_t offset = start;
+    if (auto *sliced = dyn_vmcast<SlicedASCIIStringPrimitive>(parent)) {
+      offset += sliced->getOffset();
+      parent = sliced->getParent();
+    } else if (auto *sliced = dyn_vmcast<SlicedUTF16StringPrimitive>(parent)) {
+      offset += sliced->getOffset();
+      parent = sliced->getParent();
+    } else if (auto *buf = dyn_vmcast<BufferedASCIIStringPrimitive>(parent)) {
+      parent = buf->getConcatBuffer();
+    } else if (auto *buf = dyn_vmcast<BufferedUTF16StringPrimitive>(parent)) {
+      parent = buf->getConcatBuffer();
+    }
+    // Copy a small slice of a parent which hasn't survived a collection yet,
+    // since sharing would likely keep a dead parent alive.
+    if (parent->getStringLength() / SLICED_STRING_MAX_YOUNG_PARENT_RATIO <=
+            length ||
+        !runtime.getHeap().inYoungGen(parent)) {
+      auto parentHnd = runtime.makeHandle(parent);
+      return (parent->isASCII()
+                  ? SlicedASCIIStringPrimitive::create(
+                        runtime, parentHnd, offset, length)
+                  : SlicedUTF16StringPrimitive::create(
+                        runtime, parentHnd, offset, length))
+          .getHermesValue();
+    }
+  }
+
   auto builder =
       StringBuilder::createStringBuilder(runtime, safeLen, str->isASCII());
   if (builder == ExecutionStatus::EXCEPTION) {
@@ -348,6 +383,34 @@ CallResult<HermesValue> StringPrimitive::slice(
   return HermesValue::encodeStringValue(*builder->getStringPrimitive());
 }
 
+/// If \p str is a RopeStringPrimitive<T> which has not been flattened, push
+/// its halves onto \p stack so that the left one is popped first.
+/// \return whether \p str was such a rope.
+template <typename T>
+static bool pushRopeHalves(
+    const StringPrimitive *str,
+    llvh::SmallVectorImpl<const StringPrimitive *> &stack) {
+  auto *rope = dyn_vmcast<RopeStringPrimitive<T>>(str);
+  if (!rope || rope->isFlattened())
+    return false;
+  stack.push_back(rope->getRight());
+  stack.push_back(rope->getLeft());
+  return true;
+}
+
+template <typename F>
+void StringPrimitive::forEachFlatPiece(F visit) const {
+  // Use an explicit stack, since ropes can be deep.
+  llvh::SmallVector<const StringPrimitive *, 16> stack{this};
+  do {
+    const StringPrimitive *str = stack.pop_back_val();
+    if (!pushRopeHalves<char>(str, stack) &&
+        !pushRopeHalves<char16_t>(str, stack)) {
+      visit(str);
+    }
+  } while (!stack.empty());
+}
+
 StringView StringPrimitive::createStringView(
     Runtime &runtime,
     Handle<StringPrimitive> self) {
@@ -631,20 +694,26 @@ template <>
 void BufferedStringPrimitive<char>::appendToCopyableString(
     CopyableBasicString<char> &res,
     const StringPrimitive *str) {
-  auto it = str->castToASCIIPointer();
-  res.append(it, it + str->getStringLength());
+  // Copy the pieces of ropes directly, instead of flattening them.
+  str->forEachFlatPiece([&res](const StringPrimitive *piece) {
+    auto it = piece->castToASCIIPointer();
+    res.append(it, it + piece->getStringLength());
+  });
 }
 template <>
 void BufferedStringPrimitive<char16_t>::appendToCopyableString(
     CopyableBasicString<char16_t> &res,
     const StringPrimitive *str) {
-  if (str->isASCII()) {
-    auto it = (const uint8_t *)str->castToASCIIPointer();
-    res.append(it, it + str->getStringLength());
-  } else {
-    auto it = str->castToUTF16Pointer();
-    res.append(it, it + str->getStringLength());
-  }
+  // Copy the pieces of ropes directly, instead of flattening them.
+  str->forEachFlatPiece([&res](const StringPrimitive *piece) {
+    if (piece->isASCII()) {
+      auto it = (const uint8_t *)piece->castToASCIIPointer();
+      res.append(it, it + piece->getStringLength());
+    } else {
+      auto it = piece->castToUTF16Pointer();
+      res.append(it, it + piece->getStringLength());
+    }
+  });
 }
 
 template <typename T>
@@ -706,6 +775,25 @@ PseudoHandle<StringPrimitive> BufferedStringPrimitive<T>::append(
       runtime, storage->contents_.size(), runtime.makeHandle(storage));
 }
 
+/// \return true if \p str is a BufferedStringPrimitive which doesn't end its
+/// concatenation buffer, so that appending to it requires a copy.
+static bool isBufferedPrefix(const StringPrimitive *str) {
+  if (auto *buf = dyn_vmcast<BufferedASCIIStringPrimitive>(str))
+    return !buf->endsConcatBuffer();
+  if (auto *buf = dyn_vmcast<BufferedUTF16StringPrimitive>(str))
+    return !buf->endsConcatBuffer();
+  return false;
+}
+
+/// \return the depth of \p str if it is a rope, or 0 otherwise.
+static uint32_t getRopeDepth(const StringPrimitive *str) {
+  if (auto *rope = dyn_vmcast<RopeASCIIStringPrimitive>(str))
+    return rope->getDepth();
+  if (auto *rope = dyn_vmcast<RopeUTF16StringPrimitive>(str))
+    return rope->getDepth();
+  return 0;
+}
+
 PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
     Runtime &runtime,
     Handle<StringPrimitive> leftHnd,
@@ -715,7 +803,8 @@ PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
 
   assertValidLength(left, right);
 
-  if (left->isASCII() && right->isASCII()) {
+  bool isASCII = left->isASCII() && right->isASCII();
+  if (isASCII) {
     if (auto *bufLeft = dyn_vmcast<BufferedASCIIStringPrimitive>(left)) {
       if (bufLeft->getStringLength() ==
           bufLeft->getConcatBuffer()->contents_.size())
@@ -724,7 +813,6 @@ PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
             runtime,
             rightHnd);
     }
-    return BufferedASCIIStringPrimitive::create(runtime, leftHnd, rightHnd);
   } else {
     if (auto *bufLeft = dyn_vmcast<BufferedUTF16StringPrimitive>(left)) {
       if (bufLeft->getStringLength() ==
@@ -735,8 +823,26 @@ PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
             rightHnd);
       }
     }
-    return BufferedUTF16StringPrimitive::create(runtime, leftHnd, rightHnd);
   }
+
+  // Copying the left string into a new buffer is wasted work if it is likely
+  // to be concatenated again in a different way: when it is a rope, or a
+  // prefix of a concatenation buffer. Likewise, don't copy long right strings.
+  // Past the maximum depth, fall back to copying, which resets the depth.
+  bool useRope = isRopeStringPrimitive(left) || isBufferedPrefix(left) ||
+      isRopeStringPrimitive(right) ||
+      right->getStringLength() >= StringPrimitive::CONCAT_STRING_MIN_SIZE;
+  if (useRope &&
+      std::max(getRopeDepth(left), getRopeDepth(right)) <
+          RopeASCIIStringPrimitive::MAX_DEPTH) {
+    return isASCII
+        ? RopeASCIIStringPrimitive::create(runtime, leftHnd, rightHnd)
+        : RopeUTF16StringPrimitive::create(runtime, leftHnd, rightHnd);
+  }
+
+  return isASCII
+      ? BufferedASCIIStringPrimitive::create(runtime, leftHnd, rightHnd)
+      : BufferedUTF16StringPrimitive::create(runtime, leftHnd, rightHnd);
 }
 
 #ifdef HERMES_MEMORY_INSTRUMENTATION
@@ -755,5 +861,202 @@ void BufferedStringPrimitive<T>::_snapshotAddNodesImpl(
 
 template class BufferedStringPrimitive<char16_t>;
 template class BufferedStringPrimitive<char>;
+
+//===----------------------------------------------------------------------===//
+// RopeStringPrimitive<T>
+
+void RopeASCIIStringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const RopeASCIIStringPrimitive *>(cell);
+  mb.setVTable(&RopeASCIIStringPrimitive::vt);
+  mb.addField("first", &self->leftHV_);
+  mb.addField("second", &self->rightHV_);
+}
+void RopeUTF16StringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const RopeUTF16StringPrimitive *>(cell);
+  mb.setVTable(&RopeUTF16StringPrimitive::vt);
+  mb.addField("first", &self->leftHV_);
+  mb.addField("second", &self->rightHV_);
+}
+
+template <typename T>
+PseudoHandle<StringPrimitive> RopeStringPrimitive<T>::create(
+    Runtime &runtime,
+    Handle<StringPrimitive> leftHnd,
+    Handle<StringPrimitive> rightHnd) {
+  assertValidLength(leftHnd.get(), rightHnd.get());
+  assert(
+      (std::is_same<T, char16_t>::value ||
+       (leftHnd->isASCII() && rightHnd->isASCII())) &&
+      "cannot create an ASCII rope from UTF16 strings");
+  uint32_t depth =
+      1 + std::max(getRopeDepth(leftHnd.get()), getRopeDepth(rightHnd.get()));
+  assert(depth <= MAX_DEPTH && "rope is too deep");
+  // We have to use a variable sized alloc here even though the size is already
+  // known, because RopeStringPrimitive is derived from VariableSizeRuntimeCell.
+  auto *cell = runtime.makeAVariable<RopeStringPrimitive<T>, HasFinalizer::Yes>(
+      sizeof(RopeStringPrimitive<T>), runtime, leftHnd, rightHnd, depth);
+  return createPseudoHandle<StringPrimitive>(cell);
+}
+
+/// Copy the characters of the flat string \p piece to \p out.
+/// \return the end of the copied characters.
+static char *copyFlatPiece(const StringPrimitive *piece, char *out) {
+  ASCIIRef ref = piece->getStringRef<char>();
+  return std::copy(ref.begin(), ref.end(), out);
+}
+static char16_t *copyFlatPiece(const StringPrimitive *piece, char16_t *out) {
+  if (piece->isASCII()) {
+    ASCIIRef ref = piece->getStringRef<char>();
+    return std::copy(ref.begin(), ref.end(), out);
+  }
+  UTF16Ref ref = piece->getStringRef<char16_t>();
+  return std::copy(ref.begin(), ref.end(), out);
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::flatten() const {
+  assert(!flat_ && "rope is already flattened");
+  T *flat = static_cast<T *>(checkedMalloc2(getStringLength(), sizeof(T)));
+  T *out = flat;
+  forEachFlatPiece([&out](const StringPrimitive *piece) {
+    out = copyFlatPiece(piece, out);
+  });
+  assert(out == flat + getStringLength() && "rope length mismatch");
+  flat_ = flat;
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::flattenAndRelease(Runtime &runtime) {
+  if (creditedFlat_)
+    return;
+  if (!flat_)
+    flatten();
+  creditedFlat_ = true;
+  runtime.getHeap().creditExternalMemory(this, calcExternalMemorySize());
+  leftHV_.setNonPtr(HermesValue::encodeEmptyValue(), runtime.getHeap());
+  rightHV_.setNonPtr(HermesValue::encodeEmptyValue(), runtime.getHeap());
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::_finalizeImpl(GCCell *cell, GC &gc) {
+  auto *self = vmcast<RopeStringPrimitive<T>>(cell);
+  if (self->flat_) {
+    // Remove the flat buffer from the snapshot tracking system if it's being
+    // tracked.
+    gc.getIDTracker().untrackNative(self->flat_);
+    if (self->creditedFlat_)
+      gc.debitExternalMemory(self, self->calcExternalMemorySize());
+    free(self->flat_);
+  }
+  self->~RopeStringPrimitive<T>();
+}
+
+template <typename T>
+size_t RopeStringPrimitive<T>::_mallocSizeImpl(GCCell *cell) {
+  return vmcast<RopeStringPrimitive<T>>(cell)->calcExternalMemorySize();
+}
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+template <typename T>
+std::string RopeStringPrimitive<T>::_snapshotNameImpl(GCCell *cell, GC &gc) {
+  // Don't flatten the string just to name it.
+  if (vmcast<RopeStringPrimitive<T>>(cell)->isFlattened())
+    return StringPrimitive::_snapshotNameImpl(cell, gc);
+  return "(concatenated string)";
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::_snapshotAddEdgesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {
+  auto *const self = vmcast<RopeStringPrimitive<T>>(cell);
+  if (!self->flat_)
+    return;
+  snap.addNamedEdge(
+      HeapSnapshot::EdgeType::Internal,
+      "flatString",
+      gc.getNativeID(self->flat_));
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::_snapshotAddNodesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {
+  auto *const self = vmcast<RopeStringPrimitive<T>>(cell);
+  if (!self->flat_)
+    return;
+  snap.beginNode();
+  snap.endNode(
+      HeapSnapshot::NodeType::Native,
+      "RopeStringPrimitive",
+      gc.getNativeID(self->flat_),
+      self->calcExternalMemorySize(),
+      0);
+}
+#endif
+
+template class RopeStringPrimitive<char16_t>;
+template class RopeStringPrimitive<char>;
+
+//===----------------------------------------------------------------------===//
+// SlicedStringPrimitive<T>
+
+void SlicedASCIIStringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const SlicedASCIIStringPrimitive *>(cell);
+  mb.setVTable(&SlicedASCIIStringPrimitive::vt);
+  mb.addField("parent", &self->parentHV_);
+}
+void SlicedUTF16StringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const SlicedUTF16StringPrimitive *>(cell);
+  mb.setVTable(&SlicedUTF16StringPrimitive::vt);
+  mb.addField("parent", &self->parentHV_);
+}
+
+template <typename T>
+PseudoHandle<StringPrimitive> SlicedStringPrimitive<T>::create(
+    Runtime &runtime,
+    Handle<StringPrimitive> parentHnd,
+    uint32_t offset,
+    uint32_t length) {
+  assert(
+      parentHnd->isFlat() && !isSlicedStringPrimitive(parentHnd.get()) &&
+      "slices must refer to flat strings");
+  assert(
+      (parentHnd->isASCII() == std::is_same<T, char>::value) &&
+      "slice type must match its parent");
+  // We have to use a variable sized alloc here even though the size is already
+  // known, because SlicedStringPrimitive is derived from
+  // VariableSizeRuntimeCell.
+  auto *cell = runtime.makeAVariable<SlicedStringPrimitive<T>>(
+      sizeof(SlicedStringPrimitive<T>), runtime, parentHnd, offset, length);
+  return createPseudoHandle<StringPrimitive>(cell);
+}
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+template <typename T>
+void SlicedStringPrimitive<T>::_snapshotAddEdgesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {}
+
+template <typename T>
+void SlicedStringPrimitive<T>::_snapshotAddNodesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {}
+#endif
+
+template class SlicedStringPrimitive<char16_t>;
+template class SlicedStringPrimitive<char>;
 } // namespace vm
 } // namespace hermes
@@ -18,8 +18,10 @@
 #include "hermes/VM/RootAndSlotAcceptorDefault.h"
 #include "hermes/VM/SmallHermesValue-inline.h"
 
+#include <algorithm>
 #include <array>
 #include <functional>
+#include <numeric>
 #include <stack>
 
 #pragma GCC diagnostic push
@@ -56,8 +58,10 @@ void FreelistBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
 GCCell *HadesGC::OldGen::finishAlloc(GCCell *cell, uint32_t sz) {
   // Track the number of allocated bytes in a segment.
   incrementAllocatedBytes(sz);
-  // Write a mark bit so this entry doesn't get free'd by the sweeper.
-  HeapSegment::setCellMarkBit(cell);
+  // Write a mark bit so this entry doesn't get free'd by the sweeper. This
+  // must be atomic, since threads doing a parallel evacuation may be marking
+  // neighbouring cells at the same time.
+  HeapSegment::atomicSetCellMarkBit(cell);
   // Could overwrite the VTable, but the allocator will write a new one in
   // anyway.
   return cell;
@@ -398,17 +402,175 @@ template <>
   return CompressedPointer::encodeNonNull(a, base);
 }
 
+class HadesGC::Executor {
+ public:
+  explicit Executor(const char *name = "hades")
+      : name_{name}, thread_([this] { worker(); }) {}
+  ~Executor() {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      shutdown_ = true;
+      cv_.notify_one();
+    }
+    thread_.join();
+  }
+
+  std::future<void> add(std::function<void()> fn) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    // Use a shared_ptr because we cannot std::move the promise into the
+    // lambda in C++11.
+    auto promise = std::make_shared<std::promise<void>>();
+    auto ret = promise->get_future();
+    queue_.push_back([promise, fn] {
+      fn();
+      promise->set_value();
+    });
+    cv_.notify_one();
+    return ret;
+  }
+
+  std::thread::id getThreadId() const {
+    return thread_.get_id();
+  }
+
+ private:
+  void worker() {
+    oscompat::set_thread_name(name_);
+    std::unique_lock<std::mutex> lk(mtx_);
+    while (!shutdown_) {
+      cv_.wait(lk, [this]() { return !queue_.empty() || shutdown_; });
+      while (!queue_.empty()) {
+        auto fn = std::move(queue_.front());
+        queue_.pop_front();
+        lk.unlock();
+        fn();
+        lk.lock();
+      }
+    }
+  }
+
+  const char *const name_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> queue_;
+  bool shutdown_{false};
+  std::thread thread_;
+};
+
+/// Shared state for a single round of parallel marking or evacuation. Every
+/// participating worker owns one StealQueue, onto which it donates part of its
+/// local worklist when other workers are idle. Workers that run out of local
+/// work take cells from the StealQueues of the others (or their own).
+class WorkStealingRound {
+ public:
+  explicit WorkStealingRound(size_t numWorkers)
+      : numWorkers_{numWorkers}, queues_(numWorkers) {}
+
+  /// Number of cells moved at once between a local worklist and a StealQueue.
+  static constexpr size_t kStealChunkSize = 64;
+
+  size_t numWorkers() const {
+    return numWorkers_;
+  }
+
+  /// Add \p cells to the StealQueue of the worker at \p idx.
+  void donate(size_t idx, llvh::ArrayRef<GCCell *> cells) {
+    StealQueue &q = queues_[idx];
+    std::lock_guard<std::mutex> lk{q.mtx};
+    q.cells.insert(q.cells.end(), cells.begin(), cells.end());
+    q.size.store(q.cells.size(), std::memory_order_release);
+  }
+
+  /// Take up to half of the cells from the first non-empty StealQueue, starting
+  /// with the one owned by \p idx, and append them to \p out.
+  /// \return true if any cells were taken.
+  bool steal(size_t idx, std::vector<GCCell *> &out) {
+    for (size_t i = 0; i < numWorkers_; ++i) {
+      StealQueue &q = queues_[(idx + i) % numWorkers_];
+      if (!q.size.load(std::memory_order_acquire))
+        continue;
+      std::lock_guard<std::mutex> lk{q.mtx};
+      if (q.cells.empty())
+        continue;
+      const size_t numToTake = std::max<size_t>(
+          std::min(q.cells.size(), kStealChunkSize), q.cells.size() / 2);
+      out.insert(out.end(), q.cells.end() - numToTake, q.cells.end());
+      q.cells.resize(q.cells.size() - numToTake);
+      q.size.store(q.cells.size(), std::memory_order_release);
+      return true;
+    }
+    return false;
+  }
+
+  /// \return true if any StealQueue has cells in it.
+  bool hasQueuedWork() const {
+    for (const StealQueue &q : queues_)
+      if (q.size.load(std::memory_order_acquire))
+        return true;
+    return false;
+  }
+
+  /// Record that a worker has no work left. Workers that have exited the round
+  /// remain idle.
+  void enterIdle() {
+    numIdle_.fetch_add(1, std::memory_order_acq_rel);
+  }
+  void exitIdle() {
+    numIdle_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  /// \return true if there are workers waiting for work. Used to decide
+  /// whether it's worth donating work.
+  bool hasIdleWorkers() const {
+    return numIdle_.load(std::memory_order_relaxed);
+  }
+
+  /// \return true if every worker is idle and there is no queued work, which
+  /// means no new work can appear and the round is complete.
+  bool isComplete() const {
+    return numIdle_.load(std::memory_order_acquire) == numWorkers_ &&
+        !hasQueuedWork();
+  }
+
+  /// Move all cells still in a StealQueue into \p out. Must only be called
+  /// once all workers have exited the round.
+  void takeAll(std::vector<GCCell *> &out) {
+    for (StealQueue &q : queues_) {
+      out.insert(out.end(), q.cells.begin(), q.cells.end());
+      q.cells.clear();
+      q.size.store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  struct StealQueue {
+    std::mutex mtx;
+    std::vector<GCCell *> cells;
+    /// Mirror of cells.size() that can be read without taking the lock.
+    std::atomic<size_t> size{0};
+  };
+
+  const size_t numWorkers_;
+  std::vector<StealQueue> queues_;
+  std::atomic<size_t> numIdle_{0};
+};
+
 template <bool CompactionEnabled>
 class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
                                     public WeakRootAcceptor {
  public:
-  EvacAcceptor(HadesGC &gc)
-      : gc{gc},
-        pointerBase_{gc.getPointerBase()},
-        copyListHead_{nullptr},
-        isTrackingIDs_{gc.isTrackingIDs()} {}
+  EvacAcceptor(HadesGC &gc) : EvacAcceptor(gc, /* isHelper */ false) {}
 
-  ~EvacAcceptor() override {}
+  ~EvacAcceptor() override {
+    assert(bufLevel_ == bufEnd_ && "Allocation buffer was not retired");
+  }
+
+  /// \return true if this acceptor evacuates in parallel with helpers on other
+  /// threads. Moving objects can't be tracked in parallel, so this is only
+  /// the case when IDs aren't being tracked.
+  bool isParallel() const {
+    return isParallel_;
+  }
 
   // TODO: Implement a purely CompressedPointer version of this. That will let
   // us avoid decompressing pointers altogether if they point outside the
@@ -464,6 +626,8 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
   LLVM_NODISCARD T forwardCell(GCCell *const cell) {
     assert(
         HeapSegment::getCellMarkBit(cell) && "Cannot forward unmarked object");
+    if (isParallel_)
+      return convertPtr<T>(pointerBase_, forwardCellParallel(cell));
     if (cell->hasMarkedForwardingPointer()) {
       // Get the forwarding pointer from the header of the object.
       CompressedPointer forwardedCell = cell->getMarkedForwardingPointer();
@@ -560,6 +724,56 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
     return evacuatedBytes_;
   }
 
+  /// Find the pointers from the OG into the YG/compactee, and evacuate
+  /// everything reachable from them or from the cells that were already
+  /// evacuated by this acceptor, using this thread and every helper.
+  void evacuateInParallel() {
+    assert(isParallel_ && "Acceptor is not parallel");
+    const bool preparingCompaction =
+        CompactionEnabled && gc.compactee_.hasPendingSegments();
+    // Evacuating allocates into OG segments, and scanning dirty cards walks the
+    // cells in them, so the two cannot overlap. First scan every segment,
+    // recording the slots to update, and only then start evacuating.
+    std::vector<HeapSegment *> segments;
+    segments.reserve(
+        gc.oldGen_.numSegments() + gc.compactee_.segments.size());
+    for (size_t i = 0; i < gc.oldGen_.numSegments(); ++i)
+      segments.push_back(&gc.oldGen_[i]);
+    // No need to search dirty cards in the compactee segments that are
+    // currently being evacuated, since they will be scanned fully.
+    for (size_t i = gc.compactee_.numEvacuating;
+         i < gc.compactee_.numSegments;
+         ++i)
+      segments.push_back(gc.compactee_.segments[i].get());
+    std::atomic<size_t> nextSegment{0};
+    runOnAllThreads([&segments, &nextSegment, preparingCompaction](
+                        EvacAcceptor &acceptor, size_t) {
+      acceptor.recordDirtySlots(segments, nextSegment, preparingCompaction);
+    });
+
+    // Spread the cells evacuated from the roots across all the queues.
+    const size_t numThreads = helpers_.size() + 1;
+    WorkStealingRound round{numThreads};
+    for (size_t idx = 0; !localWorklist_.empty();
+         idx = (idx + 1) % numThreads) {
+      const size_t numToDonate = std::min(
+          localWorklist_.size(), WorkStealingRound::kStealChunkSize);
+      round.donate(
+          idx, llvh::makeArrayRef(localWorklist_).take_back(numToDonate));
+      localWorklist_.resize(localWorklist_.size() - numToDonate);
+    }
+    runOnAllThreads([&round](EvacAcceptor &acceptor, size_t idx) {
+      acceptor.evacuateInRound(round, idx);
+    });
+    assert(!round.hasQueuedWork() && "Evacuation finished with work left");
+
+    for (auto &helper : helpers_) {
+      evacuatedBytes_ += std::exchange(helper->evacuatedBytes_, 0);
+      helper->retireAllocBuffer();
+    }
+    retireAllocBuffer();
+  }
+
   CopyListCell *pop() {
     if (!copyListHead_) {
       return nullptr;
@@ -580,10 +794,258 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
   const bool isTrackingIDs_;
   uint64_t evacuatedBytes_{0};
 
+  /// The kinds of slot that can be found by scanning dirty cards.
+  enum class SlotKind : uint8_t { Pointer, HermesValue, SmallHermesValue };
+
+  /// A slot in the OG that was found by scanning dirty cards to point into the
+  /// YG/compactee, and still has to be updated.
+  struct DirtySlot {
+    void *loc;
+    SlotKind kind;
+  };
+
+  /// Scans dirty cards on behalf of an EvacAcceptor in a parallel evacuation,
+  /// recording the slots to update instead of evacuating right away.
+  class DirtySlotRecorder final : public SlotAcceptor {
+   public:
+    explicit DirtySlotRecorder(EvacAcceptor &acceptor) : acceptor_{acceptor} {}
+
+    void accept(GCPointerBase &ptr) override {
+      record<CompressedPointer>(ptr, &ptr, SlotKind::Pointer);
+    }
+
+    void accept(GCHermesValue &hv) override {
+      if (hv.isPointer())
+        record(
+            static_cast<GCCell *>(hv.getPointer()), &hv, SlotKind::HermesValue);
+    }
+
+    void accept(GCSmallHermesValue &hv) override {
+      if (hv.isPointer())
+        record(hv.getPointer(), &hv, SlotKind::SmallHermesValue);
+    }
+
+    void accept(const GCSymbolID &sym) override {}
+
+   private:
+    /// Mirrors EvacAcceptor::acceptHeap, without forwarding anything.
+    template <typename Ptr>
+    void record(Ptr ptr, void *heapLoc, SlotKind kind) {
+      if (acceptor_.shouldForward(ptr)) {
+        acceptor_.dirtySlots_.push_back({heapLoc, kind});
+      } else if (CompactionEnabled && acceptor_.gc.compactee_.contains(ptr)) {
+        // If a compaction is about to take place, dirty the card for any newly
+        // evacuated cells, since the marker may miss them.
+        HeapSegment::cardTableCovering(heapLoc)->dirtyCardForAddress(heapLoc);
+      }
+    }
+
+    EvacAcceptor &acceptor_;
+  };
+
+  /// The size of the OG allocation buffers used in a parallel evacuation.
+  /// Cells larger than a quarter of this are allocated directly in the OG.
+  static constexpr uint32_t kAllocBufferSize = 64 * 1024;
+
+  /// Whether other threads may be evacuating at the same time as this
+  /// acceptor.
+  const bool isParallel_;
+
+  /// Acceptors that evacuate on worker threads alongside this one. Only
+  /// non-empty for the primary acceptor in a parallel evacuation.
+  std::vector<std::unique_ptr<EvacAcceptor>> helpers_;
+
+  /// Copied cells whose pointers have yet to be updated. Used instead of the
+  /// copy list in a parallel evacuation.
+  std::vector<GCCell *> localWorklist_;
+
+  /// Slots found by scanning dirty cards that have yet to be updated.
+  std::vector<DirtySlot> dirtySlots_;
+
+  /// The unused part of the OG allocation buffer of this acceptor. It is always
+  /// either empty or large enough to be turned into a FreelistCell.
+  char *bufLevel_{nullptr};
+  char *bufEnd_{nullptr};
+
+  /// \param isHelper Whether this acceptor is a helper of another
+  ///   EvacAcceptor in a parallel evacuation, and does not get its own
+  ///   helpers.
+  EvacAcceptor(HadesGC &gc, bool isHelper)
+      : gc{gc},
+        pointerBase_{gc.getPointerBase()},
+        copyListHead_{nullptr},
+        isTrackingIDs_{gc.isTrackingIDs()},
+        isParallel_{gc.numEvacuationThreads_ > 1 && !isTrackingIDs_} {
+    if (isHelper || !isParallel_)
+      return;
+    helpers_.reserve(gc.numEvacuationThreads_ - 1);
+    for (size_t i = 1; i < gc.numEvacuationThreads_; ++i)
+      helpers_.emplace_back(new EvacAcceptor(gc, /* isHelper */ true));
+  }
+
   void push(CopyListCell *cell) {
     cell->next_ = copyListHead_;
     copyListHead_ = CompressedPointer::encodeNonNull(cell, pointerBase_);
   }
+
+  /// Forward \p cell when other threads may be racing to forward it too. The
+  /// cell is copied into this acceptor's allocation buffer, but the copy is
+  /// only used if this thread is the one to install the forwarding pointer.
+  /// \return the new location of \p cell.
+  GCCell *forwardCellParallel(GCCell *const cell) {
+    KindAndSize header;
+    if (CompressedPointer forwardedCell = cell->loadHeaderAtomic(header))
+      return forwardedCell.getNonNull(pointerBase_);
+    const uint32_t cellSize = header.getSize();
+    GCCell *const newCell = allocForEvacuation(cellSize);
+    std::memcpy(newCell, cell, cellSize);
+    // Another thread may have installed a forwarding pointer while the cell
+    // was being copied, so restore the header that was read above.
+    newCell->setKindAndSize(header);
+    if (!cell->trySetMarkedForwardingPointer(
+            CompressedPointer::encodeNonNull(newCell, pointerBase_))) {
+      // Another thread evacuated the cell first. The copy can't be handed back,
+      // since it is in the middle of the buffer, so leave it as a dead cell for
+      // the next OG collection to sweep.
+      constructCell<FillerCell>(newCell, cellSize);
+      return cell->getMarkedForwardingPointer().getNonNull(pointerBase_);
+    }
+    assert(newCell->isValid() && "Cell was copied incorrectly");
+    evacuatedBytes_ += cellSize;
+    localWorklist_.push_back(newCell);
+    return newCell;
+  }
+
+  /// Allocate \p sz bytes in the OG for a cell evacuated in parallel. Small
+  /// cells are bump allocated in this acceptor's allocation buffer, which is
+  /// refilled from the OG when it runs out.
+  GCCell *allocForEvacuation(uint32_t sz) {
+    const size_t available = bufEnd_ - bufLevel_;
+    // Keep the remainder of the buffer large enough to be freed, or empty.
+    if (LLVM_UNLIKELY(
+            sz != available && sz + minAllocationSize() > available)) {
+      std::lock_guard<Mutex> lk{gc.evacAllocMutex_};
+      if (sz > kAllocBufferSize / 4)
+        return gc.oldGen_.alloc(sz);
+      retireAllocBufferLocked();
+      bufLevel_ = reinterpret_cast<char *>(gc.oldGen_.alloc(kAllocBufferSize));
+      bufEnd_ = bufLevel_ + kAllocBufferSize;
+    }
+    GCCell *const cell = reinterpret_cast<GCCell *>(bufLevel_);
+    bufLevel_ += sz;
+    HeapSegment::setCellHead(cell, sz);
+    // Other threads may be marking cells that share a word of mark bits.
+    HeapSegment::atomicSetCellMarkBit(cell);
+    return cell;
+  }
+
+  /// Return the unused part of the allocation buffer to the OG.
+  void retireAllocBuffer() {
+    std::lock_guard<Mutex> lk{gc.evacAllocMutex_};
+    retireAllocBufferLocked();
+  }
+  void retireAllocBufferLocked() {
+    assert(gc.evacAllocMutex_ && "Must hold evacAllocMutex_");
+    if (bufLevel_ != bufEnd_)
+      gc.oldGen_.freeTail(bufLevel_, bufEnd_ - bufLevel_);
+    bufLevel_ = bufEnd_ = nullptr;
+  }
+
+  /// Run \p fn with this acceptor on the current thread, and with each helper
+  /// on a worker thread, and wait for all of them to finish. \p fn also takes
+  /// the index of the thread it is running on.
+  template <typename Fn>
+  void runOnAllThreads(const Fn &fn) {
+    std::vector<std::future<void>> helperStatus;
+    helperStatus.reserve(helpers_.size());
+    for (size_t i = 0; i < helpers_.size(); ++i) {
+      EvacAcceptor *helper = helpers_[i].get();
+      helperStatus.push_back(gc.workerExecutors_[i]->add(
+          [&fn, helper, i] { fn(*helper, i + 1); }));
+    }
+    fn(*this, 0);
+    for (auto &status : helperStatus)
+      status.get();
+  }
+
+  /// Scan the dirty cards of \p segments into dirtySlots_, claiming one
+  /// segment at a time by incrementing \p nextSegment.
+  void recordDirtySlots(
+      llvh::ArrayRef<HeapSegment *> segments,
+      std::atomic<size_t> &nextSegment,
+      bool preparingCompaction) {
+    DirtySlotRecorder recorder{*this};
+    SlotVisitor<DirtySlotRecorder> visitor{recorder};
+    for (size_t i = nextSegment.fetch_add(1, std::memory_order_relaxed);
+         i < segments.size();
+         i = nextSegment.fetch_add(1, std::memory_order_relaxed)) {
+      HeapSegment &seg = *segments[i];
+      gc.scanDirtyCardsForSegment(visitor, seg);
+      // Do not clear the card table if the OG thread is currently marking to
+      // prepare for a compaction. Note that we should clear the card tables if
+      // the compaction is currently ongoing.
+      if (!preparingCompaction)
+        seg.cardTable().clear();
+    }
+  }
+
+  /// Update the slot at \p slot, evacuating its referent if needed.
+  void acceptDirtySlot(const DirtySlot &slot) {
+    switch (slot.kind) {
+      case SlotKind::Pointer:
+        accept(*static_cast<GCPointerBase *>(slot.loc));
+        break;
+      case SlotKind::HermesValue:
+        accept(*static_cast<GCHermesValue *>(slot.loc));
+        break;
+      case SlotKind::SmallHermesValue:
+        accept(*static_cast<GCSmallHermesValue *>(slot.loc));
+        break;
+    }
+  }
+
+  /// The loop run by each thread in a parallel evacuation. \p idx is the index
+  /// of this thread in \p round.
+  void evacuateInRound(WorkStealingRound &round, size_t idx) {
+    for (const DirtySlot &slot : dirtySlots_) {
+      acceptDirtySlot(slot);
+      shareWork(round, idx);
+    }
+    dirtySlots_.clear();
+    while (true) {
+      while (!localWorklist_.empty()) {
+        GCCell *const cell = localWorklist_.back();
+        localWorklist_.pop_back();
+        // Update the pointers inside the copied cell.
+        gc.markCell(cell, *this);
+        shareWork(round, idx);
+      }
+      if (round.steal(idx, localWorklist_))
+        continue;
+      // Out of work: wait until some shows up, or every thread is out of work.
+      round.enterIdle();
+      bool foundWork = false;
+      while (!round.isComplete()) {
+        if (round.hasQueuedWork() && round.steal(idx, localWorklist_)) {
+          foundWork = true;
+          break;
+        }
+        std::this_thread::yield();
+      }
+      if (!foundWork)
+        return;
+      round.exitIdle();
+    }
+  }
+
+  /// Give away some of the local worklist if another thread is starving.
+  void shareWork(WorkStealingRound &round, size_t idx) {
+    constexpr size_t kChunk = WorkStealingRound::kStealChunkSize;
+    if (localWorklist_.size() <= 2 * kChunk || !round.hasIdleWorkers())
+      return;
+    round.donate(idx, llvh::makeArrayRef(localWorklist_).take_back(kChunk));
+    localWorklist_.resize(localWorklist_.size() - kChunk);
+  }
 };
 
 class MarkWorklist {
@@ -696,18 +1158,15 @@ class MarkWorklist {
 
 class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor {
  public:
-  MarkAcceptor(HadesGC &gc)
-      : gc{gc},
-        pointerBase_{gc.getPointerBase()},
-        markedSymbols_{gc.gcCallbacks_.getSymbolsEnd()},
-        writeBarrierMarkedSymbols_{gc.gcCallbacks_.getSymbolsEnd()} {}
+  MarkAcceptor(HadesGC &gc) : MarkAcceptor(gc, /* isHelper */ false) {}
 
   void acceptHeap(GCCell *cell, const void *heapLoc) {
     assert(cell && "Cannot pass null pointer to acceptHeap");
     assert(!gc.inYoungGen(heapLoc) && "YG slot found in OG marking");
-    if (gc.compactee_.contains(cell) && !gc.compactee_.contains(heapLoc)) {
-      // This is a pointer in the heap pointing into the compactee, dirty the
-      // corresponding card.
+    if (gc.compactee_.contains(cell) &&
+        !AlignedStorage::containedInSame(cell, heapLoc)) {
+      // This is a pointer in the heap pointing into a compactee from outside
+      // it, dirty the corresponding card.
       HeapSegment::cardTableCovering(heapLoc)->dirtyCardForAddress(heapLoc);
     }
     if (HeapSegment::getCellMarkBit(cell)) {
@@ -811,6 +1270,8 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor {
 
   /// \return the total number of bytes marked so far.
   uint64_t markedBytes() const {
+    assert(
+        !parallelRound_ && "Cannot read marked bytes during parallel marking");
     return markedBytes_;
   }
 
@@ -832,6 +1293,12 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor {
     // See the comment in setDrainRate for why the drain rate isn't used for
     // concurrent collections.
     constexpr size_t kConcurrentMarkLimit = 8192;
+    // Waking up the helper threads has a fixed cost, so let each of them mark a
+    // larger amount per round. The background thread still yields promptly to
+    // the mutator, because every marker stops as soon as ogPaused_ is set.
+    constexpr size_t kParallelMarkLimit = 1 << 20;
+    if (!helpers_.empty())
+      return drainSomeWork(kParallelMarkLimit);
     return drainSomeWork(kConcurrentGC ? kConcurrentMarkLimit : byteDrainRate_);
   }
 
@@ -861,8 +1328,11 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor {
       }
     }
 
-    size_t numMarkedBytes = 0;
     assert(markLimit && "markLimit must be non-zero!");
+    if (!helpers_.empty())
+      return drainInParallel(markLimit);
+
+    size_t numMarkedBytes = 0;
     while (!localWorklist_.empty() && numMarkedBytes < markLimit) {
       GCCell *const cell = localWorklist_.top();
       localWorklist_.pop();
@@ -897,12 +1367,161 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor {
   llvh::BitVector &markedSymbols() {
     assert(gc.gcMutex_ && "Cannot call markedSymbols without a lock");
     markedSymbols_ |= writeBarrierMarkedSymbols_;
+    for (auto &helper : helpers_)
+      markedSymbols_ |= helper->markedSymbols_;
     // No need to clear writeBarrierMarkedSymbols_, or'ing it again won't change
     // the bit vector.
     return markedSymbols_;
   }
 
  private:
+  /// \param isHelper If true, this acceptor only marks on behalf of another
+  ///   MarkAcceptor during parallel marking, and does not get its own helpers.
+  MarkAcceptor(HadesGC &gc, bool isHelper)
+      : gc{gc},
+        pointerBase_{gc.getPointerBase()},
+        markedSymbols_{gc.gcCallbacks_.getSymbolsEnd()},
+        writeBarrierMarkedSymbols_{
+            isHelper ? 0 : gc.gcCallbacks_.getSymbolsEnd()} {
+    if (isHelper)
+      return;
+    const size_t numHelpers = gc.markerThreadCPUTimes_.size() - 1;
+    helpers_.reserve(numHelpers);
+    for (size_t i = 0; i < numHelpers; ++i)
+      helpers_.emplace_back(new MarkAcceptor(gc, /* isHelper */ true));
+  }
+
+  /// Mark using this thread and every helper thread, until either all
+  /// reachable cells are marked, each marker has marked \p markLimit bytes, or
+  /// the mutator asks the background thread to pause.
+  /// \return true if there is any remaining work in the local worklist.
+  bool drainInParallel(const size_t markLimit) {
+    const size_t numMarkers = helpers_.size() + 1;
+    WorkStealingRound round{numMarkers};
+    // Seed the round by spreading the local worklist across all the queues.
+    {
+      std::vector<GCCell *> chunk;
+      for (size_t idx = 0; !localWorklist_.empty();
+           idx = (idx + 1) % numMarkers) {
+        while (!localWorklist_.empty() &&
+               chunk.size() < WorkStealingRound::kStealChunkSize) {
+          chunk.push_back(localWorklist_.top());
+          localWorklist_.pop();
+        }
+        round.donate(idx, chunk);
+        chunk.clear();
+      }
+    }
+
+    parallelRound_ = &round;
+    std::vector<std::future<void>> helperStatus;
+    helperStatus.reserve(helpers_.size());
+    for (size_t i = 0; i < helpers_.size(); ++i) {
+      MarkAcceptor *helper = helpers_[i].get();
+      helper->parallelRound_ = &round;
+      helperStatus.push_back(gc.workerExecutors_[i]->add(
+          [helper, i, markLimit] { helper->markInRound(i + 1, markLimit); }));
+    }
+    markInRound(0, markLimit);
+    for (auto &status : helperStatus)
+      status.get();
+    parallelRound_ = nullptr;
+
+    // Collect the results of the helpers, along with any work that was left
+    // over because a marker stopped early.
+    gc.markerThreadCPUTimes_[0] += std::exchange(roundCPUTime_, {});
+    std::vector<GCCell *> leftover;
+    round.takeAll(leftover);
+    for (size_t i = 0; i < helpers_.size(); ++i) {
+      MarkAcceptor &helper = *helpers_[i];
+      helper.parallelRound_ = nullptr;
+      markedBytes_ += std::exchange(helper.markedBytes_, 0);
+      gc.markerThreadCPUTimes_[i + 1] +=
+          std::exchange(helper.roundCPUTime_, {});
+      while (!helper.localWorklist_.empty()) {
+        leftover.push_back(helper.localWorklist_.top());
+        helper.localWorklist_.pop();
+      }
+    }
+    for (GCCell *cell : leftover)
+      localWorklist_.push(cell);
+    return !localWorklist_.empty();
+  }
+
+  /// The loop run by each marker in a parallel marking round. \p idx is the
+  /// index of this marker in the round, and \p markLimit is the number of
+  /// bytes after which it should stop.
+  void markInRound(const size_t idx, const size_t markLimit) {
+    WorkStealingRound &round = *parallelRound_;
+    const auto cpuTimeStart = oscompat::thread_cpu_time();
+    std::vector<GCCell *> transfer;
+    size_t numMarkedBytes = 0;
+    const auto shouldStop = [this, &numMarkedBytes, markLimit] {
+      return numMarkedBytes >= markLimit ||
+          gc.ogPaused_.load(std::memory_order_relaxed);
+    };
+    bool idle = false;
+    while (!shouldStop()) {
+      if (!localWorklist_.empty()) {
+        GCCell *const cell = localWorklist_.top();
+        localWorklist_.pop();
+        assert(cell->isValid() && "Invalid cell in marking");
+        assert(
+            HeapSegment::getCellMarkBit(cell) && "Discovered unmarked object");
+        numMarkedBytes += cell->getAllocatedSize();
+        gc.markCell(cell, *this);
+        // Give away some work if another marker is starving.
+        if (localWorklist_.size() > 2 * WorkStealingRound::kStealChunkSize &&
+            round.hasIdleWorkers()) {
+          for (size_t i = 0; i < WorkStealingRound::kStealChunkSize; ++i) {
+            transfer.push_back(localWorklist_.top());
+            localWorklist_.pop();
+          }
+          round.donate(idx, transfer);
+          transfer.clear();
+        }
+        continue;
+      }
+      if (stealInto(round, idx, transfer))
+        continue;
+      // Out of work: wait until some shows up, or every marker is out of work.
+      round.enterIdle();
+      idle = true;
+      while (!round.isComplete() && !shouldStop()) {
+        if (round.hasQueuedWork() && stealInto(round, idx, transfer)) {
+          idle = false;
+          break;
+        }
+        std::this_thread::yield();
+      }
+      if (idle)
+        break;
+      round.exitIdle();
+    }
+    // A marker that stops early still counts as idle, so that the others can
+    // tell when the round is complete. Its local work is picked up once the
+    // round is over.
+    if (!idle)
+      round.enterIdle();
+    markedBytes_ += numMarkedBytes;
+    roundCPUTime_ += oscompat::thread_cpu_time() - cpuTimeStart;
+  }
+
+  /// Take work from the queues of \p round into the local worklist, using
+  /// \p transfer as a scratch buffer.
+  /// \return true if any work was taken.
+  bool stealInto(
+      WorkStealingRound &round,
+      size_t idx,
+      std::vector<GCCell *> &transfer) {
+    if (!round.steal(idx, transfer))
+      return false;
+    for (GCCell *cell : transfer)
+      localWorklist_.push(cell);
+    transfer.clear();
+    return true;
+  }
+
   HadesGC &gc;
   PointerBase &pointerBase_;
 
@@ -938,14 +1557,32 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor {
   /// The number of bytes that have been marked so far.
   uint64_t markedBytes_{0};
 
+  /// Acceptors that mark on other threads alongside this one. Only non-empty
+  /// for the primary acceptor when GCConfig::NumMarkerThreads is above 1.
+  std::vector<std::unique_ptr<MarkAcceptor>> helpers_;
+
+  /// The parallel marking round this acceptor is participating in, if any.
+  /// While this is set, several threads may be setting mark bits at once.
+  WorkStealingRound *parallelRound_{nullptr};
+
+  /// CPU time spent by this acceptor in the current parallel marking round.
+  std::chrono::microseconds roundCPUTime_{};
+
   void push(GCCell *cell) {
-    assert(
-        !HeapSegment::getCellMarkBit(cell) &&
-        "A marked object should never be pushed onto a worklist");
     assert(
         !gc.inYoungGen(cell) &&
         "Shouldn't ever push a YG object onto the worklist");
-    HeapSegment::setCellMarkBit(cell);
+    if (parallelRound_) {
+      // Another marker may have marked this cell since the caller checked its
+      // mark bit, only the one that actually sets it may push the cell.
+      if (!HeapSegment::atomicSetCellMarkBit(cell))
+        return;
+    } else {
+      assert(
+          !HeapSegment::getCellMarkBit(cell) &&
+          "A marked object should never be pushed onto a worklist");
+      HeapSegment::setCellMarkBit(cell);
+    }
     // There could be a race here: however, the mutator will never change a
     // cell's kind after initialization. The GC thread might to a free cell, but
     // only during sweeping, not concurrently with this operation. Therefore
@@ -1028,59 +1665,6 @@ class HadesGC::MarkWeakRootsAcceptor final : public WeakRootAcceptor {
   HadesGC &gc_;
 };
 
-class HadesGC::Executor {
- public:
-  Executor() : thread_([this] { worker(); }) {}
-  ~Executor() {
-    {
-      std::lock_guard<std::mutex> lk(mtx_);
-      shutdown_ = true;
-      cv_.notify_one();
-    }
-    thread_.join();
-  }
-
-  std::future<void> add(std::function<void()> fn) {
-    std::lock_guard<std::mutex> lk(mtx_);
-    // Use a shared_ptr because we cannot std::move the promise into the
-    // lambda in C++11.
-    auto promise = std::make_shared<std::promise<void>>();
-    auto ret = promise->get_future();
-    queue_.push_back([promise, fn] {
-      fn();
-      promise->set_value();
-    });
-    cv_.notify_one();
-    return ret;
-  }
-
-  std::thread::id getThreadId() const {
-    return thread_.get_id();
-  }
-
- private:
-  void worker() {
-    oscompat::set_thread_name("hades");
-    std::unique_lock<std::mutex> lk(mtx_);
-    while (!shutdown_) {
-      cv_.wait(lk, [this]() { return !queue_.empty() || shutdown_; });
-      while (!queue_.empty()) {
-        auto fn = std::move(queue_.front());
-        queue_.pop_front();
-        lk.unlock();
-        fn();
-        lk.lock();
-      }
-    }
-  }
-
-  std::mutex mtx_;
-  std::condition_variable cv_;
-  std::deque<std::function<void()>> queue_;
-  bool shutdown_{false};
-  std::thread thread_;
-};
-
 bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
   // Check if there are any more segments to sweep. Note that in the case where
   // OG has zero segments, this also skips updating the stats and survival ratio
@@ -1089,41 +1673,78 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
     return false;
   assert(gc_.gcMutex_ && "gcMutex_ must be held while sweeping.");
 
-  sweepIterator_.segNumber--;
-
-  const bool isTracking = gc_.isTrackingIDs();
   // Re-evaluate this start point each time, as releasing the gcMutex_ allows
   // allocations into the old gen, which might boost the credited memory.
   const uint64_t externalBytesBefore = externalBytes();
 
-  auto &segBuckets = segmentBuckets_[sweepIterator_.segNumber];
+  // Sweep a batch of segments in parallel if there are workers to help. This
+  // is only done on the background thread, which does not trim cells, and
+  // when not tracking IDs, since untracking objects is not thread-safe.
+  const size_t numSegments =
+      std::min<size_t>(gc_.numSweeperThreads_, sweepIterator_.segNumber);
+  if (kConcurrentGC && backgroundThread && numSegments > 1 &&
+      !gc_.isTrackingIDs()) {
+    sweepSegmentsInParallel(numSegments);
+  } else {
+    sweepSegment(--sweepIterator_.segNumber, backgroundThread);
+  }
+  sweepIterator_.sweptExternalBytes += externalBytesBefore - externalBytes();
 
-  // Clear the head pointers and remove this segment from the segment level
-  // freelists, so that we can construct a new freelist. The
-  // freelistBucketBitArray_ will be updated after the segment is swept. The
-  // bits will be inconsistent with the actual freelist for the duration of
-  // sweeping, but this is fine because gcMutex_ is held during the entire
-  // period.
-  for (size_t bucket = 0; bucket < kNumFreelistBuckets; bucket++) {
-    auto *segBucket = &segBuckets[bucket];
-    if (segBucket->head) {
-      segBucket->removeFromFreelist();
-      segBucket->head = nullptr;
-    }
+  // There are more iterations to go.
+  if (sweepIterator_.segNumber)
+    return true;
+
+  // This was the last sweep iteration, finish the collection.
+  auto &stats = *gc_.ogCollectionStats_;
+
+  auto sweptBytes = sweepIterator_.sweptBytes;
+  auto preAllocated = stats.beforeAllocatedBytes();
+  if (sweptBytes > preAllocated) {
+    // Only trimming can result in freeing more memory than was allocated at the
+    // start of the collection, since we may trim cells that were allocated
+    // after the collection started.
+    assert(sweepIterator_.trimmedBytes >= (sweptBytes - preAllocated));
+    // We can't precisely calculate how much of the trimmed memory came from
+    // cells allocated during the collection, so just cap the swept bytes at the
+    // number of initially allocated bytes.
+    sweptBytes = preAllocated;
   }
+  stats.setSweptBytes(sweptBytes);
+  stats.setSweptExternalBytes(sweepIterator_.sweptExternalBytes);
+  const uint64_t targetSizeBytes =
+      (stats.afterAllocatedBytes() + stats.afterExternalBytes()) /
+      gc_.occupancyTarget_;
+
+  // In a very large heap, use the configured max heap size as a backstop to
+  // prevent the target size crossing it (which would delay collection and cause
+  // an OOM). This is just an approximation, a precise accounting would subtract
+  // segment metadata and YG memory.
+  uint64_t clampedSizeBytes = std::min(targetSizeBytes, gc_.maxHeapSize_);
+  targetSizeBytes_.update(clampedSizeBytes);
+  sweepIterator_ = {};
+  return false;
+}
+
+void HadesGC::OldGen::sweepSegment(size_t segIdx, bool backgroundThread) {
+  const bool isTracking = gc_.isTrackingIDs();
+  auto &segBuckets = segmentBuckets_[segIdx];
+  clearSegmentFreelists(segBuckets);
 
   char *freeRangeStart = nullptr, *freeRangeEnd = nullptr;
   size_t mergedCells = 0;
   int32_t segmentSweptBytes = 0;
-  for (GCCell *cell : segments_[sweepIterator_.segNumber].cells()) {
+  uint32_t segmentLiveBytes = 0;
+  for (GCCell *cell : segments_[segIdx].cells()) {
     assert(cell->isValid() && "Invalid cell in sweeping");
     if (HeapSegment::getCellMarkBit(cell)) {
+      const uint32_t cellSize = cell->getAllocatedSize();
       // Cannot concurrently trim storage. Technically just checking
       // backgroundThread would suffice, but the kConcurrentGC lets us compile
       // away this check in incremental mode.
-      if (kConcurrentGC && backgroundThread)
+      if (kConcurrentGC && backgroundThread) {
+        segmentLiveBytes += cellSize;
         continue;
-      const uint32_t cellSize = cell->getAllocatedSize();
+      }
       const uint32_t trimmedSize =
           cell->getVT()->getTrimmedSize(cell, cellSize);
       assert(cellSize >= trimmedSize && "Growing objects is not supported.");
@@ -1150,6 +1771,7 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
         sweepIterator_.trimmedBytes += trimmableBytes;
 #endif
       }
+      segmentLiveBytes += cell->getAllocatedSize();
       continue;
     }
 
@@ -1188,6 +1810,109 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
     addCellToFreelistFromSweep(
         freeRangeStart, freeRangeEnd, segBuckets, mergedCells > 1);
 
+  restoreSegmentFreelists(segBuckets);
+  recordSegmentSwept(segIdx, segmentSweptBytes, segmentLiveBytes);
+}
+
+void HadesGC::OldGen::sweepSegmentsInParallel(size_t numSegments) {
+  assert(
+      numSegments <= sweepIterator_.segNumber &&
+      numSegments - 1 <= gc_.workerExecutors_.size() &&
+      "Not enough segments or workers for the batch");
+  if (parallelSweepResults_.size() < numSegments)
+    parallelSweepResults_.resize(numSegments);
+  // Segments are swept from the back, so result i is for the segment at
+  // firstSeg - i.
+  const size_t firstSeg = sweepIterator_.segNumber - 1;
+  std::vector<std::future<void>> workerStatus;
+  workerStatus.reserve(numSegments - 1);
+  for (size_t i = 1; i < numSegments; ++i) {
+    workerStatus.push_back(
+        gc_.workerExecutors_[i - 1]->add([this, firstSeg, i] {
+          scanSegmentForSweep(
+              segments_[firstSeg - i], parallelSweepResults_[i]);
+        }));
+  }
+  scanSegmentForSweep(segments_[firstSeg], parallelSweepResults_[0]);
+  for (auto &status : workerStatus)
+    status.wait();
+
+  // Finalizers may take the gcMutex_ to update the external memory, and the
+  // freelists are shared by all segments, so the rest of the sweep happens on
+  // this thread, in the same order as a serial sweep.
+  for (size_t i = 0; i < numSegments; ++i) {
+    SegmentSweepResult &result = parallelSweepResults_[i];
+    auto &segBuckets = segmentBuckets_[firstSeg - i];
+    clearSegmentFreelists(segBuckets);
+    // Finalize the dead cells before any of them are overwritten by the
+    // freelist.
+    for (GCCell *cell : result.finalizableCells)
+      cell->getVT()->finalize(cell, gc_);
+    for (const auto &range : result.freeRanges)
+      addCellToFreelistFromSweep(
+          range.start, range.end, segBuckets, range.merged);
+    restoreSegmentFreelists(segBuckets);
+    recordSegmentSwept(firstSeg - i, result.sweptBytes, result.liveBytes);
+    result.freeRanges.clear();
+    result.finalizableCells.clear();
+    result.sweptBytes = 0;
+    result.liveBytes = 0;
+  }
+  sweepIterator_.segNumber -= numSegments;
+}
+
+void HadesGC::OldGen::scanSegmentForSweep(
+    HeapSegment &seg,
+    SegmentSweepResult &result) {
+  assert(
+      result.freeRanges.empty() && result.finalizableCells.empty() &&
+      !result.sweptBytes && !result.liveBytes &&
+      "Sweep result must start empty");
+  SegmentSweepResult::FreeRange *curRange = nullptr;
+  for (GCCell *cell : seg.cells()) {
+    assert(cell->isValid() && "Invalid cell in sweeping");
+    if (HeapSegment::getCellMarkBit(cell)) {
+      result.liveBytes += cell->getAllocatedSize();
+      continue;
+    }
+
+    const auto sz = cell->getAllocatedSize();
+    char *const cellCharPtr = reinterpret_cast<char *>(cell);
+    if (curRange && curRange->end == cellCharPtr) {
+      // Expand the current free range to include the current cell.
+      curRange->end += sz;
+      curRange->merged = true;
+    } else {
+      result.freeRanges.push_back({cellCharPtr, cellCharPtr + sz, false});
+      curRange = &result.freeRanges.back();
+    }
+
+    if (vmisa<FreelistCell>(cell))
+      continue;
+
+    result.sweptBytes += sz;
+    if (cell->getVT()->finalize_)
+      result.finalizableCells.push_back(cell);
+  }
+}
+
+void HadesGC::OldGen::clearSegmentFreelists(SegmentBuckets &segBuckets) {
+  // Clear the head pointers and remove this segment from the segment level
+  // freelists, so that we can construct a new freelist. The
+  // freelistBucketBitArray_ will be updated after the segment is swept. The
+  // bits will be inconsistent with the actual freelist for the duration of
+  // sweeping, but this is fine because gcMutex_ is held during the entire
+  // period.
+  for (size_t bucket = 0; bucket < kNumFreelistBuckets; bucket++) {
+    auto *segBucket = &segBuckets[bucket];
+    if (segBucket->head) {
+      segBucket->removeFromFreelist();
+      segBucket->head = nullptr;
+    }
+  }
+}
+
+void HadesGC::OldGen::restoreSegmentFreelists(SegmentBuckets &segBuckets) {
   // Update the segment level freelists for any buckets that this segment has
   // free cells for.
   for (size_t bucket = 0; bucket < kNumFreelistBuckets; ++bucket) {
@@ -1201,45 +1926,33 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
     // erased prior to sweeping.
     freelistBucketBitArray_.set(bucket, buckets_[bucket].next);
   }
+}
 
+void HadesGC::OldGen::recordSegmentSwept(
+    size_t segIdx,
+    int32_t segmentSweptBytes,
+    uint32_t segmentLiveBytes) {
+  segmentLiveBytes_[segIdx] = segmentLiveBytes;
   // Correct the allocated byte count.
   incrementAllocatedBytes(-segmentSweptBytes);
   sweepIterator_.sweptBytes += segmentSweptBytes;
-  sweepIterator_.sweptExternalBytes += externalBytesBefore - externalBytes();
-
-  // There are more iterations to go.
-  if (sweepIterator_.segNumber)
-    return true;
-
-  // This was the last sweep iteration, finish the collection.
-  auto &stats = *gc_.ogCollectionStats_;
-
-  auto sweptBytes = sweepIterator_.sweptBytes;
-  auto preAllocated = stats.beforeAllocatedBytes();
-  if (sweptBytes > preAllocated) {
-    // Only trimming can result in freeing more memory than was allocated at the
-    // start of the collection, since we may trim cells that were allocated
-    // after the collection started.
-    assert(sweepIterator_.trimmedBytes >= (sweptBytes - preAllocated));
-    // We can't precisely calculate how much of the trimmed memory came from
-    // cells allocated during the collection, so just cap the swept bytes at the
-    // number of initially allocated bytes.
-    sweptBytes = preAllocated;
-  }
-  stats.setSweptBytes(sweptBytes);
-  stats.setSweptExternalBytes(sweepIterator_.sweptExternalBytes);
-  const uint64_t targetSizeBytes =
-      (stats.afterAllocatedBytes() + stats.afterExternalBytes()) /
-      gc_.occupancyTarget_;
+  // Publish the progress as each segment is swept, rather than only once the
+  // whole OG has been swept, so that the memory is visible as reclaimed as
+  // soon as possible. The final count is corrected once sweeping completes.
+  if (gc_.ogCollectionStats_)
+    gc_.ogCollectionStats_->setSweptBytes(std::min(
+        sweepIterator_.sweptBytes,
+        gc_.ogCollectionStats_->beforeAllocatedBytes()));
+}
 
-  // In a very large heap, use the configured max heap size as a backstop to
-  // prevent the target size crossing it (which would delay collection and cause
-  // an OOM). This is just an approximation, a precise accounting would subtract
-  // segment metadata and YG memory.
-  uint64_t clampedSizeBytes = std::min(targetSizeBytes, gc_.maxHeapSize_);
-  targetSizeBytes_.update(clampedSizeBytes);
-  sweepIterator_ = {};
-  return false;
+void HadesGC::OldGen::sweepOnDemand(uint64_t sz) {
+  assert(gc_.gcMutex_ && "gcMutex_ must be held while sweeping.");
+  // The sweep iterator is set up when marking starts, but segments can only be
+  // swept once marking has completed.
+  if (gc_.concurrentPhase_ != Phase::Sweep)
+    return;
+  while (sweepIterator_.segNumber > 1 && size() - allocatedBytes() < sz)
+    sweepSegment(--sweepIterator_.segNumber, /*backgroundThread*/ false);
 }
 
 void HadesGC::OldGen::initializeSweep() {
@@ -1285,6 +1998,8 @@ HadesGC::HadesGC(
       oldGen_{*this},
       backgroundExecutor_{
           kConcurrentGC ? std::make_unique<Executor>() : nullptr},
+      markerThreadCPUTimes_(
+          kConcurrentGC ? std::max(gcConfig.getNumMarkerThreads(), 1u) : 1),
       promoteYGToOG_{!gcConfig.getAllocInYoung()},
       revertToYGAtTTI_{gcConfig.getRevertToYGAtTTI()},
       overwriteDeadYGObjects_{gcConfig.getOverwriteDeadYGObjects()},
@@ -1294,6 +2009,27 @@ HadesGC::HadesGC(
           /*init*/ kYGInitialSizeFactor * HeapSegment::maxSize() *
               kYGInitialSurvivalRatio} {
   (void)vmExperimentFlags;
+#ifndef HERMESVM_EXCEPTION_ON_OOM
+  // Evacuation may run out of memory on a worker thread, where an exception
+  // could not be thrown, so it only runs in parallel when OOM is fatal.
+  if (kConcurrentGC)
+    numEvacuationThreads_ = std::max(gcConfig.getNumEvacuationThreads(), 1u);
+#endif
+  if (kConcurrentGC)
+    numSweeperThreads_ = std::max(gcConfig.getNumSweeperThreads(), 1u);
+  maxCompacteeSegments_ = std::min<size_t>(
+      std::max(gcConfig.getMaxCompacteeSegments(), 1u),
+      CompacteeState::kMaxSegments);
+  compactionBytesPerPause_ = gcConfig.getCompactionBytesPerPause();
+  // Parallel marking and evacuation rely on concurrently setting mark bits, so
+  // they are only available in concurrent mode. The background thread is the
+  // first marker and sweeper, and the mutator is the first evacuator.
+  const size_t numWorkers = std::max<size_t>(
+      {markerThreadCPUTimes_.size(),
+       numEvacuationThreads_,
+       numSweeperThreads_});
+  for (size_t i = 1; i < numWorkers; ++i)
+    workerExecutors_.push_back(std::make_unique<Executor>("hades-worker"));
   std::lock_guard<Mutex> lk(gcMutex_);
   crashMgr_->setCustomData("HermesGC", getKindAsStr().c_str());
   // createSegment relies on member variables and should not be called until
@@ -1446,6 +2182,16 @@ void HadesGC::printStats(JSONEmitter &json) {
   json.emitKey("stats");
   json.openDict();
   json.emitKeyValue("Num compactions", numCompactions_);
+  if (markerThreadCPUTimes_.size() > 1) {
+    auto lk = ensureBackgroundTaskPaused();
+    json.emitKey("Marker thread CPU times (ms)");
+    json.openArray();
+    for (auto cpuTime : markerThreadCPUTimes_)
+      json.emitValue(
+          std::chrono::duration_cast<std::chrono::milliseconds>(cpuTime)
+              .count());
+    json.closeArray();
+  }
   json.closeDict();
   json.closeDict();
 }
@@ -1472,13 +2218,19 @@ void HadesGC::collect(std::string cause, bool /*canEffectiveOOM*/) {
     std::lock_guard<Mutex> lk{gcMutex_};
     waitForCollectionToFinish(cause);
   }
-  // Start a second YG collection to complete any pending compaction.
-  // Since YG is empty, this will only be evacuating the compactee.
-  // Note that it's possible for this call to start another OG collection if the
-  // occupancy target is >= 75%. That doesn't break the contract of this
+  // Start more YG collections to complete any pending compaction. Since YG is
+  // empty, these will only be evacuating the compactees, which may take more
+  // than one collection to stay within the compaction pause budget.
+  // Note that it's possible for the last call to start another OG collection if
+  // the occupancy target is >= 75%. That doesn't break the contract of this
   // function though, and we don't want to bother with waiting for that
   // collection to complete because it won't find any garbage anyway.
-  youngGenCollection(std::move(cause), /*forceOldGenCollection*/ false);
+  bool compacting;
+  do {
+    youngGenCollection(cause, /*forceOldGenCollection*/ false);
+    std::lock_guard<Mutex> lk{gcMutex_};
+    compacting = compactee_.evacActive();
+  } while (compacting);
 }
 
 void HadesGC::waitForCollectionToFinish(std::string cause) {
@@ -1715,60 +2467,152 @@ void HadesGC::prepareCompactee(bool forceCompaction) {
 #endif
 
   // To avoid compacting too often, keep a buffer of one segment or 5% of the
-  // heap (whichever is greater). Since the selected segment will be removed
+  // heap (whichever is greater). Since the selected segments will be removed
   // from the heap, we only want to compact if there are at least 2 segments in
   // the OG.
   uint64_t buffer = std::max<uint64_t>(
       oldGen_.targetSizeBytes() / 20, HeapSegment::maxSize());
   uint64_t threshold = oldGen_.targetSizeBytes() + buffer;
   uint64_t totalBytes = oldGen_.size() + oldGen_.externalBytes();
-  if ((forceCompaction || totalBytes > threshold) &&
-      oldGen_.numSegments() > 1) {
-    compactee_.segment = std::make_shared<HeapSegment>(oldGen_.popSegment());
+  if ((!forceCompaction && totalBytes <= threshold) ||
+      oldGen_.numSegments() <= 1)
+    return;
+
+  // Compact as many segments as it takes to bring the OG back to its target
+  // size, and always leave at least one segment in the OG.
+  const size_t maxSegments =
+      std::min(maxCompacteeSegments_, oldGen_.numSegments() - 1);
+  const size_t numSegments = forceCompaction
+      ? maxSegments
+      : std::min<size_t>(
+            maxSegments,
+            std::max<uint64_t>(
+                (totalBytes - oldGen_.targetSizeBytes()) /
+                    HeapSegment::maxSize(),
+                1));
+
+  // Pick the segments with the fewest live bytes, since they free the most
+  // memory for the least copying. Beyond the first, only pick segments that
+  // are sparser than the occupancy target, since denser segments are not worth
+  // the extra pause time.
+  std::vector<size_t> candidates(oldGen_.numSegments());
+  std::iota(candidates.begin(), candidates.end(), 0);
+  std::partial_sort(
+      candidates.begin(),
+      candidates.begin() + numSegments,
+      candidates.end(),
+      [this](size_t a, size_t b) {
+        return oldGen_.segmentLiveBytes(a) < oldGen_.segmentLiveBytes(b);
+      });
+  const auto maxLiveBytes =
+      static_cast<uint64_t>(HeapSegment::maxSize() * occupancyTarget_);
+  size_t numChosen = 1;
+  while (numChosen < numSegments &&
+         oldGen_.segmentLiveBytes(candidates[numChosen]) <= maxLiveBytes)
+    ++numChosen;
+  candidates.resize(numChosen);
+
+  // Removing a segment moves the last segment into its place, so remove them
+  // from the highest index down, to keep the remaining indices valid. Record
+  // them in the order they were chosen, so the sparsest are evacuated first.
+  std::vector<size_t> removalOrder(candidates);
+  std::sort(removalOrder.begin(), removalOrder.end(), std::greater<size_t>());
+  compactee_.segments.resize(numChosen);
+  for (size_t idx : removalOrder) {
+    const size_t i = std::find(candidates.begin(), candidates.end(), idx) -
+        candidates.begin();
+    compactee_.liveBytes[i] = oldGen_.segmentLiveBytes(idx);
+    compactee_.segments[i] =
+        std::make_shared<HeapSegment>(oldGen_.removeSegment(idx));
+  }
+  for (size_t i = 0; i < numChosen; ++i) {
+    HeapSegment &seg = *compactee_.segments[i];
     addSegmentExtentToCrashManager(
-        *compactee_.segment, kCompacteeNameForCrashMgr);
-    compactee_.start = compactee_.segment->lowLim();
-    compactee_.startCP = CompressedPointer::encodeNonNull(
-        reinterpret_cast<GCCell *>(compactee_.segment->lowLim()),
-        getPointerBase());
-  }
+        seg,
+        kCompacteeNameForCrashMgr +
+            std::to_string(SegmentInfo::segmentIndexFromStart(seg.lowLim())));
+    compactee_.starts[i] = seg.lowLim();
+    compactee_.startCPs[i] =
+        CompressedPointer::encodeNonNull(
+            reinterpret_cast<GCCell *>(seg.lowLim()), getPointerBase())
+            .getRaw();
+  }
+  compactee_.numSegments = numChosen;
+}
+
+void HadesGC::scheduleCompacteeEvacuation() {
+  assert(
+      !compactee_.evacActive() &&
+      "Previous evacuation of compactees has not completed");
+  if (!compactee_.numSegments)
+    return;
+  uint64_t evacBytes = compactee_.liveBytes[0];
+  size_t numEvacuating = 1;
+  while (numEvacuating < compactee_.numSegments &&
+         evacBytes + compactee_.liveBytes[numEvacuating] <=
+             compactionBytesPerPause_) {
+    evacBytes += compactee_.liveBytes[numEvacuating];
+    ++numEvacuating;
+  }
+  compactee_.numEvacuating = numEvacuating;
 }
 
 void HadesGC::finalizeCompactee() {
-  char *stop = compactee_.segment->level();
-  char *cur = compactee_.segment->start();
+  assert(compactee_.evacActive() && "No compactee was evacuated");
   PointerBase &base = getPointerBase();
-  // Calculate the total number of bytes that were allocated in the compactee at
-  // the start of compaction.
-  int32_t preAllocated = 0;
-  while (cur < stop) {
-    auto *cell = reinterpret_cast<GCCell *>(cur);
-    if (cell->hasMarkedForwardingPointer()) {
-      auto size = cell->getMarkedForwardingPointer()
-                      .getNonNull(base)
-                      ->getAllocatedSize();
-      preAllocated += size;
-      cur += size;
-    } else {
-      auto size = cell->getAllocatedSize();
-      if (!vmisa<OldGen::FreelistCell>(cell)) {
-        cell->getVT()->finalizeIfExists(cell, *this);
+  for (size_t i = 0; i < compactee_.numEvacuating; ++i) {
+    HeapSegment &seg = *compactee_.segments[i];
+    char *stop = seg.level();
+    char *cur = seg.start();
+    // Calculate the total number of bytes that were allocated in the compactee
+    // at the start of compaction.
+    int32_t preAllocated = 0;
+    while (cur < stop) {
+      auto *cell = reinterpret_cast<GCCell *>(cur);
+      if (cell->hasMarkedForwardingPointer()) {
+        auto size = cell->getMarkedForwardingPointer()
+                        .getNonNull(base)
+                        ->getAllocatedSize();
         preAllocated += size;
+        cur += size;
+      } else {
+        auto size = cell->getAllocatedSize();
+        if (!vmisa<OldGen::FreelistCell>(cell)) {
+          cell->getVT()->finalizeIfExists(cell, *this);
+          preAllocated += size;
+        }
+        cur += size;
       }
-      cur += size;
     }
-  }
-  // At this point, any cells that survived compaction are already accounted for
-  // separately in the counter, so we just need to subtract the number of bytes
-  // allocated in the compactee.
-  oldGen_.incrementAllocatedBytes(-preAllocated);
-
-  const size_t segIdx =
-      SegmentInfo::segmentIndexFromStart(compactee_.segment->lowLim());
-  segmentIndices_.push_back(segIdx);
-  removeSegmentExtentFromCrashManager(std::to_string(segIdx));
-  removeSegmentExtentFromCrashManager(kCompacteeNameForCrashMgr);
-  compactee_ = {};
+    // At this point, any cells that survived compaction are already accounted
+    // for separately in the counter, so we just need to subtract the number of
+    // bytes allocated in the compactee.
+    oldGen_.incrementAllocatedBytes(-preAllocated);
+
+    const size_t segIdx = SegmentInfo::segmentIndexFromStart(seg.lowLim());
+    segmentIndices_.push_back(segIdx);
+    removeSegmentExtentFromCrashManager(std::to_string(segIdx));
+    removeSegmentExtentFromCrashManager(
+        kCompacteeNameForCrashMgr + std::to_string(segIdx));
+  }
+
+  // Drop the evacuated segments, which returns their memory to the storage
+  // provider, and move up the ones that remain.
+  const size_t numEvacuated = compactee_.numEvacuating;
+  const size_t numRemaining = compactee_.numSegments - numEvacuated;
+  compactee_.segments.erase(
+      compactee_.segments.begin(),
+      compactee_.segments.begin() + numEvacuated);
+  for (size_t i = 0; i < numRemaining; ++i) {
+    compactee_.starts[i] = compactee_.starts[i + numEvacuated];
+    compactee_.startCPs[i] = compactee_.startCPs[i + numEvacuated];
+    compactee_.liveBytes[i] = compactee_.liveBytes[i + numEvacuated];
+  }
+  compactee_.numSegments = numRemaining;
+  compactee_.numEvacuating = 0;
+  // Marking has already completed, so any remaining segments can be evacuated
+  // by the next YG collection.
+  scheduleCompacteeEvacuation();
 }
 
 void HadesGC::updateOldGenThreshold() {
@@ -1874,10 +2718,9 @@ void HadesGC::completeMarking() {
       oldGenMarker_->globalWorklist().empty() &&
       "Marking worklist wasn't drained");
   markWeakMapEntrySlots();
-  // Update the compactee tracking pointers so that the next YG collection will
+  // Update the compactee tracking state so that the next YG collection will
   // do a compaction.
-  compactee_.evacStart = compactee_.start;
-  compactee_.evacStartCP = compactee_.startCP;
+  scheduleCompacteeEvacuation();
   assert(
       oldGenMarker_->globalWorklist().empty() &&
       "Marking worklist wasn't drained");
@@ -1917,8 +2760,8 @@ void HadesGC::finalizeAll() {
     assert(cell->isValid() && "Invalid cell in finalizeAll");
     cell->getVT()->finalizeIfExists(cell, *this);
   };
-  if (compactee_.segment)
-    compactee_.segment->forCompactedObjs(finalizeCallback, getPointerBase());
+  for (const auto &seg : compactee_.segments)
+    seg->forCompactedObjs(finalizeCallback, getPointerBase());
 
   for (HeapSegment &seg : oldGen_)
     seg.forAllObjs(finalizeCallback);
@@ -2160,11 +3003,11 @@ void HadesGC::forAllObjs(const std::function<void(GCCell *)> &callback) {
     else
       seg.forAllObjs(skipGarbageCallback);
   }
-  if (compactee_.segment) {
+  for (const auto &seg : compactee_.segments) {
     if (!compactee_.evacActive())
-      compactee_.segment->forAllObjs(callback);
+      seg->forAllObjs(callback);
     else
-      compactee_.segment->forAllObjs(skipGarbageCallback);
+      seg->forAllObjs(skipGarbageCallback);
   }
 }
 
@@ -2177,9 +3020,16 @@ void HadesGC::ttiReached() {
 
 bool HadesGC::calledByBackgroundThread() const {
   // If the background thread is active, check if this thread matches the
-  // background thread.
-  return kConcurrentGC &&
-      backgroundExecutor_->getThreadId() == std::this_thread::get_id();
+  // background thread or one of the GC worker threads.
+  if (!kConcurrentGC)
+    return false;
+  const auto tid = std::this_thread::get_id();
+  if (backgroundExecutor_->getThreadId() == tid)
+    return true;
+  for (const auto &executor : workerExecutors_)
+    if (executor->getThreadId() == tid)
+      return true;
+  return false;
 }
 
 bool HadesGC::validPointer(const void *p) const {
@@ -2238,10 +3088,23 @@ GCCell *HadesGC::OldGen::alloc(uint32_t sz) {
       "Should be aligned before entering this function");
   assert(sz >= minAllocationSize() && "Allocating too small of an object");
   assert(sz <= maxAllocationSize() && "Allocating too large of an object");
-  assert(gc_.gcMutex_ && "gcMutex_ must be held before calling oldGenAlloc");
+  assert(
+      (gc_.gcMutex_ || gc_.evacAllocMutex_) &&
+      "gcMutex_ must be held before calling oldGenAlloc");
   if (GCCell *cell = search(sz)) {
     return cell;
   }
+  // If a sweep is in progress, the unswept segments may have enough free
+  // space, so sweep them one at a time instead of growing the heap. During a
+  // YG collection other threads may be walking the OG, so it is left to the
+  // collection to sweep ahead of time instead, see sweepOnDemand.
+  if (!gc_.inGC() && gc_.concurrentPhase_ == Phase::Sweep) {
+    while (sweepIterator_.segNumber > 1) {
+      sweepSegment(--sweepIterator_.segNumber, /*backgroundThread*/ false);
+      if (GCCell *cell = search(sz))
+        return cell;
+    }
+  }
   // Before waiting for a collection to finish, check if we're below the max
   // heap size and can simply allocate another segment. This will prevent
   // blocking the YG unnecessarily.
@@ -2403,21 +3266,28 @@ void HadesGC::youngGenEvacuateImpl(Acceptor &acceptor, bool doCompaction) {
       nameAcceptor.accept(slot.mappedValue);
     });
   }
-  // Find old-to-young pointers, as they are considered roots for YG
-  // collection.
-  scanDirtyCards(acceptor);
-  // Iterate through the copy list to find new pointers.
-  while (CopyListCell *const copyCell = acceptor.pop()) {
-    assert(
-        copyCell->hasMarkedForwardingPointer() && "Discovered unmarked object");
-    assert(
-        (inYoungGen(copyCell) || compactee_.evacContains(copyCell)) &&
-        "Unexpected object in YG collection");
-    // Update the pointers inside the forwarded object, since the old
-    // object is only there for the forwarding pointer.
-    GCCell *const cell =
-        copyCell->getMarkedForwardingPointer().getNonNull(getPointerBase());
-    markCell(cell, acceptor);
+  if (acceptor.isParallel()) {
+    // Find old-to-young pointers, and evacuate everything reachable from them
+    // and the roots, on all of the evacuation threads.
+    acceptor.evacuateInParallel();
+  } else {
+    // Find old-to-young pointers, as they are considered roots for YG
+    // collection.
+    scanDirtyCards(acceptor);
+    // Iterate through the copy list to find new pointers.
+    while (CopyListCell *const copyCell = acceptor.pop()) {
+      assert(
+          copyCell->hasMarkedForwardingPointer() &&
+          "Discovered unmarked object");
+      assert(
+          (inYoungGen(copyCell) || compactee_.evacContains(copyCell)) &&
+          "Unexpected object in YG collection");
+      // Update the pointers inside the forwarded object, since the old
+      // object is only there for the forwarding pointer.
+      GCCell *const cell =
+          copyCell->getMarkedForwardingPointer().getNonNull(getPointerBase());
+      markCell(cell, acceptor);
+    }
   }
 
   // Mark weak roots. We only need to update the long lived weak roots if we are
@@ -2467,7 +3337,12 @@ void HadesGC::youngGenCollection(
   } else {
     auto &yg = youngGen();
 
-    if (compactee_.segment) {
+    // If the OG is still being swept, make sure there is enough free space for
+    // the objects expected to survive, rather than growing the heap while
+    // evacuating into a partially swept OG.
+    oldGen_.sweepOnDemand(static_cast<uint64_t>(ygAverageSurvivalBytes_));
+
+    if (!compactee_.segments.empty()) {
       EvacAcceptor<true> acceptor{*this};
       youngGenEvacuateImpl(acceptor, doCompaction);
       // The remaining bytes after the collection is just the number of bytes
@@ -2489,8 +3364,9 @@ void HadesGC::youngGenCollection(
         }
       };
       yg.forCompactedObjs(trackerCallback, getPointerBase());
-      if (doCompaction) {
-        compactee_.segment->forCompactedObjs(trackerCallback, getPointerBase());
+      for (size_t i = 0; doCompaction && i < compactee_.numEvacuating; ++i) {
+        compactee_.segments[i]->forCompactedObjs(
+            trackerCallback, getPointerBase());
       }
     }
     // Run finalizers for young gen objects.
@@ -2703,9 +3579,9 @@ void HadesGC::updateYoungGenSizeFactor() {
     ygSizeFactor_ = std::max(ygSizeFactor_ * 0.9, 0.25);
 }
 
-template <bool CompactionEnabled>
+template <typename Acceptor>
 void HadesGC::scanDirtyCardsForSegment(
-    SlotVisitor<EvacAcceptor<CompactionEnabled>> &visitor,
+    SlotVisitor<Acceptor> &visitor,
     HeapSegment &seg) {
   const auto &cardTable = seg.cardTable();
   // Use level instead of end in case the OG segment is still in bump alloc
@@ -2724,7 +3600,11 @@ void HadesGC::scanDirtyCardsForSegment(
   // 3. If a compaction was completed during this cycle, unmarked objects may
   //    contain references into the now freed compactee. These pointers are not
   //    safe to visit.
-  const bool visitUnmarked = concurrentPhase_ != Phase::Sweep;
+  // 4. Once marking is complete, unmarked objects in a compactee segment that
+  //    has not been evacuated yet are never swept, and may contain references
+  //    into compactees that were evacuated and freed by earlier collections.
+  const bool visitUnmarked = concurrentPhase_ != Phase::Sweep &&
+      !(compactee_.evacActive() && compactee_.contains(seg.lowLim()));
 
   while (const auto oiBegin = cardTable.findNextDirtyCard(from, to)) {
     const auto iBegin = *oiBegin;
@@ -2792,7 +3672,7 @@ template <bool CompactionEnabled>
 void HadesGC::scanDirtyCards(EvacAcceptor<CompactionEnabled> &acceptor) {
   SlotVisitor<EvacAcceptor<CompactionEnabled>> visitor{acceptor};
   const bool preparingCompaction =
-      CompactionEnabled && !compactee_.evacActive();
+      CompactionEnabled && compactee_.hasPendingSegments();
   // The acceptors in this loop can grow the old gen by adding another
   // segment, if there's not enough room to evac the YG objects discovered.
   // Since segments are always placed at the end, we can use indices instead
@@ -2806,16 +3686,17 @@ void HadesGC::scanDirtyCards(EvacAcceptor<CompactionEnabled> &acceptor) {
     HeapSegment &seg = oldGen_[i];
     scanDirtyCardsForSegment(visitor, seg);
     // Do not clear the card table if the OG thread is currently marking to
-    // prepare for a compaction. Note that we should clear the card tables if
-    // the compaction is currently ongoing.
+    // prepare for a compaction, or if some compactees will remain to be
+    // evacuated by later YG collections. Note that we should clear the card
+    // tables if the last of the compaction is currently ongoing.
     if (!preparingCompaction)
       seg.cardTable().clear();
   }
 
-  // No need to search dirty cards in the compactee segment if it is
-  // currently being evacuated, since it will be scanned fully.
-  if (preparingCompaction)
-    scanDirtyCardsForSegment(visitor, *compactee_.segment);
+  // No need to search dirty cards in the compactee segments that are currently
+  // being evacuated, since they will be scanned fully.
+  for (size_t i = compactee_.numEvacuating; i < compactee_.numSegments; ++i)
+    scanDirtyCardsForSegment(visitor, *compactee_.segments[i]);
 }
 
 void HadesGC::finalizeYoungGenObjects() {
@@ -2838,7 +3719,7 @@ uint64_t HadesGC::externalBytes() const {
 
 uint64_t HadesGC::segmentFootprint() const {
   size_t totalSegments = oldGen_.numSegments() + (youngGen_ ? 1 : 0) +
-      (compactee_.segment ? 1 : 0);
+      compactee_.segments.size();
   return totalSegments * AlignedStorage::size();
 }
 
@@ -2856,12 +3737,14 @@ void HadesGC::OldGen::incrementAllocatedBytes(int32_t incr) {
 }
 
 uint64_t HadesGC::OldGen::externalBytes() const {
-  assert(gc_.gcMutex_ && "OG external bytes must be accessed under gcMutex_.");
+  assert(
+      (gc_.gcMutex_ || gc_.evacAllocMutex_) &&
+      "OG external bytes must be accessed under gcMutex_.");
   return externalBytes_;
 }
 
 uint64_t HadesGC::OldGen::size() const {
-  size_t totalSegments = numSegments() + (gc_.compactee_.segment ? 1 : 0);
+  size_t totalSegments = numSegments() + gc_.compactee_.segments.size();
   return totalSegments * HeapSegment::maxSize();
 }
 
@@ -2871,8 +3754,10 @@ uint64_t HadesGC::OldGen::targetSizeBytes() const {
 }
 
 size_t HadesGC::getYoungGenExternalBytes() const {
+  // Worker threads doing a parallel evacuation may read this while allocating
+  // a new segment, since the mutator is blocked in the YG collection.
   assert(
-      !calledByBackgroundThread() &&
+      (!calledByBackgroundThread() || evacAllocMutex_) &&
       "ygExternalBytes_ is only accessible from the mutator.");
   return ygExternalBytes_;
 }
@@ -2960,6 +3845,9 @@ void HadesGC::OldGen::addSegment(HeapSegment seg) {
   incrementAllocatedBytes(newSeg.used());
   // Add a set of freelist buckets for this segment.
   segmentBuckets_.emplace_back();
+  // The live bytes are unknown until the segment is swept, so assume that it
+  // is full, to avoid choosing it for compaction.
+  segmentLiveBytes_.push_back(HeapSegment::maxSize());
 
   assert(
       segmentBuckets_.size() == segments_.size() &&
@@ -2977,6 +3865,20 @@ void HadesGC::OldGen::addSegment(HeapSegment seg) {
   gc_.addSegmentExtentToCrashManager(newSeg, std::to_string(numSegments()));
 }
 
+void HadesGC::OldGen::freeTail(void *addr, uint32_t sz) {
+  assert(sz >= minAllocationSize() && "Tail is too small to be freed");
+  // Search from the back, since recently added segments are the most likely to
+  // have been allocated into.
+  for (size_t i = segments_.size(); i-- > 0;) {
+    if (!segments_[i].contains(addr))
+      continue;
+    addCellToFreelist(addr, sz, &segmentBuckets_[i][getFreelistBucket(sz)]);
+    incrementAllocatedBytes(-static_cast<int32_t>(sz));
+    return;
+  }
+  llvm_unreachable("Freed memory is not in the OG");
+}
+
 HadesGC::HeapSegment HadesGC::OldGen::popSegment() {
   const auto &segBuckets = segmentBuckets_.back();
   for (size_t bucket = 0; bucket < kNumFreelistBuckets; ++bucket) {
@@ -2986,12 +3888,47 @@ HadesGC::HeapSegment HadesGC::OldGen::popSegment() {
     }
   }
   segmentBuckets_.pop_back();
+  segmentLiveBytes_.pop_back();
 
   auto oldSeg = std::move(segments_.back());
   segments_.pop_back();
   return oldSeg;
 }
 
+HadesGC::HeapSegment HadesGC::OldGen::removeSegment(size_t idx) {
+  assert(idx < segments_.size() && "Segment index out of range");
+  const size_t lastIdx = segments_.size() - 1;
+  if (idx != lastIdx) {
+    // Swap the freelists of the two segments, taking them out of the segment
+    // level freelists while they are being swapped, since those link the
+    // SegmentBuckets by address.
+    auto &segBuckets = segmentBuckets_[idx];
+    auto &lastBuckets = segmentBuckets_[lastIdx];
+    for (size_t bucket = 0; bucket < kNumFreelistBuckets; ++bucket) {
+      auto &segBucket = segBuckets[bucket];
+      auto &lastBucket = lastBuckets[bucket];
+      if (segBucket.head)
+        segBucket.removeFromFreelist();
+      if (lastBucket.head)
+        lastBucket.removeFromFreelist();
+      AssignableCompressedPointer head{segBucket.head};
+      segBucket.head = lastBucket.head;
+      lastBucket.head = head;
+      if (segBucket.head)
+        segBucket.addToFreelist(&buckets_[bucket]);
+      if (lastBucket.head)
+        lastBucket.addToFreelist(&buckets_[bucket]);
+    }
+    std::swap(segments_[idx], segments_[lastIdx]);
+    std::swap(segmentLiveBytes_[idx], segmentLiveBytes_[lastIdx]);
+  }
+  return popSegment();
+}
+
+uint32_t HadesGC::OldGen::segmentLiveBytes(size_t idx) const {
+  return segmentLiveBytes_[idx];
+}
+
 void HadesGC::OldGen::setTargetSizeBytes(size_t targetSizeBytes) {
   assert(gc_.gcMutex_ && "Must hold gcMutex_ when accessing targetSizeBytes_.");
   assert(!targetSizeBytes_ && "Should only initialise targetSizeBytes_ once.");
@@ -190,6 +190,27 @@ enum class GCEventKind {
   /* Whether to use mprotect on GC metadata between GCs. */              \
   F(constexpr, bool, ProtectMetadata, false)                             \
                                                                          \
+  /* Number of threads that mark the old generation during a */          \
+  /* concurrent collection. 1 means only the background thread marks. */ \
+  F(constexpr, unsigned, NumMarkerThreads, 1)                            \
+                                                                         \
+  /* Number of threads that evacuate the young generation during a */    \
+  /* young-gen collection, including the thread that runs it. */         \
+  F(constexpr, unsigned, NumEvacuationThreads, 1)                        \
+                                                                         \
+  /* Number of threads that sweep the old generation, including the */   \
+  /* background thread. */                                               \
+  F(constexpr, unsigned, NumSweeperThreads, 1)                           \
+                                                                         \
+  /* Maximum number of old generation segments that are compacted by */  \
+  /* a single old generation collection. */                              \
+  F(constexpr, unsigned, MaxCompacteeSegments, 4)                        \
+                                                                         \
+  /* Maximum number of live bytes evacuated from compacted segments */   \
+  /* by a single young-gen collection, to bound its pause. At least */   \
+  /* one segment is always evacuated per collection. */                  \
+  F(constexpr, gcheapsize_t, CompactionBytesPerPause, 4 << 20)           \
+                                                                         \
   /* Callout for an analytics event. */                                  \
   F(HERMES_NON_CONSTEXPR,                                                \
     std::function<void(const GCAnalyticsEvent &)>,                       \
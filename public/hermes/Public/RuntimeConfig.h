@@ -24,6 +24,17 @@ enum CompilationMode {
   ForceLazyCompilation
 };
 
+/// Which engine executes regular expressions.
+enum class RegExpEngine : uint8_t {
+  /// Use the non-backtracking engine for patterns which it supports and which
+  /// may take exponential time with backtracking, and backtracking otherwise.
+  Auto,
+  /// Always use the backtracking engine.
+  Backtracking,
+  /// Use the non-backtracking engine for every pattern it supports.
+  NFA,
+};
+
 enum class SynthTraceMode : int8_t {
   None,
   Replaying,
@@ -123,6 +134,16 @@ class PinnedHermesValue;
                                                                        \
   /* Whether or not block scoping is enabled */                        \
   F(constexpr, bool, EnableBlockScoping, false)                        \
+                                                                       \
+  /* Whether to compile hot functions with the baseline JIT, where */ \
+  /* it is available. */                                               \
+  F(constexpr, bool, EnableJIT, false)                                 \
+                                                                       \
+  /* Number of calls after which a function is compiled by the JIT. */ \
+  F(constexpr, uint32_t, JITThreshold, 32)                             \
+                                                                       \
+  /* Which engine executes regular expressions. */                     \
+  F(constexpr, RegExpEngine, RegExpEngine, RegExpEngine::Auto)         \
   /* RUNTIME_FIELDS END */
 
 _HERMES_CTORCONFIG_STRUCT(RuntimeConfig, RUNTIME_FIELDS, {})
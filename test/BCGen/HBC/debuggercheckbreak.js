@@ -43,7 +43,7 @@
 //CHECK-NEXT:    Jmp               L2
 //CHECK-NEXT:L1:
 //CHECK-NEXT:    LoadConstUInt8    r3, 10
-//CHECK-NEXT:    Mov               r1, r2
+//CHECK-NEXT:    MovMov            r1, r2
 //CHECK-NEXT:    Mov               r2, r1
 //CHECK-NEXT:    JNotGreater       L4, r2, r3
 //CHECK-NEXT:L5:
@@ -0,0 +1,417 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermesc -O -dump-bytecode %s | %FileCheckOrRegen --match-full-lines %s
+// RUN: %hermesc -O -fno-superinstructions -dump-bytecode %s | %FileCheckOrRegen --check-prefix=NOFUSE --match-full-lines %s
+// RUN: %hermesc -O0 -dump-bytecode %s | %FileCheck --check-prefix=O0 --match-full-lines %s
+// RUN: %hermes -O %s | %FileCheck --check-prefix=EXEC --match-full-lines %s
+
+// Adjacent instructions are fused into superinstructions with -O.
+// O0-NOT: {{.*}}LoadParamLoadParam{{.*}}
+
+function eitherZero(x, y) {
+  if (x === 0 || y === 0)
+    return 'zero';
+  return 'nonzero';
+}
+
+// The second instruction of MovRet is also a jump target.
+function pick(a, b) {
+  var r = a;
+  if (b)
+    r = b;
+  return r;
+}
+
+function negative(a, b) {
+  return a + b < 0;
+}
+
+function add3(x) {
+  return x + 3;
+}
+
+function swap(a, b, c) {
+  var t;
+  for (var i = 0; i < c; ++i) {
+    t = a;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+print(eitherZero(1, 0), eitherZero(1, 2), pick(1, 0), pick(1, 2));
+// EXEC: zero nonzero 1 2
+print(negative(1, -2), add3(4), swap(1, 2, 3));
+// EXEC-NEXT: true 7 2
+
+// Auto-generated content below. Please do not modify manually.
+
+// CHECK:Bytecode File Information:
+// CHECK-NEXT:  Bytecode version number: {{.*}}
+// CHECK-NEXT:  Source hash: {{.*}}
+// CHECK-NEXT:  Function count: 6
+// CHECK-NEXT:  String count: 9
+// CHECK-NEXT:  BigInt count: 0
+// CHECK-NEXT:  String Kind Entry count: 2
+// CHECK-NEXT:  RegExp count: 0
+// CHECK-NEXT:  Segment ID: 0
+// CHECK-NEXT:  CommonJS module count: 0
+// CHECK-NEXT:  CommonJS module count (static): 0
+// CHECK-NEXT:  Function source count: 0
+// CHECK-NEXT:  Bytecode options:
+// CHECK-NEXT:    staticBuiltins: 0
+// CHECK-NEXT:    cjsModulesStaticallyResolved: 0
+
+// CHECK:Global String Table:
+// CHECK-NEXT:s0[ASCII, 0..5]: global
+// CHECK-NEXT:s1[ASCII, 6..12]: nonzero
+// CHECK-NEXT:s2[ASCII, 9..12]: zero
+// CHECK-NEXT:i3[ASCII, 13..16] #427F9CB9: add3
+// CHECK-NEXT:i4[ASCII, 17..24] #29456DD6: negative
+// CHECK-NEXT:i5[ASCII, 24..33] #55EBA9A3: eitherZero
+// CHECK-NEXT:i6[ASCII, 34..37] #C318DB2A: swap
+// CHECK-NEXT:i7[ASCII, 37..40] #6DB0C257: pick
+// CHECK-NEXT:i8[ASCII, 41..45] #A689F65B: print
+
+// CHECK:Function<global>(1 params, 20 registers, 0 symbols):
+// CHECK-NEXT:Offset in debug table: source 0x0000, scope 0x0000, textified callees 0x0000
+// CHECK-NEXT:    DeclareGlobalVar  "eitherZero"
+// CHECK-NEXT:    DeclareGlobalVar  "pick"
+// CHECK-NEXT:    DeclareGlobalVar  "negative"
+// CHECK-NEXT:    DeclareGlobalVar  "add3"
+// CHECK-NEXT:    DeclareGlobalVar  "swap"
+// CHECK-NEXT:    CreateEnvironment r1
+// CHECK-NEXT:    CreateClosure     r2, r1, Function<eitherZero>
+// CHECK-NEXT:    GetGlobalObject   r0
+// CHECK-NEXT:    PutById           r0, r2, 1, "eitherZero"
+// CHECK-NEXT:    CreateClosure     r2, r1, Function<pick>
+// CHECK-NEXT:    PutById           r0, r2, 2, "pick"
+// CHECK-NEXT:    CreateClosure     r2, r1, Function<negative>
+// CHECK-NEXT:    PutById           r0, r2, 3, "negative"
+// CHECK-NEXT:    CreateClosure     r2, r1, Function<add3>
+// CHECK-NEXT:    PutById           r0, r2, 4, "add3"
+// CHECK-NEXT:    CreateClosure     r1, r1, Function<swap>
+// CHECK-NEXT:    PutById           r0, r1, 5, "swap"
+// CHECK-NEXT:    TryGetById        r8, r0, 1, "print"
+// CHECK-NEXT:    GetByIdShort      r1, r0, 2, "eitherZero"
+// CHECK-NEXT:    LoadConstUndefined r4
+// CHECK-NEXT:    LoadConstUInt8    r7, 1
+// CHECK-NEXT:    LoadConstZero     r2
+// CHECK-NEXT:    Call3             r5, r1, r4, r7, r2
+// CHECK-NEXT:    GetByIdShort      r1, r0, 2, "eitherZero"
+// CHECK-NEXT:    LoadConstUInt8    r6, 2
+// CHECK-NEXT:    Call3             r3, r1, r4, r7, r6
+// CHECK-NEXT:    GetByIdShort      r1, r0, 3, "pick"
+// CHECK-NEXT:    Call3             r10, r1, r4, r7, r2
+// CHECK-NEXT:    GetByIdShort      r1, r0, 3, "pick"
+// CHECK-NEXT:    Call3             r9, r1, r4, r7, r6
+// CHECK-NEXT:    LoadConstUndefined r13
+// CHECK-NEXT:    MovMov            r12, r5
+// CHECK-NEXT:    Mov               r11, r3
+// CHECK-NEXT:    Call              r1, r8, 5
+// CHECK-NEXT:    TryGetById        r3, r0, 1, "print"
+// CHECK-NEXT:    GetByIdShort      r2, r0, 4, "negative"
+// CHECK-NEXT:    LoadConstInt      r1, -2
+// CHECK-NEXT:    Call3             r2, r2, r4, r7, r1
+// CHECK-NEXT:    GetByIdShort      r5, r0, 5, "add3"
+// CHECK-NEXT:    LoadConstUInt8    r1, 4
+// CHECK-NEXT:    Call2             r1, r5, r4, r1
+// CHECK-NEXT:    GetByIdShort      r5, r0, 6, "swap"
+// CHECK-NEXT:    LoadConstUInt8    r0, 3
+// CHECK-NEXT:    Call4             r0, r5, r4, r7, r6, r0
+// CHECK-NEXT:    Call4             r0, r3, r4, r2, r1, r0
+// CHECK-NEXT:    Ret               r0
+
+// CHECK:Function<eitherZero>(3 params, 2 registers, 0 symbols):
+// CHECK-NEXT:    LoadParamLoadConstZero r0, 1
+// CHECK-NEXT:    LoadConstZeroJStrictEqual r1
+// CHECK-NEXT:    JStrictEqual      L1, r0, r1
+// CHECK-NEXT:    LoadParam         r0, 2
+// CHECK-NEXT:    JStrictEqual      L1, r0, r1
+// CHECK-NEXT:    LoadConstString   r0, "nonzero"
+// CHECK-NEXT:    Ret               r0
+// CHECK-NEXT:L1:
+// CHECK-NEXT:    LoadConstString   r0, "zero"
+// CHECK-NEXT:    Ret               r0
+
+// CHECK:Function<pick>(3 params, 3 registers, 0 symbols):
+// CHECK-NEXT:    LoadParamLoadParam r0, 1
+// CHECK-NEXT:    LoadParam         r1, 2
+// CHECK-NEXT:    JmpFalse          L1, r1
+// CHECK-NEXT:    MovRet            r0, r1
+// CHECK-NEXT:L1:
+// CHECK-NEXT:    Ret               r0
+
+// CHECK:Function<negative>(3 params, 2 registers, 0 symbols):
+// CHECK-NEXT:Offset in debug table: source 0x0078, scope 0x0000, textified callees 0x0000
+// CHECK-NEXT:    LoadParamLoadParam r1, 1
+// CHECK-NEXT:    LoadParam         r0, 2
+// CHECK-NEXT:    Add               r1, r1, r0
+// CHECK-NEXT:    LoadConstZeroLess r0
+// CHECK-NEXT:    Less              r0, r1, r0
+// CHECK-NEXT:    Ret               r0
+
+// CHECK:Function<add3>(2 params, 2 registers, 0 symbols):
+// CHECK-NEXT:Offset in debug table: source 0x0085, scope 0x0000, textified callees 0x0000
+// CHECK-NEXT:    LoadParam         r1, 1
+// CHECK-NEXT:    LoadConstUInt8Add r0, 3
+// CHECK-NEXT:    Add               r0, r1, r0
+// CHECK-NEXT:    Ret               r0
+
+// CHECK:Function<swap>(4 params, 7 registers, 0 symbols):
+// CHECK-NEXT:Offset in debug table: source 0x0092, scope 0x0000, textified callees 0x0000
+// CHECK-NEXT:    LoadParamLoadParam r1, 1
+// CHECK-NEXT:    LoadParamLoadParam r4, 2
+// CHECK-NEXT:    LoadParamLoadConstZero r3, 3
+// CHECK-NEXT:    LoadConstZeroLess r2
+// CHECK-NEXT:    Less              r5, r2, r3
+// CHECK-NEXT:    Mov               r0, r1
+// CHECK-NEXT:    JmpFalse          L1, r5
+// CHECK-NEXT:L2:
+// CHECK-NEXT:    Inc               r2, r2
+// CHECK-NEXT:    MovMov            r6, r1
+// CHECK-NEXT:    MovMovMov         r1, r4
+// CHECK-NEXT:    MovMov            r4, r6
+// CHECK-NEXT:    Mov               r0, r1
+// CHECK-NEXT:    JLess             L2, r2, r3
+// CHECK-NEXT:L1:
+// CHECK-NEXT:    Ret               r0
+
+// CHECK:Debug filename table:
+// CHECK-NEXT:  0: {{.*}}superinstructions.js
+
+// CHECK:Debug file table:
+// CHECK-NEXT:  source table offset 0x0000: filename id 0
+
+// CHECK:Debug source table:
+// CHECK-NEXT:  0x0000  function idx 0, starts at line 16 col 1
+// CHECK-NEXT:    bc 34: line 16 col 1 scope offset 0x0000 env r2
+// CHECK-NEXT:    bc 45: line 16 col 1 scope offset 0x0000 env r2
+// CHECK-NEXT:    bc 56: line 16 col 1 scope offset 0x0000 env r2
+// CHECK-NEXT:    bc 67: line 16 col 1 scope offset 0x0000 env r2
+// CHECK-NEXT:    bc 78: line 16 col 1 scope offset 0x0000 env r1
+// CHECK-NEXT:    bc 84: line 48 col 1 scope offset 0x0000 env r8
+// CHECK-NEXT:    bc 90: line 48 col 7 scope offset 0x0000 env r1
+// CHECK-NEXT:    bc 102: line 48 col 17 scope offset 0x0000 env r5
+// CHECK-NEXT:    bc 108: line 48 col 25 scope offset 0x0000 env r1
+// CHECK-NEXT:    bc 116: line 48 col 35 scope offset 0x0000 env r3
+// CHECK-NEXT:    bc 122: line 48 col 43 scope offset 0x0000 env r1
+// CHECK-NEXT:    bc 127: line 48 col 47 scope offset 0x0000 env r10
+// CHECK-NEXT:    bc 133: line 48 col 55 scope offset 0x0000 env r1
+// CHECK-NEXT:    bc 138: line 48 col 59 scope offset 0x0000 env r9
+// CHECK-NEXT:    bc 152: line 48 col 6 scope offset 0x0000 env r1
+// CHECK-NEXT:    bc 156: line 50 col 1 scope offset 0x0000 env r3
+// CHECK-NEXT:    bc 162: line 50 col 7 scope offset 0x0000 env r2
+// CHECK-NEXT:    bc 173: line 50 col 15 scope offset 0x0000 env r2
+// CHECK-NEXT:    bc 179: line 50 col 24 scope offset 0x0000 env r5
+// CHECK-NEXT:    bc 187: line 50 col 28 scope offset 0x0000 env r1
+// CHECK-NEXT:    bc 192: line 50 col 33 scope offset 0x0000 env r5
+// CHECK-NEXT:    bc 200: line 50 col 37 scope offset 0x0000 env r0
+// CHECK-NEXT:    bc 207: line 50 col 6 scope offset 0x0000 env r0
+// CHECK-NEXT:  0x0078  function idx 3, starts at line 30 col 1
+// CHECK-NEXT:    bc 6: line 31 col 10 scope offset 0x0000 env none
+// CHECK-NEXT:  0x0085  function idx 4, starts at line 34 col 1
+// CHECK-NEXT:    bc 6: line 35 col 10 scope offset 0x0000 env none
+// CHECK-NEXT:  0x0092  function idx 5, starts at line 38 col 1
+// CHECK-NEXT:    bc 11: line 40 col 19 scope offset 0x0000 env none
+// CHECK-NEXT:    bc 36: line 40 col 3 scope offset 0x0000 env none
+// CHECK-NEXT:  0x00a8  end of debug source table
+
+// CHECK:Debug scope descriptor table:
+// CHECK-NEXT:  0x0000  lexical parent:   none, flags:    , variable count: 0
+// CHECK-NEXT:  0x0003  end of debug scope descriptor table
+
+// CHECK:Textified callees table:
+// CHECK-NEXT:  0x0000  entries: 0
+// CHECK-NEXT:  0x0001  end of textified callees table
+
+// CHECK:Debug string table:
+// CHECK-NEXT:  0x0000  end of debug string table
+
+// NOFUSE:Bytecode File Information:
+// NOFUSE-NEXT:  Bytecode version number: {{.*}}
+// NOFUSE-NEXT:  Source hash: {{.*}}
+// NOFUSE-NEXT:  Function count: 6
+// NOFUSE-NEXT:  String count: 9
+// NOFUSE-NEXT:  BigInt count: 0
+// NOFUSE-NEXT:  String Kind Entry count: 2
+// NOFUSE-NEXT:  RegExp count: 0
+// NOFUSE-NEXT:  Segment ID: 0
+// NOFUSE-NEXT:  CommonJS module count: 0
+// NOFUSE-NEXT:  CommonJS module count (static): 0
+// NOFUSE-NEXT:  Function source count: 0
+// NOFUSE-NEXT:  Bytecode options:
+// NOFUSE-NEXT:    staticBuiltins: 0
+// NOFUSE-NEXT:    cjsModulesStaticallyResolved: 0
+
+// NOFUSE:Global String Table:
+// NOFUSE-NEXT:s0[ASCII, 0..5]: global
+// NOFUSE-NEXT:s1[ASCII, 6..12]: nonzero
+// NOFUSE-NEXT:s2[ASCII, 9..12]: zero
+// NOFUSE-NEXT:i3[ASCII, 13..16] #427F9CB9: add3
+// NOFUSE-NEXT:i4[ASCII, 17..24] #29456DD6: negative
+// NOFUSE-NEXT:i5[ASCII, 24..33] #55EBA9A3: eitherZero
+// NOFUSE-NEXT:i6[ASCII, 34..37] #C318DB2A: swap
+// NOFUSE-NEXT:i7[ASCII, 37..40] #6DB0C257: pick
+// NOFUSE-NEXT:i8[ASCII, 41..45] #A689F65B: print
+
+// NOFUSE:Function<global>(1 params, 20 registers, 0 symbols):
+// NOFUSE-NEXT:Offset in debug table: source 0x0000, scope 0x0000, textified callees 0x0000
+// NOFUSE-NEXT:    DeclareGlobalVar  "eitherZero"
+// NOFUSE-NEXT:    DeclareGlobalVar  "pick"
+// NOFUSE-NEXT:    DeclareGlobalVar  "negative"
+// NOFUSE-NEXT:    DeclareGlobalVar  "add3"
+// NOFUSE-NEXT:    DeclareGlobalVar  "swap"
+// NOFUSE-NEXT:    CreateEnvironment r1
+// NOFUSE-NEXT:    CreateClosure     r2, r1, Function<eitherZero>
+// NOFUSE-NEXT:    GetGlobalObject   r0
+// NOFUSE-NEXT:    PutById           r0, r2, 1, "eitherZero"
+// NOFUSE-NEXT:    CreateClosure     r2, r1, Function<pick>
+// NOFUSE-NEXT:    PutById           r0, r2, 2, "pick"
+// NOFUSE-NEXT:    CreateClosure     r2, r1, Function<negative>
+// NOFUSE-NEXT:    PutById           r0, r2, 3, "negative"
+// NOFUSE-NEXT:    CreateClosure     r2, r1, Function<add3>
+// NOFUSE-NEXT:    PutById           r0, r2, 4, "add3"
+// NOFUSE-NEXT:    CreateClosure     r1, r1, Function<swap>
+// NOFUSE-NEXT:    PutById           r0, r1, 5, "swap"
+// NOFUSE-NEXT:    TryGetById        r8, r0, 1, "print"
+// NOFUSE-NEXT:    GetByIdShort      r1, r0, 2, "eitherZero"
+// NOFUSE-NEXT:    LoadConstUndefined r4
+// NOFUSE-NEXT:    LoadConstUInt8    r7, 1
+// NOFUSE-NEXT:    LoadConstZero     r2
+// NOFUSE-NEXT:    Call3             r5, r1, r4, r7, r2
+// NOFUSE-NEXT:    GetByIdShort      r1, r0, 2, "eitherZero"
+// NOFUSE-NEXT:    LoadConstUInt8    r6, 2
+// NOFUSE-NEXT:    Call3             r3, r1, r4, r7, r6
+// NOFUSE-NEXT:    GetByIdShort      r1, r0, 3, "pick"
+// NOFUSE-NEXT:    Call3             r10, r1, r4, r7, r2
+// NOFUSE-NEXT:    GetByIdShort      r1, r0, 3, "pick"
+// NOFUSE-NEXT:    Call3             r9, r1, r4, r7, r6
+// NOFUSE-NEXT:    LoadConstUndefined r13
+// NOFUSE-NEXT:    Mov               r12, r5
+// NOFUSE-NEXT:    Mov               r11, r3
+// NOFUSE-NEXT:    Call              r1, r8, 5
+// NOFUSE-NEXT:    TryGetById        r3, r0, 1, "print"
+// NOFUSE-NEXT:    GetByIdShort      r2, r0, 4, "negative"
+// NOFUSE-NEXT:    LoadConstInt      r1, -2
+// NOFUSE-NEXT:    Call3             r2, r2, r4, r7, r1
+// NOFUSE-NEXT:    GetByIdShort      r5, r0, 5, "add3"
+// NOFUSE-NEXT:    LoadConstUInt8    r1, 4
+// NOFUSE-NEXT:    Call2             r1, r5, r4, r1
+// NOFUSE-NEXT:    GetByIdShort      r5, r0, 6, "swap"
+// NOFUSE-NEXT:    LoadConstUInt8    r0, 3
+// NOFUSE-NEXT:    Call4             r0, r5, r4, r7, r6, r0
+// NOFUSE-NEXT:    Call4             r0, r3, r4, r2, r1, r0
+// NOFUSE-NEXT:    Ret               r0
+
+// NOFUSE:Function<eitherZero>(3 params, 2 registers, 0 symbols):
+// NOFUSE-NEXT:    LoadParam         r0, 1
+// NOFUSE-NEXT:    LoadConstZero     r1
+// NOFUSE-NEXT:    JStrictEqual      L1, r0, r1
+// NOFUSE-NEXT:    LoadParam         r0, 2
+// NOFUSE-NEXT:    JStrictEqual      L1, r0, r1
+// NOFUSE-NEXT:    LoadConstString   r0, "nonzero"
+// NOFUSE-NEXT:    Ret               r0
+// NOFUSE-NEXT:L1:
+// NOFUSE-NEXT:    LoadConstString   r0, "zero"
+// NOFUSE-NEXT:    Ret               r0
+
+// NOFUSE:Function<pick>(3 params, 3 registers, 0 symbols):
+// NOFUSE-NEXT:    LoadParam         r0, 1
+// NOFUSE-NEXT:    LoadParam         r1, 2
+// NOFUSE-NEXT:    JmpFalse          L1, r1
+// NOFUSE-NEXT:    Mov               r0, r1
+// NOFUSE-NEXT:L1:
+// NOFUSE-NEXT:    Ret               r0
+
+// NOFUSE:Function<negative>(3 params, 2 registers, 0 symbols):
+// NOFUSE-NEXT:Offset in debug table: source 0x0078, scope 0x0000, textified callees 0x0000
+// NOFUSE-NEXT:    LoadParam         r1, 1
+// NOFUSE-NEXT:    LoadParam         r0, 2
+// NOFUSE-NEXT:    Add               r1, r1, r0
+// NOFUSE-NEXT:    LoadConstZero     r0
+// NOFUSE-NEXT:    Less              r0, r1, r0
+// NOFUSE-NEXT:    Ret               r0
+
+// NOFUSE:Function<add3>(2 params, 2 registers, 0 symbols):
+// NOFUSE-NEXT:Offset in debug table: source 0x0085, scope 0x0000, textified callees 0x0000
+// NOFUSE-NEXT:    LoadParam         r1, 1
+// NOFUSE-NEXT:    LoadConstUInt8    r0, 3
+// NOFUSE-NEXT:    Add               r0, r1, r0
+// NOFUSE-NEXT:    Ret               r0
+
+// NOFUSE:Function<swap>(4 params, 7 registers, 0 symbols):
+// NOFUSE-NEXT:Offset in debug table: source 0x0092, scope 0x0000, textified callees 0x0000
+// NOFUSE-NEXT:    LoadParam         r1, 1
+// NOFUSE-NEXT:    LoadParam         r4, 2
+// NOFUSE-NEXT:    LoadParam         r3, 3
+// NOFUSE-NEXT:    LoadConstZero     r2
+// NOFUSE-NEXT:    Less              r5, r2, r3
+// NOFUSE-NEXT:    Mov               r0, r1
+// NOFUSE-NEXT:    JmpFalse          L1, r5
+// NOFUSE-NEXT:L2:
+// NOFUSE-NEXT:    Inc               r2, r2
+// NOFUSE-NEXT:    Mov               r6, r1
+// NOFUSE-NEXT:    Mov               r1, r4
+// NOFUSE-NEXT:    Mov               r4, r6
+// NOFUSE-NEXT:    Mov               r0, r1
+// NOFUSE-NEXT:    JLess             L2, r2, r3
+// NOFUSE-NEXT:L1:
+// NOFUSE-NEXT:    Ret               r0
+
+// NOFUSE:Debug filename table:
+// NOFUSE-NEXT:  0: {{.*}}superinstructions.js
+
+// NOFUSE:Debug file table:
+// NOFUSE-NEXT:  source table offset 0x0000: filename id 0
+
+// NOFUSE:Debug source table:
+// NOFUSE-NEXT:  0x0000  function idx 0, starts at line 16 col 1
+// NOFUSE-NEXT:    bc 34: line 16 col 1 scope offset 0x0000 env r2
+// NOFUSE-NEXT:    bc 45: line 16 col 1 scope offset 0x0000 env r2
+// NOFUSE-NEXT:    bc 56: line 16 col 1 scope offset 0x0000 env r2
+// NOFUSE-NEXT:    bc 67: line 16 col 1 scope offset 0x0000 env r2
+// NOFUSE-NEXT:    bc 78: line 16 col 1 scope offset 0x0000 env r1
+// NOFUSE-NEXT:    bc 84: line 48 col 1 scope offset 0x0000 env r8
+// NOFUSE-NEXT:    bc 90: line 48 col 7 scope offset 0x0000 env r1
+// NOFUSE-NEXT:    bc 102: line 48 col 17 scope offset 0x0000 env r5
+// NOFUSE-NEXT:    bc 108: line 48 col 25 scope offset 0x0000 env r1
+// NOFUSE-NEXT:    bc 116: line 48 col 35 scope offset 0x0000 env r3
+// NOFUSE-NEXT:    bc 122: line 48 col 43 scope offset 0x0000 env r1
+// NOFUSE-NEXT:    bc 127: line 48 col 47 scope offset 0x0000 env r10
+// NOFUSE-NEXT:    bc 133: line 48 col 55 scope offset 0x0000 env r1
+// NOFUSE-NEXT:    bc 138: line 48 col 59 scope offset 0x0000 env r9
+// NOFUSE-NEXT:    bc 152: line 48 col 6 scope offset 0x0000 env r1
+// NOFUSE-NEXT:    bc 156: line 50 col 1 scope offset 0x0000 env r3
+// NOFUSE-NEXT:    bc 162: line 50 col 7 scope offset 0x0000 env r2
+// NOFUSE-NEXT:    bc 173: line 50 col 15 scope offset 0x0000 env r2
+// NOFUSE-NEXT:    bc 179: line 50 col 24 scope offset 0x0000 env r5
+// NOFUSE-NEXT:    bc 187: line 50 col 28 scope offset 0x0000 env r1
+// NOFUSE-NEXT:    bc 192: line 50 col 33 scope offset 0x0000 env r5
+// NOFUSE-NEXT:    bc 200: line 50 col 37 scope offset 0x0000 env r0
+// NOFUSE-NEXT:    bc 207: line 50 col 6 scope offset 0x0000 env r0
+// NOFUSE-NEXT:  0x0078  function idx 3, starts at line 30 col 1
+// NOFUSE-NEXT:    bc 6: line 31 col 10 scope offset 0x0000 env none
+// NOFUSE-NEXT:  0x0085  function idx 4, starts at line 34 col 1
+// NOFUSE-NEXT:    bc 6: line 35 col 10 scope offset 0x0000 env none
+// NOFUSE-NEXT:  0x0092  function idx 5, starts at line 38 col 1
+// NOFUSE-NEXT:    bc 11: line 40 col 19 scope offset 0x0000 env none
+// NOFUSE-NEXT:    bc 36: line 40 col 3 scope offset 0x0000 env none
+// NOFUSE-NEXT:  0x00a8  end of debug source table
+
+// NOFUSE:Debug scope descriptor table:
+// NOFUSE-NEXT:  0x0000  lexical parent:   none, flags:    , variable count: 0
+// NOFUSE-NEXT:  0x0003  end of debug scope descriptor table
+
+// NOFUSE:Textified callees table:
+// NOFUSE-NEXT:  0x0000  entries: 0
+// NOFUSE-NEXT:  0x0001  end of textified callees table
+
+// NOFUSE:Debug string table:
+// NOFUSE-NEXT:  0x0000  end of debug string table
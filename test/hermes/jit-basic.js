@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -Xjit -Xjit-threshold=0 %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -Xjit -Xjit-threshold=2 %s | %FileCheck --match-full-lines %s
+
+// Exercise the instructions the baseline JIT compiles, and the transitions
+// between compiled and interpreted code. Without the JIT, the flags are
+// ignored and this simply runs in the interpreter.
+
+"use strict";
+
+print('jit');
+// CHECK-LABEL: jit
+
+function sum(n) {
+  var s = 0;
+  for (var i = 0; i < n; ++i)
+    s += i;
+  return s;
+}
+for (var k = 0; k < 3; ++k)
+  print(sum(100));
+// CHECK-NEXT: 4950
+// CHECK-NEXT: 4950
+// CHECK-NEXT: 4950
+
+function arith(a, b) {
+  return [a + b, a - b, a * b, a / b, a % b, a & b, a | b, a ^ b, a << 2,
+          a >> 1, a >>> 1, -a, ~a];
+}
+print(arith(7, 2).join());
+// CHECK-NEXT: 9,5,14,3.5,1,2,7,5,28,3,3,-7,-8
+print(arith(-7.5, 0.5).join());
+// CHECK-NEXT: -7,-8,-3.75,-15,0,0,-7,-7,-28,-4,2147483644,7.5,6
+print(arith('7', 2).join());
+// CHECK-NEXT: 72,5,14,3.5,1,2,7,5,28,3,3,-7,-8
+
+function compare(a, b) {
+  var r = '';
+  r += a < b ? 'l' : '-';
+  r += a <= b ? 'L' : '-';
+  r += a > b ? 'g' : '-';
+  r += a >= b ? 'G' : '-';
+  r += a == b ? 'e' : '-';
+  r += a === b ? 'E' : '-';
+  return r;
+}
+print(compare(1, 2), compare(2, 2), compare(3, 2), compare(NaN, 1));
+// CHECK-NEXT: lL---- -L-GeE --gG-- ------
+print(compare('a', 'b'), compare('2', 2), compare(null, undefined));
+// CHECK-NEXT: lL---- -L-Ge- ----e-
+
+function fib(n) {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+print(fib(20));
+// CHECK-NEXT: 6765
+
+function Point(x, y) {
+  this.x = x;
+  this.y = y;
+}
+Point.prototype.len2 = function () {
+  return this.x * this.x + this.y * this.y;
+};
+function totalLen2(points) {
+  var t = 0;
+  for (var i = 0; i < points.length; ++i)
+    t += points[i].len2();
+  return t;
+}
+var points = [];
+for (var i = 0; i < 10; ++i)
+  points.push(new Point(i, i + 1));
+print(totalLen2(points));
+// CHECK-NEXT: 670
+// A different shape at the same property access sites.
+points.push({x: 1, y: 1, len2: Point.prototype.len2});
+print(totalLen2(points));
+// CHECK-NEXT: 672
+
+function counter() {
+  var c = 0;
+  return function () {
+    return ++c;
+  };
+}
+var next = counter();
+next();
+next();
+print(next());
+// CHECK-NEXT: 3
+
+function literals() {
+  return JSON.stringify({a: [1, 'two', null, true], b: {c: undefined}});
+}
+print(literals());
+// CHECK-NEXT: {"a":[1,"two",null,true],"b":{}}
+
+function thrower(x) {
+  if (x > 1)
+    throw new Error('too big: ' + x);
+  return x;
+}
+function callsThrower(x) {
+  return thrower(x) + 1;
+}
+for (var k = 0; k < 3; ++k) {
+  try {
+    print(callsThrower(k));
+  } catch (e) {
+    print(e.message);
+    print(e.stack.split('\n').slice(1, 3).map(function (s) {
+      return s.trim().split(' ')[1];
+    }).join());
+  }
+}
+// CHECK-NEXT: 1
+// CHECK-NEXT: 2
+// CHECK-NEXT: too big: 2
+// CHECK-NEXT: thrower,callsThrower
+
+function typeError(o) {
+  return o.missing.property;
+}
+try {
+  typeError({});
+} catch (e) {
+  print(e.constructor.name);
+}
+// CHECK-NEXT: TypeError
+
+// Functions with try/catch stay in the interpreter, but can call compiled code.
+function catcher() {
+  try {
+    return thrower(5);
+  } catch (e) {
+    return 'caught ' + e.message;
+  }
+}
+print(catcher());
+// CHECK-NEXT: caught too big: 5
+
+function* gen() {
+  yield sum(3);
+}
+print(gen().next().value);
+// CHECK-NEXT: 3
@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// JSON.parse predicts the keys of an object from the previous object at the
+// same nesting level. Check objects that match the prediction fully, partly or
+// not at all.
+print('json shapes');
+// CHECK-LABEL: json shapes
+
+function show(text) {
+  var parsed = JSON.parse(text);
+  print(JSON.stringify(parsed));
+  return parsed;
+}
+
+show('[{"a":1,"b":2},{"a":3,"b":4},{"a":5,"b":6}]');
+// CHECK-NEXT: [{"a":1,"b":2},{"a":3,"b":4},{"a":5,"b":6}]
+show('[{"a":1,"b":2},{"a":3,"c":4},{"a":5}]');
+// CHECK-NEXT: [{"a":1,"b":2},{"a":3,"c":4},{"a":5}]
+show('[{"a":1,"b":2},{"a":3,"b":4,"c":5},{"b":6,"a":7},{}]');
+// CHECK-NEXT: [{"a":1,"b":2},{"a":3,"b":4,"c":5},{"b":6,"a":7},{}]
+show('[{"a":1,"b":2},{"a":3,"a":4},{"a":5,"b":6}]');
+// CHECK-NEXT: [{"a":1,"b":2},{"a":4},{"a":5,"b":6}]
+show('[{"1":"x","a":2},{"1":"y","a":3},{"0":"z"}]');
+// CHECK-NEXT: [{"1":"x","a":2},{"1":"y","a":3},{"0":"z"}]
+
+// Nested records use a prediction per level.
+show('[{"p":{"x":1,"y":2},"q":[{"z":1}]},{"p":{"x":3,"y":4},"q":[{"z":2}]}]');
+// CHECK-NEXT: [{"p":{"x":1,"y":2},"q":[{"z":1}]},{"p":{"x":3,"y":4},"q":[{"z":2}]}]
+var deep = '';
+for (var i = 0; i < 12; ++i)
+  deep += '{"k' + i + '":';
+deep += '0' + '}'.repeat(12);
+show('[' + deep + ',' + deep + ']');
+// CHECK-NEXT: [{"k0":{"k1":{"k2":{"k3":{"k4":{"k5":{"k6":{"k7":{"k8":{"k9":{"k10":{"k11":0}}}}}}}}}}}},{"k0":{"k1":{"k2":{"k3":{"k4":{"k5":{"k6":{"k7":{"k8":{"k9":{"k10":{"k11":0}}}}}}}}}}}}]
+
+// Objects created from a prediction are ordinary objects.
+var recs = show('[{"__proto__":1,"b":2},{"__proto__":3,"b":4}]');
+// CHECK-NEXT: [{"__proto__":1,"b":2},{"__proto__":3,"b":4}]
+print(Object.getPrototypeOf(recs[1]) === Object.prototype, recs[1].__proto__);
+// CHECK-NEXT: true 3
+recs[1].c = 5;
+delete recs[1].b;
+print(JSON.stringify(recs), Object.keys(recs[0]));
+// CHECK-NEXT: [{"__proto__":1,"b":2},{"__proto__":3,"c":5}] __proto__,b
+
+// Many keys, more than fit in direct property slots.
+var keys = [];
+for (var i = 0; i < 40; ++i)
+  keys.push('"key' + i + '":' + i);
+var wide = JSON.parse('[{' + keys.join() + '},{' + keys.join() + '}]');
+print(wide[1].key0, wide[1].key39, Object.keys(wide[1]).length);
+// CHECK-NEXT: 0 39 40
+
+// The reviver sees the same objects.
+print(JSON.stringify(JSON.parse('[{"a":1,"b":2},{"a":3,"b":4}]', function (k, v) {
+  return k === 'b' ? v * 10 : v;
+})));
+// CHECK-NEXT: [{"a":1,"b":20},{"a":3,"b":40}]
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// JSON.stringify reads the properties of plain objects and the elements of
+// arrays directly. Check that it still observes changes made while
+// serializing.
+print('stringify slots');
+// CHECK-LABEL: stringify slots
+
+// Members without a JSON representation are skipped, also when indenting.
+print(JSON.stringify({a: undefined, b: function () {}, c: Symbol()}, null, 2));
+// CHECK-NEXT: {}
+print(JSON.stringify({a: undefined, b: 1, c: undefined, d: [undefined]}));
+// CHECK-NEXT: {"b":1,"d":[null]}
+print(JSON.stringify({a: {b: undefined}, c: 2}, null, 1));
+// CHECK-NEXT: {
+// CHECK-NEXT:  "a": {},
+// CHECK-NEXT:  "c": 2
+// CHECK-NEXT: }
+
+// Accessors, non-enumerable and symbol-keyed properties.
+var o = {x: 1};
+Object.defineProperty(o, 'hidden', {value: 2, enumerable: false});
+Object.defineProperty(o, 'getter', {
+  get: function () {
+    return this.x + 10;
+  },
+  enumerable: true,
+});
+o[Symbol('s')] = 3;
+o.y = 4;
+print(JSON.stringify(o));
+// CHECK-NEXT: {"x":1,"getter":11,"y":4}
+
+// A toJSON which changes its parent: the keys are taken before serializing,
+// and later values are read after the change.
+var parent = {
+  a: {
+    toJSON: function () {
+      delete parent.b;
+      parent.c = 'changed';
+      parent.d = 'added';
+      return 'a';
+    },
+  },
+  b: 'deleted',
+  c: 'original',
+};
+print(JSON.stringify(parent));
+// CHECK-NEXT: {"a":"a","c":"changed"}
+
+// A deleted property is looked up on the prototype.
+var proto = {b: 'from proto'};
+var child = Object.create(proto);
+child.a = {
+  toJSON: function () {
+    delete child.b;
+    return 1;
+  },
+};
+child.b = 'own';
+print(JSON.stringify(child));
+// CHECK-NEXT: {"a":1,"b":"from proto"}
+
+// A replacer which changes the holder.
+print(
+  JSON.stringify({a: 1, b: 2, c: 3}, function (k, v) {
+    if (k === 'a') this.b = 'replaced';
+    return v;
+  }),
+);
+// CHECK-NEXT: {"a":1,"b":"replaced","c":3}
+
+// Index-like keys come first, dictionary objects keep insertion order.
+print(JSON.stringify({b: 1, 2: 2, a: 3, 1: 4}));
+// CHECK-NEXT: {"1":4,"2":2,"b":1,"a":3}
+var dict = {p: 1, q: 2, r: 3};
+delete dict.q;
+dict.q = 4;
+print(JSON.stringify(dict));
+// CHECK-NEXT: {"p":1,"r":3,"q":4}
+
+// Array holes are looked up on the prototype, and elements changed by an
+// earlier element's toJSON are seen.
+Array.prototype[1] = 'proto';
+print(JSON.stringify([0, , 2]));
+// CHECK-NEXT: [0,"proto",2]
+delete Array.prototype[1];
+var arr = [
+  {
+    toJSON: function () {
+      arr[1] = 'changed';
+      arr.length = 3;
+      return 0;
+    },
+  },
+  1,
+  2,
+  3,
+];
+print(JSON.stringify(arr));
+// CHECK-NEXT: [0,"changed",2,null]
+var accessorArr = [1, 2];
+Object.defineProperty(accessorArr, 1, {
+  get: function () {
+    return 'getter';
+  },
+  enumerable: true,
+});
+print(JSON.stringify(accessorArr));
+// CHECK-NEXT: [1,"getter"]
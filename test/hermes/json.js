@@ -497,3 +497,43 @@ print(JSON.parse("1.2e2"));
 // CHECK-NEXT: 120
 print(JSON.parse("2.3E3"));
 // CHECK-NEXT: 2300
+
+// Simple decimals are converted without strtod; others still go through it.
+print(JSON.stringify(JSON.parse(
+  '[0, -0, 7, -42, 0.1, 0.3, -1.5, 123456789012345, 1234567890123456789, ' +
+  '0.123456789012345, 9007199254740993, 1.7976931348623157e308]')));
+// CHECK-NEXT: [0,0,7,-42,0.1,0.3,-1.5,123456789012345,1234567890123456800,0.123456789012345,9007199254740992,1.7976931348623157e+308]
+print(1 / JSON.parse('-0'));
+// CHECK-NEXT: -Infinity
+for (var bad of ['-', '1.', '.5', '01', '1.2.3', '1e']) {
+  try {
+    JSON.parse(bad);
+    print('parsed', bad);
+  } catch (e) {
+    print(e.name);
+  }
+}
+// CHECK-NEXT: SyntaxError
+// CHECK-NEXT: parsed 1.
+// CHECK-NEXT: SyntaxError
+// CHECK-NEXT: SyntaxError
+// CHECK-NEXT: SyntaxError
+// CHECK-NEXT: SyntaxError
+
+// Long strings are scanned a block at a time. Check escapes and errors at
+// every offset around the block boundaries.
+var ok = true;
+for (var i = 0; i < 40; ++i) {
+  var pad = 'x'.repeat(i);
+  ok = ok && JSON.parse('"' + pad + '\\n' + pad + '"') === pad + '\n' + pad;
+  ok = ok && JSON.parse('{"' + pad + '\\u0041": 1}')[pad + 'A'] === 1;
+  ok = ok && JSON.parse('"' + pad + '\u0100"') === pad + '\u0100';
+  try {
+    JSON.parse('"' + pad + '\t"');
+    ok = false;
+  } catch (e) {
+    ok = ok && e instanceof SyntaxError;
+  }
+}
+print(ok);
+// CHECK-NEXT: true
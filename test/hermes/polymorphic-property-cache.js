@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O0 %s | %FileCheck --match-full-lines %s
+
+// Exercise property caches that see several classes, and caches for
+// properties found on the prototype chain.
+
+print('polymorphic');
+// CHECK-LABEL: polymorphic
+
+function getX(o) {
+  return o.x;
+}
+function setX(o, v) {
+  o.x = v;
+}
+
+var shapes = [
+  {x: 1},
+  {a: 0, x: 2},
+  {a: 0, b: 0, x: 3},
+  {a: 0, b: 0, c: 0, x: 4},
+];
+var sum = 0;
+for (var i = 0; i < 100; ++i) {
+  for (var j = 0; j < shapes.length; ++j) {
+    setX(shapes[j], j + 1);
+    sum += getX(shapes[j]);
+  }
+}
+print(sum);
+// CHECK-NEXT: 1000
+
+print('megamorphic');
+// CHECK-LABEL: megamorphic
+
+var many = [];
+for (var i = 0; i < 10; ++i) {
+  var o = {};
+  for (var j = 0; j < i; ++j) o['p' + j] = j;
+  o.x = i;
+  many.push(o);
+}
+sum = 0;
+for (var i = 0; i < 10; ++i) {
+  for (var j = 0; j < many.length; ++j) {
+    setX(many[j], j);
+    sum += getX(many[j]);
+  }
+}
+print(sum);
+// CHECK-NEXT: 450
+
+print('proto');
+// CHECK-LABEL: proto
+
+function getM(o) {
+  return o.m;
+}
+
+var base = {m: 'base'};
+var mid = Object.create(base);
+var obj = Object.create(mid);
+obj.own = 1;
+print(getM(obj), getM(obj));
+// CHECK-NEXT: base base
+
+// Shadow the property on an object in the middle of the chain.
+mid.m = 'mid';
+print(getM(obj));
+// CHECK-NEXT: mid
+
+// Change the prototype chain.
+Object.setPrototypeOf(obj, base);
+print(getM(obj));
+// CHECK-NEXT: base
+
+// Shadow the property on a dictionary-mode prototype, which does not change
+// its class.
+var dictProto = Object.create(base);
+for (var i = 0; i < 100; ++i) dictProto['d' + i] = i;
+delete dictProto.d0;
+var viaDict = Object.create(dictProto);
+viaDict.own = 1;
+print(getM(viaDict), getM(viaDict));
+// CHECK-NEXT: base base
+dictProto.m = 'dict';
+print(getM(viaDict));
+// CHECK-NEXT: dict
+
+// Redefine the property as an accessor on the object owning it.
+var accBase = {m: 'data'};
+var accObj = Object.create(accBase);
+print(getM(accObj), getM(accObj));
+// CHECK-NEXT: data data
+Object.defineProperty(accBase, 'm', {get: function () { return 'getter'; }});
+print(getM(accObj));
+// CHECK-NEXT: getter
+
+// Objects with the same class but different prototypes.
+var p1 = {m: 'p1'};
+var p2 = Object.create({m: 'p2 parent'});
+var o1 = Object.create(p1);
+var o2 = Object.create(p2);
+print(getM(o1), getM(o2), getM(o1), getM(o2));
+// CHECK-NEXT: p1 p2 parent p1 p2 parent
+p2.m = 'p2';
+print(getM(o1), getM(o2));
+// CHECK-NEXT: p1 p2
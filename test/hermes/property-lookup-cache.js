@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O0 %s | %FileCheck --match-full-lines %s
+
+// Exercise the runtime-wide property lookup cache, which is used by accesses
+// that see too many classes to be cached at the access itself. Objects in
+// dictionary mode change their properties without changing their class.
+
+print('megamorphic');
+// CHECK-LABEL: megamorphic
+
+function getX(o) {
+  return o.x;
+}
+
+var objs = [];
+for (var i = 0; i < 10; ++i) {
+  var o = {};
+  for (var j = 0; j < i; ++j)
+    o['p' + j] = j;
+  o.x = i;
+  objs.push(o);
+}
+var sum = 0;
+for (var n = 0; n < 100; ++n)
+  for (var i = 0; i < objs.length; ++i)
+    sum += getX(objs[i]);
+print(sum);
+// CHECK-NEXT: 4500
+
+print('dictionary');
+// CHECK-LABEL: dictionary
+
+var dict = {};
+for (var i = 0; i < 100; ++i)
+  dict['d' + i] = i;
+print(getX(dict));
+// CHECK-NEXT: undefined
+dict.x = 'added';
+print(getX(dict));
+// CHECK-NEXT: added
+delete dict.x;
+print(getX(dict));
+// CHECK-NEXT: undefined
+dict.x = 'readded';
+print(getX(dict));
+// CHECK-NEXT: readded
+Object.defineProperty(dict, 'x', {
+  get: function() {
+    return 'getter';
+  },
+});
+print(getX(dict));
+// CHECK-NEXT: getter
+delete dict.x;
+print(getX(dict));
+// CHECK-NEXT: undefined
+
+print('prototype');
+// CHECK-LABEL: prototype
+
+var protoDict = {};
+for (var i = 0; i < 100; ++i)
+  protoDict['d' + i] = i;
+var child = Object.create(protoDict);
+print(getX(child));
+// CHECK-NEXT: undefined
+protoDict.x = 'proto';
+print(getX(child));
+// CHECK-NEXT: proto
+child.x = 'own';
+print(getX(child));
+// CHECK-NEXT: own
+delete child.x;
+print(getX(child));
+// CHECK-NEXT: proto
+Object.freeze(protoDict);
+print(getX(child), Object.getOwnPropertyDescriptor(protoDict, 'x').writable);
+// CHECK-NEXT: proto false
+
+print('gc');
+// CHECK-LABEL: gc
+
+for (var n = 0; n < 3; ++n) {
+  // Create and drop many classes so that new classes may reuse their memory.
+  for (var i = 0; i < 1000; ++i) {
+    var tmp = {};
+    tmp['g' + i] = i;
+    getX(tmp);
+  }
+  gc();
+  var fresh = {};
+  fresh['g' + n] = n;
+  fresh.x = 'fresh' + n;
+  print(getX(fresh));
+}
+// CHECK-NEXT: fresh0
+// CHECK-NEXT: fresh1
+// CHECK-NEXT: fresh2
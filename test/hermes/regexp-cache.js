@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// RegExps constructed from the same pattern and flags share their compiled
+// form. Check that they still behave independently.
+print('regexp cache');
+// CHECK-LABEL: regexp cache
+
+function stats() {
+  var s = HermesInternal.getInstrumentedStats();
+  return [s.js_regExpCacheHits, s.js_regExpCacheMisses];
+}
+
+var before = stats();
+var res = [];
+for (var i = 0; i < 3; ++i) {
+  var re = new RegExp('(?<word>[a-z]+)(\\d)', 'g');
+  re.lastIndex = i;
+  var m = re.exec('ab1 cd2');
+  res.push(m.groups.word + m[2] + re.lastIndex);
+}
+print(res.join());
+// CHECK-NEXT: ab13,b13,cd27
+var after = stats();
+print(after[0] - before[0], after[1] - before[1]);
+// CHECK-NEXT: 2 1
+
+// The flags are part of the key.
+print(new RegExp('(?<word>[a-z]+)(\\d)', 'i').exec('AB1')[0]);
+// CHECK-NEXT: AB1
+print(new RegExp('(?<word>[a-z]+)(\\d)', 'g').flags);
+// CHECK-NEXT: g
+var last = stats();
+print(last[0] - after[0], last[1] - after[1]);
+// CHECK-NEXT: 1 1
+
+// Errors are still reported for every construction.
+for (var i = 0; i < 2; ++i) {
+  try {
+    new RegExp('(', '');
+  } catch (e) {
+    print(e.name);
+  }
+}
+// CHECK-NEXT: SyntaxError
+// CHECK-NEXT: SyntaxError
+try {
+  new RegExp('a', 'gg');
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: SyntaxError
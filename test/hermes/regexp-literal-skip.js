@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// Regexps containing literals skip ahead to where the literals occur. Check
+// that no matches are lost, in ASCII and UTF-16 inputs.
+print('literal skip');
+// CHECK-LABEL: literal skip
+
+var pad = 'abcdefghijklmnopqrstuvwxyz'.repeat(3);
+print(/\d\dXY/.exec(pad + '12XY' + pad).index);
+// CHECK-NEXT: 78
+print(/\d\dXY/.exec('Ā' + pad + '12XY').index);
+// CHECK-NEXT: 79
+print(/\d\dXY/.exec(pad + '1XY 12X'));
+// CHECK-NEXT: null
+print(/a+XY/.exec(pad + 'aaaXY')[0]);
+// CHECK-NEXT: aaaXY
+print(/[a-z]+\d+==/.exec(pad + '0==')[0].length);
+// CHECK-NEXT: 81
+
+// Global and sticky searches start from lastIndex.
+var re = /x=\d/g;
+var s = pad + 'x=1' + pad + 'x=2';
+var m;
+while ((m = re.exec(s)))
+  print(m.index, m[0], re.lastIndex);
+// CHECK-NEXT: 78 x=1 81
+// CHECK-NEXT: 159 x=2 162
+var sticky = /\wx=/y;
+sticky.lastIndex = 76;
+print(sticky.exec(s));
+// CHECK-NEXT: null
+sticky.lastIndex = 77;
+print(sticky.exec(s));
+// CHECK-NEXT: zx=
+
+// Lookarounds do not consume the literal.
+print(/(?<=ab)cd/.exec('xxabcd').index);
+// CHECK-NEXT: 4
+print(/(?=\w*!)ab/.exec('ab ab!').index);
+// CHECK-NEXT: 3
+
+// In Unicode mode a match never starts inside a surrogate pair.
+print(/\uDE00/u.test('😀'));
+// CHECK-NEXT: false
+print(/\uDE00/.exec('😀').index);
+// CHECK-NEXT: 1
+print(/.x/u.exec('😀x')[0].length);
+// CHECK-NEXT: 3
@@ -0,0 +1,21 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -Xregexp-engine=nfa %s | %FileCheck --match-full-lines %s
+
+// These take exponential time with backtracking, so the default engine runs
+// them on the NFA.
+print('nested quantifiers');
+// CHECK-LABEL: nested quantifiers
+var bad = 'a'.repeat(40) + '!';
+print(/^(a+)+$/.test(bad));
+// CHECK-NEXT: false
+print(/^(\w+\s?)*$/.test(bad));
+// CHECK-NEXT: false
+print(JSON.stringify(/(a|aa)+(!)/.exec(bad).slice(1)));
+// CHECK-NEXT: ["a","!"]
@@ -0,0 +1,39 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -Xregexp-engine=nfa %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -Xregexp-engine=backtracking %s | %FileCheck --match-full-lines %s
+
+// All regexp engines must agree on matches and captures.
+print('regexp engines');
+// CHECK-LABEL: regexp engines
+
+print(JSON.stringify(/(a|ab)(c|bcd)(d*)/.exec('abcd')));
+// CHECK-NEXT: ["abcd","a","bcd",""]
+print(JSON.stringify(/((a)|b)+/.exec('ab')));
+// CHECK-NEXT: ["ab","b",null]
+print(JSON.stringify(/(z)((a+)?(b+)?(c))*/.exec('zaacbbbcac')));
+// CHECK-NEXT: ["zaacbbbcac","z","ac","a",null,"c"]
+print(JSON.stringify(/(a+?)(a*)/.exec('xaaa')));
+// CHECK-NEXT: ["aaa","a","aa"]
+print(JSON.stringify('x1y22z333'.match(/\d+/g)));
+// CHECK-NEXT: ["1","22","333"]
+print(JSON.stringify(/^b|c$/m.exec('a\nb')));
+// CHECK-NEXT: ["b"]
+print(JSON.stringify(/\bfoo\b/i.exec('a Foo b')));
+// CHECK-NEXT: ["Foo"]
+print(JSON.stringify(/(é+)|x/i.exec('ÉÉé')));
+// CHECK-NEXT: ["ÉÉé","ÉÉé"]
+
+var re = /(a|b)+c/y;
+re.lastIndex = 1;
+print(JSON.stringify(re.exec('xabc')), re.lastIndex);
+// CHECK-NEXT: ["abc","b"] 4
+re.lastIndex = 0;
+print(re.exec('xabc'), re.lastIndex);
+// CHECK-NEXT: null 0
@@ -21,6 +21,7 @@ print(/a\x01\u017f/i);
 print(/^a\u017f\x01$/);
 // CHECK:       1: /^a\u017f\x01$/
 // CHECK-NEXT:    Header: marked: 0 loops: 0 flags: 0 constraints: 7
+// CHECK-NEXT:    Anchored literal at 0: a\u017f\u0001
 // CHECK-NEXT:    0000  LeftAnchor
 // CHECK-NEXT:    0001  MatchChar8: 'a'
 // CHECK-NEXT:    0003  MatchChar16: 0x17f
@@ -50,6 +51,7 @@ print(/[a-z][^A-Z0-9_\d][\s][abc]/);
 print(/a(b(c)(d))e\1\2/);
 // CHECK:       4: /a(b(c)(d))e\1\2/
 // CHECK-NEXT:    Header: marked: 3 loops: 0 flags: 0 constraints: 4
+// CHECK-NEXT:    Anchored literal at 0: abcde
 // CHECK-NEXT:    0000  MatchChar8: 'a'
 // CHECK-NEXT:    0002  BeginMarkedSubexpression: 0
 // CHECK-NEXT:    0005  MatchChar8: 'b'
@@ -86,6 +88,7 @@ print(/abc(?=^)(?!def)/i);
 print(/ab*c+d{3,5}/);
 // CHECK:        7: /ab*c+d{3,5}/
 // CHECK-NEXT:    Header: marked: 0 loops: 3 flags: 0 constraints: 4
+// CHECK-NEXT:    Anchored literal at 0: a
 // CHECK-NEXT:    0000  MatchChar8: 'a'
 // CHECK-NEXT:    0002  Width1Loop: 0 greedy {0, 4294967295}
 // CHECK-NEXT:    0014  MatchChar8: 'b'
@@ -98,6 +101,7 @@ print(/ab*c+d{3,5}/);
 print(/a((b+){3})*/);
 // CHECK:        8: /a((b+){3})*/
 // CHECK-NEXT:    Header: marked: 2 loops: 3 flags: 0 constraints: 4
+// CHECK-NEXT:    Anchored literal at 0: a
 // CHECK-NEXT:     0000  MatchChar8: 'a'
 // CHECK-NEXT:     0002  BeginLoop: 2 greedy {0, 4294967295} (constraints: 4)
 // CHECK-NEXT:     0019  BeginMarkedSubexpression: 0
@@ -114,6 +118,7 @@ print(/a((b+){3})*/);
 print(/(^b)+(c)*?/);
 // CHECK:        9: /(^b)+(c)*?/
 // CHECK-NEXT:    Header: marked: 2 loops: 2 flags: 0 constraints: 6
+// CHECK-NEXT:    Anchored literal at 0: b
 // CHECK-NEXT:     0000  BeginLoop: 0 greedy {1, 4294967295} (constraints: 6)
 // CHECK-NEXT:     0017  BeginMarkedSubexpression: 0
 // CHECK-NEXT:     001a  LeftAnchor
@@ -143,6 +148,7 @@ print(/a*/);
 print(/a+/);
 // CHECK:        12: /a+/
 // CHECK-NEXT:    Header: marked: 0 loops: 1 flags: 0 constraints: 4
+// CHECK-NEXT:    Anchored literal at 0: a
 // CHECK-NEXT:    0000  Width1Loop: 0 greedy {1, 4294967295}
 // CHECK-NEXT:    0012  MatchChar8: 'a'
 // CHECK-NEXT:    0014  Goal
@@ -216,6 +222,7 @@ print(/(a)(?<!(.))/i);
 print(/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaoverflow/);
 // CHECK:        20: /{{a{255}overflow}}/
 // CHECK-NEXT:   Header: marked: 0 loops: 0 flags: 0 constraints: 4
+// CHECK-NEXT:   Anchored literal at 0: aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa
 // CHECK-NEXT:   0000  MatchNChar8: {{'a{255}'}}
 // CHECK-NEXT:   0101  MatchNChar8: 'overflow'
 // CHECK-NEXT:   010b  Goal
@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// Long concatenations which cannot append to a shared buffer are represented
+// lazily. Check that their contents are correct however they are used.
+print('string rope');
+// CHECK-LABEL: string rope
+
+var chunk = 'abcdefghij'.repeat(30);
+
+// Prepending.
+var s = '';
+for (var i = 0; i < 2000; ++i) s = (i % 10) + s;
+s = s + chunk;
+print(s.length, s.slice(0, 12), s.charAt(1999), s.slice(-3));
+// CHECK-NEXT: 2300 987654321098 0 hij
+
+// Building a tree, with UTF-16 content on one side.
+function tree(depth, leaf) {
+  if (depth === 0) return leaf;
+  return '<' + tree(depth - 1, leaf) + '|' + tree(depth - 1, leaf) + '>';
+}
+var t = tree(8, chunk);
+var u = tree(3, chunk + 'é中');
+print(t.length, t.indexOf('|'), t.lastIndexOf('a'));
+// CHECK-NEXT: 77565 308 77547
+print(u.length, u.charCodeAt(303).toString(16), u.indexOf('中'));
+// CHECK-NEXT: 2437 e9 304
+var mixed = t + u;
+print(mixed.length, mixed.charCodeAt(77565 + 304).toString(16));
+// CHECK-NEXT: 80002 4e2d
+
+// Appending different suffixes to the same prefix.
+var prefix = chunk + chunk;
+var a = prefix + 'A';
+var b = prefix + 'B';
+var c = a + chunk;
+print(a.slice(-2), b.slice(-2), c.length, a === prefix + 'A', a === b);
+// CHECK-NEXT: jA jB 901 true false
+
+// Ropes used as property keys and compared with flat strings.
+var o = {};
+o[a] = 1;
+print(o[prefix + 'A'], Object.keys(o)[0] === a);
+// CHECK-NEXT: 1 true
+print(a < b, c > a, c.startsWith(a), JSON.stringify(c).length);
+// CHECK-NEXT: true true true 903
+
+// Very deep ropes.
+var deep = chunk;
+for (var i = 0; i < 5000; ++i) deep = 'x' + deep + 'y';
+print(deep.length, deep.indexOf('a'), deep[deep.length - 1]);
+// CHECK-NEXT: 10300 5000 y
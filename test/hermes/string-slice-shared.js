@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// Long slices may share the characters of the sliced string. Check that their
+// contents stay correct as the strings move and the originals die.
+print('string slice');
+// CHECK-LABEL: string slice
+
+var line = 'field number one;field number two;'.repeat(3) + '\n';
+var text = line.repeat(500);
+var utf16 = ('é' + line).repeat(50);
+
+var lines = text.split('\n');
+print(lines.length, lines[0].length, lines[499] === line.slice(0, -1));
+// CHECK-NEXT: 501 102 true
+
+var parts = [];
+for (var i = 0; i < 200; ++i) {
+  parts.push(text.slice(i * 103, i * 103 + 40));
+  parts.push(utf16.substring(i, i + 60));
+  parts.push(text.substr(i, 33).slice(1));
+}
+text = null;
+utf16 = null;
+lines = null;
+gc();
+print(JSON.stringify(parts[0]), parts[0].length);
+// CHECK-NEXT: "field number one;field number two;field " 40
+print(parts[1].charCodeAt(0).toString(16), parts[1].length, parts[2]);
+// CHECK-NEXT: e9 60 ield number one;field number two
+print(parts[597], parts[599].length);
+// CHECK-NEXT: field number one;field number two;field  32
+
+// Slices work as keys and compare by contents.
+var o = {};
+o[parts[0]] = 1;
+print(o['field number one;field number two;field '], parts[0] === parts[3]);
+// CHECK-NEXT: 1 true
+print(parts[0] + parts[1] === parts[3] + parts[1], parts[4] < parts[1]);
+// CHECK-NEXT: true true
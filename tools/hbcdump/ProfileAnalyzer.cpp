@@ -11,6 +11,7 @@
 #include "hermes/BCGen/HBC/HBC.h"
 #include "hermes/Parser/JSONParser.h"
 
+#include <algorithm>
 #include <set>
 #include <vector>
 
@@ -661,10 +662,17 @@ void ProfileAnalyzer::dumpIO() {
   os_ << executionInfo.size() << " functions accessed out of total "
       << funcCount << " functions\n";
 
-  uint32_t funcRegionStartOffset = bcProvider->getFunctionHeader(0).offset();
-  uint32_t funcRegionEndOffset =
-      bcProvider->getFunctionHeader(funcCount - 1).offset() +
-      bcProvider->getFunctionHeader(funcCount - 1).bytecodeSizeInBytes() - 1;
+  // Function bodies may have been reordered by a layout profile, so the
+  // region isn't necessarily bounded by the first and last function.
+  uint32_t funcRegionStartOffset = UINT32_MAX;
+  uint32_t funcRegionEndOffset = 0;
+  for (uint32_t i = 0; i < funcCount; ++i) {
+    hbc::RuntimeFunctionHeader header = bcProvider->getFunctionHeader(i);
+    funcRegionStartOffset = std::min(funcRegionStartOffset, header.offset());
+    funcRegionEndOffset = std::max(
+        funcRegionEndOffset,
+        header.offset() + header.bytecodeSizeInBytes() - 1);
+  }
 
   uint32_t funcRegionStartPage = getPageIndexFromOffset(funcRegionStartOffset);
   uint32_t funcRegionEndPage = getPageIndexFromOffset(funcRegionEndOffset);
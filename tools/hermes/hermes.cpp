@@ -54,6 +54,24 @@ static opt<bool> GCRevertToYGAtTTI(
     cat(GCCategory),
     init(false));
 
+static opt<unsigned> GCMarkerThreads(
+    "gc-marker-threads",
+    desc("Number of threads used to mark the old generation in Hades"),
+    cat(GCCategory),
+    init(vm::GCConfig::getDefaultNumMarkerThreads()));
+
+static opt<unsigned> GCEvacuationThreads(
+    "gc-evacuation-threads",
+    desc("Number of threads used to evacuate the young generation in Hades"),
+    cat(GCCategory),
+    init(vm::GCConfig::getDefaultNumEvacuationThreads()));
+
+static opt<unsigned> GCSweeperThreads(
+    "gc-sweeper-threads",
+    desc("Number of threads used to sweep the old generation in Hades"),
+    cat(GCCategory),
+    init(vm::GCConfig::getDefaultNumSweeperThreads()));
+
 static opt<bool> GCBeforeStats(
     "gc-before-stats",
     desc("Perform a full GC just before printing statistics at exit"),
@@ -95,6 +113,9 @@ static int executeHBCBytecodeFromCL(
                             .withShouldReleaseUnused(vm::kReleaseUnusedNone)
                             .withAllocInYoung(cl::GCAllocYoung)
                             .withRevertToYGAtTTI(cl::GCRevertToYGAtTTI)
+                            .withNumMarkerThreads(cl::GCMarkerThreads)
+                            .withNumEvacuationThreads(cl::GCEvacuationThreads)
+                            .withNumSweeperThreads(cl::GCSweeperThreads)
                             .build())
           .withEnableBlockScoping(cl::EnableBlockScoping)
           .withEnableEval(cl::EnableEval)
@@ -107,6 +128,9 @@ static int executeHBCBytecodeFromCL(
           .withES6Class(cl::ES6Class)
           .withIntl(cl::Intl)
           .withMicrotaskQueue(cl::MicrotaskQueue)
+          .withEnableJIT(cl::JIT)
+          .withJITThreshold(cl::JITThreshold)
+          .withRegExpEngine(cl::RegExpEngine)
           .withEnableSampleProfiling(cl::SampleProfiling)
           .withRandomizeMemoryLayout(cl::RandomizeMemoryLayout)
           .withTrackIO(cl::TrackBytecodeIO)
@@ -164,6 +188,9 @@ static vm::RuntimeConfig getReplRuntimeConfig() {
       .withES6Class(cl::ES6Class)
       .withIntl(cl::Intl)
       .withMicrotaskQueue(cl::MicrotaskQueue)
+      .withEnableJIT(cl::JIT)
+      .withJITThreshold(cl::JITThreshold)
+      .withRegExpEngine(cl::RegExpEngine)
       .withEnableHermesInternal(cl::EnableHermesInternal)
       .withEnableHermesInternalTestMethods(cl::EnableHermesInternalTestMethods)
       .build();
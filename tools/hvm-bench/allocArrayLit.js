@@ -0,0 +1,33 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// Allocates many small, non-empty arrays. Each one needs both the array object
+// and its element storage, so this exercises creating the two together.
+function doAlloc(n) {
+    var x0 = null;
+    var x1 = null;
+    var x2 = null;
+    var x3 = null;
+    for (var i = 0; i < 100000; i++) {
+        x0 = [i];
+        x1 = [i, n];
+        x2 = [i, n, i];
+        x3 = [i, n, i, n, i, n, i, n];
+    }
+    // Use the last arrays so the allocations cannot be optimized away.
+    return x0[0] + x1[1] + x2[2] + x3[7];
+}
+
+function allocNTimes(n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+        sum += doAlloc(i)
+    }
+    return sum;
+}
+
+print(allocNTimes(500));
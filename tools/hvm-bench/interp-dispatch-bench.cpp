@@ -32,6 +32,9 @@
 ///
 /// If, on the other hand, it is faster, then we can focus on higher level
 /// optimizations.
+///
+/// With -jit, the same bytecode is compiled by the baseline JIT before it runs,
+/// for comparison with the interpreter.
 //===----------------------------------------------------------------------===//
 #include "hermes/BCGen/HBC/BytecodeGenerator.h"
 #include "hermes/BCGen/HBC/BytecodeProviderFromSrc.h"
@@ -184,6 +187,10 @@ static llvh::cl::opt<int> FactValue{
     llvh::cl::Positional,
     llvh::cl::init(100),
     llvh::cl::desc("(factorial value)")};
+static llvh::cl::opt<bool> JIT{
+    "jit",
+    llvh::cl::init(false),
+    llvh::cl::desc("Compile the benchmark with the baseline JIT, if available")};
 
 int main(int argc, char **argv) {
   // Print a stack trace if we signal out.
@@ -194,7 +201,7 @@ int main(int argc, char **argv) {
   llvh::cl::ParseCommandLineOptions(argc, argv, "Hermes vm driver\n");
 
   llvh::outs() << "Running " << (uint64_t)LoopCount << " loops of factorial("
-               << FactValue << ")\n";
+               << FactValue << ")" << (JIT ? " with the JIT" : "") << "\n";
 
   auto runtime =
       Runtime::create(RuntimeConfig::Builder()
@@ -202,6 +209,8 @@ int main(int argc, char **argv) {
                                             .withInitHeapSize(1 << 16)
                                             .withMaxHeapSize(1 << 19)
                                             .build())
+                          .withEnableJIT(JIT)
+                          .withJITThreshold(0)
                           .build());
 
   GCScope scope(*runtime);
@@ -0,0 +1,26 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Parses a document made of many short arrays, which is dominated by the cost
+// of allocating each array and its element storage.
+(function () {
+  var numIter = 200;
+  var rows = [];
+  for (var i = 0; i < 2000; i++) {
+    rows.push('[' + i + ',' + (i + 1) + ',' + (i + 2) + ']');
+  }
+  var text = '[' + rows.join(',') + ']';
+
+  var sum = 0;
+  for (var i = 0; i < numIter; i++) {
+    var parsed = JSON.parse(text);
+    sum += parsed[i][0];
+  }
+  print(sum);
+})();
@@ -0,0 +1,29 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Parses an array of 50k records that all have the same keys, which is
+// dominated by creating the objects and adding their properties.
+(function () {
+  var numIter = 10;
+  var rows = [];
+  for (var i = 0; i < 50000; i++) {
+    rows.push(
+      '{"id":' + i + ',"active":true,"score":' + (i % 100) +
+        ',"tag":"t","owner":{"id":' + (i % 7) + ',"name":"n"}}',
+    );
+  }
+  var text = '[' + rows.join(',') + ']';
+
+  var sum = 0;
+  for (var i = 0; i < numIter; i++) {
+    var parsed = JSON.parse(text);
+    sum += parsed[i].score + parsed[parsed.length - 1 - i].owner.id;
+  }
+  print(sum);
+})();
@@ -0,0 +1,34 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Parses records with long string values and decimal numbers, which is
+// dominated by scanning the strings and converting the numbers.
+(function () {
+  var numIter = 100;
+  var rows = [];
+  for (var i = 0; i < 2000; i++) {
+    rows.push(
+      JSON.stringify({
+        id: i,
+        price: i + 0.25,
+        name: 'item number ' + i,
+        description: 'lorem ipsum dolor sit amet, consectetur adipiscing '.repeat(4),
+        path: '/api/v1/items/' + i + '/details?format=json',
+      }),
+    );
+  }
+  var text = '[' + rows.join(',') + ']';
+
+  var sum = 0;
+  for (var i = 0; i < numIter; i++) {
+    var parsed = JSON.parse(text);
+    sum += parsed[i].price + parsed[i].description.length;
+  }
+  print(sum);
+})();
@@ -0,0 +1,31 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Stringifies an array of records with the same shape, which is dominated by
+// enumerating and reading the properties of plain objects.
+(function () {
+  var numIter = 30;
+  var rows = [];
+  for (var i = 0; i < 20000; i++) {
+    rows.push({
+      id: i,
+      active: i % 3 === 0,
+      name: 'item number ' + i,
+      tags: ['a', 'b', i % 7],
+      owner: {id: i % 100, name: 'owner'},
+      note: null,
+    });
+  }
+
+  var len = 0;
+  for (var i = 0; i < numIter; i++) {
+    len += JSON.stringify(rows).length;
+  }
+  print(len);
+})();
@@ -0,0 +1,47 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// Reads properties at sites that see far more classes than their inline caches
+// can hold, so every read has to look the property up in the class.
+function makeObjects(n) {
+    var objs = [];
+    for (var i = 0; i < n; i++) {
+        var o = {};
+        // Give each object a different class, with x at a different position.
+        for (var j = 0; j < i % 16; j++) {
+            o['p' + j] = j;
+        }
+        o.x = i;
+        o.y = -i;
+        objs.push(o);
+    }
+    return objs;
+}
+
+function readAll(objs) {
+    var sum = 0;
+    for (var i = 0; i < objs.length; i++) {
+        var o = objs[i];
+        sum += o.x + o.y;
+        // Found on Object.prototype.
+        if (o.hasOwnProperty) {
+            sum++;
+        }
+    }
+    return sum;
+}
+
+function run(n) {
+    var objs = makeObjects(64);
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+        sum += readAll(objs);
+    }
+    return sum;
+}
+
+print(run(100000));
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+//===----------------------------------------------------------------------===//
+/// \file
+/// Run a bytecode file and print the opcode pairs executed most often by the
+/// interpreter. This is the data used to choose the superinstructions in
+/// BytecodeList.def, so it can be used to retune them for a given workload:
+///
+///   hermesc -O -emit-binary -out workload.hbc workload.js
+///   opcode-pairs -top=30 workload.hbc
+///
+/// The counts are only collected when the VM is built with
+/// HERMESVM_PROFILER_OPCODE. Superinstructions are counted as their first
+/// instruction followed by their second, so compile the workload with
+/// -fno-superinstructions to see the pairs they would replace.
+//===----------------------------------------------------------------------===//
+
+#include "hermes/BCGen/HBC/BytecodeDataProvider.h"
+#include "hermes/Support/MemoryBuffer.h"
+#include "hermes/VM/Callable.h"
+#include "hermes/VM/Runtime.h"
+
+#include "llvh/Support/CommandLine.h"
+#include "llvh/Support/InitLLVM.h"
+#include "llvh/Support/MemoryBuffer.h"
+#include "llvh/Support/raw_ostream.h"
+
+using namespace hermes;
+using namespace hermes::vm;
+
+static llvh::cl::opt<std::string> InputFilename(
+    llvh::cl::desc("input bytecode file"),
+    llvh::cl::Positional,
+    llvh::cl::Required);
+
+static llvh::cl::opt<unsigned> Top(
+    "top",
+    llvh::cl::init(20),
+    llvh::cl::desc("Number of opcode pairs to print"));
+
+int main(int argc, char **argv) {
+  llvh::InitLLVM initLLVM(argc, argv);
+  llvh::cl::ParseCommandLineOptions(argc, argv, "Opcode pair statistics\n");
+
+#ifndef HERMESVM_PROFILER_OPCODE
+  llvh::errs() << "opcode-pairs requires a VM built with "
+                  "HERMESVM_PROFILER_OPCODE\n";
+  return 1;
+#else
+  llvh::ErrorOr<std::unique_ptr<llvh::MemoryBuffer>> fileBufOrErr =
+      llvh::MemoryBuffer::getFile(InputFilename);
+  if (!fileBufOrErr) {
+    llvh::errs() << "Error! Failed to open file: " << InputFilename << "\n";
+    return 1;
+  }
+
+  auto ret = hbc::BCProviderFromBuffer::createBCProviderFromBuffer(
+      std::make_unique<MemoryBuffer>(fileBufOrErr.get().get()));
+  if (!ret.first) {
+    llvh::errs() << ret.second << "\n";
+    return 1;
+  }
+
+  std::shared_ptr<Runtime> runtime = Runtime::create(RuntimeConfig{});
+  GCScope scope{*runtime};
+  RuntimeModuleFlags flags;
+  flags.persistent = true;
+  CallResult<HermesValue> status = runtime->runBytecode(
+      std::move(ret.first),
+      flags,
+      InputFilename,
+      Runtime::makeNullHandle<Environment>());
+  if (status == ExecutionStatus::EXCEPTION) {
+    llvh::outs().flush();
+    runtime->printException(
+        llvh::errs(), runtime->makeHandle(runtime->getThrownValue()));
+    return 1;
+  }
+
+  runtime->dumpOpcodePairStats(llvh::outs(), Top);
+  return 0;
+#endif
+}
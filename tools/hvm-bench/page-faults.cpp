@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+//===----------------------------------------------------------------------===//
+/// \file
+/// Run bytecode files from a cold page cache and report how many pages of each
+/// file were read, and how many page faults the run took. This measures the
+/// effect of laying out a bytecode file with a startup profile:
+///
+///   hermesc -O -emit-binary -out default.hbc bundle.js
+///   hermes -track-io -gc-print-stats default.hbc 2>&1 >/dev/null |
+///       sed -n '/^\[/,$p' > io.json
+///   hermesc -O -emit-binary -layout-profile=io.json -out hot.hbc bundle.js
+///   page-faults -repeat=5 default.hbc hot.hbc
+///
+/// Each file is mapped with readahead disabled after its pages have been
+/// dropped from the page cache, so the resident page count after the run is
+/// the number of distinct pages the VM touched.
+//===----------------------------------------------------------------------===//
+
+#include "hermes/BCGen/HBC/BytecodeDataProvider.h"
+#include "hermes/VM/Callable.h"
+#include "hermes/VM/Runtime.h"
+
+#include "llvh/Support/CommandLine.h"
+#include "llvh/Support/Format.h"
+#include "llvh/Support/InitLLVM.h"
+#include "llvh/Support/raw_ostream.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+using namespace hermes;
+using namespace hermes::vm;
+
+static llvh::cl::list<std::string> InputFilenames(
+    llvh::cl::desc("input bytecode files"),
+    llvh::cl::Positional,
+    llvh::cl::OneOrMore);
+
+static llvh::cl::opt<unsigned> Repeat(
+    "repeat",
+    llvh::cl::init(1),
+    llvh::cl::desc("Number of cold runs of each file to average over"));
+
+#ifndef _WIN32
+
+namespace {
+
+/// A read-only mapping of a whole file, which it owns.
+class MappedBuffer : public Buffer {
+ public:
+  MappedBuffer(const uint8_t *data, size_t size) : Buffer(data, size) {}
+  ~MappedBuffer() override {
+    munmap(const_cast<uint8_t *>(data_), size_);
+  }
+};
+
+/// What one cold run of a file cost.
+struct RunStats {
+  /// Pages of the file resident after the run.
+  size_t filePages;
+  /// Page faults taken by the process during the run.
+  long minorFaults;
+  long majorFaults;
+};
+
+/// \return the number of resident pages in [data, data + size).
+size_t residentPages(const uint8_t *data, size_t size) {
+  const size_t PS = getpagesize();
+  std::vector<unsigned char> vec((size + PS - 1) / PS);
+  if (mincore(const_cast<uint8_t *>(data), size, vec.data()) != 0) {
+    return 0;
+  }
+  size_t count = 0;
+  for (unsigned char c : vec) {
+    count += c & 1;
+  }
+  return count;
+}
+
+/// Run the bytecode file at \p path once, after evicting it from the page
+/// cache. \return whether the run succeeded.
+bool coldRun(const std::string &path, RunStats &stats) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    llvh::errs() << "Error! Failed to open file: " << path << "\n";
+    return false;
+  }
+  off_t size = lseek(fd, 0, SEEK_END);
+  // Dropping the pages only works for clean pages that nobody else maps.
+  fdatasync(fd);
+  posix_fadvise(fd, 0, size, POSIX_FADV_DONTNEED);
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    llvh::errs() << "Error! Failed to map file: " << path << "\n";
+    return false;
+  }
+  madvise(addr, size, MADV_RANDOM);
+  const auto *data = static_cast<const uint8_t *>(addr);
+
+  auto ret = hbc::BCProviderFromBuffer::createBCProviderFromBuffer(
+      std::make_unique<MappedBuffer>(data, size));
+  if (!ret.first) {
+    llvh::errs() << path << ": " << ret.second << "\n";
+    return false;
+  }
+
+  struct rusage before, after;
+  getrusage(RUSAGE_SELF, &before);
+  std::shared_ptr<Runtime> runtime = Runtime::create(RuntimeConfig{});
+  bool ok;
+  {
+    GCScope scope{*runtime};
+    RuntimeModuleFlags flags;
+    flags.persistent = true;
+    CallResult<HermesValue> status = runtime->runBytecode(
+        std::move(ret.first),
+        flags,
+        path,
+        Runtime::makeNullHandle<Environment>());
+    ok = status != ExecutionStatus::EXCEPTION;
+    if (!ok) {
+      runtime->printException(
+          llvh::errs(), runtime->makeHandle(runtime->getThrownValue()));
+    }
+  }
+  getrusage(RUSAGE_SELF, &after);
+
+  // The runtime keeps the mapping alive, so count its pages before the
+  // runtime goes away.
+  stats.filePages = residentPages(data, size);
+  stats.minorFaults = after.ru_minflt - before.ru_minflt;
+  stats.majorFaults = after.ru_majflt - before.ru_majflt;
+  return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  llvh::InitLLVM initLLVM(argc, argv);
+  llvh::cl::ParseCommandLineOptions(argc, argv, "Bytecode page faults\n");
+
+  llvh::outs() << llvh::format(
+      "%-40s %10s %10s %10s\n",
+      (const char *)"file",
+      (const char *)"pages",
+      (const char *)"minflt",
+      (const char *)"majflt");
+  for (const std::string &path : InputFilenames) {
+    RunStats total{0, 0, 0};
+    for (unsigned i = 0; i < Repeat; ++i) {
+      RunStats stats;
+      if (!coldRun(path, stats)) {
+        return 1;
+      }
+      total.filePages += stats.filePages;
+      total.minorFaults += stats.minorFaults;
+      total.majorFaults += stats.majorFaults;
+    }
+    llvh::outs() << llvh::format(
+        "%-40s %10zu %10ld %10ld\n",
+        path.c_str(),
+        total.filePages / Repeat,
+        total.minorFaults / (long)Repeat,
+        total.majorFaults / (long)Repeat);
+  }
+  return 0;
+}
+
+#else
+
+int main(int argc, char **argv) {
+  llvh::InitLLVM initLLVM(argc, argv);
+  llvh::cl::ParseCommandLineOptions(argc, argv, "Bytecode page faults\n");
+  llvh::errs() << "page-faults requires a POSIX system\n";
+  return 1;
+}
+
+#endif
@@ -0,0 +1,23 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Searching a long string which does not match, where a backtracking search
+// rescans the rest of the input from every start position.
+(function() {
+  var numIter = 20;
+  var len = 2000;
+  var s = 'ab'.repeat(len);
+  var rx = /(a|b)*[cd]/;
+
+  for (var i = 0; i < numIter; i++) {
+    rx.exec(s);
+  }
+
+  print('done');
+})();
@@ -0,0 +1,24 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// A quantifier nested in a quantifier, which backtracking matches in time
+// exponential in the length of a line that almost matches.
+(function() {
+  var numIter = 200;
+  var rx = /^(\w+\s?)*$/;
+  var good = 'lorem ipsum dolor sit amet '.repeat(40);
+  var bad = 'aaaa bbbb cccc dddd!';
+
+  for (var i = 0; i < numIter; i++) {
+    rx.test(good);
+    rx.test(bad);
+  }
+
+  print('done');
+})();
@@ -0,0 +1,31 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Builds HTML by wrapping and prepending, which cannot append to a shared
+// concatenation buffer.
+(function () {
+  var numIter = 20;
+  var item = 'lorem ipsum dolor sit amet, consectetur adipiscing elit '.repeat(
+    5,
+  );
+
+  function render(depth) {
+    if (depth === 0) return '<li>' + item + '</li>';
+    return '<ul>' + render(depth - 1) + render(depth - 1) + '</ul>';
+  }
+
+  var total = 0;
+  for (var i = 0; i < numIter; i++) {
+    var html = render(10);
+    var log = '';
+    for (var j = 0; j < 3000; j++) log = '<p>' + j + '</p>' + log + item;
+    total += html.length + log.length + html.charCodeAt(i) + log.charCodeAt(i);
+  }
+  print(total);
+})();
@@ -0,0 +1,40 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Splits a large payload into lines and slices fields out of each line, which
+// is dominated by creating the substrings.
+(function () {
+  var numIter = 200;
+  var lines = [];
+  for (var i = 0; i < 5000; i++) {
+    lines.push(
+      'record ' +
+        i +
+        '\t' +
+        'lorem ipsum dolor sit amet, consectetur adipiscing elit '.repeat(3) +
+        '\t' +
+        '/api/v1/items/' +
+        i +
+        '/details?format=json&fields=name,description,price',
+    );
+  }
+  var payload = lines.join('\n');
+
+  var total = 0;
+  for (var i = 0; i < numIter; i++) {
+    var rows = payload.split('\n');
+    for (var j = 0; j < rows.length; j++) {
+      var row = rows[j];
+      var tab = row.indexOf('\t');
+      var rest = row.slice(tab + 1);
+      total += rest.length + rest.substring(0, rest.indexOf('\t')).length;
+    }
+  }
+  print(total);
+})();
@@ -142,6 +142,9 @@ int main(int argc, char **argv) {
           .withES6Class(ES6Class)
           .withIntl(cl::Intl)
           .withMicrotaskQueue(cl::MicrotaskQueue)
+          .withEnableJIT(cl::JIT)
+          .withJITThreshold(cl::JITThreshold)
+          .withRegExpEngine(cl::RegExpEngine)
           .withTrackIO(cl::TrackBytecodeIO)
           .withEnableHermesInternal(cl::EnableHermesInternal)
           .withEnableHermesInternalTestMethods(
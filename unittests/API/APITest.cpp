@@ -416,6 +416,66 @@ TEST(HermesRootsTest, DontGrowWhenCloneObject) {
   EXPECT_EQ(rootsDelta, 0);
 }
 
+TEST(HermesStringifyToTest, StreamsChunks) {
+  auto rt = makeHermesRuntime();
+  auto eval = [&](const char *code) {
+    return rt->global().getPropertyAsFunction(*rt, "eval").call(*rt, code);
+  };
+  auto stringify = [&](const Value &val) {
+    return rt->global()
+        .getPropertyAsObject(*rt, "JSON")
+        .getPropertyAsFunction(*rt, "stringify")
+        .call(*rt, val)
+        .getString(*rt)
+        .utf8(*rt);
+  };
+
+  std::string out;
+  size_t numChunks = 0;
+  auto sink = [&](const char *data, size_t length) {
+    out.append(data, length);
+    ++numChunks;
+  };
+
+  Value small =
+      eval("({a: [1, 'x', null], b: {c: true}, \\u00e9: '\\u{1F600}'})");
+  EXPECT_TRUE(rt->stringifyTo(small, sink));
+  EXPECT_EQ(stringify(small), out);
+  EXPECT_EQ(1u, numChunks);
+
+  // A large value is passed in several chunks.
+  out.clear();
+  numChunks = 0;
+  Value large = eval(
+      "Array.from({length: 10000}, (_, i) => ({id: i, name: 'item ' + i}))");
+  EXPECT_TRUE(rt->stringifyTo(large, sink));
+  EXPECT_EQ(stringify(large), out);
+  EXPECT_GT(numChunks, 1u);
+
+  // Values without a JSON representation produce no output.
+  out.clear();
+  numChunks = 0;
+  EXPECT_FALSE(rt->stringifyTo(Value::undefined(), sink));
+  EXPECT_EQ(0u, numChunks);
+
+  // JS exceptions are propagated.
+  EXPECT_THROW(
+      rt->stringifyTo(eval("({toJSON() { throw 1; }})"), sink), JSError);
+  EXPECT_THROW(rt->stringifyTo(eval("[1n]"), sink), JSError);
+
+  // So are exceptions thrown by the sink, which stop the serialization.
+  numChunks = 0;
+  EXPECT_THROW(
+      rt->stringifyTo(
+          large,
+          [&](const char *, size_t) {
+            ++numChunks;
+            throw std::runtime_error("sink");
+          }),
+      std::runtime_error);
+  EXPECT_EQ(1u, numChunks);
+}
+
 TEST(HermesWatchTimeLimitTest, WatchTimeLimit) {
   // Some code that exercies the async break checks.
   const char *forABit = "var t = Date.now(); while (Date.now() < t + 100) {}";
@@ -544,5 +544,72 @@ TEST(HBCBytecodeGen, BytecodeOptionHasAsync) {
   EXPECT_TRUE(bytecodeHasAsync->getBytecodeOptions().hasAsync);
 }
 
+TEST(HBCBytecodeGen, LayoutProfile) {
+  const char *source = R"(
+    function a() { return 1; }
+    function b() { return 'b'; }
+    function c(x) { return x + 1; }
+    function d(x, y) { return x * y; }
+  )";
+  auto bytecodeVecDefault = bytecodeForSource(source);
+  auto bytecodeDefault = hbc::BCProviderFromBuffer::createBCProviderFromBuffer(
+                             std::make_unique<VectorBuffer>(bytecodeVecDefault))
+                             .first;
+  ASSERT_TRUE(bytecodeDefault);
+  const uint32_t count = bytecodeDefault->getFunctionCount();
+  ASSERT_EQ(count, 5u);
+  for (uint32_t i = 1; i < count; ++i) {
+    EXPECT_LT(
+        bytecodeDefault->getFunctionHeader(i - 1).offset(),
+        bytecodeDefault->getFunctionHeader(i).offset());
+  }
+
+  // Functions 3 and 1 were executed, in that order.
+  auto coverage = std::make_shared<BytecodeLayoutProfile>();
+  for (uint32_t id : {3, 1}) {
+    coverage->executedFunctions.push_back(
+        {0, bytecodeDefault->getVirtualOffsetForFunction(id)});
+  }
+  BytecodeGenerationOptions opts = BytecodeGenerationOptions::defaults();
+  opts.layoutProfile = coverage;
+  auto bytecodeVecCoverage = bytecodeForSource(source, opts);
+  auto bytecodeCoverage =
+      hbc::BCProviderFromBuffer::createBCProviderFromBuffer(
+          std::make_unique<VectorBuffer>(bytecodeVecCoverage))
+          .first;
+  ASSERT_TRUE(bytecodeCoverage);
+  ASSERT_EQ(bytecodeCoverage->getFunctionCount(), count);
+  // The profiled functions come first, then the rest in ID order.
+  uint32_t expectedOrder[] = {3, 1, 0, 2, 4};
+  for (uint32_t i = 1; i < count; ++i) {
+    EXPECT_LT(
+        bytecodeCoverage->getFunctionHeader(expectedOrder[i - 1]).offset(),
+        bytecodeCoverage->getFunctionHeader(expectedOrder[i]).offset());
+  }
+  // Reordering doesn't change function IDs, so the virtual offsets match.
+  for (uint32_t i = 0; i < count; ++i) {
+    EXPECT_EQ(
+        bytecodeCoverage->getVirtualOffsetForFunction(i),
+        bytecodeDefault->getVirtualOffsetForFunction(i));
+  }
+
+  // A one byte page holding the start of function 4 was accessed.
+  auto trackIO = std::make_shared<BytecodeLayoutProfile>();
+  trackIO->pageSize = 1;
+  trackIO->accessedPages.push_back(
+      bytecodeDefault->getFunctionHeader(4).offset());
+  opts.layoutProfile = trackIO;
+  auto bytecodeVecTrackIO = bytecodeForSource(source, opts);
+  auto bytecodeTrackIO = hbc::BCProviderFromBuffer::createBCProviderFromBuffer(
+                             std::make_unique<VectorBuffer>(bytecodeVecTrackIO))
+                             .first;
+  ASSERT_TRUE(bytecodeTrackIO);
+  for (uint32_t i = 0; i < 4; ++i) {
+    EXPECT_LT(
+        bytecodeTrackIO->getFunctionHeader(4).offset(),
+        bytecodeTrackIO->getFunctionHeader(i).offset());
+  }
+}
+
 } // end anonymous namespace
 #undef DEBUG_TYPE
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Regex/NFA.h"
+#include "hermes/Regex/Executor.h"
+#include "hermes/Regex/Regex.h"
+#include "hermes/Regex/RegexTraits.h"
+
+#include <string>
+#include "gtest/gtest.h"
+
+using namespace hermes::regex;
+
+namespace {
+
+using cregex = Regex<UTF16RegexTraits>;
+
+// Flatten a search result into a string representation like:
+// "(0-5) (1-3) nm"
+std::string flatten(
+    MatchRuntimeResult result,
+    const std::vector<CapturedRange> &ranges) {
+  if (result == MatchRuntimeResult::NoMatch)
+    return "no match";
+  if (result == MatchRuntimeResult::StackOverflow)
+    return "stack overflow";
+  std::string str;
+  for (const auto &range : ranges) {
+    if (!str.empty())
+      str += " ";
+    if (!range.matched()) {
+      str += "nm";
+    } else {
+      str += '(';
+      str += std::to_string(range.start);
+      str += '-';
+      str += std::to_string(range.end);
+      str += ')';
+    }
+  }
+  return str;
+}
+
+/// \return \p str with non-ASCII characters replaced by '?', for messages.
+std::string toASCII(const std::u16string &str) {
+  std::string result;
+  for (char16_t c : str)
+    result += c < 128 ? (char)c : '?';
+  return result;
+}
+
+std::vector<uint8_t> compile(const char16_t *pattern, const char16_t *flags) {
+  cregex re(pattern, flags);
+  EXPECT_TRUE(re.valid());
+  return re.compile();
+}
+
+/// All strings over \p alphabet with length at most \p maxLength.
+std::vector<std::u16string> allStrings(
+    const std::u16string &alphabet,
+    size_t maxLength) {
+  std::vector<std::u16string> result{u""};
+  for (size_t i = 0; i < result.size(); ++i) {
+    if (result[i].size() == maxLength)
+      continue;
+    for (char16_t c : alphabet)
+      result.push_back(result[i] + c);
+  }
+  return result;
+}
+
+/// Search every string in \p texts from every start offset, with both the
+/// backtracking executor and the NFA, and expect the same results. ASCII
+/// texts are searched both as UTF-16 and as ASCII.
+void expectSameAsBacktracking(
+    const char16_t *pattern,
+    const char16_t *flags,
+    const std::vector<std::u16string> &texts) {
+  SCOPED_TRACE("/" + toASCII(pattern) + "/" + toASCII(flags));
+  auto bytecode = compile(pattern, flags);
+  auto program = NFAProgram::fromBytecode(bytecode);
+  ASSERT_TRUE(program != nullptr);
+
+  std::vector<CapturedRange> expected, actual;
+  for (const std::u16string &text : texts) {
+    bool ascii = std::all_of(
+        text.begin(), text.end(), [](char16_t c) { return c < 128; });
+    std::string narrow = toASCII(text);
+    auto length = (uint32_t)text.size();
+    for (uint32_t start = 0; start <= length; ++start) {
+      for (auto flag :
+           {constants::matchDefault, constants::matchOnlyAtStart}) {
+        auto expectedResult = searchWithBytecode(
+            bytecode, text.data(), start, length, &expected, flag);
+        auto actualResult = searchWithNFA(
+            *program, text.data(), start, length, &actual, flag);
+        ASSERT_EQ(
+            flatten(expectedResult, expected), flatten(actualResult, actual))
+            << "text \"" << narrow << "\" start " << start;
+        if (!ascii)
+          continue;
+        flag |= constants::matchInputAllAscii;
+        actualResult = searchWithNFA(
+            *program, narrow.data(), start, length, &actual, flag);
+        ASSERT_EQ(
+            flatten(expectedResult, expected), flatten(actualResult, actual))
+            << "ASCII text \"" << narrow << "\" start " << start;
+        // Searches which do not need captures may be answered by the DFA
+        // alone.
+        ASSERT_EQ(
+            expectedResult,
+            searchWithNFA(
+                *program, narrow.data(), start, length, nullptr, flag));
+      }
+    }
+  }
+}
+
+TEST(RegexNFA, Eligibility) {
+  for (const char16_t *pattern :
+       {u"a", u"(a)|b", u"(a+)+", u"[^a-z]*\\s", u"^a$", u"\\bx"}) {
+    EXPECT_TRUE(NFAProgram::fromBytecode(compile(pattern, u"")) != nullptr);
+  }
+  // Backreferences, lookarounds, unicode mode, loops whose optional
+  // iterations may be empty, and huge counted loops are not supported.
+  EXPECT_EQ(nullptr, NFAProgram::fromBytecode(compile(u"(a)\\1", u"")));
+  EXPECT_EQ(nullptr, NFAProgram::fromBytecode(compile(u"a(?=b)", u"")));
+  EXPECT_EQ(nullptr, NFAProgram::fromBytecode(compile(u"(?<!b)a", u"")));
+  EXPECT_EQ(nullptr, NFAProgram::fromBytecode(compile(u"a", u"u")));
+  EXPECT_EQ(nullptr, NFAProgram::fromBytecode(compile(u"(a*)*", u"")));
+  EXPECT_EQ(nullptr, NFAProgram::fromBytecode(compile(u"(ab){99999}", u"")));
+}
+
+TEST(RegexNFA, BacktrackingIsRisky) {
+  for (const char16_t *pattern :
+       {u"(a+)+", u"(a|ab)*c", u"(?:\\w+\\s?)*$", u"(x{2,}y)+"}) {
+    EXPECT_TRUE(
+        NFAProgram::fromBytecode(compile(pattern, u""))->backtrackingIsRisky());
+  }
+  for (const char16_t *pattern :
+       {u"a+b+", u"(ab)+", u"a|b|c", u"(a|b){3}", u"(a+)?"}) {
+    EXPECT_FALSE(
+        NFAProgram::fromBytecode(compile(pattern, u""))->backtrackingIsRisky());
+  }
+}
+
+TEST(RegexNFA, SameAsBacktracking) {
+  auto texts = allStrings(u"abc", 6);
+  for (const char16_t *pattern :
+       {u"a",
+        u"ab",
+        u"a|b",
+        u"a*",
+        u"a+?",
+        u"a*?b",
+        u"(a)*",
+        u"(a|b)*c",
+        u"(a+)+b",
+        u"(a|ab)*c",
+        u"(a|ab)(c|bcd)?",
+        u"^a*$",
+        u"^(a|b)+$",
+        u"a{2,3}",
+        u"(a){2,3}?",
+        u"(ab){1,}",
+        u"(?:a|b){0,2}b",
+        u"[ab]+",
+        u"[^a]*",
+        u"\\w+\\W?",
+        u"\\bab\\b",
+        u"\\Bb",
+        u"a.b",
+        u"^ab|ba$",
+        u"(a)|(b)",
+        u"((a)|b)+",
+        u"(a(b)?)+",
+        u"c*(a|b)?",
+        u"a{0,2}?b",
+        u"(a+|b+)*c",
+        u"(?:(a)|(b)|c){2}",
+        u"$",
+        u"^",
+        u"b|$"}) {
+    expectSameAsBacktracking(pattern, u"", texts);
+  }
+  for (const char16_t *pattern : {u"AB", u"[a-b]+C", u"(B|C)*"}) {
+    expectSameAsBacktracking(pattern, u"i", texts);
+  }
+}
+
+TEST(RegexNFA, Multiline) {
+  auto texts = allStrings(u"ab\n", 5);
+  for (const char16_t *pattern : {u"^b", u"a$", u"^$", u"(^a|b$)+", u"a.*"}) {
+    expectSameAsBacktracking(pattern, u"", texts);
+    expectSameAsBacktracking(pattern, u"m", texts);
+  }
+}
+
+TEST(RegexNFA, NonASCII) {
+  auto texts = allStrings(u"a\u00E9 \u0130", 4);
+  for (const char16_t *pattern :
+       {u"\u00E9+", u"[^a]", u"\u00C9", u".a", u"[\u00E0-\u00FF]*a"}) {
+    expectSameAsBacktracking(pattern, u"", texts);
+    expectSameAsBacktracking(pattern, u"i", texts);
+  }
+}
+
+TEST(RegexNFA, Linear) {
+  // These take exponential time to fail with backtracking.
+  std::string text(5000, 'a');
+  text += '!';
+  for (const char16_t *pattern :
+       {u"^(a+)+$", u"(a|aa)+$", u"^(a|a)+b", u"^(\\w+\\s?)*$"}) {
+    auto program = NFAProgram::fromBytecode(compile(pattern, u""));
+    ASSERT_TRUE(program != nullptr);
+    std::vector<CapturedRange> captures;
+    EXPECT_EQ(
+        MatchRuntimeResult::NoMatch,
+        searchWithNFA(
+            *program,
+            text.data(),
+            0,
+            text.size(),
+            &captures,
+            constants::matchInputAllAscii));
+  }
+
+  // A match found after a long run of threads.
+  auto program = NFAProgram::fromBytecode(compile(u"(a|aa)+(!)", u""));
+  ASSERT_TRUE(program != nullptr);
+  std::vector<CapturedRange> captures;
+  EXPECT_EQ(
+      MatchRuntimeResult::Match,
+      searchWithNFA(
+          *program,
+          text.data(),
+          0,
+          text.size(),
+          &captures,
+          constants::matchDefault));
+  EXPECT_EQ(
+      "(0-5001) (4999-5000) (5000-5001)",
+      flatten(MatchRuntimeResult::Match, captures));
+}
+
+TEST(RegexNFA, ManyDFAStates) {
+  // The DFA for this needs a state for each combination of the last nine
+  // characters, more than it caches at once.
+  auto bytecode = compile(u"[ab]*a[ab]{8}c", u"");
+  auto program = NFAProgram::fromBytecode(bytecode);
+  ASSERT_TRUE(program != nullptr);
+  std::u16string text;
+  for (uint32_t i = 0, x = 1; i < 3000; ++i, x = x * 1103515245 + 12345)
+    text += (x >> 16) & 1 ? u'a' : u'b';
+  std::vector<CapturedRange> expected, actual;
+  for (const std::u16string &str : {text, text + u"c"}) {
+    auto length = (uint32_t)str.size();
+    auto expectedResult = searchWithBytecode(
+        bytecode, str.data(), 0, length, &expected, constants::matchDefault);
+    auto actualResult = searchWithNFA(
+        *program, str.data(), 0, length, &actual, constants::matchDefault);
+    EXPECT_EQ(
+        flatten(expectedResult, expected), flatten(actualResult, actual));
+  }
+}
+
+} // namespace
@@ -821,4 +821,73 @@ TEST(Regex, NonASCII) {
       constants::matchInputAllAscii));
 }
 
+/// \return a description of the literals in the header of the compiled
+/// \p pattern, like "2:abc|def" for an anchored literal "abc" at offset 2 and
+/// a floating literal "def".
+static std::u16string regexLiterals(
+    const char16_t *pattern,
+    const char16_t *flags = u"") {
+  std::vector<uint8_t> bytecode = cregex(pattern, flags).compile();
+  RegexBytecodeHeader header;
+  memcpy(&header, bytecode.data(), sizeof(header));
+  std::u16string literals(
+      header.anchoredLiteralLength + header.floatingLiteralLength, u'\0');
+  memcpy(
+      &literals[0],
+      bytecode.data() + sizeof(header),
+      literals.size() * sizeof(char16_t));
+  std::u16string result;
+  if (header.anchoredLiteralLength) {
+    for (char c : std::to_string(header.anchoredLiteralOffset))
+      result += c;
+    result += u':';
+    result += literals.substr(0, header.anchoredLiteralLength);
+  }
+  result += u'|';
+  result += literals.substr(header.anchoredLiteralLength);
+  return result;
+}
+
+TEST(Regex, Literals) {
+  EXPECT_EQ(u"0:abc|", regexLiterals(u"abc"));
+  EXPECT_EQ(u"2:foo|", regexLiterals(u"\\d.foo"));
+  EXPECT_EQ(u"0:ab|", regexLiterals(u"(ab)+c*"));
+  EXPECT_EQ(u"|", regexLiterals(u"(ab)*"));
+  EXPECT_EQ(u"|", regexLiterals(u"a|b"));
+  EXPECT_EQ(u"|", regexLiterals(u"abc", u"i"));
+  // The rarer literal is preferred, and a rarer literal at an unknown offset
+  // is kept as the floating literal.
+  EXPECT_EQ(u"0:ab|X=1", regexLiterals(u"ab\\w*X=1"));
+  EXPECT_EQ(u"2:X=1|", regexLiterals(u"a\\dX=1\\w*ab"));
+  // Unicode brackets may match a surrogate pair, so the offset is unknown.
+  EXPECT_EQ(u"0:a|bc", regexLiterals(u"a.bc", u"u"));
+  // Astral characters are stored as their surrogate pairs.
+  EXPECT_EQ(u"0:\U0001F600|", regexLiterals(u"\U0001F600", u"u"));
+}
+
+TEST(Regex, LiteralSkipping) {
+  cmatch m;
+  // Matches in long inputs, at and around vector boundaries.
+  for (size_t pos = 0; pos < 40; ++pos) {
+    std::u16string text(40, u'f');
+    text.replace(pos, 0, u"foo1");
+    EXPECT_TRUE(search(text, m, cregex(u"\\w{2}o1")));
+    EXPECT_EQ(pos, m[0].start);
+    EXPECT_TRUE(search(text, m, cregex(u"f+oo1")));
+    EXPECT_EQ(0u, m[0].start);
+  }
+  EXPECT_FALSE(search(u"fo1 foo fo1", m, cregex(u"\\w{2}o1")));
+  EXPECT_FALSE(search(u"foo1", m, cregex(u"\\w{3}o1")));
+
+  // A match never starts between the halves of a surrogate pair in Unicode
+  // mode, even if the literal would allow it.
+  EXPECT_TRUE(search(u"\U0001F600x", m, cregex(u"[^a]x", u"u")));
+  EXPECT_EQ("(0-3)", flatten(m));
+  EXPECT_TRUE(search(u"\U0001F600x", m, cregex(u"[^a]x")));
+  EXPECT_EQ("(1-3)", flatten(m));
+  EXPECT_FALSE(search(u"\U0001F600", m, cregex(u"\\uDE00", u"u")));
+  EXPECT_TRUE(search(u"\U0001F600", m, cregex(u"\\uDE00")));
+  EXPECT_EQ("(1-2)", flatten(m));
+}
+
 } // end anonymous namespace
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/StringKernels.h"
+
+#include <algorithm>
+#include <string>
+
+#include "gtest/gtest.h"
+
+using namespace hermes;
+
+namespace {
+
+/// Check findCodeUnit and findSubstring against std::search for every needle
+/// position in a haystack long enough to cover the vector loops and their
+/// scalar tails.
+template <typename CharT>
+void checkAllPositions() {
+  const std::basic_string<CharT> needles[] = {
+      {CharT('x')},
+      {CharT('x'), CharT('y')},
+      {CharT('x'), CharT('a'), CharT('y')},
+      std::basic_string<CharT>(20, CharT('q')) + CharT('x'),
+  };
+  for (const auto &needle : needles) {
+    for (size_t len = 0; len < 70; ++len) {
+      for (size_t pos = 0; pos + needle.size() <= len; ++pos) {
+        // Fill with partial matches of the needle to exercise the full
+        // comparison of candidates.
+        std::basic_string<CharT> hay(len, CharT('a'));
+        for (size_t i = 0; i + 1 < len; i += 3)
+          hay[i] = needle.front();
+        hay.replace(pos, needle.size(), needle);
+        const CharT *first = hay.data();
+        const CharT *last = first + hay.size();
+        const CharT *expected =
+            std::search(first, last, needle.begin(), needle.end());
+        EXPECT_EQ(
+            expected,
+            findSubstring(first, last, {needle.data(), needle.size()}));
+        if (needle.size() == 1)
+          EXPECT_EQ(expected, findCodeUnit(first, last, needle.front()));
+      }
+      // No occurrence at all.
+      std::basic_string<CharT> hay(len, CharT('a'));
+      const CharT *first = hay.data();
+      const CharT *last = first + hay.size();
+      EXPECT_EQ(
+          last, findSubstring(first, last, {needle.data(), needle.size()}));
+    }
+  }
+}
+
+TEST(StringKernelsTest, Char) {
+  checkAllPositions<char>();
+}
+
+TEST(StringKernelsTest, Char16) {
+  checkAllPositions<char16_t>();
+}
+
+TEST(StringKernelsTest, EdgeCases) {
+  const std::u16string hay = u"abc\xFFFF\x8000";
+  const char16_t *first = hay.data();
+  const char16_t *last = first + hay.size();
+  // An empty needle is found at the start.
+  EXPECT_EQ(first, findSubstring(first, last, {}));
+  // A needle longer than the haystack is never found.
+  const std::u16string longNeedle = hay + u"d";
+  EXPECT_EQ(
+      last,
+      findSubstring(first, last, {longNeedle.data(), longNeedle.size()}));
+  // Code units with the top bit set compare correctly.
+  EXPECT_EQ(first + 3, findCodeUnit(first, last, u'\xFFFF'));
+  const std::u16string high = u"\xFFFF\x8000";
+  EXPECT_EQ(first + 3, findSubstring(first, last, {high.data(), high.size()}));
+  const std::string bytes = "ab\xFF\x80";
+  EXPECT_EQ(
+      bytes.data() + 2,
+      findCodeUnit(bytes.data(), bytes.data() + bytes.size(), '\xFF'));
+}
+
+TEST(StringKernelsTest, JSONStringSpecial) {
+  // Each special code unit, and code units that only differ from one in
+  // their high bits, at every position.
+  for (char16_t special : {u'"', u'\\', u'\0', u'\n', u'\x1F'}) {
+    for (size_t len = 1; len < 40; ++len) {
+      for (size_t pos = 0; pos < len; ++pos) {
+        std::u16string str(len, u'a');
+        for (size_t i = 0; i < len; i += 2)
+          str[i] = i % 4 ? u'\x20' : u'\xFF1F';
+        str[pos] = special;
+        const char16_t *first = str.data();
+        EXPECT_EQ(first + pos, findJSONStringSpecial(first, first + len));
+      }
+    }
+  }
+  const std::u16string plain = u"plain text \x7F\x80\xFFFF with no specials";
+  const char16_t *first = plain.data();
+  const char16_t *last = first + plain.size();
+  EXPECT_EQ(last, findJSONStringSpecial(first, last));
+}
+
+} // end anonymous namespace
@@ -180,4 +180,34 @@ TEST_F(ArrayTest, TestLength) {
   EXPECT_CALLRESULT_DOUBLE(
       5.0, JSObject::getNamed_RJS(array, runtime, lengthID));
 }
+
+TEST_F(ArrayTest, StorageAllocatedWithArraySurvivesCollection) {
+  GCScope scope(runtime);
+  // Arrays with a non-zero capacity have their element storage allocated
+  // together with the array. Make sure both stay valid across collections.
+  constexpr uint32_t kNumArrays = 1000;
+  auto arrayRes = JSArray::create(runtime, kNumArrays, kNumArrays);
+  ASSERT_FALSE(isException(arrayRes));
+  auto arrays = *arrayRes;
+  auto marker = scope.createMarker();
+  for (uint32_t i = 0; i < kNumArrays; ++i) {
+    scope.flushToMarker(marker);
+    auto res = JSArray::create(runtime, 4, 4);
+    ASSERT_FALSE(isException(res));
+    Handle<JSArray> elem = *res;
+    JSArray::setElementAt(
+        elem,
+        runtime,
+        3,
+        runtime.makeHandle(HermesValue::encodeTrustedNumberValue(i)));
+    JSArray::setElementAt(arrays, runtime, i, elem);
+  }
+  runtime.collect("test");
+  for (uint32_t i = 0; i < kNumArrays; ++i) {
+    auto *arr = vmcast<JSArray>(arrays->at(runtime, i).getObject(runtime));
+    ASSERT_EQ(4u, JSArray::getLength(arr, runtime));
+    EXPECT_EQ(
+        static_cast<double>(i), arr->at(runtime, 3).getNumber(runtime));
+  }
+}
 } // namespace
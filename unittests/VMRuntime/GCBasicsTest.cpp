@@ -357,6 +357,147 @@ TEST(GCCallbackTest, TestCallbackInvoked) {
   }
 }
 
+#if defined(HERMESVM_GC_HADES) || defined(HERMESVM_GC_RUNTIME)
+TEST(GCBasicsTestParallelMark, ChainSurvivesParallelMarking) {
+  const GCConfig config =
+      GCConfig::Builder(kTestGCConfigBuilder).withNumMarkerThreads(4).build();
+  auto runtime = DummyRuntime::create(config);
+  DummyRuntime &rt = *runtime;
+  GCScope scope{rt};
+
+  // Build a long chain interleaved with garbage, so that the marker threads
+  // have to share work and race on mark bits.
+  constexpr size_t kChainLength = 20000;
+  MutableHandle<DummyObject> head{rt, DummyObject::create(rt.getHeap(), rt)};
+  for (size_t i = 1; i < kChainLength; ++i) {
+    auto *obj = DummyObject::create(rt.getHeap(), rt);
+    obj->setPointer(rt.getHeap(), *head);
+    head = obj;
+    DummyObject::create(rt.getHeap(), rt);
+  }
+  rt.collect();
+  rt.collect();
+
+  size_t length = 0;
+  for (DummyObject *cur = *head; cur; cur = cur->other.get(rt))
+    ++length;
+  EXPECT_EQ(kChainLength, length);
+}
+
+TEST(GCBasicsTestParallelEvacuation, ChainSurvivesParallelEvacuation) {
+  const GCConfig config = GCConfig::Builder(kTestGCConfigBuilder)
+                              .withMaxHeapSize(kMaxHeapLarge)
+                              .withNumEvacuationThreads(4)
+                              .build();
+  auto runtime = DummyRuntime::create(config);
+  DummyRuntime &rt = *runtime;
+  GCScope scope{rt};
+
+  // Grow a chain from its tail, interleaved with garbage, so that the YG
+  // collections along the way find the new part of the chain through dirty
+  // cards in the OG, as well as through the roots.
+  constexpr size_t kChainLength = 50000;
+  auto head = rt.makeHandle(DummyObject::create(rt.getHeap(), rt));
+  MutableHandle<DummyObject> tail{rt, *head};
+  for (size_t i = 1; i < kChainLength; ++i) {
+    auto *obj = DummyObject::create(rt.getHeap(), rt);
+    tail->setPointer(rt.getHeap(), obj);
+    tail = obj;
+    DummyObject::create(rt.getHeap(), rt);
+  }
+  rt.collect();
+
+  size_t length = 0;
+  for (DummyObject *cur = *head; cur; cur = cur->other.get(rt))
+    ++length;
+  EXPECT_EQ(kChainLength, length);
+}
+
+TEST(GCBasicsTestParallelSweep, DeadCellsFinalizedByParallelSweep) {
+  size_t numFinalized = 0;
+  const GCConfig config = GCConfig::Builder(kTestGCConfigBuilder)
+                              .withMaxHeapSize(kMaxHeapLarge)
+                              .withNumSweeperThreads(4)
+                              .build();
+  auto runtime = DummyRuntime::create(config);
+  DummyRuntime &rt = *runtime;
+  GCScope scope{rt};
+
+  // Promote a chain spanning several OG segments, then cut every other object
+  // out of it, so that each segment has dead cells to finalize and free.
+  constexpr size_t kChainLength = 50000;
+  MutableHandle<DummyObject> head{rt};
+  for (size_t i = 0; i < kChainLength; ++i) {
+    auto *obj = DummyObject::create(rt.getHeap(), rt);
+    obj->finalizerCallback.set(
+        rt.getHeap(),
+        new DummyObject::Callback([&numFinalized] { ++numFinalized; }));
+    obj->setPointer(rt.getHeap(), *head);
+    head = obj;
+  }
+  rt.collect();
+  EXPECT_EQ(0u, numFinalized);
+
+  for (DummyObject *cur = *head; cur; cur = cur->other.get(rt)) {
+    if (DummyObject *next = cur->other.get(rt))
+      cur->setPointer(rt.getHeap(), next->other.get(rt));
+  }
+  rt.collect();
+  EXPECT_EQ(kChainLength / 2, numFinalized);
+
+  size_t length = 0;
+  for (DummyObject *cur = *head; cur; cur = cur->other.get(rt))
+    ++length;
+  EXPECT_EQ(kChainLength / 2, length);
+}
+
+TEST(GCBasicsTestCompaction, CompactsSeveralSparseSegments) {
+  const GCConfig config = GCConfig::Builder(kTestGCConfigBuilder)
+                              .withMaxHeapSize(1 << 26)
+                              .withMaxCompacteeSegments(4)
+                              .build();
+  auto runtime = DummyRuntime::create(config);
+  DummyRuntime &rt = *runtime;
+  GCScope scope{rt};
+
+  // Promote a chain that fills several OG segments.
+  constexpr size_t kMinSegments = 6;
+  GC::HeapInfo info;
+  size_t chainLength = 0;
+  MutableHandle<DummyObject> head{rt};
+  do {
+    for (size_t i = 0; i < 1000; ++i, ++chainLength) {
+      auto *obj = DummyObject::create(rt.getHeap(), rt);
+      obj->setPointer(rt.getHeap(), *head);
+      head = obj;
+    }
+    rt.getHeap().getHeapInfo(info);
+  } while (info.heapSize < kMinSegments * AlignedStorage::size());
+  rt.collect();
+
+  // Keep only every tenth object alive, leaving every segment sparse.
+  for (DummyObject *cur = *head; cur; cur = cur->other.get(rt)) {
+    DummyObject *next = cur->other.get(rt);
+    for (size_t i = 1; i < 10 && next; ++i)
+      next = next->other.get(rt);
+    cur->setPointer(rt.getHeap(), next);
+  }
+  // The first collection finds out how sparse the segments are, so the next
+  // one can compact more than one of them.
+  rt.collect();
+  rt.getHeap().getHeapInfo(info);
+  const uint64_t sizeBefore = info.heapSize;
+  rt.collect();
+  rt.getHeap().getHeapInfo(info);
+  EXPECT_GE(sizeBefore - info.heapSize, 2 * AlignedStorage::size());
+
+  size_t length = 0;
+  for (DummyObject *cur = *head; cur; cur = cur->other.get(rt))
+    ++length;
+  EXPECT_EQ((chainLength + 9) / 10, length);
+}
+#endif
+
 #ifndef HERMESVM_GC_MALLOC
 using SegmentCell = EmptyCell<AlignedHeapSegment::maxSize()>;
 TEST(GCBasicsTestNCGen, TestIDPersistsAcrossMultipleCollections) {
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/VM/RegExpCache.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+using namespace hermes::vm;
+using hermes::regex::SyntaxFlags;
+
+namespace {
+
+/// \return an entry with \p size bytes of bytecode.
+RegExpCache::Entry makeEntry(size_t size) {
+  RegExpCache::Entry entry;
+  entry.bytecode.resize(size);
+  return entry;
+}
+
+/// \return a pattern which differs for each \p i.
+llvh::ArrayRef<char16_t> patternFor(unsigned i) {
+  static const std::u16string xs(RegExpCache::kMaxEntries, u'x');
+  return llvh::makeArrayRef(xs.data(), i);
+}
+
+/// \return the pattern \p str without its terminating null.
+template <size_t N>
+llvh::ArrayRef<char16_t> pattern(const char16_t (&str)[N]) {
+  return llvh::makeArrayRef(str, N - 1);
+}
+
+TEST(RegExpCacheTest, HitsAndMisses) {
+  RegExpCache cache;
+  auto none = SyntaxFlags::fromByte(0);
+  auto global = none;
+  global.global = 1;
+
+  EXPECT_EQ(nullptr, cache.lookup(pattern(u"abc"), none));
+  cache.insert(pattern(u"abc"), none, makeEntry(10));
+  EXPECT_EQ(1u, cache.getNumMisses());
+
+  RegExpCache::Entry *entry = cache.lookup(pattern(u"abc"), none);
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(10u, entry->bytecode.size());
+  EXPECT_EQ(1u, cache.getNumHits());
+
+  // The flags are part of the key.
+  EXPECT_EQ(nullptr, cache.lookup(pattern(u"abc"), global));
+  EXPECT_EQ(nullptr, cache.lookup(pattern(u"ab"), none));
+  EXPECT_EQ(3u, cache.getNumMisses());
+  EXPECT_EQ(1u, cache.size());
+
+  cache.clear();
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(nullptr, cache.lookup(pattern(u"abc"), none));
+  EXPECT_EQ(1u, cache.getNumHits());
+  EXPECT_EQ(4u, cache.getNumMisses());
+}
+
+TEST(RegExpCacheTest, EvictLeastRecentlyUsed) {
+  RegExpCache cache;
+  auto flags = SyntaxFlags::fromByte(0);
+  for (unsigned i = 0; i < RegExpCache::kMaxEntries; ++i)
+    cache.insert(patternFor(i), flags, makeEntry(1));
+  EXPECT_EQ(RegExpCache::kMaxEntries, cache.size());
+
+  // Use the oldest entry, so that the second oldest is evicted next.
+  EXPECT_NE(nullptr, cache.lookup(patternFor(0), flags));
+  cache.insert(pattern(u"new"), flags, makeEntry(1));
+  EXPECT_EQ(RegExpCache::kMaxEntries, cache.size());
+  EXPECT_NE(nullptr, cache.lookup(patternFor(0), flags));
+  EXPECT_EQ(nullptr, cache.lookup(patternFor(1), flags));
+  EXPECT_NE(nullptr, cache.lookup(patternFor(2), flags));
+  EXPECT_NE(nullptr, cache.lookup(pattern(u"new"), flags));
+}
+
+TEST(RegExpCacheTest, BytecodeSizeLimit) {
+  RegExpCache cache;
+  auto flags = SyntaxFlags::fromByte(0);
+  const size_t half = RegExpCache::kMaxBytecodeSize / 2;
+  cache.insert(pattern(u"a"), flags, makeEntry(half));
+  cache.insert(pattern(u"b"), flags, makeEntry(half));
+  EXPECT_EQ(2u, cache.size());
+
+  // Too large to fit with anything else, but still cached on its own.
+  cache.insert(
+      pattern(u"c"), flags, makeEntry(RegExpCache::kMaxBytecodeSize + 1));
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_NE(nullptr, cache.lookup(pattern(u"c"), flags));
+  EXPECT_GT(cache.getAllocatedSize(), RegExpCache::kMaxBytecodeSize);
+
+  cache.insert(pattern(u"d"), flags, makeEntry(1));
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(nullptr, cache.lookup(pattern(u"c"), flags));
+}
+
+} // namespace
@@ -12,6 +12,7 @@
 
 #include "TestHelpers.h"
 
+#include <algorithm>
 #include <climits>
 #include <random>
 
@@ -271,11 +272,10 @@ TEST_F(StringPrimTest, FastConcatTest) {
   // Append some the first result again.
   cr = StringPrimitive::concat(runtime, resASCII_1, b);
   ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
-  auto resASCII_3 = runtime.makeHandle<BufferedASCIIStringPrimitive>(*cr);
-
-  // The buffer cannot be reused.
-  EXPECT_TRUE(
-      resASCII_3->testGetConcatBuffer() != resASCII_1->testGetConcatBuffer());
+  // The buffer cannot be reused, so the result refers to both strings.
+  auto resASCII_3 = runtime.makeHandle<RopeASCIIStringPrimitive>(*cr);
+  EXPECT_FALSE(resASCII_3->isFlattened());
+  EXPECT_EQ(*resASCII_1, resASCII_3->getLeft());
 
   std::string asciiStr3 = asciiStr1 + strB;
   asciiRef = resASCII_3->getStringRef<char>();
@@ -317,15 +317,127 @@ TEST_F(StringPrimTest, FastConcatTest) {
   // Add some more UTF16 to resUTF_1
   cr = StringPrimitive::concat(runtime, resUTF_1, b);
   ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
-  auto resUTF_3 = runtime.makeHandle<BufferedUTF16StringPrimitive>(*cr);
-
-  // The buffer cannot be reused.
-  EXPECT_TRUE(
-      resUTF_1->testGetConcatBuffer() != resUTF_3->testGetConcatBuffer());
+  // The buffer cannot be reused, so the result refers to both strings.
+  auto resUTF_3 = runtime.makeHandle<RopeUTF16StringPrimitive>(*cr);
+  EXPECT_FALSE(resUTF_3->isFlattened());
+  EXPECT_EQ(*resUTF_1, resUTF_3->getLeft());
 
   std::u16string utfStr3 = utfStr1 + strC;
   utf16Ref = resUTF_3->getStringRef<char16_t>();
   EXPECT_TRUE(utf16Ref.size() == utfStr3.size());
   EXPECT_TRUE(std::equal(utfStr3.begin(), utfStr3.end(), utf16Ref.begin()));
+  EXPECT_TRUE(resUTF_3->isFlattened());
+}
+
+TEST_F(StringPrimTest, RopeTest) {
+  CallResult<HermesValue> cr{ExecutionStatus::EXCEPTION};
+  std::string bigStrA(300, 'a');
+  std::u16string strB(u"b\u1234");
+
+  // Prepending to a long string creates a rope.
+  auto a = StringPrimitive::createNoThrow(runtime, bigStrA);
+  auto b = StringPrimitive::createNoThrow(
+      runtime, UTF16Ref(strB.data(), strB.size()));
+  cr = StringPrimitive::concat(runtime, b, a);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto rope1 = runtime.makeHandle<RopeUTF16StringPrimitive>(*cr);
+  EXPECT_EQ(1u, rope1->getDepth());
+
+  // So does concatenating ropes.
+  cr = StringPrimitive::concat(runtime, rope1, rope1);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto rope2 = runtime.makeHandle<RopeUTF16StringPrimitive>(*cr);
+  EXPECT_EQ(2u, rope2->getDepth());
+  EXPECT_FALSE(rope2->isFlat());
+
+  // Flattening through the runtime drops the references to the halves.
+  auto view = StringPrimitive::createStringView(runtime, rope2);
+  EXPECT_TRUE(rope2->isFlattened());
+  EXPECT_TRUE(rope2->isFlat());
+  EXPECT_EQ(0u, rope2->getDepth());
+  EXPECT_FALSE(rope1->isFlattened());
+
+  std::u16string str1 = strB;
+  str1.append(bigStrA.begin(), bigStrA.end());
+  std::u16string str2 = str1 + str1;
+  ASSERT_EQ(str2.size(), view.length());
+  EXPECT_TRUE(std::equal(str2.begin(), str2.end(), view.begin()));
+
+  // Raw accessors flatten without the runtime.
+  auto utf16Ref = rope1->getStringRef<char16_t>();
+  EXPECT_TRUE(rope1->isFlattened());
+  ASSERT_EQ(str1.size(), utf16Ref.size());
+  EXPECT_TRUE(std::equal(str1.begin(), str1.end(), utf16Ref.begin()));
+
+  // Ropes too deep are copied instead.
+  MutableHandle<StringPrimitive> deep{runtime, *a};
+  for (uint32_t i = 0; i <= RopeASCIIStringPrimitive::MAX_DEPTH; ++i) {
+    cr = StringPrimitive::concat(runtime, a, deep);
+    ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+    deep = vmcast<StringPrimitive>(*cr);
+  }
+  EXPECT_TRUE(vmisa<BufferedASCIIStringPrimitive>(*deep));
+  EXPECT_EQ(
+      (RopeASCIIStringPrimitive::MAX_DEPTH + 2) * bigStrA.size(),
+      deep->getStringLength());
+  auto asciiRef = deep->getStringRef<char>();
+  EXPECT_TRUE(
+      std::all_of(asciiRef.begin(), asciiRef.end(), [](char c) {
+        return c == 'a';
+      }));
+}
+
+TEST_F(StringPrimTest, SliceTest) {
+  CallResult<HermesValue> cr{ExecutionStatus::EXCEPTION};
+  std::string bigStr;
+  for (unsigned i = 0; i < 300; ++i)
+    bigStr.push_back('a' + i % 26);
+  auto big = StringPrimitive::createNoThrow(runtime, bigStr);
+
+  auto expectContents = [](StringPrimitive *str, llvh::StringRef expected) {
+    auto ref = str->getStringRef<char>();
+    EXPECT_EQ(expected, llvh::StringRef(ref.data(), ref.size()));
+  };
+
+  // Long slices share the characters of their parent.
+  cr = StringPrimitive::slice(runtime, big, 10, 200);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto slice1 = runtime.makeHandle<SlicedASCIIStringPrimitive>(*cr);
+  EXPECT_EQ(*big, slice1->getParent());
+  EXPECT_EQ(10u, slice1->getOffset());
+  expectContents(*slice1, llvh::StringRef(bigStr).substr(10, 200));
+
+  // Slices of slices refer to the original parent.
+  cr = StringPrimitive::slice(runtime, slice1, 5, 100);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto slice2 = runtime.makeHandle<SlicedASCIIStringPrimitive>(*cr);
+  EXPECT_EQ(*big, slice2->getParent());
+  EXPECT_EQ(15u, slice2->getOffset());
+  expectContents(*slice2, llvh::StringRef(bigStr).substr(15, 100));
+
+  // Short slices are copied.
+  cr = StringPrimitive::slice(runtime, slice1, 1, 20);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  EXPECT_FALSE(isSlicedStringPrimitive(cr->getString()));
+  expectContents(cr->getString(), llvh::StringRef(bigStr).substr(11, 20));
+
+  // Slicing the whole string doesn't create a new one.
+  cr = StringPrimitive::slice(runtime, big, 0, bigStr.size());
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  EXPECT_EQ(*big, cr->getString());
+
+  // Small slices of a much longer parent are only shared once the parent has
+  // survived a collection.
+  cr = StringPrimitive::slice(runtime, big, 0, 33);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  if (runtime.getHeap().inYoungGen(*big)) {
+    EXPECT_FALSE(isSlicedStringPrimitive(cr->getString()));
+    runtime.collect("test");
+    cr = StringPrimitive::slice(runtime, big, 0, 33);
+    ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  }
+  EXPECT_TRUE(isSlicedStringPrimitive(cr->getString()));
+  expectContents(cr->getString(), llvh::StringRef(bigStr).substr(0, 33));
+  expectContents(*slice2, llvh::StringRef(bigStr).substr(15, 100));
 }
 } // namespace